@@ -188,6 +188,12 @@ public:
     callback.timedEventCustom = fptr;
 #endif
   }
+#if BMC_MAX_SEQUENCES > 0
+  // triggered after a sequence sends the library item of a step
+  void onSequenceStep(void (*fptr)(uint8_t n, bmcLibrary_t event)){
+    callback.sequenceStep = fptr;
+  }
+#endif
   //DEPRECATED, USE onStoreUpdate INSTEAD
   void onEditorUpdate(void (*fptr)()){
     onStoreUpdate(fptr);
@@ -249,10 +255,26 @@ public:
   void onMidiPreRouting(bool (*fptr)(BMCMidiMessage& data, uint8_t destinations)){
     callback.midiPreRoute = fptr;
   }
+  // triggered when a SysEx message was assembled in the SysEx pool, @port
+  // is one of BMC_MIDI_PORT_*_BIT, @length includes the 0xF0 and 0xF7,
+  // read the message with readAssembledSysEx() within the callback, once
+  // the callback returns the message is removed from the pool
+  void onMidiSysExAssembled(void (*fptr)(uint8_t port, uint16_t length)){
+#ifdef BMC_SYSEX_POOL_ENABLED
+    callback.midiSysExAssembled = fptr;
+#endif
+  }
   // triggered when a USB MIDI Device is connected to the Teensy's USB Host
   void onHostConnectionChange(void (*fptr)(bool t_connected)){
 #ifdef BMC_USB_HOST_ENABLED
     callback.hostConnection = fptr;
+#endif
+  }
+  // triggered when a MIDI device is attached to or removed from the USB Host
+  // port, @device is the number used with BMC_HOST_DEVICE_PORT(device)
+  void onHostDeviceConnectionChange(void (*fptr)(uint8_t device, bool t_connected)){
+#ifdef BMC_USB_HOST_ENABLED
+    callback.hostDeviceConnection = fptr;
 #endif
   }
   // triggered when BMC connects to a BLE Master Device
@@ -336,6 +358,44 @@ public:
   void onFasBlockParameterReceived(void (*fptr)(uint8_t block, uint8_t param, uint16_t value, char* str, uint8_t strLen)){
     callback.fasBlockParameterReceived = fptr;
   }
+  // triggered when a resync with the FAS device is complete, latency is the
+  // number of milliseconds from the first request until the last response
+  void onFasSyncComplete(void (*fptr)(uint16_t latency)){
+    callback.fasSyncComplete = fptr;
+  }
+  // triggered when a FAS Effect Block Parameter received has a new value
+  void onFasParameterChange(void (*fptr)(uint8_t block, uint8_t param, uint16_t value)){
+    callback.fasParameterChange = fptr;
+  }
+#endif
+
+// only available if BMC has Kemper sync compiled
+#ifdef BMC_USE_KEMPER
+  // triggered when BMC Detects a Kemper has been connected/disconnected
+  void onKemperConnectionChange(void (*fptr)(bool state)){
+    callback.kemperConnection = fptr;
+  }
+  // triggered when the Kemper rig name has changed
+  void onKemperRigChange(void (*fptr)(char* name)){
+    callback.kemperRigChange = fptr;
+  }
+  // triggered when any Kemper effect module turned on/off
+  void onKemperModulesChange(void (*fptr)()){
+    callback.kemperModulesChange = fptr;
+  }
+  // triggered when a sync with the Kemper is complete, latency is the
+  // number of milliseconds from the first request until the last response
+  void onKemperSyncComplete(void (*fptr)(uint16_t latency)){
+    callback.kemperSyncComplete = fptr;
+  }
+  // triggered when any Kemper parameter value is received
+  void onKemperParameterReceived(void (*fptr)(uint16_t param, uint16_t value)){
+    callback.kemperParamReceived = fptr;
+  }
+  // triggered when any Kemper string parameter is received
+  void onKemperStringReceived(void (*fptr)(uint16_t param, char* str, uint8_t len)){
+    callback.kemperStringReceived = fptr;
+  }
 #endif
 
 // only available when BEATBUDDY is compiled
@@ -344,6 +404,26 @@ public:
     callback.beatBuddyBeatLocation = fptr;
   }
 #endif
+
+// only available when HELIX is compiled
+#ifdef BMC_USE_HELIX
+  // triggered when the Helix snapshot has changed
+  void onHelixSnapshotChange(void (*fptr)(uint8_t n)){
+    callback.helixSnapshotChange = fptr;
+  }
+  // triggered when a Program Change is received from the Helix
+  void onHelixPresetChange(void (*fptr)(uint8_t n)){
+    callback.helixPresetChange = fptr;
+  }
+  // triggered when a Helix footswitch changed, each bit is a footswitch
+  void onHelixFootswitchesChange(void (*fptr)(uint16_t states)){
+    callback.helixFootswitchesChange = fptr;
+  }
+  // triggered when the Helix looper changed, state has the BMC_HELIX_LOOPER_* bits
+  void onHelixLooperChange(void (*fptr)(uint8_t state)){
+    callback.helixLooperChange = fptr;
+  }
+#endif
   // triggered when a BMC Preset has changed
   void onPresetChange(void (*fptr)(bmcPreset_t n)){
     callback.presetChanged = fptr;
@@ -440,6 +520,46 @@ public:
   uint8_t getDawVPotLedState(uint8_t channel, uint8_t ledN){
     return daw.getVPotLedState(channel, ledN);
   }
+  // returns the number of meter segments lit for a channel, 0 to 12
+  uint8_t getDawMeter(uint8_t channel){
+    return daw.getMeter(channel);
+  }
+  // returns the peak hold segment of a channel meter, 0 to 12
+  uint8_t getDawMeterPeak(uint8_t channel){
+    return daw.getMeterPeak(channel);
+  }
+  // the track shown on channel 1, meters are kept for each track as you bank,
+  // Bank/Channel buttons update it but you can set it if the DAW is already banked
+  void setDawMeterBankOffset(uint8_t value){
+    daw.setMeterBankOffset(value);
+  }
+  uint8_t getDawMeterBankOffset(){
+    return daw.getMeterBankOffset();
+  }
+  // passes the 14-bit position of a fader when it changes, channel 8 is the master
+  void onDawFaderFeedback(void (*fptr)(uint8_t channel, uint16_t position)){
+    callback.dawFaderFeedback = fptr;
+  }
+  // passes the leds lit on an 11 led ring when a V-Pot ring changes, bit 0 is the first led
+  void onDawVPotFeedback(void (*fptr)(uint8_t channel, uint16_t leds, bool centered)){
+    callback.dawVPotFeedback = fptr;
+  }
+  // returns the 14-bit position of a fader, 0 to 7 channels, 8 selected, 9 master
+  uint16_t getDawFaderPosition(uint8_t channel){
+    return daw.getFaderPosition(channel);
+  }
+  // returns the leds lit by a fader on a strip of @count leds (up to 32)
+  uint32_t getDawFaderLeds(uint8_t channel, uint8_t count){
+    return daw.getFaderLeds(channel, count);
+  }
+  // returns the leds lit by a V-Pot on a ring of @count leds (up to 32)
+  uint32_t getDawVPotLeds(uint8_t channel, uint8_t count){
+    return daw.getVPotLeds(channel, count);
+  }
+  // true if the pot assigned to the fader has picked up the DAW position
+  bool getDawPotPickedUp(uint8_t channel){
+    return daw.getPotPickedUp(channel);
+  }
 #endif
   // ******************************
   // *****  STOPWATCH  *****
@@ -488,7 +608,7 @@ public:
       if(callback.valueStream){
         uint8_t nStoreAddress = getStoreAddress();
         char buff[30] = "";
-        sprintf(buff, "Store Address Changed to %02u", (uint8_t)(nStoreAddress+1));
+        BMCFormat(buff, sizeof(buff)).addString("Store Address Changed to ").addNumber(nStoreAddress+1, 2);
         streamToSketch(0, nStoreAddress, buff);
       }
       return true;
@@ -522,7 +642,7 @@ public:
   // must pass a pointer to your string with length >= BMC_NAME_LEN_PAGES
   void getPageName(uint8_t n, char* t_string){
     if(n<BMC_MAX_PAGES){
-      strcpy(t_string, store.pages[n].name);
+      strcpy(t_string, pages[n].name);
     }
   }
 #endif
@@ -905,7 +1025,7 @@ public:
   }
   void getButton(uint8_t t_page, uint8_t t_index, bmcStoreButton& t_item){
     if(t_page<BMC_MAX_PAGES && t_index<BMC_MAX_BUTTONS){
-      t_item = store.pages[t_page].buttons[t_index];
+      t_item = pages[t_page].buttons[t_index];
     }
   }
   #if BMC_NAME_LEN_BUTTONS > 1
@@ -914,7 +1034,7 @@ public:
     }
     void getButtonName(uint8_t t_page, uint8_t n, char* t_string){
       if(t_page<BMC_MAX_PAGES && n<BMC_MAX_BUTTONS){
-        strcpy(t_string, store.pages[t_page].buttons[n].name);
+        strcpy(t_string, pages[t_page].buttons[n].name);
       }
     }
   #endif
@@ -974,7 +1094,7 @@ public:
   }
   void getLed(uint8_t t_page, uint8_t t_index, bmcStoreLed& t_item){
     if(t_page<BMC_MAX_PAGES && t_index<BMC_MAX_LEDS){
-      t_item = store.pages[t_page].leds[t_index];
+      t_item = pages[t_page].leds[t_index];
     }
   }
 
@@ -984,7 +1104,7 @@ public:
   }
   void getLedName(uint8_t t_page, uint8_t t_index, char* t_string){
     if(t_page<BMC_MAX_PAGES && t_index<BMC_MAX_LEDS){
-      strcpy(t_string, store.pages[t_page].leds[t_index].name);
+      strcpy(t_string, pages[t_page].leds[t_index].name);
     }
   }
 #endif
@@ -1037,7 +1157,7 @@ public:
   }
   void getPwmLed(uint8_t t_page, uint8_t n, bmcStoreLed& t_item){
     if(t_page < BMC_MAX_PAGES && n < BMC_MAX_PWM_LEDS){
-      t_item = store.pages[t_page].pwmLeds[n];
+      t_item = pages[t_page].pwmLeds[n];
     }
   }
 
@@ -1047,7 +1167,7 @@ public:
   }
   void getPwmLedName(uint8_t t_page, uint8_t n, char* t_string){
     if(t_page<BMC_MAX_PAGES && n<BMC_MAX_PWM_LEDS){
-      strcpy(t_string, store.pages[t_page].pwmLeds[n].name);
+      strcpy(t_string, pages[t_page].pwmLeds[n].name);
     }
   }
 #endif
@@ -1072,7 +1192,7 @@ public:
   }
   void getPixel(uint8_t t_page, uint8_t n, bmcStoreLed& t_item){
     if(t_page<BMC_MAX_PAGES && n<BMC_MAX_PIXELS){
-      t_item = store.pages[t_page].pixels[n];
+      t_item = pages[t_page].pixels[n];
     }
   }
 #if BMC_NAME_LEN_LEDS > 1
@@ -1081,7 +1201,7 @@ public:
   }
   void getPixelName(uint8_t t_page, uint8_t n, char* t_string){
     if(t_page<BMC_MAX_PAGES && n<BMC_MAX_PIXELS){
-      strcpy(t_string, store.pages[t_page].pixels[n].name);
+      strcpy(t_string, pages[t_page].pixels[n].name);
     }
   }
 #endif
@@ -1122,7 +1242,7 @@ public:
   }
   void getRgbPixel(uint8_t t_page, uint8_t n, bmcStoreRgbLed& t_item){
     if(t_page<BMC_MAX_PAGES && n<BMC_MAX_RGB_PIXELS){
-      t_item = store.pages[t_page].rgbPixels[n];
+      t_item = pages[t_page].rgbPixels[n];
     }
   }
 #if BMC_NAME_LEN_LEDS > 1
@@ -1131,7 +1251,7 @@ public:
   }
   void getRgbPixelName(uint8_t t_page, uint8_t n, char* t_string){
     if(t_page<BMC_MAX_PAGES && n<BMC_MAX_RGB_PIXELS){
-      strcpy(t_string, store.pages[t_page].rgbPixels[n].name);
+      strcpy(t_string, pages[t_page].rgbPixels[n].name);
     }
   }
 #endif
@@ -1167,7 +1287,7 @@ public:
   // Get ENCODER Data on specified page
   void getEncoder(uint8_t t_page, uint8_t t_index, bmcStoreEncoder& t_item){
     if(t_page<BMC_MAX_PAGES && t_index<BMC_MAX_ENCODERS){
-      t_item = store.pages[t_page].encoders[t_index];
+      t_item = pages[t_page].encoders[t_index];
     }
   }
   #if BMC_NAME_LEN_ENCODERS > 1
@@ -1178,7 +1298,7 @@ public:
     // get encoder name on specified page passing a pointer string
     void getEncoderName(uint8_t t_page, uint8_t t_index, char* t_string){
       if(t_page<BMC_MAX_PAGES && t_index<BMC_MAX_ENCODERS){
-        strcpy(t_string, store.pages[t_page].encoders[t_index].name);
+        strcpy(t_string, pages[t_page].encoders[t_index].name);
       }
     }
   #endif
@@ -1209,7 +1329,7 @@ public:
   // Get POT Data on specified page
   void getPot(uint8_t t_page, uint8_t n, bmcStorePot& t_item){
     if(t_page<BMC_MAX_PAGES && n<BMC_MAX_POTS){
-      t_item = store.pages[t_page].pots[n];
+      t_item = pages[t_page].pots[n];
     }
   }
   #if BMC_NAME_LEN_POTS > 1
@@ -1220,7 +1340,7 @@ public:
     // get pot name on specified page passing a pointer string
     void getPotName(uint8_t t_page, uint8_t n, char* t_string){
       if(t_page<BMC_MAX_PAGES && n<BMC_MAX_POTS){
-        strcpy(t_string, store.pages[t_page].pots[n].name);
+        strcpy(t_string, pages[t_page].pots[n].name);
       }
     }
   #endif
@@ -1362,26 +1482,27 @@ public:
         strcpy(t_string,(t_value==0)?"OFF":"ON");
         return;
     }
-    char append[16] = "";
+    const char * append = "";
     switch(fAppend){
-      case 0: strcpy(append,""); break;
-      case 1: strcpy(append,"sec"); break;
-      case 2: strcpy(append,"ms"); break;
-      case 3: strcpy(append,"us"); break;
-      case 4: strcpy(append,"mm"); break;
-      case 5: strcpy(append,"cm"); break;
-      case 6: strcpy(append,"m"); break;
-      case 7: strcpy(append,"%"); break;
-      case 8: strcpy(append,"bpm"); break;
-      case 9: strcpy(append,"bpm"); break;
-      case 10: strcpy(append,"hours"); break;
-      case 11: strcpy(append,"minutes"); break;
-      case 12: strcpy(append,"seconds"); break;
-      case 13: strcpy(append,"days"); break;
-      case 14: strcpy(append,"weeks"); break;
-      case 15: strcpy(append,"hours"); break;
-    }
-    sprintf(t_string,"%d %s",value,append);
+      case 0: append = ""; break;
+      case 1: append = "sec"; break;
+      case 2: append = "ms"; break;
+      case 3: append = "us"; break;
+      case 4: append = "mm"; break;
+      case 5: append = "cm"; break;
+      case 6: append = "m"; break;
+      case 7: append = "%"; break;
+      case 8: append = "bpm"; break;
+      case 9: append = "bpm"; break;
+      case 10: append = "hours"; break;
+      case 11: append = "minutes"; break;
+      case 12: append = "seconds"; break;
+      case 13: append = "days"; break;
+      case 14: append = "weeks"; break;
+      case 15: append = "hours"; break;
+    }
+    // the longest value is 16 characters
+    BMCFormat(t_string, 17).addSigned(value).addChar(' ').addString(append);
   }
 #endif
 
@@ -1422,6 +1543,14 @@ public:
   uint8_t getFasSceneNumber(){
     return fas.getSceneNumber();
   }
+  // milliseconds the last resync with the FAS device took
+  uint16_t getFasSyncLatency(){
+    return fas.getSyncLatency();
+  }
+  // longest resync since BMC started
+  uint16_t getFasSyncLatencyMax(){
+    return fas.getSyncLatencyMax();
+  }
   // get the synced preset Bank Number (0 index)
   // the Axe FX II has 384 presets that is 3 banks each with 128 presets
   // on Axe FX II a number from 0 to 2 will be returned
@@ -1506,6 +1635,84 @@ public:
   }
 #endif
 
+#if defined(BMC_USE_KEMPER)
+  bool kemperConnected(){
+    return kemper.connected();
+  }
+  void kemperConnect(){
+    kemper.connect();
+  }
+  void kemperDisconnect(){
+    kemper.disconnect();
+  }
+  // request the rig names and effect module states again
+  void kemperSync(){
+    kemper.sync();
+  }
+  // copy the current Rig Name into a buffer char array
+  // the length of the char array must be at least 32 bytes
+  bool getKemperRigName(char* str){
+    strcpy(str, kemper.getRigName());
+    return kemper.connected();
+  }
+  bool getKemperPerformanceName(char* str){
+    strcpy(str, kemper.getPerformanceName());
+    return kemper.connected();
+  }
+  // rig slot of the current performance 0 to 4, 255 if unknown
+  uint8_t getKemperSlot(){
+    return kemper.getSlot();
+  }
+  void setKemperSlot(uint8_t n){
+    kemper.setSlot(n);
+  }
+  void setKemperProgram(uint8_t n){
+    kemper.setProgram(n);
+  }
+  // n is one of BMC_KEMPER_MODULE_*
+  bool getKemperModuleState(uint8_t n){
+    return kemper.isModuleOn(n);
+  }
+  void setKemperModuleState(uint8_t n, bool state){
+    kemper.setModule(n, state);
+  }
+  void kemperToggleModule(uint8_t n){
+    kemper.toggleModule(n);
+  }
+  // last value received for a parameter, page in the upper byte
+  uint16_t getKemperParameter(uint16_t param){
+    return kemper.getParameter(param);
+  }
+  void kemperSendSetParameter(uint16_t param, uint16_t value){
+    kemper.sendSetParameter(param, value);
+  }
+  void kemperRequestParameter(uint16_t param){
+    kemper.requestParameter(param);
+  }
+  // milliseconds the last sync with the Kemper took
+  uint16_t getKemperSyncLatency(){
+    return kemper.getSyncLatency();
+  }
+#endif
+
+#if defined(BMC_USE_HELIX)
+  uint8_t getHelixSnapshot(){
+    return helix.getSnapshot();
+  }
+  uint8_t getHelixPreset(){
+    return helix.getPreset();
+  }
+  bool getHelixFootswitch(uint8_t n){
+    return helix.isFootswitchOn(n);
+  }
+  uint8_t getHelixLooperState(){
+    return helix.getLooperState();
+  }
+  void setHelixSnapshot(uint8_t n){
+    helix.setSnapshot(n);
+  }
+#endif
+
 #if defined(BMC_USE_BEATBUDDY)
   bool beatBuddySynced(){
     return beatBuddy.inSync();
@@ -1540,6 +1747,47 @@ public:
   void midiClockTap(){
     midiClock.tap();
   }
+  // only works when on master clock
+  // sends Start and plays the song from the beginning
+  void midiClockStart(){
+    midiClock.start();
+  }
+  // sends Stop, the song position is kept
+  void midiClockStop(){
+    midiClock.stop();
+  }
+  // sends Continue and plays from the current song position
+  void midiClockContinue(){
+    midiClock.resume();
+  }
+  bool midiClockIsPlaying(){
+    return midiClock.isPlaying();
+  }
+  // moves the song to @position in 16th notes and sends a Song Position
+  // Pointer, if playing the song is stopped and continued
+  void setMidiClockSongPosition(uint16_t position){
+    midiClock.setSongPosition(position);
+  }
+  uint16_t getMidiClockSongPosition(){
+    return midiClock.getSongPosition();
+  }
+  // swing of the outgoing clock, the percentage of each 8th note taken by
+  // it's first 16th note, 50 (straight) to 75
+  void setMidiClockSwing(uint8_t value){
+    midiClock.setSwing(value);
+  }
+  uint8_t getMidiClockSwing(){
+    return midiClock.getSwing();
+  }
+#ifdef BMC_MTC_ENABLED
+  // MIDI Time Code frames per second, 24, 25 or 30
+  void setMidiTimeCodeRate(uint8_t fps){
+    midiClock.setTimeCodeRate(fps);
+  }
+  uint8_t getMidiTimeCodeRate(){
+    return midiClock.getTimeCodeRate();
+  }
+#endif
   bool editorConnected(){
     return globals.editorConnected();
   }
@@ -1549,6 +1797,16 @@ public:
   bool hostConnected(){
     return globals.hostConnected();
   }
+  // bit mask of the devices connected to the USB Host port
+  uint8_t getHostDevices(){
+    return midi.getHostDevices();
+  }
+  uint16_t getHostDeviceVendorId(uint8_t device=0){
+    return midi.getHostDeviceVendorId(device);
+  }
+  uint16_t getHostDeviceProductId(uint8_t device=0){
+    return midi.getHostDeviceProductId(device);
+  }
   // STOP WATCH
   uint8_t getStopwatchState(){
     return stopwatch.getState();
@@ -1569,6 +1827,38 @@ public:
   uint32_t getRuntime(){
     return runTime.getSeconds();
   }
+  // BOOT TIME
+  // microseconds from the start of begin() until a stage of the startup was
+  // reached, @n is one of BMC_BOOT_STAGE_*, 0 if it hasn't been reached yet
+  uint32_t getBootStageTime(uint8_t n){
+    return bootStages.elapsed(n);
+  }
+  // PRESET RECALL
+  // microseconds from the last preset recall until the last byte was sent
+  // to port @n, @n is one of BMC_MIDI_PORT_*_BIT, 0 if the port wasn't used
+  uint32_t getPresetRecallLatency(uint8_t n){
+    #if defined(BMC_PRESET_PIPELINE_ENABLED)
+      return presets.getRecallLatency(n);
+    #else
+      return 0;
+    #endif
+  }
+  // true while the last preset recall is still sending
+  bool presetRecallActive(){
+    #if defined(BMC_PRESET_PIPELINE_ENABLED)
+      return presets.recallActive();
+    #else
+      return false;
+    #endif
+  }
+  // true while the store is still being loaded in the background
+  bool storeLoading(){
+    #if defined(BMC_FAST_BOOT_ENABLED)
+      return editor.storeLoading();
+    #else
+      return false;
+    #endif
+  }
   //TIME
 #if defined(BMC_USE_TIME)
   uint8_t getHour(){
@@ -1673,6 +1963,210 @@ public:
     return 0;
   }
 
+#if BMC_MAX_SEQUENCES > 0
+  // ***************************
+  // ******* SEQUENCES *********
+  // ***************************
+  // starts sequence @n, right away or on the next multiple of it's
+  // quantize beats
+  void startSequence(uint8_t n){
+    sequencer.start(n, midiClock.getSongTicks());
+  }
+  void stopSequence(uint8_t n){
+    sequencer.stop(n);
+  }
+  void toggleSequence(uint8_t n){
+    sequencer.toggle(n, midiClock.getSongTicks());
+  }
+  void stopAllSequences(){
+    sequencer.stopAll();
+  }
+  bool isSequencePlaying(uint8_t n){
+    return sequencer.isPlaying(n);
+  }
+  // @length number of steps, @ticks loop length in ticks (0 loops after
+  // the last step), @quantize beats to start on (0 starts right away)
+  // stops the sequence, call saveSequence() to store it in EEPROM
+  void setSequence(uint8_t n, uint8_t length, bool loop, uint16_t ticks=0, uint8_t quantize=0){
+    if(n >= BMC_MAX_SEQUENCES){
+      return;
+    }
+    sequencer.edited(n);
+    bmcStoreGlobalSequence& item = store.global.sequences[n];
+    item.length = (length > BMC_MAX_SEQUENCE_STEPS) ? BMC_MAX_SEQUENCE_STEPS : length;
+    bitWrite(item.flags, BMC_SEQUENCE_FLAG_LOOP, loop);
+    item.ticks = ticks;
+    item.quantize = quantize;
+  }
+  // step @s of sequence @n sends library item @event at @tick,
+  // 24 ticks per quarter note, steps are sorted by tick when the
+  // sequence starts so they can be set in any order
+  void setSequenceStep(uint8_t n, uint8_t s, uint16_t tick, bmcLibrary_t event){
+    if(n >= BMC_MAX_SEQUENCES || s >= BMC_MAX_SEQUENCE_STEPS){
+      return;
+    }
+    sequencer.edited(n);
+    store.global.sequences[n].steps[s].tick = tick;
+    store.global.sequences[n].steps[s].event = event;
+  }
+  // saves sequence @n to EEPROM
+  void saveSequence(uint8_t n){
+    if(n >= BMC_MAX_SEQUENCES || globals.editorConnected()){
+      return;
+    }
+    editor.saveSequence(n);
+  }
+#endif
+
+#if BMC_MAX_MODULATORS > 0
+  // ***************************
+  // ******* MODULATORS ********
+  // ***************************
+  void startModulator(uint8_t n){
+    modulators.start(n);
+  }
+  // the last value sent is kept
+  void stopModulator(uint8_t n){
+    modulators.stop(n);
+  }
+  void toggleModulator(uint8_t n){
+    modulators.toggle(n);
+  }
+  void stopAllModulators(){
+    modulators.stopAll();
+  }
+  bool isModulatorRunning(uint8_t n){
+    return modulators.isRunning(n);
+  }
+  // last value sent by modulator @n
+  uint16_t getModulatorValue(uint8_t n){
+    return modulators.getValue(n);
+  }
+  // @shape BMC_MODULATOR_SHAPE_*, @period length of a cycle in milliseconds
+  // or in clock ticks (24 per quarter note) if @sync is true
+  // stops the modulator, call saveModulator() to store it in EEPROM
+  void setModulator(uint8_t n, uint8_t shape, uint16_t period, bool loop, bool sync=false){
+    if(n >= BMC_MAX_MODULATORS){
+      return;
+    }
+    modulators.stop(n);
+    bmcStoreGlobalModulator& item = store.global.modulators[n];
+    item.shape = (shape > BMC_MODULATOR_SHAPE_RANDOM) ? BMC_MODULATOR_SHAPE_RAMP : shape;
+    item.period = period;
+    bitWrite(item.flags, BMC_MODULATOR_FLAG_LOOP, loop);
+    bitWrite(item.flags, BMC_MODULATOR_FLAG_SYNC, sync);
+  }
+  // @output BMC_MODULATOR_OUTPUT_*, @number CC#, CC# 0 to 31 for 14-bit CC
+  // or the NRPN number, @min and @max are 0 to 127 for CC and 0 to 16383
+  // for the rest, @interval milliseconds between updates (0 for 10ms)
+  void setModulatorOutput(uint8_t n, uint8_t output, uint8_t ports, uint8_t channel,
+                          uint16_t number, uint16_t min, uint16_t max, uint8_t interval=0){
+    if(n >= BMC_MAX_MODULATORS){
+      return;
+    }
+    modulators.stop(n);
+    bmcStoreGlobalModulator& item = store.global.modulators[n];
+    item.output = (output > BMC_MODULATOR_OUTPUT_PITCH) ? BMC_MODULATOR_OUTPUT_CC : output;
+    item.ports = ports;
+    item.channel = constrain(channel, 1, 16);
+    item.number = number & 0x3FFF;
+    item.min = min;
+    item.max = max;
+    item.interval = interval;
+  }
+  // saves modulator @n to EEPROM
+  void saveModulator(uint8_t n){
+    if(n >= BMC_MAX_MODULATORS || globals.editorConnected()){
+      return;
+    }
+    editor.saveModulator(n);
+  }
+#endif
+
+#if BMC_MAX_TEMPO_TO_TAP > 0
+  // ***************************
+  // ****** TEMPO TO TAP *******
+  // ***************************
+#if defined(BMC_TEMPO_TO_TAP_PROFILES_ENABLED)
+  // profile of device @n, @taps number of taps sent, @window number of tap
+  // intervals the device averages, @threshold BPM the tempo has to drift
+  // before the device is tapped again, 0 uses the default of each one
+  // call saveTempoToTapProfile() to store it in EEPROM
+  void setTempoToTapProfile(uint8_t n, uint8_t taps, uint8_t window=0, uint8_t threshold=0){
+    if(n >= BMC_MAX_TEMPO_TO_TAP){
+      return;
+    }
+    bmcStoreGlobalTempoToTapProfile& item = store.global.tempoToTapProfiles[n];
+    item.taps = taps;
+    item.window = window;
+    item.threshold = threshold;
+  }
+  // saves the profile of device @n to EEPROM
+  void saveTempoToTapProfile(uint8_t n){
+    if(n >= BMC_MAX_TEMPO_TO_TAP || globals.editorConnected()){
+      return;
+    }
+    editor.saveTempoToTapProfile(n);
+  }
+#endif
+  // taps every device again at the current tempo on the next beats
+  void tempoToTapRetap(){
+    tempoToTap.retap(midiClock.getBpm());
+  }
+  // the tempo device @n was last tapped to, 0 if it wasn't tapped yet
+  uint16_t getTempoToTapBpm(uint8_t n){
+    return tempoToTap.getTappedBpm(n);
+  }
+#endif
+
+#ifdef BMC_SYSEX_POOL_ENABLED
+  // ***************************
+  // ****** SYSEX POOL *********
+  // ***************************
+  // copies up to @length bytes of the SysEx message assembled on @port
+  // starting at @offset into @buff, returns the number of bytes copied
+  // only available within the onMidiSysExAssembled callback
+  uint16_t readAssembledSysEx(uint8_t port, uint16_t offset, uint8_t * buff, uint16_t length){
+    return midi.getSysExPool().read(port, offset, buff, length);
+  }
+  // blocks in use, most blocks used at once, messages dropped etc.
+  bmcSysExPoolStats& getSysExPoolStats(){
+    return midi.getSysExPool().getStats();
+  }
+  void resetSysExPoolStats(){
+    midi.getSysExPool().resetStats();
+  }
+#endif
+
+  // ***************************
+  // ***** MIDI USB CABLES *****
+  // ***************************
+  // number of USB cables, each one is a separate MIDI port on the computer
+  uint8_t getUsbCables(){
+    return BMC_USB_CABLES;
+  }
+  // route the messages received on USB @cable, @data is the same as the
+  // routing data set with the editor, bits 0-6 destination ports, bits 7-10
+  // filters and bits 11-15 channel (0 for omni)
+  // cable 0 is the USB routing set with the editor, it's replaced when the
+  // editor updates the routing
+  void setUsbCableRouting(uint8_t cable, uint16_t data){
+    midi.setRouting(BMC_USB_CABLE_PORT(cable), data);
+  }
+  // USB cable used when messages received by @port are routed to USB,
+  // @port is BMC_SERIAL_A, BMC_HOST etc. or a USB cable port
+  void setRoutingCable(uint8_t port, uint8_t cable){
+    midi.setRoutingCable(port, cable);
+  }
+#ifdef BMC_USB_HOST_ENABLED
+  // route the messages received from USB Host @device, @data is the same
+  // as in setUsbCableRouting, device 0 is the USB Host routing set with
+  // the editor
+  void setHostDeviceRouting(uint8_t device, uint16_t data){
+    midi.setRouting(BMC_HOST_DEVICE_PORT(device), data);
+  }
+#endif
+
   // ***************************
   // ******* MIDI SEND *********
   // ***************************
@@ -13,6 +13,7 @@ BMC::BMC():
   midi(callback, globals, store.global.portPresets),
   valueTyper(callback),
   editor(store, midi, settings, messenger),
+  pages(editor.getPages()),
   midiClock(midi),
   midiActiveSense(midi)
   #ifdef BMC_USE_DAW_LC
@@ -58,6 +59,12 @@ BMC::BMC():
   #if BMC_MAX_TIMED_EVENTS > 0
     ,timedEvents(store.global)
   #endif
+  #if BMC_MAX_SEQUENCES > 0
+    ,sequencer(store.global)
+  #endif
+  #if BMC_MAX_MODULATORS > 0
+    ,modulators(midi, store.global)
+  #endif
   #if BMC_MAX_BUTTONS > 1
     // second argument is true for global buttons
     // to check which callback to use
@@ -76,6 +83,7 @@ BMC::BMC():
 }
 
 void BMC::begin(){
+  bootStages.set(BMC_BOOT_STAGE_START);
   // keep this order
   #ifdef BMC_DEBUG
     setupDebug();
@@ -84,6 +92,7 @@ void BMC::begin(){
 
   // setup all MIDI Ports being used
   midi.begin();
+  bootStages.set(BMC_BOOT_STAGE_MIDI);
 
   // setup midi clock
   midiClock.begin();
@@ -93,9 +102,18 @@ void BMC::begin(){
 
   // load intial data from EEPROM, etc.
   editor.begin();
+  #if defined(BMC_FAST_BOOT_ENABLED)
+    // only settings and the first page are loaded at this point,
+    // assign the midi routing now so midi can go thru on the first update()
+    assignSettings();
+  #else
+    bootStages.set(BMC_BOOT_STAGE_STORE);
+  #endif
+  bootStages.set(BMC_BOOT_STAGE_SETTINGS);
 
   // here we handle pin assignments during the initial setup
   setupHardware();
+  bootStages.set(BMC_BOOT_STAGE_HARDWARE);
 
   #ifdef BMC_USE_CLICK_TRACK
     // the click track object is tied to the MIDI Clock since they work hand in hand.
@@ -117,19 +135,30 @@ void BMC::begin(){
   midi.setRealTimeBlockInput(settings.getMidiRealTimeBlockInput());
   midi.setRealTimeBlockOutput(settings.getMidiRealTimeBlockOutput());
 
+  #if BMC_MAX_SEQUENCES > 0 && !defined(BMC_FAST_BOOT_ENABLED)
+    sequencer.buildListeners();
+  #endif
+
   BMC_INFO("BMC Initial Setup Complete!");
 
-  delay(100);
+  #if !defined(BMC_FAST_BOOT_ENABLED)
+    delay(100);
+  #endif
 
   #ifdef BMC_USE_FAS
     fas.begin();
   #endif
 
+  #ifdef BMC_USE_KEMPER
+    kemper.begin();
+  #endif
+
   // this flag will allow BMC to execute some code only the first time update() runs
   // yes that code can run here instead HOWEVER by letting that code execute
   // after the first loop we are allowing other classes with a begin() method
   // do their thing
   flags.on(BMC_FLAGS_FIRST_LOOP);
+  bootStages.set(BMC_BOOT_STAGE_READY);
 }
 
 void BMC::update(){
@@ -150,14 +179,23 @@ void BMC::update(){
     // We do this here so that any other objects initialized after BMC
     // can receive callbacks.
     setPage(0, true);
-
-    // Startup Preset
-    #if BMC_MAX_LIBRARY > 0 && BMC_MAX_PRESETS > 0
-      // send the startup Preset if any
-      if(settings.getMidiStartup()){
-        delay(1);
-        presets.send(globalData.startup);
+    bootStages.set(BMC_BOOT_STAGE_PAGE);
+
+    #if defined(BMC_FAST_BOOT_ENABLED)
+      if(editor.storeLoading()){
+        // presets are not loaded yet, the startup preset
+        // is sent once the store is loaded
+        flags.on(BMC_FLAGS_STARTUP_PRESET);
+      } else {
+        sendStartupPreset();
       }
+    #else
+      sendStartupPreset();
+    #endif
+
+    #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+      // resume the stopwatch where it was left
+      editor.getJournal().getStopwatch(stopwatch);
     #endif
 
     // start sending active sense if stored in settings
@@ -177,16 +215,33 @@ void BMC::update(){
     oneMilliSecondtimer = 0;
   }
 
-  #if BMC_MAX_TEMPO_TO_TAP > 0
-    tempoToTap.update();
-  #endif
-
   #if BMC_MAX_TIMED_EVENTS > 0
     readTimedEvent();
   #endif
 
+  #if BMC_MAX_MODULATORS > 0
+    modulators.update();
+  #endif
+
   editor.update();
 
+  #if defined(BMC_PRESET_PIPELINE_ENABLED)
+    // send what's left of the last preset recall
+    presets.update();
+  #endif
+
+  #if defined(BMC_FAST_BOOT_ENABLED)
+    if(editor.storeLoaded()){
+      // the rest of the store was loaded in the background,
+      // reassign everything that uses global data
+      assignStoreData();
+      bootStages.set(BMC_BOOT_STAGE_STORE);
+      if(flags.toggleIfTrue(BMC_FLAGS_STARTUP_PRESET)){
+        sendStartupPreset();
+      }
+    }
+  #endif
+
   // read the midi input ports
   // this method is in BMC.midi.cpp
   readMidi();
@@ -218,6 +273,9 @@ void BMC::update(){
 
 #ifdef BMC_USE_KEMPER
     kemper.update();
+    if(kemper.rigChanged()){
+      streamToSketch(BMC_ITEM_ID_KEMPER_RIG, kemper.getSlot(), kemper.getRigName());
+    }
 #endif
 
   // Read/Update the hardware: buttons, leds, pots, encoders
@@ -231,12 +289,13 @@ void BMC::update(){
   #if BMC_MAX_PRESETS > 0
     if(presets.presetChanged()){
       editor.utilitySendPreset(presets.get());
-      char presetName[30] = "";
-      presets.getName(presets.get(), presetName);
-      streamToSketch(BMC_ITEM_ID_PRESET, presets.get(), presetName);
+      streamToSketch(BMC_ITEM_ID_PRESET, presets.get(), presets.getName(presets.get()));
       if(callback.presetChanged){
         callback.presetChanged(presets.get());
       }
+      #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+        saveJournalPreset();
+      #endif
     }
     if(presets.bankChanged()){
       if(callback.presetBankChanged){
@@ -251,14 +310,18 @@ void BMC::update(){
         if(callback.setListChanged){
           callback.setListChanged(setLists.get());
         }
+        #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+          saveJournalPreset();
+        #endif
       }
       if(setLists.songChanged()){
-        char songName[30] = "";
-        presets.getName(setLists.getSongPreset(), songName);
-        streamToSketch(BMC_ITEM_ID_SETLIST_SONG, setLists.getSong(), songName);
+        streamToSketch(BMC_ITEM_ID_SETLIST_SONG, setLists.getSong(), presets.getName(setLists.getSongPreset()));
         if(callback.setListSongChanged){
           callback.setListSongChanged(setLists.getSong());
         }
+        #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+          saveJournalPreset();
+        #endif
       }
     #endif
   #endif
@@ -278,6 +341,13 @@ void BMC::update(){
         pixelPrograms.setProgram(library.getPixelProgramChange());
       }
     #endif
+    #if BMC_MAX_MODULATORS > 0
+      uint8_t modulator = 0;
+      uint8_t modulatorCmd = 0;
+      while(library.getModulatorCommand(modulator, modulatorCmd)){
+        modulators.command(modulator, modulatorCmd);
+      }
+    #endif
   }
 #endif
 
@@ -359,6 +429,24 @@ void BMC::update(){
   }
 }
 
+void BMC::sendStartupPreset(){
+  #if BMC_MAX_LIBRARY > 0 && BMC_MAX_PRESETS > 0
+    bool sendStartup = settings.getMidiStartup();
+    #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+      // the preset in use when BMC was turned off takes the place
+      // of the startup preset
+      if(restoreJournalPreset()){
+        sendStartup = false;
+      }
+    #endif
+    // send the startup Preset if any
+    if(sendStartup){
+      delay(1);
+      presets.send(globalData.startup);
+    }
+  #endif
+}
+
 void BMC::stopwatchCmd(uint8_t cmd, uint8_t h, uint8_t m, uint8_t s){
   switch(cmd){
     case BMC_STOPWATCH_CMD_STOP:
@@ -386,4 +474,38 @@ void BMC::stopwatchCmd(uint8_t cmd, uint8_t h, uint8_t m, uint8_t s){
       stopwatch.toggleReset();
       break;
   }
+  #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+    // the time is only saved when a command is received, saving it
+    // every second would wear out the EEPROM
+    editor.getJournal().saveStopwatch(stopwatch);
+  #endif
+}
+
+#if defined(BMC_STORAGE_JOURNAL_ENABLED) && BMC_MAX_LIBRARY > 0 && BMC_MAX_PRESETS > 0
+void BMC::saveJournalPreset(){
+  bmcJournalPreset data;
+  data.preset = presets.get();
+  #if BMC_MAX_SETLISTS > 0
+    data.setList = setLists.get();
+    data.song = setLists.getSong();
+  #endif
+  editor.getJournal().savePreset(data);
 }
+bool BMC::restoreJournalPreset(){
+  bmcJournalPreset data;
+  if(!editor.getJournal().getPreset(data) || data.preset >= BMC_MAX_PRESETS){
+    return false;
+  }
+  BMC_PRINTLN("Restoring Preset", data.preset, "from journal");
+  delay(1);
+  #if BMC_MAX_SETLISTS > 0
+    setLists.set(data.setList);
+    if(data.song < BMC_MAX_SETLISTS_SONGS && setLists.getSongPreset(data.song) == data.preset){
+      setLists.setSong(data.song);
+      return true;
+    }
+  #endif
+  presets.send(data.preset);
+  return true;
+}
+#endif
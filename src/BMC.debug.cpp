@@ -60,13 +60,34 @@ void BMC::readDebug(){
     #ifdef BMC_MIDI_BLE_ENABLED
     BMC_PRINTLN("bleDebug = Toggles BLE MIDI Debugging, displays Incoming/Outgoing BLE Packet arrays.");
     BMC_PRINTLN("disconnectBLE = Disconnect the BLE Module if connected.");
+    BMC_PRINTLN("bleStats = Displays the BLE MIDI queues and packet stats since the last time it was used.");
     #endif
 
 #ifdef BMC_USE_FAS
     BMC_PRINTLN("fasConnection = Toggle the connection state of a FAS device");
     BMC_PRINTLN("fasDebug = Toggle Additional debug information of synced FAS device");
+    BMC_PRINTLN("fasSync = Displays FAS resync latency statistics");
+#endif
+#ifdef BMC_USE_KEMPER
+    BMC_PRINTLN("kemperConnection = Toggle the connection state of a Kemper device");
+    BMC_PRINTLN("kemperSync = Displays Kemper sync latency statistics and the synced rig");
 #endif
 
+    #ifdef BMC_USB_HOST_ENABLED
+    BMC_PRINTLN("hostDevices = Displays the MIDI devices connected to the USB Host port with their vendor and product ids");
+    #endif
+    #ifdef BMC_SYSEX_POOL_ENABLED
+    BMC_PRINTLN("sysExPool = Displays the SysEx pool blocks in use, the most used at once and messages dropped since the last time it was used.");
+    #endif
+    #ifdef BMC_SD_PAGED_STORE_ENABLED
+    BMC_PRINTLN("pageCache = Displays the pages loaded from the SD Card, page load times and RAM used by pages");
+    #endif
+    #ifdef BMC_STORAGE_JOURNAL_ENABLED
+    BMC_PRINTLN("journal = Displays the state of the storage journal, records written and live records");
+    #endif
+    #ifdef BMC_PRESET_PIPELINE_ENABLED
+    BMC_PRINTLN("presetRecall = Displays how long the last preset recall took on each port");
+    #endif
     BMC_PRINTLN("storageDebug = Prints the time it takes to read/write/clear EEPROM everytime the actions happens");
     BMC_PRINTLN("metrics = Prints some metrics of the performance of BMC like loops per second, etc. Happens every other second.");
     BMC_PRINTLN("nextPage = Go to next page");
@@ -80,6 +101,7 @@ void BMC::readDebug(){
     BMC_PRINTLN("buttons = Toggles displaying when buttons are triggered");
     #endif
     BMC_PRINTLN("runTime = Displays how long BMC has been running.");
+    BMC_PRINTLN("bootTime = Displays how long each stage of the startup took.");
     BMC_PRINTLN("stopwatch = Displays Stopwatch info.");
     printDebugHeader(debugInput);
 
@@ -98,12 +120,93 @@ void BMC::readDebug(){
     BMC_PRINTLN("FAS Debug:",globals.toggleFasDebug());
     printDebugHeader(debugInput);
 
+  } else if(BMC_STR_MATCH(debugInput,"fasSync")){
+    printDebugHeader(debugInput);
+    BMC_PRINTLN("Resyncs:", fas.getSyncCount());
+    BMC_PRINTLN("Last:", fas.getSyncLatency(), "ms");
+    BMC_PRINTLN("Max:", fas.getSyncLatencyMax(), "ms");
+    BMC_PRINTLN("Retries:", fas.getSyncRetries());
+    printDebugHeader(debugInput);
+
+#endif
+#ifdef BMC_USE_KEMPER
+  } else if(BMC_STR_MATCH(debugInput,"kemperConnection")){
+    printDebugHeader(debugInput);
+    if(kemper.connected()){
+      kemper.disconnect();
+    } else {
+      kemper.connect();
+    }
+    printDebugHeader(debugInput);
+
+  } else if(BMC_STR_MATCH(debugInput,"kemperSync")){
+    printDebugHeader(debugInput);
+    BMC_PRINTLN("Connected:", kemper.connected());
+    BMC_PRINTLN("Rig:", kemper.getRigName());
+    BMC_PRINTLN("Performance:", kemper.getPerformanceName());
+    BMC_PRINTLN("Slot:", kemper.getSlot());
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_MODULES ; i++){
+      BMC_PRINTLN("Module", i, kemper.isModuleKnown(i) ? (kemper.isModuleOn(i) ? "ON" : "OFF") : "?");
+    }
+    BMC_PRINTLN("Syncs:", kemper.getSyncCount());
+    BMC_PRINTLN("Last:", kemper.getSyncLatency(), "ms");
+    BMC_PRINTLN("Max:", kemper.getSyncLatencyMax(), "ms");
+    BMC_PRINTLN("Retries:", kemper.getRequestRetries());
+    BMC_PRINTLN("Queued:", kemper.getRequestsQueued());
+    printDebugHeader(debugInput);
+
 #endif
   } else if(BMC_STR_MATCH(debugInput,"storageDebug")){
     printDebugHeader(debugInput);
     BMC_PRINTLN("Storage Debug:",globals.toggleStorageDebug());
     printDebugHeader(debugInput);
 
+#ifdef BMC_SD_PAGED_STORE_ENABLED
+  } else if(BMC_STR_MATCH(debugInput,"pageCache")){
+    printDebugHeader(debugInput);
+    BMC_PRINTLN("Pages", BMC_MAX_PAGES, "Slots", BMC_SD_PAGED_STORE_SLOTS);
+    for(uint8_t i = 0 ; i < BMC_SD_PAGED_STORE_SLOTS ; i++){
+      BMC_PRINTLN("slot", i, "page", pages.getSlotPage(i));
+    }
+    BMC_PRINTLN("hits", pages.getHits(), "misses", pages.getMisses(), "prefetched", pages.getPrefetched(), "out of range", pages.getRejected());
+    BMC_PRINTLN("last page load", pages.getLastLoadTime(), "us, max", pages.getMaxLoadTime(), "us");
+    BMC_PRINTLN("RAM used by pages", (sizeof(bmcStorePage)*(BMC_SD_PAGED_STORE_SLOTS+1)), "bytes, instead of", (sizeof(bmcStorePage)*BMC_MAX_PAGES), "bytes");
+    BMC_PRINTLN("Free RAM", globals.getRAM());
+    printDebugHeader(debugInput);
+
+#endif
+#ifdef BMC_STORAGE_JOURNAL_ENABLED
+  } else if(BMC_STR_MATCH(debugInput,"journal")){
+    printDebugHeader(debugInput);
+    BMCStorageJournal& journal = editor.getJournal();
+    BMC_PRINTLN("Slots", BMC_JOURNAL_SLOTS, "at address", journal.getStart(), "head", journal.getHead());
+    BMC_PRINTLN("live records", journal.getLiveRecords(), "next seq", journal.getSeq());
+    BMC_PRINTLN("written", journal.getWrites(), "unchanged", journal.getSkipped(), "restored", journal.getRestored(), "compactions", journal.getCompactions());
+    BMC_PRINTLN("last write", journal.getLastWriteTime(), "us");
+    printDebugHeader(debugInput);
+
+#endif
+#ifdef BMC_PRESET_PIPELINE_ENABLED
+  } else if(BMC_STR_MATCH(debugInput,"presetRecall")){
+    printDebugHeader(debugInput);
+    BMC_PRINTLN("Preset", presets.get(), presets.recallActive() ? "sending" : "done");
+    for(uint8_t i = 0 ; i < BMC_PRESET_RECALL_PORTS ; i++){
+      if(presets.getRecallLatency(i) > 0){
+        BMC_PRINTLN(BMCTools::printPortsNames(bit(i)), presets.getRecallLatency(i), "us");
+      }
+    }
+    printDebugHeader(debugInput);
+
+#endif
+  } else if(BMC_STR_MATCH(debugInput,"bootTime")){
+    printDebugHeader(debugInput);
+    BMC_PRINTLN("midi ports", bootStages.elapsed(BMC_BOOT_STAGE_MIDI), "us");
+    BMC_PRINTLN("settings", bootStages.elapsed(BMC_BOOT_STAGE_SETTINGS), "us");
+    BMC_PRINTLN("hardware", bootStages.elapsed(BMC_BOOT_STAGE_HARDWARE), "us");
+    BMC_PRINTLN("begin() done", bootStages.elapsed(BMC_BOOT_STAGE_READY), "us");
+    BMC_PRINTLN("first page", bootStages.elapsed(BMC_BOOT_STAGE_PAGE), "us");
+    BMC_PRINTLN("store loaded", bootStages.elapsed(BMC_BOOT_STAGE_STORE), "us");
+    printDebugHeader(debugInput);
   } else if(BMC_STR_MATCH(debugInput,"runTime")){
     printDebugHeader(debugInput);
     BMC_PRINTLN("millis()", millis());
@@ -179,6 +282,20 @@ void BMC::readDebug(){
       );
     }
     BMC_PRINTLN("BPM", midiClock.getBpm());
+    if(midiClock.isMaster()){
+      BMC_PRINTLN(midiClock.isPlaying() ? "Playing" : "Stopped",
+                  "Song Position", midiClock.getSongPosition(),
+                  "Swing", midiClock.getSwing());
+#ifdef BMC_MTC_ENABLED
+      {
+        BMCMidiTimeCode& mtc = midiClock.getTimeCode();
+        uint32_t frames = mtc.getFrames();
+        BMC_PRINTLN("MTC", mtc.getRate(), "fps",
+                    mtc.getHours(frames), mtc.getMinutes(frames),
+                    mtc.getSeconds(frames), mtc.getFrame(frames));
+      }
+#endif
+    }
     printDebugHeader(debugInput);
 
   } else if(BMC_STR_MATCH(debugInput,"midiIn")){
@@ -214,11 +331,47 @@ void BMC::readDebug(){
     printDebugHeader(debugInput);
     midi.disconnectBLE();
     printDebugHeader(debugInput);
+  } else if(BMC_STR_MATCH(debugInput,"bleStats")){
+    printDebugHeader(debugInput);
+    BMC_PRINTLN("RX queued:", midi.getSerialBle().getRxQueued(), "dropped:", midi.getSerialBle().getRxOverflows());
+    BMC_PRINTLN("TX queued:", midi.getSerialBle().getTxQueued(), "dropped:", midi.getSerialBle().getTxOverflows());
+    {
+      bmcBleTxStats& stats = midi.getSerialBle().getTxStats();
+      BMC_PRINTLN("TX packets:", stats.packets, "bytes:", stats.bytes, "refused:", stats.refused, "clocks dropped:", stats.clocksDropped);
+      BMC_PRINTLN("TX latency avg:", (stats.latencyAvg >> 3), "ms max:", stats.latencyMax, "ms");
+      BMC_PRINTLN("Connection interval:", stats.interval, "ms packets per interval:", stats.packetsPerInterval);
+      midi.getSerialBle().resetTxStats();
+    }
+    printDebugHeader(debugInput);
 
 #endif
 
 
 
+#ifdef BMC_USB_HOST_ENABLED
+  } else if(BMC_STR_MATCH(debugInput,"hostDevices")){
+    printDebugHeader(debugInput);
+    for(uint8_t i = 0 ; i < BMC_USB_HOST_DEVICES ; i++){
+      if(bitRead(midi.getHostDevices(), i)){
+        BMC_PRINTLN("Device", i, "vendor:", midi.getHostDeviceVendorId(i), "product:", midi.getHostDeviceProductId(i));
+      } else {
+        BMC_PRINTLN("Device", i, "not connected");
+      }
+    }
+    printDebugHeader(debugInput);
+#endif
+#ifdef BMC_SYSEX_POOL_ENABLED
+  } else if(BMC_STR_MATCH(debugInput,"sysExPool")){
+    printDebugHeader(debugInput);
+    {
+      bmcSysExPoolStats& stats = midi.getSysExPool().getStats();
+      BMC_PRINTLN("Blocks:", BMC_SYSEX_POOL_BLOCKS, "of", BMC_SYSEX_POOL_BLOCK_SIZE, "bytes");
+      BMC_PRINTLN("In use:", stats.inUse, "most used:", stats.highWater);
+      BMC_PRINTLN("Assembled:", stats.assembled, "largest:", stats.largest, "bytes dropped:", stats.dropped);
+      midi.getSysExPool().resetStats();
+    }
+    printDebugHeader(debugInput);
+#endif
   } else if(BMC_STR_MATCH(debugInput,"version")){
 
     printDebugHeader(debugInput);
@@ -248,6 +401,8 @@ void BMC::readDebug(){
     BMC_PRINTLN("BMC_MAX_CUSTOM_SYSEX", BMC_MAX_CUSTOM_SYSEX);
     BMC_PRINTLN("BMC_MAX_TRIGGERS", BMC_MAX_TRIGGERS);
     BMC_PRINTLN("BMC_MAX_TIMED_EVENTS", BMC_MAX_TIMED_EVENTS);
+    BMC_PRINTLN("BMC_MAX_SEQUENCES", BMC_MAX_SEQUENCES);
+    BMC_PRINTLN("BMC_MAX_MODULATORS", BMC_MAX_MODULATORS);
     BMC_PRINTLN("BMC_MAX_TEMPO_TO_TAP", BMC_MAX_TEMPO_TO_TAP);
     BMC_PRINTLN("BMC_MAX_SKETCH_BYTES", BMC_MAX_SKETCH_BYTES);
     BMC_PRINTLN("BMC_MAX_GLOBAL_BUTTONS", BMC_MAX_GLOBAL_BUTTONS);
@@ -422,9 +577,20 @@ void BMC::readDebug(){
       BMC_PRINTLN("store.global.timedEvents",sizeof(store.global.timedEvents),"bytes");
       BMC_PRINTLN("store.global.timedEvents[0]",sizeof(store.global.timedEvents[0]),"bytes");
     #endif
+    #if BMC_MAX_SEQUENCES > 0
+      BMC_PRINTLN("store.global.sequences",sizeof(store.global.sequences),"bytes");
+      BMC_PRINTLN("store.global.sequences[0]",sizeof(store.global.sequences[0]),"bytes");
+    #endif
+    #if BMC_MAX_MODULATORS > 0
+      BMC_PRINTLN("store.global.modulators",sizeof(store.global.modulators),"bytes");
+      BMC_PRINTLN("store.global.modulators[0]",sizeof(store.global.modulators[0]),"bytes");
+    #endif
     #if BMC_MAX_TEMPO_TO_TAP > 0
       BMC_PRINTLN("store.global.tempoToTap",sizeof(store.global.tempoToTap),"bytes");
       BMC_PRINTLN("store.global.tempoToTap[0]",sizeof(store.global.tempoToTap[0]),"bytes");
+      #if defined(BMC_TEMPO_TO_TAP_PROFILES_ENABLED)
+        BMC_PRINTLN("store.global.tempoToTapProfiles",sizeof(store.global.tempoToTapProfiles),"bytes");
+      #endif
     #endif
     #if BMC_MAX_GLOBAL_BUTTONS > 0
       BMC_PRINTLN("store.global.buttons",sizeof(store.global.buttons),"bytes");
@@ -454,30 +620,30 @@ void BMC::readDebug(){
 
     #if BMC_MAX_PAGES > 0
       BMC_PRINTLN("");
-      BMC_PRINTLN("store.pages",sizeof(store.pages),"bytes");
-      BMC_PRINTLN("store.pages[0]",sizeof(store.pages[0]),"bytes");
+      BMC_PRINTLN("store.pages",(sizeof(bmcStorePage)*BMC_MAX_PAGES),"bytes");
+      BMC_PRINTLN("store.pages[0]",sizeof(pages[0]),"bytes");
 
       #if BMC_MAX_BUTTONS > 0
-        BMC_PRINTLN("store.pages[0].buttons",sizeof(store.pages[0].buttons),"bytes");
-        BMC_PRINTLN("store.pages[0].buttons[0]",sizeof(store.pages[0].buttons[0]),"bytes");
-        BMC_PRINTLN("store.pages[0].buttons[0].events[0]",sizeof(store.pages[0].buttons[0].events[0]),"bytes");
+        BMC_PRINTLN("store.pages[0].buttons",sizeof(pages[0].buttons),"bytes");
+        BMC_PRINTLN("store.pages[0].buttons[0]",sizeof(pages[0].buttons[0]),"bytes");
+        BMC_PRINTLN("store.pages[0].buttons[0].events[0]",sizeof(pages[0].buttons[0].events[0]),"bytes");
       #endif
       #if BMC_MAX_ENCODERS > 0
-        BMC_PRINTLN("store.pages[0].encoders",sizeof(store.pages[0].encoders),"bytes");
-        BMC_PRINTLN("store.pages[0].encoders[0]",sizeof(store.pages[0].encoders[0]),"bytes");
+        BMC_PRINTLN("store.pages[0].encoders",sizeof(pages[0].encoders),"bytes");
+        BMC_PRINTLN("store.pages[0].encoders[0]",sizeof(pages[0].encoders[0]),"bytes");
       #endif
       #if BMC_MAX_POTS > 0
-        BMC_PRINTLN("store.pages[0].pots",sizeof(store.pages[0].pots),"bytes");
-        BMC_PRINTLN("store.pages[0].pots[0]",sizeof(store.pages[0].pots[0]),"bytes");
+        BMC_PRINTLN("store.pages[0].pots",sizeof(pages[0].pots),"bytes");
+        BMC_PRINTLN("store.pages[0].pots[0]",sizeof(pages[0].pots[0]),"bytes");
       #endif
 
       #if BMC_MAX_LEDS > 0
-        BMC_PRINTLN("store.pages[0].leds",sizeof(store.pages[0].leds),"bytes");
-        BMC_PRINTLN("store.pages[0].leds[0]",sizeof(store.pages[0].leds[0]),"bytes");
+        BMC_PRINTLN("store.pages[0].leds",sizeof(pages[0].leds),"bytes");
+        BMC_PRINTLN("store.pages[0].leds[0]",sizeof(pages[0].leds[0]),"bytes");
       #endif
       #if BMC_MAX_PWM_LEDS > 0
-        BMC_PRINTLN("store.pages[0].pwmLeds",sizeof(store.pages[0].pwmLeds),"bytes");
-        BMC_PRINTLN("store.pages[0].pwmLeds[0]",sizeof(store.pages[0].pwmLeds[0]),"bytes");
+        BMC_PRINTLN("store.pages[0].pwmLeds",sizeof(pages[0].pwmLeds),"bytes");
+        BMC_PRINTLN("store.pages[0].pwmLeds[0]",sizeof(pages[0].pwmLeds[0]),"bytes");
       #endif
     #endif
     printDebugHeader(debugInput);
@@ -581,6 +747,16 @@ void BMC::midiInDebug(BMCMidiMessage message){
   if(!globals.getMidiInDebug() || message.getStatus()==BMC_NONE){
     return;
   }
+#if BMC_USB_CABLES > 1
+  if(message.getCable()>0 && !message.isClock() && !message.isActiveSense()){
+    BMC_PRINT("Cable", message.getCable());
+  }
+#endif
+#if defined(BMC_USB_HOST_ENABLED) && BMC_USB_HOST_DEVICES > 1
+  if(message.getSource()==BMC_HOST && !message.isClock() && !message.isActiveSense()){
+    BMC_PRINT("Device", message.getDevice());
+  }
+#endif
   if(message.isClock()){
     if(globals.getMidiInClockDebug()){
       BMC_PRINTLN(
@@ -44,6 +44,14 @@ void BMC::assignStoreData(){
   BMC_PRINTLN("editor.readyToReload()");
   setPage(editor.getPage(), true);
 
+  #if BMC_MAX_SEQUENCES > 0
+    sequencer.buildListeners();
+  #endif
+
+  #if BMC_MAX_MODULATORS > 0
+    modulators.buildListeners();
+  #endif
+
   #if BMC_MAX_GLOBAL_BUTTONS > 0
     globalButtonStates = ~globalButtonStates;
     // BMC.hardware.buttons
@@ -34,6 +34,7 @@
 #define BMC_FLAGS_PAGE_CHANGED 1
 #define BMC_FLAGS_FIRST_LOOP 2
 #define BMC_FLAGS_STATUS_LED 3
+#define BMC_FLAGS_STARTUP_PRESET 4
 
 
 #ifndef BMC_DEBUG_MAX_TIMING
@@ -148,6 +149,12 @@
 #if BMC_MAX_TIMED_EVENTS > 0
   #include "utility/BMC-TimedEvents.h"
 #endif
+#if BMC_MAX_SEQUENCES > 0
+  #include "utility/BMC-Sequencer.h"
+#endif
+#if BMC_MAX_MODULATORS > 0
+  #include "utility/BMC-Modulators.h"
+#endif
 
 //const uint8_t bmcLogCurve[128] = {0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,3,3,3,3,3,3,4,4,4,4,4,5,5,5,5,5,6,6,6,7,7,7,8,8,8,9,9,10,10,11,11,12,12,13,13,14,14,15,16,17,17,18,19,20,21,22,23,24,25,26,27,28,30,31,32,34,35,37,39,40,42,44,46,48,50,53,55,58,60,63,66,69,72,75,78,82,85,89,93,98,102,106,111,116,121,127,133,139,145,151,158,165,172,180,188,197,205,215,224,234,245,255};
 
@@ -219,6 +226,9 @@ private:
   BMCMessenger messenger;
   // editor handling all editing of the store
   BMCEditor editor;
+  // the pages of the store, use pages[n] instead of store.pages[n]
+  // see src/storage/BMC-StorePages.h
+  BMCStorePages& pages;
   // handles master and sleve midi clock
   BMCMidiClock midiClock;
   // handles active sense
@@ -279,6 +289,14 @@ private:
     BMCTimedEvents timedEvents;
 #endif
 
+#if BMC_MAX_SEQUENCES > 0
+    BMCSequencer sequencer;
+#endif
+
+#if BMC_MAX_MODULATORS > 0
+    BMCModulators modulators;
+#endif
+
 
 
   uint8_t page = 0;
@@ -309,9 +327,16 @@ private:
   // keeps track of how long BMC has been running, used by BMC for some tasks
   BMCRunTime runTime;
   BMCStopwatch stopwatch;
+  // time when each stage of the startup was reached
+  BMCBootStages bootStages;
 
   // code @ BMC.cpp
   void stopwatchCmd(uint8_t cmd, uint8_t h=0, uint8_t m=0, uint8_t s=0);
+  void sendStartupPreset();
+#if defined(BMC_STORAGE_JOURNAL_ENABLED) && BMC_MAX_LIBRARY > 0 && BMC_MAX_PRESETS > 0
+  void saveJournalPreset();
+  bool restoreJournalPreset();
+#endif
 
   // code @ BMC.page.cpp
   bool pageChanged();
@@ -353,6 +378,10 @@ private:
   void processTimedEvent(uint8_t n);
 #endif
 
+#if BMC_MAX_SEQUENCES > 0
+  void readSequencer(uint8_t ticks);
+#endif
+
 // ** HARDWARE **
 // code @ BMC.hardware.cpp
   void setupHardware();
@@ -643,7 +672,7 @@ private:
   void printButtonTrigger(uint8_t n, uint8_t t_trigger, bool t_global=false);
   void printDebugHeader(char* str);
   void midiInDebug(BMCMidiMessage midiMessage);
-  void printMidiInDebug(String str, BMCMidiMessage midiMessage);
+  void printMidiInDebug(const char* str, BMCMidiMessage midiMessage);
   void debugStartTiming(uint8_t n, bool t_micros=false);
   unsigned long debugStopTiming(uint8_t n, bool t_micros=false);
   unsigned long getTiming(uint8_t n, bool t_micros=false);
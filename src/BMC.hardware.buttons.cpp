@@ -56,7 +56,7 @@ void BMC::assignButton(BMCButton& button, bmcStoreButton& data){
 // we don't bother parsing the event data, UNLESS all buttons are active thru settings
 void BMC::assignButtons(){
   for(uint8_t i = 0; i < BMC_MAX_BUTTONS; i++){
-    assignButton(buttons[i], store.pages[page].buttons[i]);
+    assignButton(buttons[i], pages[page].buttons[i]);
   }
 }
 // read the buttons
@@ -137,7 +137,7 @@ void BMC::readButtons(){
 
 void BMC::handleButton(uint8_t index, uint8_t t_trigger){
   for(uint8_t e = 0; e < BMC_MAX_BUTTON_EVENTS; e++){
-    bmcStoreButtonEvent &data = store.pages[page].buttons[index].events[e];
+    bmcStoreButtonEvent &data = pages[page].buttons[index].events[e];
     uint8_t type = BMC_GET_BYTE(0, data.event);
     uint8_t trigger = ((data.mode&0x0F)==t_trigger) ? t_trigger : BMC_NONE;
 
@@ -177,7 +177,7 @@ void BMC::handleButton(uint8_t index, uint8_t t_trigger){
                             BMC_GET_BYTE(3,data.event),
                             data.ports);
     } else if(callback.buttonActivity){
-      callback.buttonActivity(index, e, trigger, store.pages[page].buttons[index], data);
+      callback.buttonActivity(index, e, trigger, pages[page].buttons[index], data);
     }
   }
   #if defined(BMC_BUTTON_DELAY_ENABLED)
@@ -316,6 +316,22 @@ void BMC::handleGlobalButton(uint8_t index, uint8_t t_trigger){
       case BMC_BUTTON_EVENT_TYPE_MASTER_CLOCK_SET:
         midiClock.setBpm((event >> 8) & 0x1FF);
         break;
+      case BMC_BUTTON_EVENT_TYPE_MASTER_CLOCK_TRANSPORT:
+        // byteA is one of BMC_MIDI_CLOCK_TRANSPORT_*
+        midiClock.transport(byteA);
+        break;
+#if BMC_MAX_SEQUENCES > 0
+      case BMC_BUTTON_EVENT_TYPE_SEQUENCE:
+        // byteA = sequence, byteB = BMC_SEQUENCE_CMD_*
+        sequencer.command(byteA, byteB, midiClock.getSongTicks());
+        break;
+#endif
+#if BMC_MAX_MODULATORS > 0
+      case BMC_BUTTON_EVENT_TYPE_MODULATOR:
+        // byteA = modulator, byteB = BMC_MODULATOR_CMD_*
+        modulators.command(byteA, byteB);
+        break;
+#endif
 
       case BMC_EVENT_TYPE_CUSTOM:
         // this is a standard custom event for all hardware the value is 127
@@ -728,6 +744,36 @@ void BMC::handleGlobalButton(uint8_t index, uint8_t t_trigger){
         break;
   #endif
 
+  #ifdef BMC_USE_KEMPER
+      case BMC_BUTTON_EVENT_TYPE_KEMPER_COMMAND:
+        if(byteA==0){
+          kemper.disconnect();
+        } else if(byteA==1){
+          kemper.connect();
+        } else if(byteA==2){
+          if(kemper.connected()){
+            kemper.disconnect();
+          } else {
+            kemper.connect();
+          }
+        } else if(byteA==3){
+          kemper.sync();
+        }
+        break;
+      case BMC_BUTTON_EVENT_TYPE_KEMPER_RIG:
+        // byteA = rig slot 0 to 4
+        kemper.setSlot(byteA);
+        break;
+      case BMC_BUTTON_EVENT_TYPE_KEMPER_STOMP:
+        // byteA = module, byteB = off (0), on (1), toggle (2)
+        if(byteB>=2){
+          kemper.toggleModule(byteA);
+        } else {
+          kemper.setModule(byteA, byteB==1);
+        }
+        break;
+  #endif
+
       case BMC_BUTTON_EVENT_TYPE_MIDI_REAL_TIME_BLOCK:
         // ignored any incoming/Outgoing MIDI real time messages
         // byteA: 0=input, 1=output
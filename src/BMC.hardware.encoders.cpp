@@ -31,12 +31,12 @@ void BMC::assignEncoder(BMCEncoder& encoder, bmcStoreEncoder& data){
 #if BMC_MAX_ENCODERS > 0
 void BMC::assignEncoders(){
   for(uint8_t i = 0; i < BMC_MAX_ENCODERS; i++){
-    assignEncoder(encoders[i], store.pages[page].encoders[i]);
+    assignEncoder(encoders[i], pages[page].encoders[i]);
   }
 }
 // READ
 void BMC::readEncoders(){
-  bmcStorePage& pageData = store.pages[page];
+  bmcStorePage& pageData = pages[page];
   for(uint8_t i = 0; i < BMC_MAX_ENCODERS; i++){
     // GET THE PIN STATE FROM MUX
     #if BMC_MAX_MUX_IN > 0 || BMC_MAX_MUX_GPIO > 0
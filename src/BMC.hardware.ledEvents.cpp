@@ -130,6 +130,16 @@ uint8_t BMC::handleLedEvent(uint8_t index, uint32_t event, uint8_t ledType){
 #if defined(BMC_USE_HELIX)
     case BMC_LED_EVENT_TYPE_HELIX_SNAPSHOT:
       return helix.isSnapshot(byteA);
+    case BMC_LED_EVENT_TYPE_HELIX_PRESET:
+      return helix.isPreset(byteA);
+    case BMC_LED_EVENT_TYPE_HELIX_FOOTSWITCH:
+      return helix.isFootswitchOn(byteA);
+    case BMC_LED_EVENT_TYPE_HELIX_LOOPER:
+      // byteA is one of BMC_HELIX_LOOPER_*, 6 is recording or overdubbing
+      if(byteA==6){
+        return helix.looperRecordingOrDubbing();
+      }
+      return helix.isLooper(byteA);
 #endif
 
 
@@ -179,6 +189,20 @@ uint8_t BMC::handleLedEvent(uint8_t index, uint32_t event, uint8_t ledType){
 #endif
 
 
+#if defined(BMC_USE_KEMPER)
+    case BMC_LED_EVENT_TYPE_KEMPER_STATE:
+      switch(byteA){
+        case 0: return kemper.connected();
+        case 1: return kemper.syncing();
+      }
+      break;
+    case BMC_LED_EVENT_TYPE_KEMPER_RIG:
+      return kemper.connected() && kemper.getSlot()==byteA;
+    case BMC_LED_EVENT_TYPE_KEMPER_STOMP:
+      return kemper.connected() && kemper.isModuleOn(byteA);
+#endif
+
+
 #if BMC_MAX_PRESETS > 0
     case BMC_LED_EVENT_TYPE_PRESET:
       return BMC_EVENT_TO_PRESET_NUM(event>>8) == presets.get();
@@ -375,7 +399,7 @@ void BMC::handleClockLeds(){
 
 #if BMC_MAX_LEDS > 0
   for(uint8_t index = 0; index < BMC_MAX_LEDS; index++){
-    bmcStoreLed& item = store.pages[page].leds[index];
+    bmcStoreLed& item = pages[page].leds[index];
     if(BMCTools::isMidiClockLedEvent(item.event)){
       leds[index].pulse();
     }
@@ -393,7 +417,7 @@ void BMC::handleClockLeds(){
 
 #if BMC_MAX_PWM_LEDS > 0
   for(uint8_t index = 0; index < BMC_MAX_PWM_LEDS; index++){
-    bmcStoreLed& item = store.pages[page].pwmLeds[index];
+    bmcStoreLed& item = pages[page].pwmLeds[index];
     if(BMCTools::isMidiClockLedEvent(item.event)){
       pwmLeds[index].pulse(((BMC_GET_BYTE(3, item.event)) & 0x7F));
     }
@@ -402,7 +426,7 @@ void BMC::handleClockLeds(){
 
 #if BMC_MAX_PIXELS > 0
   for(uint8_t index = 0; index < BMC_MAX_PIXELS; index++){
-    bmcStoreLed& item = store.pages[page].pixels[index];
+    bmcStoreLed& item = pages[page].pixels[index];
     // first bit is always the "blink" state
     if(BMCTools::isMidiClockLedEvent(item.event)){
       // last 4 bits are always the color
@@ -413,7 +437,7 @@ void BMC::handleClockLeds(){
 
 #if BMC_MAX_RGB_PIXELS > 0
   for(uint8_t index = 0; index < BMC_MAX_RGB_PIXELS; index++){
-    bmcStoreRgbLed& item = store.pages[page].rgbPixels[index];
+    bmcStoreRgbLed& item = pages[page].rgbPixels[index];
     if(BMCTools::isMidiClockLedEvent(item.red)){
       pixels.pulseRgb(index, 0);
     }
@@ -54,7 +54,7 @@ void BMC::setupLeds(){
 
 #if BMC_MAX_LEDS > 0
 void BMC::assignLeds(){
-  bmcStorePage& pageData = store.pages[page];
+  bmcStorePage& pageData = pages[page];
   for(uint8_t index = 0; index < BMC_MAX_LEDS; index++){
     leds[index].reassign(bitRead(pageData.leds[index].event, 31));
     // turn off blinking for certain events like MIDI IO
@@ -73,7 +73,7 @@ void BMC::readLeds(){
   uint32_t _ledStates = ledStates;
   for(uint8_t i = 0; i < BMC_MAX_LEDS; i++){
     // handleLedEvent() @ BMC.hardware.ledEvents.cpp
-    uint8_t state = handleLedEvent(i, store.pages[page].leds[i].event, 0);
+    uint8_t state = handleLedEvent(i, pages[page].leds[i].event, 0);
     if(state<=1){
       leds[i].setState(state);
     } else if(state==2){
@@ -13,13 +13,13 @@ void BMC::setupPixels(){
 }
 void BMC::assignPixels(){
   for(uint8_t i=0;i<BMC_MAX_PIXELS;i++){
-    bmcStoreLed& item = store.pages[page].pixels[i];
+    bmcStoreLed& item = pages[page].pixels[i];
     pixels.setDimColor(i,(BMC_GET_BYTE(3, item.event) >> 4));
   }
 
 #if BMC_MAX_RGB_PIXELS > 0
   for(uint8_t i=0;i<BMC_MAX_RGB_PIXELS;i++){
-    bmcStoreRgbLed& item = store.pages[page].rgbPixels[i];
+    bmcStoreRgbLed& item = pages[page].rgbPixels[i];
     uint8_t color = 0;
     bitWrite(color, 0, (BMC_GET_BYTE(0, item.red)>0));
     bitWrite(color, 1, (BMC_GET_BYTE(0, item.green)>0));
@@ -31,7 +31,7 @@ void BMC::assignPixels(){
   pixels.setPwmOffValue(settings.getPwmDimWhenOff());
 }
 void BMC::readPixels(){
-  bmcStorePage& pageData = store.pages[page];
+  bmcStorePage& pageData = pages[page];
   for(uint8_t i = 0; i < BMC_MAX_PIXELS; i++){
     // handleLedEvent() @ BMC.hardware.ledEvents.cpp
     uint8_t state = handleLedEvent(i, pageData.pixels[i].event, 3);
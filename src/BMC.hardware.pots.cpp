@@ -50,7 +50,7 @@ void BMC::assignPot(BMCPot& pot, bmcStorePot& storeData, bmcStoreGlobalPotCalibr
 #if BMC_MAX_POTS > 0
 void BMC::assignPots(){
   for(uint8_t i = 0; i < BMC_MAX_POTS; i++){
-    assignPot(pots[i], store.pages[page].pots[i], globalData.potCalibration[i]);
+    assignPot(pots[i], pages[page].pots[i], globalData.potCalibration[i]);
   }
 }
 // READ
@@ -72,7 +72,7 @@ void BMC::readPots(){
 
 #if defined(BMC_USE_POT_TOE_SWITCH)
     if(pots[i].toeSwitchActive()){
-      potParseToeSwitch(pots[i].toeSwitchGetEvent(), pots[i].toeSwitchGetState(), store.pages[page].pots[i].ports);
+      potParseToeSwitch(pots[i].toeSwitchGetEvent(), pots[i].toeSwitchGetState(), pages[page].pots[i].ports);
       if(callback.potsToeSwitchState && BMC_GET_BYTE(0, pots[i].toeSwitchGetEvent())>0){
         callback.potsToeSwitchState(i, pots[i].toeSwitchGetState());
       }
@@ -86,9 +86,9 @@ void BMC::readPots(){
         BMC_PRINTLN("Page Pot #",i," > value:",value,"raw:",getPotAnalogValue(i));
       }
 #endif
-      handlePot(store.pages[page].pots[i], value);
+      handlePot(pages[page].pots[i], value);
       // HANDLE CALLBACKS
-      uint32_t event = store.pages[page].pots[i].event;
+      uint32_t event = pages[page].pots[i].event;
       if(BMC_GET_BYTE(0, event)==BMC_EVENT_TYPE_CUSTOM && callback.potCustomActivity){
         callback.potCustomActivity(i,
                           BMC_GET_BYTE(1, event),
@@ -96,7 +96,7 @@ void BMC::readPots(){
                           BMC_GET_BYTE(3, event),
                           value);
       } else if(callback.potActivity){
-        callback.potActivity(i, value, store.pages[page].pots[i]);
+        callback.potActivity(i, value, pages[page].pots[i]);
       }
       if(globals.editorConnected()){
         editor.utilitySendPotActivity(i, pots[i].getPosition());
@@ -294,6 +294,12 @@ void BMC::handlePot(bmcStorePot& data, uint8_t value){
       }
       break;
 
+#ifdef BMC_USE_DAW_LC
+    case BMC_POT_EVENT_TYPE_DAW_FADER:
+      daw.sendPotFader(byteA, value);
+      break;
+#endif
+
 #ifdef BMC_USE_BEATBUDDY
     case BMC_POT_EVENT_TYPE_BEATBUDDY_CMD:
       if(byteA == BMC_BEATBUDDY_CMD_MIX_VOL){
@@ -22,7 +22,7 @@ void BMC::assignPwmLeds(){
 // Read
 void BMC::readPwmLeds(){
   uint16_t _pwmLedStates = 0;
-  bmcStorePage& pageData = store.pages[page];
+  bmcStorePage& pageData = pages[page];
   for(uint8_t i = 0; i < BMC_MAX_PWM_LEDS; i++){
     // handleLedEvent() @ BMC.hardware.ledEvents.cpp
     uint8_t state = handleLedEvent(i, pageData.pwmLeds[i].event, 2);
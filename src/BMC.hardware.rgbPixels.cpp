@@ -18,7 +18,7 @@ void BMC::assignRgbPixels(){
 #if BMC_MAX_PIXELS == 0
   // assign their off value based on what color led has an event
   for(uint8_t i=0;i<BMC_MAX_RGB_PIXELS;i++){
-    bmcStoreRgbLed& item = store.pages[page].rgbPixels[i];
+    bmcStoreRgbLed& item = pages[page].rgbPixels[i];
     uint8_t color = 0;
     bitWrite(color, 0, (BMC_GET_BYTE(0, item.red)>0));
     bitWrite(color, 1, (BMC_GET_BYTE(0, item.green)>0));
@@ -30,7 +30,7 @@ void BMC::assignRgbPixels(){
 #endif
 }
 void BMC::readRgbPixels(){
-  bmcStorePage& pageData = store.pages[page];
+  bmcStorePage& pageData = pages[page];
   for(uint8_t i = 0; i < BMC_MAX_RGB_PIXELS; i++){
     uint32_t events[3] = {
       pageData.rgbPixels[i].red,
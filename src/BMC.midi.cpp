@@ -38,6 +38,13 @@ void BMC::readMidi(){
     incomingMidi(midi.readSerial(3));// Read the Serial D MIDI Port
   #endif
 
+  #ifdef BMC_SYSEX_POOL_ENABLED
+    // SysEx assembled by the pool on any port
+    while(midi.hasSysExPoolMessage()){
+      incomingMidi(midi.readSysExPool());
+    }
+  #endif
+
 #ifdef BMC_USE_BEATBUDDY
   beatBuddy.update();
 #endif
@@ -79,6 +86,10 @@ void BMC::incomingMidi(BMCMidiMessage message){
   beatBuddy.incoming(message);
 #endif
 
+#ifdef BMC_USE_HELIX
+  helix.incoming(message);
+#endif
+
 #ifdef BMC_USE_FAS
   fas.incoming(message);
 #endif
@@ -154,10 +165,23 @@ void BMC::handleMidiClock(bool isClock, bool isStartOrContinue){
       }
       streamMidiClockBPM(midiClock.getBpm());
     }
+    #if BMC_MAX_TEMPO_TO_TAP > 0
+      // taps are sent on the beat so they are in phase with the clock
+      tempoToTap.beat();
+    #endif
   }
 #if BMC_MAX_PIXELS > 0
     pixels.clockBeat(midiClock.getBpm());
 #endif
+#if BMC_MAX_SEQUENCES > 0 || BMC_MAX_MODULATORS > 0
+  uint8_t ticks = midiClock.takeTicks();
+#endif
+#if BMC_MAX_SEQUENCES > 0
+  readSequencer(ticks);
+#endif
+#if BMC_MAX_MODULATORS > 0
+  modulators.tick(ticks, midiClock.getBpm());
+#endif
 }
 void BMC::midiProgramBankScroll(bool up, bool endless, uint8_t amount, uint8_t min, uint8_t max){
   amount = constrain(amount, 1, 64);
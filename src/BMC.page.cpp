@@ -10,10 +10,17 @@ void BMC::setPage(uint8_t page, bool reassignSettings){
   if(page >= BMC_MAX_PAGES){
     return;
   }
+  #if defined(BMC_FAST_BOOT_ENABLED)
+    // the page may not have been loaded in the background yet
+    editor.loadPage(page);
+  #endif
+  // with the SD Card paged store this will load the page if needed
+  // and prefetch the pages next to it
+  pages.setCurrent(page);
   if(this->page!=page){
     flags.write(BMC_FLAGS_PAGE_CHANGED, true);
     #if BMC_NAME_LEN_PAGES > 1
-      streamToSketch(BMC_ITEM_ID_PAGE, page, store.pages[page].name);
+      streamToSketch(BMC_ITEM_ID_PAGE, page, pages[page].name);
     #endif
   }
   this->page = page;
@@ -13,38 +13,37 @@
 
 // Value stream handlers
 // used to send data to the sketch for use with displays
+// names are formatted with BMCFormat into the item itself so nothing is allocated
 void BMC::streamToSketch(uint8_t t_id, int t_value){
   if(callback.valueStream){
-    char str[2] = " ";
-    streamToSketch(t_id, t_value, str);
-  }
-}
-void BMC::streamToSketch(uint8_t t_id, int t_value, const char* str){
-  if(callback.valueStream){
-    String buff = str;
-    uint8_t length = buff.length()+1;
-    length = constrain(length,0,30);
-    char output[length];
-    buff.toCharArray(output, length);
-    streamToSketch(t_id, t_value, str);
+    streamToSketch(t_id, t_value, " ");
   }
 }
 void BMC::streamToSketch(uint8_t t_id, int t_value, char* str){
+  streamToSketch(t_id, t_value, (const char*) str);
+}
+void BMC::streamToSketch(uint8_t t_id, int t_value, const char* str){
   if(callback.valueStream){
     BMCValueStream item;
     item.id = t_id;
     item.value = t_value;
-
-    if(t_id==BMC_ITEM_ID_PAGE && strlen(BMC_STREAM_TEMPL_PAGE)+strlen(str)<30){
-      sprintf(item.name, BMC_STREAM_TEMPL_PAGE, (uint8_t) (t_value+1), str);
-    } else if(t_id==BMC_ITEM_ID_PRESET && strlen(BMC_STREAM_TEMPL_PRESET)+strlen(str)<30){
-      sprintf(item.name, BMC_STREAM_TEMPL_PRESET,(uint8_t) (t_value+1), str);
-    } else if(t_id==BMC_ITEM_ID_SETLIST && strlen(BMC_STREAM_TEMPL_SETLIST)+strlen(str)<30){
-      sprintf(item.name, BMC_STREAM_TEMPL_SETLIST,(uint8_t) (t_value+1), str);
-    } else if(t_id==BMC_ITEM_ID_SETLIST_SONG && strlen(BMC_STREAM_TEMPL_SETLIST_SONG)+strlen(str)<30){
-      sprintf(item.name, BMC_STREAM_TEMPL_SETLIST_SONG,(uint8_t) (t_value+1), str);
-    } else if(strlen(str)<30){
-      strcpy(item.name, str);
+    BMCFormat name(item.name, sizeof(item.name));
+    switch(t_id){
+      case BMC_ITEM_ID_PAGE:
+        name.addTemplate(BMC_STREAM_TEMPL_PAGE, str, t_value+1);
+        break;
+      case BMC_ITEM_ID_PRESET:
+        name.addTemplate(BMC_STREAM_TEMPL_PRESET, str, t_value+1);
+        break;
+      case BMC_ITEM_ID_SETLIST:
+        name.addTemplate(BMC_STREAM_TEMPL_SETLIST, str, t_value+1);
+        break;
+      case BMC_ITEM_ID_SETLIST_SONG:
+        name.addTemplate(BMC_STREAM_TEMPL_SETLIST_SONG, str, t_value+1);
+        break;
+      default:
+        name.addString(str);
+        break;
     }
     callback.valueStream(item);
   }
@@ -59,18 +58,19 @@ void BMC::streamMidi(uint8_t status, uint8_t channel, uint8_t data1, uint8_t dat
     } else {
       item.data = (data2<<16) | (data1<<8) | (status | channel);
     }
+    BMCFormat name(item.name, sizeof(item.name));
     switch(status){
       case BMC_MIDI_CONTROL_CHANGE:
-        sprintf(item.name, BMC_STREAM_TEMPL_MIDI_CC, channel, data1, data2);
+        name.addTemplate(BMC_STREAM_TEMPL_MIDI_CC, "", channel, data1, data2);
         break;
       case BMC_MIDI_NOTE_ON:
-        sprintf(item.name, BMC_STREAM_TEMPL_MIDI_NOTE_ON, channel, data1, data2);
+        name.addTemplate(BMC_STREAM_TEMPL_MIDI_NOTE_ON, "", channel, data1, data2);
         break;
       case BMC_MIDI_NOTE_OFF:
-        sprintf(item.name, BMC_STREAM_TEMPL_MIDI_NOTE_ON, channel, data1, data2);
+        name.addTemplate(BMC_STREAM_TEMPL_MIDI_NOTE_OFF, "", channel, data1, data2);
         break;
       case BMC_MIDI_PROGRAM_CHANGE:
-        sprintf(item.name, BMC_STREAM_TEMPL_MIDI_PC, channel, data1);
+        name.addTemplate(BMC_STREAM_TEMPL_MIDI_PC, "", channel, data1);
         break;
     }
     callback.valueStream(item);
@@ -82,7 +82,7 @@ void BMC::streamRawValue(uint16_t t_value){
     item.id = 0;
     item.value = t_value;
     item.data = t_value;
-    sprintf(item.name, "%03u", t_value);
+    BMCFormat(item.name, sizeof(item.name)).addNumber(t_value, 3);
     callback.valueStream(item);
   }
 }
@@ -92,7 +92,7 @@ void BMC::streamMidiProgram(uint8_t channel, uint8_t program){
     item.id = BMC_ITEM_ID_MIDI_PROGRAM;
     item.value = program;
     item.data = (program<<8) | BMC_ITEM_ID_MIDI_PROGRAM |channel;
-    sprintf(item.name,BMC_STREAM_TEMPL_MIDI_PC,channel, program);
+    BMCFormat(item.name, sizeof(item.name)).addTemplate(BMC_STREAM_TEMPL_MIDI_PC, "", channel, program);
     callback.valueStream(item);
   }
 }
@@ -102,7 +102,7 @@ void BMC::streamMidiControl(uint8_t channel, uint8_t control, uint8_t value){
     item.id = BMC_ITEM_ID_MIDI_CONTROL;
     item.value = value;
     item.data = (value<<16) | (control<<8) | BMC_ITEM_ID_MIDI_CONTROL | channel;
-    sprintf(item.name,BMC_STREAM_TEMPL_MIDI_CC,channel, control,value);
+    BMCFormat(item.name, sizeof(item.name)).addTemplate(BMC_STREAM_TEMPL_MIDI_CC, "", channel, control, value);
     callback.valueStream(item);
   }
 }
@@ -112,7 +112,7 @@ void BMC::streamMidiClockBPM(uint16_t bpm){
     item.id = BMC_ITEM_ID_MIDI_CLOCK;
     item.value = bpm;
     item.data = bpm;
-    sprintf(item.name, BMC_STREAM_TEMPL_MIDI_CLOCK_BPM, bpm);
+    BMCFormat(item.name, sizeof(item.name)).addTemplate(BMC_STREAM_TEMPL_MIDI_CLOCK_BPM, "", bpm);
     callback.valueStream(item);
   }
 }
@@ -58,7 +58,7 @@
         {
           uint8_t btnN = BMC_GET_BYTE(1, event);
           uint8_t btnEventN = BMC_GET_BYTE(2, event);
-          bmcStoreButtonEvent &data = store.pages[page].buttons[btnN].events[btnEventN];
+          bmcStoreButtonEvent &data = pages[page].buttons[btnN].events[btnEventN];
           uint8_t type = BMC_GET_BYTE(0,data.event);
           if(type!=BMC_NONE){
             handleButtonEvent(type, data);
@@ -84,9 +84,9 @@
         {
           uint8_t enc   = BMC_GET_BYTE(1, event);
           uint8_t inc   = BMC_GET_BYTE(2, event);
-          uint8_t type  = BMC_GET_BYTE(0, store.pages[page].encoders[enc].event);
+          uint8_t type  = BMC_GET_BYTE(0, pages[page].encoders[enc].event);
           if(type!=BMC_NONE){
-            handleEncoder(store.pages[page].encoders[enc], inc);
+            handleEncoder(pages[page].encoders[enc], inc);
           }
         }
 #endif
@@ -111,6 +111,18 @@
       case BMC_TIMED_EVENT_TYPE_MASTER_CLOCK:
         midiClock.setBpm((event >> 8) & 0x1FF);
         break;
+      case BMC_TIMED_EVENT_TYPE_SEQUENCE:
+#if BMC_MAX_SEQUENCES > 0
+        // byteA = sequence, byteB = BMC_SEQUENCE_CMD_*
+        sequencer.command(BMC_GET_BYTE(1, event), BMC_GET_BYTE(2, event), midiClock.getSongTicks());
+#endif
+        break;
+      case BMC_TIMED_EVENT_TYPE_MODULATOR:
+#if BMC_MAX_MODULATORS > 0
+        // byteA = modulator, byteB = BMC_MODULATOR_CMD_*
+        modulators.command(BMC_GET_BYTE(1, event), BMC_GET_BYTE(2, event));
+#endif
+        break;
       case BMC_TIMED_EVENT_TYPE_CUSTOM:
         callback.timedEventCustom(n,
                               BMC_GET_BYTE(1,event),
@@ -120,3 +132,24 @@
     }
   }
 #endif
+
+#if BMC_MAX_SEQUENCES > 0
+  // called on every loop with the clock ticks sent or received since the
+  // last loop, steps are sent in the order they are due
+  void BMC::readSequencer(uint8_t ticks){
+    uint8_t n = 0;
+    bmcLibrary_t event = 0;
+    for( ; ; ticks--){
+      while(sequencer.getDueStep(n, event)){
+        library.send(event);
+        if(callback.sequenceStep){
+          callback.sequenceStep(n, event);
+        }
+      }
+      if(ticks == 0){
+        break;
+      }
+      sequencer.tick();
+    }
+  }
+#endif
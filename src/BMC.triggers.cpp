@@ -11,8 +11,10 @@
     if(!triggers.isAllowed()){
       return;
     }
-    for(uint8_t index = 0, n=triggers.available(); index < n; index++){
-      if(triggers.isValidTrigger(index)){
+    // only triggers with the same status, channel and data1 are checked
+    for(uint8_t i = 0, n=triggers.findCandidates(); i < n; i++){
+      uint8_t index = triggers.getCandidate(i);
+      if(triggers.isValidCandidate(index)){
         processTrigger(index);
       }
     }
@@ -119,6 +121,24 @@
         break;
 #endif
 
+#if BMC_MAX_SEQUENCES > 0
+      case BMC_TRIGGER_EVENT_TYPE_SEQUENCE:
+        // event (bits 08 to 15) = Sequence Index
+        // event (bits 16 to 23) = BMC_SEQUENCE_CMD_*
+        sequencer.command(byteA, byteB, midiClock.getSongTicks());
+        BMC_PRINTLN("processTrigger BMC_TRIGGER_EVENT_TYPE_SEQUENCE");
+        break;
+#endif
+
+#if BMC_MAX_MODULATORS > 0
+      case BMC_TRIGGER_EVENT_TYPE_MODULATOR:
+        // event (bits 08 to 15) = Modulator Index
+        // event (bits 16 to 23) = BMC_MODULATOR_CMD_*
+        modulators.command(byteA, byteB);
+        BMC_PRINTLN("processTrigger BMC_TRIGGER_EVENT_TYPE_MODULATOR");
+        break;
+#endif
+
 #if BMC_MAX_ENCODERS > 0
       case BMC_TRIGGER_EVENT_TYPE_ENCODER:
         if(byteA < BMC_MAX_ENCODERS){
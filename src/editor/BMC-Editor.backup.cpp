@@ -462,13 +462,13 @@ void BMCEditor::backupPageName(uint16_t t_minLength){
     // for it to be used
     if(incoming.size() == (nameLength + t_minLength)){
       // set all the name characters all to 0
-      memset(store.pages[index].name, 0, BMC_NAME_LEN_PAGES);
+      memset(pages[index].name, 0, BMC_NAME_LEN_PAGES);
       // if the length we received is higher than the compiled length,
       // set it to the compiled length
       if(nameLength > BMC_NAME_LEN_PAGES){
         nameLength = BMC_NAME_LEN_PAGES;
       }
-      incoming.getStringFromSysEx(10, store.pages[index].name, nameLength);
+      incoming.getStringFromSysEx(10, pages[index].name, nameLength);
     }
   }
 #endif
@@ -488,7 +488,7 @@ void BMCEditor::backupPageButton(uint16_t t_minLength){
       uint8_t eventIndex = incoming.get7Bits(10);
       //uint8_t buttonIndex = incoming.sysex[9];
       //uint8_t eventIndex = incoming.sysex[10];
-      bmcStoreButton& button = store.pages[page].buttons[buttonIndex];
+      bmcStoreButton& button = pages[page].buttons[buttonIndex];
       bmcStoreButtonEvent& event = button.events[eventIndex];
       event.mode = incoming.get8Bits(11);//+2
       event.ports = incoming.get8Bits(13);//+2
@@ -515,7 +515,7 @@ void BMCEditor::backupPageLed(uint16_t t_minLength){
     if(incoming.size()==(nameLength+t_minLength+1)){
       uint8_t page = getMessagePageNumber() & 0xFF;
       uint8_t index = incoming.sysex[9];
-      bmcStoreLed &item = store.pages[page].leds[index];
+      bmcStoreLed &item = pages[page].leds[index];
       //item.event = BMC_MIDI_ARRAY_TO_32BITS(10,incoming.sysex);
       item.event = incoming.get32Bits(10);
       #if BMC_NAME_LEN_LEDS > 1
@@ -540,7 +540,7 @@ void BMCEditor::backupPagePwmLed(uint16_t t_minLength){
     if(incoming.size()==(nameLength+t_minLength+1)){
       uint8_t page = getMessagePageNumber() & 0xFF;
       uint8_t index = incoming.sysex[9];
-      bmcStoreLed &item = store.pages[page].pwmLeds[index];
+      bmcStoreLed &item = pages[page].pwmLeds[index];
       //item.event = BMC_MIDI_ARRAY_TO_32BITS(10, incoming.sysex);
       item.event = incoming.get32Bits(10);
       #if BMC_NAME_LEN_LEDS > 1
@@ -564,7 +564,7 @@ void BMCEditor::backupPagePixel(uint16_t t_minLength){
       if(incoming.size()==(nameLength+t_minLength+1)){
         uint8_t page = getMessagePageNumber() & 0xFF;
         uint8_t index = incoming.sysex[9];
-        bmcStoreLed &item = store.pages[page].pixels[index];
+        bmcStoreLed &item = pages[page].pixels[index];
         //item.event = BMC_MIDI_ARRAY_TO_32BITS(10,incoming.sysex);
         item.event = incoming.get32Bits(10);
         #if BMC_NAME_LEN_LEDS > 1
@@ -588,7 +588,7 @@ void BMCEditor::backupPageRgbPixel(uint16_t t_minLength){
       if(incoming.size()==(nameLength+t_minLength+1)){
         uint8_t page = getMessagePageNumber() & 0xFF;
         uint8_t index = incoming.sysex[9];
-        bmcStoreRgbLed &item = store.pages[page].rgbPixels[index];
+        bmcStoreRgbLed &item = pages[page].rgbPixels[index];
         //item.event = BMC_MIDI_ARRAY_TO_32BITS(10,incoming.sysex);
         item.red = incoming.get32Bits(10);
         item.green = incoming.get32Bits(15);
@@ -614,7 +614,7 @@ void BMCEditor::backupPageEncoder(uint16_t t_minLength){
     if(incoming.size()==(nameLength+t_minLength+1)){
       uint8_t page = getMessagePageNumber() & 0xFF;
       uint8_t index = incoming.sysex[9];
-      bmcStoreEncoder& item = store.pages[page].encoders[index];
+      bmcStoreEncoder& item = pages[page].encoders[index];
       item.mode = incoming.get8Bits(10);//+2
       item.ports = incoming.get8Bits(12);//+2
       item.event = incoming.get32Bits(14);//+2
@@ -645,7 +645,7 @@ void BMCEditor::backupPagePot(uint16_t t_minLength){
     if(incoming.size()==(nameLength+t_minLength+toeSwitch+1)){
       uint8_t page = getMessagePageNumber() & 0xFF;
       uint8_t index = incoming.sysex[9];
-      bmcStorePot& item = store.pages[page].pots[index];
+      bmcStorePot& item = pages[page].pots[index];
       //item.ports = BMC_MIDI_ARRAY_TO_8BITS(10,incoming.sysex);
       //item.event = BMC_MIDI_ARRAY_TO_32BITS(12,incoming.sysex);
       item.ports = incoming.get8Bits(10);
@@ -15,6 +15,10 @@ BMCEditor::BMCEditor(bmcStore& t_store,
   midi(t_midi),
   settings(t_settings),
   storage(midi.globals),
+  pages(t_store, storage),
+#if defined(BMC_STORAGE_JOURNAL_ENABLED)
+  journal(t_store, storage),
+#endif
   incoming(midi.message),
   messenger(t_messenger)
 {
@@ -29,6 +33,9 @@ void BMCEditor::begin(){
   BMC_PRINTLN("BMCEditor::begin");
 
   storage.begin();
+  #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+    journal.begin(storage.length());
+  #endif
   #if defined(BMC_USE_TIME)
     setSyncProvider(getTeensy3Time);
     adjustTime(BMC_TIME_ADJUST);
@@ -45,11 +52,11 @@ void BMCEditor::begin(){
     #endif
   #endif
   // Make sure the bmcStore size is not larger than the EEPROM size
-  if(sizeof(bmcStore) > storage.length()){
+  if(sizeof(bmcStore) > getStoresLength()){
     BMC_ERROR(
       "The size of bmcStore has exceeded the size of EEPROM",
       "Reupload your sketch with a different config",
-      storage.length()
+      getStoresLength()
     );
     BMC_HALT();
   }
@@ -99,7 +106,18 @@ void BMCEditor::begin(){
   flags.off(BMC_EDITOR_FLAG_EDITOR_INITIAL_SETUP);
 }
 void BMCEditor::update(){
-
+  // prefetch pages when using the SD Card paged store
+  pages.update();
+  #if defined(BMC_FAST_BOOT_ENABLED)
+    // load the rest of the store one block per loop
+    if(storeLoading()){
+      loadStoreBlock();
+    }
+  #endif
+  #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+    // write one pending journal record per loop
+    journal.update();
+  #endif
 }
 bool BMCEditor::readyToReload(){
   return flags.toggleIfTrue(BMC_EDITOR_FLAG_READY_TO_RELOAD);
@@ -400,3 +418,38 @@ uint32_t BMCEditor::getTimedEventOffset(uint8_t index){
   #endif
   return value;
 }
+uint32_t BMCEditor::getSequenceOffset(){
+  uint32_t value = getTimedEventOffset();
+  #if BMC_MAX_SEQUENCES > 0
+    value += sizeof(store.global.sequences);
+  #endif
+  return value;
+}
+uint32_t BMCEditor::getSequenceOffset(uint8_t index){
+  uint32_t value = getTimedEventOffset();
+  #if BMC_MAX_SEQUENCES > 0
+    value += (sizeof(bmcStoreGlobalSequence) * index);
+  #endif
+  return value;
+}
+uint32_t BMCEditor::getModulatorOffset(){
+  uint32_t value = getSequenceOffset();
+  #if BMC_MAX_MODULATORS > 0
+    value += sizeof(store.global.modulators);
+  #endif
+  return value;
+}
+uint32_t BMCEditor::getModulatorOffset(uint8_t index){
+  uint32_t value = getSequenceOffset();
+  #if BMC_MAX_MODULATORS > 0
+    value += (sizeof(bmcStoreGlobalModulator) * index);
+  #endif
+  return value;
+}
+uint32_t BMCEditor::getTempoToTapProfileOffset(uint8_t index){
+  uint32_t value = getModulatorOffset();
+  #if defined(BMC_TEMPO_TO_TAP_PROFILES_ENABLED)
+    value += (sizeof(bmcStoreGlobalTempoToTapProfile) * index);
+  #endif
+  return value;
+}
@@ -14,6 +14,8 @@
 #include "utility/BMC-Def.h"
 #include "editor/BMC-EditorMidiDef.h"
 #include "storage/BMC-Storage.h"
+#include "storage/BMC-StorePages.h"
+#include "storage/BMC-StorageJournal.h"
 #include "midi/BMC-Midi.h"
 
 #if defined(BMC_USE_TIME)
@@ -36,6 +38,7 @@
 #define BMC_EDITOR_FLAG_BACKUP_STARTED 12
 #define BMC_EDITOR_FLAG_BACKUP_COMPLETE 13
 #define BMC_EDITOR_FLAG_BACKUP_CANCELED 14
+#define BMC_EDITOR_FLAG_STORE_LOADED 15
 
 
 class BMCEditor {
@@ -74,7 +77,8 @@ public:
     if(!midi.globals.editorConnected() || connectionOngoing()){
       return;
     }
-    String str2 = str;
+    size_t length = strlen(str);
+    uint8_t len = (length > 32) ? 32 : length;
     BMCMidiMessage buff;
     buff.prepareEditorMessage(
       port, deviceId,
@@ -85,8 +89,8 @@ public:
     buff.appendToSysEx7Bits(1);
     buff.appendToSysEx16Bits(status);
     buff.appendToSysEx32Bits(value);
-    buff.appendToSysEx7Bits(str2.length()>32 ? 32 : str2.length());
-    buff.appendCharArrayToSysEx(str2);
+    buff.appendToSysEx7Bits(len);
+    buff.appendCharArrayToSysEx(str, len+1);
     sendToEditor(buff);
   }
   // USB can not be used as a Chaining Port
@@ -124,7 +128,7 @@ public:
   void setPort(uint8_t port);
   void setPage(uint8_t page);
   uint8_t getPage();
-  uint16_t getEepromSize(){
+  uint32_t getEepromSize(){
     return storage.length();
   }
 
@@ -132,10 +136,52 @@ public:
     p = store.global;
   }
   void getPageData(bmcStorePage& p){
-    p = store.pages[page];
+    p = pages[page];
   }
   void getPageData(uint8_t index, bmcStorePage& p){
-    p = store.pages[index];
+    p = pages[index];
+  }
+  // access to the store pages, use this instead of store.pages
+  BMCStorePages& getPages(){
+    return pages;
+  }
+#if defined(BMC_STORAGE_JOURNAL_ENABLED)
+  BMCStorageJournal& getJournal(){
+    return journal;
+  }
+#endif
+#if defined(BMC_FAST_BOOT_ENABLED)
+  // true while the store is being loaded in the background
+  bool storeLoading(){
+    return loadOffset > 0;
+  }
+  // true once after the whole store was loaded in the background
+  bool storeLoaded(){
+    return flags.toggleIfTrue(BMC_EDITOR_FLAG_STORE_LOADED);
+  }
+  // load the rest of the store now, used before reading or writing
+  // parts of the store that may not have been loaded yet
+  void completeStoreLoad(){
+    while(storeLoading()){
+      loadStoreBlock();
+    }
+  }
+  // load the store up to the end of page @n if it wasn't loaded yet, pages
+  // are loaded in order after store.global, the first one at startup
+  void loadPage(uint8_t n){
+    uint32_t end = getFirstPageOffset() + (sizeof(bmcStorePage) * (n+1));
+    while(n > 0 && storeLoading() && loadOffset < end){
+      loadStoreBlock();
+    }
+  }
+#endif
+  // bytes available for stores, the journal uses the end of the EEPROM
+  uint32_t getStoresLength(){
+    #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+      return journal.getStart();
+    #else
+      return storage.length();
+    #endif
   }
 
   void saveSketchBytesToEEPROM(){
@@ -237,10 +283,66 @@ private:
   //BMCBuildData pins;
   // reads/writes the store object to EEPROM/SD Card
   BMCStorage storage;
+  // pages of the store, either from the store itself or loaded on demand
+  // from the SD Card, see BMC-StorePages.h
+  BMCStorePages pages;
+#if defined(BMC_STORAGE_JOURNAL_ENABLED)
+  // settings, sketch bytes, preset and stopwatch are written here instead
+  // of their address in EEPROM, see BMC-StorageJournal.h
+  BMCStorageJournal journal;
+#endif
   // midi port we're listening to for editing.
   uint8_t port = 1;
+  // USB cable the editor is connected on
+  uint8_t cable = 0;
   // id of this device, this can be changed via Settings
   uint8_t deviceId = 0;
+#if defined(BMC_FAST_BOOT_ENABLED)
+  // next byte of the store to load in the background, 0 when done
+  uint32_t loadOffset = 0;
+  // crc, version, settings and sketch bytes
+  uint32_t getStoreHeaderSize(){
+    return getCrcAndVersionSize() + getSketchBytesOffset();
+  }
+  uint32_t getFirstPageOffset(){
+    return getCrcAndVersionSize() + sizeof(bmcStoreGlobal);
+  }
+  // load BMC_FAST_BOOT_BLOCK_SIZE bytes of the store, the first page
+  // was already loaded by getStore()
+  void loadStoreBlock(){
+    if(loadOffset == getFirstPageOffset()){
+      loadOffset += sizeof(bmcStorePage);
+    }
+    if(loadOffset < sizeof(bmcStore)){
+      uint32_t end = loadOffset < getFirstPageOffset() ? getFirstPageOffset() : sizeof(bmcStore);
+      uint32_t len = end - loadOffset;
+      if(len > BMC_FAST_BOOT_BLOCK_SIZE){
+        len = BMC_FAST_BOOT_BLOCK_SIZE;
+      }
+      if(!storage.read(getStoreOffset()+loadOffset, ((uint8_t *) &store)+loadOffset, len)){
+        // the rest of the store can't be trusted and saving it would
+        // write it back, same as a store that couldn't be read at startup
+        BMC_ERROR(
+          "EEPROM Store", storeAddress, "could not be read at", loadOffset,
+          "Check the wiring to your 24LC256 Chip"
+        );
+        BMC_HALT();
+      }
+      loadOffset += len;
+    }
+    if(loadOffset >= sizeof(bmcStore)){
+      loadOffset = 0;
+      flags.on(BMC_EDITOR_FLAG_STORE_LOADED);
+      // let BMC read triggers and timed events again now that they're loaded
+      #if BMC_MAX_TRIGGERS > 0
+        flags.on(BMC_EDITOR_FLAG_EDITOR_TRIGGERS_UPDATED);
+      #endif
+      #if BMC_MAX_TIMED_EVENTS > 0
+        flags.on(BMC_EDITOR_FLAG_EDITOR_TIMED_EVENTS_UPDATED);
+      #endif
+    }
+  }
+#endif
   // the current page we are working with
   uint8_t page = 0;
   // the current store address
@@ -402,27 +504,64 @@ private:
   uint32_t getPixelProgramsOffset(uint8_t index);
   uint32_t getTimedEventOffset();
   uint32_t getTimedEventOffset(uint8_t n);
+  uint32_t getSequenceOffset();
+  uint32_t getSequenceOffset(uint8_t n);
+  uint32_t getModulatorOffset();
+  uint32_t getModulatorOffset(uint8_t n);
+  uint32_t getTempoToTapProfileOffset(uint8_t n);
 
   // Clear the entire EEPROM
   void clearEEPROM(){
     storage.clear();
+    #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+      journal.reset();
+    #endif
+  }
+  // with fast boot the rest of the store is loaded before anything is
+  // saved, a save never writes bytes that weren't read yet and the
+  // background load can't overwrite what was saved
+  void loadBeforeSave(){
+    #if defined(BMC_FAST_BOOT_ENABLED)
+      completeStoreLoad();
+    #endif
+  }
+  // save a single item of store.global, @offset is it's offset in
+  // store.global, the SD Card always writes the whole store
+  template <typename T> void saveGlobalItem(uint32_t offset, const T& item){
+    loadBeforeSave();
+    #if defined(BMC_SD_CARD_ENABLED)
+      storage.set(storeAddress, store);
+    #else
+      storage.set(getGlobalOffset()+offset, item);
+    #endif
   }
   // save the entire "store" struct to EEPROM
   void saveStore(){
-    #if defined(BMC_SD_CARD_ENABLED)
+    loadBeforeSave();
+    #if defined(BMC_SD_PAGED_STORE_ENABLED)
+      storage.set(storeAddress, store);
+      pages.saveAll();
+    #elif defined(BMC_SD_CARD_ENABLED)
       storage.set(storeAddress, store);
     #else
-      uint16_t address = getStoreOffset();
+      uint32_t address = getStoreOffset();
       storage.set(address, store);
+      #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+        journal.checkpoint();
+      #endif
     #endif
   }
   // save "store.global" only to EEPROM
   void saveGlobal(){
+    loadBeforeSave();
     #if defined(BMC_SD_CARD_ENABLED)
       storage.set(storeAddress, store);
     #else
-      uint16_t address = getGlobalOffset();
+      uint32_t address = getGlobalOffset();
       storage.set(address, store.global);
+      #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+        journal.checkpoint();
+      #endif
     #endif
   }
   // save "store.global" only to EEPROM
@@ -438,8 +577,10 @@ public:
   void saveSettings(){
     #if defined(BMC_SD_CARD_ENABLED)
       storage.set(storeAddress, store);
+    #elif defined(BMC_STORAGE_JOURNAL_ENABLED)
+      journal.saveSettings();
     #else
-      uint16_t address = getGlobalOffset();
+      uint32_t address = getGlobalOffset();
       storage.set(address, store.global.settings);
     #endif
   }
@@ -449,8 +590,10 @@ public:
   void saveSketchBytes(){
     #if defined(BMC_SD_CARD_ENABLED)
       storage.set(storeAddress, store);
+    #elif defined(BMC_STORAGE_JOURNAL_ENABLED)
+      journal.saveSketchBytes();
     #else
-      uint16_t address = getGlobalOffset();
+      uint32_t address = getGlobalOffset();
       address += getSettingsOffset();
       storage.set(address, store.global.sketchBytes);
     #endif
@@ -460,13 +603,7 @@ public:
 #if BMC_MAX_STRING_LIBRARY > 0
   // save a single "string library" item to EEPROM
   void saveStringLibrary(uint8_t index){
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getStringLibraryOffset(index);
-      storage.set(address, store.global.stringLibrary[index]);
-    #endif
+    saveGlobalItem(getStringLibraryOffset(index), store.global.stringLibrary[index]);
   }
 #endif
 
@@ -476,39 +613,21 @@ public:
     if(index>=BMC_MAX_LIBRARY){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getLibraryOffset(index);
-      storage.set(address, store.global.library[index]);
-    #endif
+    saveGlobalItem(getLibraryOffset(index), store.global.library[index]);
   }
 #endif
 
 #if BMC_MAX_LIBRARY > 0 && BMC_MAX_PRESETS > 0
   // save the "startup" preset item to EEPROM
   void saveStartup(){
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getLibraryOffset();
-      storage.set(address, store.global.startup);
-    #endif
+    saveGlobalItem(getLibraryOffset(), store.global.startup);
   }
   // save a single "preset" to EEPROM
   void savePreset(bmcPreset_t index){
     if(index>=BMC_MAX_PRESETS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getPresetOffset(index);
-      storage.set(address, store.global.presets[index]);
-    #endif
+    saveGlobalItem(getPresetOffset(index), store.global.presets[index]);
   }
   #if BMC_MAX_SETLISTS > 0
   // save a single "preset" to EEPROM
@@ -516,13 +635,7 @@ public:
     if(index>=BMC_MAX_SETLISTS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getSetListOffset(index);
-      storage.set(address, store.global.setLists[index]);
-    #endif
+    saveGlobalItem(getSetListOffset(index), store.global.setLists[index]);
   }
   #endif
 #endif
@@ -533,13 +646,7 @@ public:
     if(index>=BMC_MAX_GLOBAL_LEDS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getGlobalLedOffset(index);
-      storage.set(address, store.global.leds[index]);
-    #endif
+    saveGlobalItem(getGlobalLedOffset(index), store.global.leds[index]);
   }
 #endif
 
@@ -549,13 +656,7 @@ public:
     if(index>=BMC_MAX_GLOBAL_BUTTONS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getGlobalButtonOffset(index);
-      storage.set(address, store.global.buttons[index]);
-    #endif
+    saveGlobalItem(getGlobalButtonOffset(index), store.global.buttons[index]);
   }
 #endif
 
@@ -565,13 +666,7 @@ public:
     if(index>=BMC_MAX_GLOBAL_ENCODERS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getGlobalEncoderOffset(index);
-      storage.set(address, store.global.encoders[index]);
-    #endif
+    saveGlobalItem(getGlobalEncoderOffset(index), store.global.encoders[index]);
   }
 #endif
 
@@ -581,26 +676,14 @@ public:
     if(index>=BMC_MAX_GLOBAL_POTS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getGlobalPotOffset(index);
-      storage.set(address, store.global.pots[index]);
-    #endif
+    saveGlobalItem(getGlobalPotOffset(index), store.global.pots[index]);
   }
   // save a single global pot calibrarion to EEPROM
   void saveGlobalPotCalibration(uint8_t index){
     if(index>=BMC_MAX_GLOBAL_POTS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getGlobalPotCalibrationOffset(index);
-      storage.set(address, store.global.globalPotCalibration[index]);
-    #endif
+    saveGlobalItem(getGlobalPotCalibrationOffset(index), store.global.globalPotCalibration[index]);
   }
 
 #endif
@@ -611,13 +694,7 @@ public:
     if(index>=BMC_MAX_POTS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getPotCalibrationOffset(index);
-      storage.set(address, store.global.potCalibration[index]);
-    #endif
+    saveGlobalItem(getPotCalibrationOffset(index), store.global.potCalibration[index]);
   }
 #endif
 
@@ -627,13 +704,7 @@ public:
     if(index>=BMC_MAX_CUSTOM_SYSEX){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getCustomSysExOffset(index);
-      storage.set(address, store.global.customSysEx[index]);
-    #endif
+    saveGlobalItem(getCustomSysExOffset(index), store.global.customSysEx[index]);
   }
 #endif
 
@@ -643,13 +714,7 @@ public:
     if(index>=BMC_MAX_TRIGGERS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getTriggerOffset(index);
-      storage.set(address, store.global.triggers[index]);
-    #endif
+    saveGlobalItem(getTriggerOffset(index), store.global.triggers[index]);
   }
 #endif
 
@@ -659,13 +724,7 @@ public:
     if(index>=BMC_MAX_TEMPO_TO_TAP){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getTempoToTapOffset(index);
-      storage.set(address, store.global.tempoToTap[index]);
-    #endif
+    saveGlobalItem(getTempoToTapOffset(index), store.global.tempoToTap[index]);
   }
 #endif
 
@@ -675,13 +734,7 @@ public:
     if(index>=BMC_MAX_NL_RELAYS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getNLRelayOffset(index);
-      storage.set(address, store.global.relaysNL[index]);
-    #endif
+    saveGlobalItem(getNLRelayOffset(index), store.global.relaysNL[index]);
   }
 #endif
 
@@ -691,37 +744,19 @@ public:
     if(index>=BMC_MAX_L_RELAYS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getLRelayOffset(index);
-      storage.set(address, store.global.relaysL[index]);
-    #endif
+    saveGlobalItem(getLRelayOffset(index), store.global.relaysL[index]);
   }
 #endif
   // save a single "Tempo To Tap" to EEPROM
   void saveDevicePorts(){
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getPortPresetsOffset();
-      storage.set(address, store.global.portPresets);
-    #endif
+    saveGlobalItem(getPortPresetsOffset(), store.global.portPresets);
   }
 #if BMC_MAX_PIXEL_PROGRAMS > 0
   void savePixelProgram(uint8_t index){
     if(index >= BMC_MAX_PIXEL_PROGRAMS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getPixelProgramsOffset(index);
-      storage.set(address, store.global.pixelPrograms);
-    #endif
+    saveGlobalItem(getPixelProgramsOffset(index), store.global.pixelPrograms[index]);
   }
 #endif
 #if BMC_MAX_TIMED_EVENTS > 0
@@ -730,32 +765,59 @@ public:
     if(n>=BMC_MAX_TIMED_EVENTS){
       return;
     }
-    #if defined(BMC_SD_CARD_ENABLED)
-      storage.set(storeAddress, store);
-    #else
-      uint16_t address = getGlobalOffset();
-      address += getTimedEventOffset(n);
-      storage.set(address, store.global.timedEvents[n]);
-    #endif
+    saveGlobalItem(getTimedEventOffset(n), store.global.timedEvents[n]);
+  }
+#endif
+#if BMC_MAX_SEQUENCES > 0
+  // save a single "Sequence" to EEPROM
+  void saveSequence(uint8_t n){
+    if(n>=BMC_MAX_SEQUENCES){
+      return;
+    }
+    saveGlobalItem(getSequenceOffset(n), store.global.sequences[n]);
+  }
+#endif
+#if BMC_MAX_MODULATORS > 0
+  // save a single "Modulator" to EEPROM
+  void saveModulator(uint8_t n){
+    if(n>=BMC_MAX_MODULATORS){
+      return;
+    }
+    saveGlobalItem(getModulatorOffset(n), store.global.modulators[n]);
+  }
+#endif
+#if defined(BMC_TEMPO_TO_TAP_PROFILES_ENABLED)
+  // save a single "Tempo To Tap" device profile to EEPROM
+  void saveTempoToTapProfile(uint8_t index){
+    if(index>=BMC_MAX_TEMPO_TO_TAP){
+      return;
+    }
+    saveGlobalItem(getTempoToTapProfileOffset(index), store.global.tempoToTapProfiles[index]);
   }
 #endif
   // save a single page to EEPROM
   void savePage(uint8_t page){
-    #if defined(BMC_SD_CARD_ENABLED)
+    loadBeforeSave();
+    #if defined(BMC_SD_PAGED_STORE_ENABLED)
+      pages.save(page);
+    #elif defined(BMC_SD_CARD_ENABLED)
       storage.set(storeAddress,store);
     #else
-      uint16_t address = getGlobalOffset();
-      address += sizeof(store.global) + (sizeof(store.pages[0]) * page);
+      uint32_t address = getGlobalOffset();
+      address += sizeof(store.global) + (sizeof(bmcStorePage) * page);
       storage.set(address,store.pages[page]);
     #endif
   }
 private:
   // save all pages to EEPROM
   void savePage(){
-    #if defined(BMC_SD_CARD_ENABLED)
+    loadBeforeSave();
+    #if defined(BMC_SD_PAGED_STORE_ENABLED)
+      pages.saveAll();
+    #elif defined(BMC_SD_CARD_ENABLED)
       storage.set(storeAddress,store);
     #else
-      uint16_t address = getGlobalOffset();
+      uint32_t address = getGlobalOffset();
       address += sizeof(store.global);
       storage.set(address,store.pages);
     #endif
@@ -786,7 +848,7 @@ private:
 #if defined(BMC_SD_CARD_ENABLED)
     return BMC_FS_MAX_STORES;
 #else
-    uint8_t max = (storage.length()/sizeof(bmcStore));
+    uint32_t max = (getStoresLength()/sizeof(bmcStore));
     if(max==0){
       return 1;
     } else if(max>32){
@@ -801,10 +863,45 @@ private:
     #if defined(BMC_SD_CARD_ENABLED)
       uint16_t address = storeAddress;
     #else
-      uint16_t address = getStoreOffset();
+      uint32_t address = getStoreOffset();
+    #endif
+    bool loaded = true;
+
+    #if defined(BMC_FAST_BOOT_ENABLED)
+      if(flags.read(BMC_EDITOR_FLAG_EDITOR_INITIAL_SETUP)){
+        // at startup only settings and the first page are loaded,
+        // the rest is loaded by update(), see loadStoreBlock()
+        loadOffset = getStoreHeaderSize();
+        if(!storage.read(address, (uint8_t *) &store, getStoreHeaderSize()) ||
+           !storage.read(address+getFirstPageOffset(), (uint8_t *) &store.pages[0], sizeof(bmcStorePage))){
+          // try reading the whole store, if that fails too BMC halts below
+          BMC_PRINTLN("EEPROM Store", address, "partial read failed, loading all of it");
+          loaded = storage.get(address, store);
+          loadOffset = 0;
+        }
+      } else {
+        loaded = storage.get(address, store);
+        loadOffset = 0;
+      }
+    #else
+      loaded = storage.get(address, store);
+    #endif
+    if(!loaded){
+      // a store that couldn't be read would fail the CRC and be erased
+      BMC_ERROR(
+        "EEPROM Store", address, "could not be read",
+        "Check the wiring to your 24LC256 Chip"
+      );
+      BMC_HALT();
+    }
+    // any page loaded belongs to the previous store
+    pages.reset();
+    #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+      if(store.crc == BMC_CRC){
+        // apply the newest settings and sketch bytes from the journal
+        journal.restore(storeAddress);
+      }
     #endif
-
-    storage.get(address, store);
 
     // if the CRC in the store did NOT match the computed CRC then
     // we will clear all bytes of the store and add the new CRC and version
@@ -820,6 +917,10 @@ private:
       BMC_WARN_FOOT;
       // clear the current store in RAM by setting all bytes to 0
       memset(&store,0,sizeof(bmcStore));
+      #if defined(BMC_FAST_BOOT_ENABLED)
+        // nothing left to load, the whole store is being rebuilt
+        loadOffset = 0;
+      #endif
       // add the CRC
       store.crc = (BMC_CRC); // update the CRC
       store.version = (BMC_VERSION); // update the library version
@@ -833,6 +934,14 @@ private:
 #endif
       // update the device id on this new store to match the one we already have
       settings.setDeviceId(deviceId);
+      #if defined(BMC_SD_PAGED_STORE_ENABLED)
+        // pages are not part of the store in RAM, clear them in the file
+        storage.clear();
+      #elif defined(BMC_STORAGE_JOURNAL_ENABLED)
+        // records in the journal were made with the previous config
+        journal.erase();
+        journal.restore(storeAddress);
+      #endif
       saveStore();
       storage.get(address, store);
       flags.on(BMC_EDITOR_FLAG_EDITOR_EEPROM_CLEARED);
@@ -877,13 +986,24 @@ private:
       saveSettings();
     #else
       if(storeAddress!=0){
+        #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+          // write the settings of this store to its address so
+          // the journal only holds records of one store at a time
+          saveGlobal();
+        #endif
         storage.get(0, store);
+        #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+          journal.restore(0);
+        #endif
       }
       setStoreAddress(t_address);
       settings.setStoreAddress(storeAddress);
       // always save the device id to store 0.
       settings.setDeviceId(deviceId);
       storage.set(0, store);
+      #if defined(BMC_STORAGE_JOURNAL_ENABLED)
+        journal.checkpoint();
+      #endif
       getStore();
       delay(5);
       // update the device id on the current store
@@ -63,8 +63,18 @@ bool BMCEditor::read(){
   if(!incoming.isEditorMessage()){
     return false;
   }
+#if defined(BMC_EDITOR_USB_CABLE)
+  // the other cables are left for performance MIDI
+  if(incoming.getSource()==BMC_USB && incoming.getCable()!=BMC_EDITOR_USB_CABLE){
+    return false;
+  }
+#endif
   if(getMessageDeviceId() == deviceId){
     if(incoming.validateChecksum()){
+      #if defined(BMC_FAST_BOOT_ENABLED)
+        // the editor may read any part of the store
+        completeStoreLoad();
+      #endif
       // assign the flags to make it easier to read them
       midiFlags.set(incoming.sysex[5]);
       if(isUtilityMessage()){
@@ -98,6 +108,10 @@ bool BMCEditor::read(){
     if(!BMC_MATCH_PORT(incoming.getSource(), chaingingPort)){
       if(chaingingEditorPort==0){
         chaingingEditorPort = incoming.getPort();
+        // replies go back on the USB cable the editor is on
+        if(chaingingEditorPort==BMC_USB){
+          chaingingEditorPort = BMC_USB_CABLE_PORT(incoming.getCable());
+        }
       }
     } else {
       outPort = chaingingEditorPort;
@@ -128,7 +142,7 @@ void BMCEditor::sendToEditor(BMCMidiMessage message, bool appendCRC,
       message.getSysEx(), // the sysex array
       message.size(), // the sysex array length
       false, // does it have the 0xF0 & 0xF7 bytes
-      0, // cable, used for USB
+      cable, // cable, used for USB
       midiOutActivityAllowed // should it trigger MIDI Out activity
     );
   }
@@ -146,6 +146,7 @@ void BMCEditor::connectEditor(){
   );
 
   port = incoming.getPort();
+  cable = incoming.getCable();
   midi.globals.setEditorConnected(true);
   flags.on(BMC_EDITOR_FLAG_CONNECTING_TO_EDITOR);
   flags.on(BMC_EDITOR_FLAG_CONNECTION_HAS_CHANGED);
@@ -190,6 +191,7 @@ void BMCEditor::disconnect(bool t_notify){
   }
 
   port = 0;
+  cable = 0;
   midi.globals.setEditorConnected(false);
   flags.off(BMC_EDITOR_FLAG_EDITOR_FEEDBACK);
   flags.off(BMC_EDITOR_FLAG_CONNECTING_TO_EDITOR);
@@ -501,8 +503,8 @@ void BMCEditor::globalBuildInfoMessage(){// BMC_GLOBALF_BUILD_INFO
       }
     #endif
   } else if(itemId==BMC_GLOBALF_BUILD_INFO_DEVICE_NAME){
-    String name = BMC_DEVICE_NAME;
-    buff.appendToSysEx7Bits(name.length()+1);
+    const char * name = BMC_DEVICE_NAME;
+    buff.appendToSysEx7Bits(strlen(name)+1);
     buff.appendCharArrayToSysEx(name);
 
   } else if(itemId==BMC_GLOBALF_BUILD_INFO_MERGE_BUTTON_LEDS){
@@ -89,7 +89,7 @@ void BMCEditor::pageNameMessage(bool write){
 
   #if BMC_NAME_LEN_PAGES > 1
   if(write){
-    incoming.getStringFromSysEx(10, store.pages[page].name, BMC_NAME_LEN_PAGES);
+    incoming.getStringFromSysEx(10, pages[page].name, BMC_NAME_LEN_PAGES);
     if(!backupActive()){
       savePagesAndReloadData(page);
     }
@@ -102,7 +102,7 @@ void BMCEditor::pageNameMessage(bool write){
   buff.prepareEditorMessage(port, deviceId, BMC_PAGEF_PAGE_NAME, flag, page);
   buff.appendToSysEx7Bits(BMC_NAME_LEN_PAGES);//9
   #if BMC_NAME_LEN_PAGES > 1
-    buff.appendCharArrayToSysEx(store.pages[page].name,BMC_NAME_LEN_PAGES);
+    buff.appendCharArrayToSysEx(pages[page].name,BMC_NAME_LEN_PAGES);
   #endif
   sendToEditor(buff);
 }
@@ -158,7 +158,7 @@ void BMCEditor::pageButtonMessage(bool write){
     // the flags are always stored on the first event of the page button
     if(isWriteToAllPages()){
       for(uint8_t i=0;i<BMC_MAX_PAGES;i++){
-        bmcStoreButton& button = store.pages[i].buttons[buttonIndex];
+        bmcStoreButton& button = pages[i].buttons[buttonIndex];
         bmcStoreButtonEvent& event = button.events[eventIndex];
         event.mode  = incoming.get8Bits(11) & 0x0F;//+2
         event.ports = incoming.get8Bits(13);//+2
@@ -178,7 +178,7 @@ void BMCEditor::pageButtonMessage(bool write){
         savePagesAndReloadData();
       }
     } else {
-      bmcStoreButton& button = store.pages[page].buttons[buttonIndex];
+      bmcStoreButton& button = pages[page].buttons[buttonIndex];
       bmcStoreButtonEvent& event = button.events[eventIndex];
       event.mode  = incoming.get8Bits(11) & 0x0F;//+2
       event.ports = incoming.get8Bits(13);//+2
@@ -207,7 +207,7 @@ void BMCEditor::pageButtonMessage(bool write){
   buff.appendToSysEx7Bits(BMC_MAX_BUTTONS);
   buff.appendToSysEx7Bits(BMC_MAX_BUTTON_EVENTS);
 #if BMC_MAX_BUTTONS > 0 && BMC_MAX_BUTTON_EVENTS > 0
-  bmcStoreButton& button = store.pages[page].buttons[buttonIndex];
+  bmcStoreButton& button = pages[page].buttons[buttonIndex];
   buff.appendToSysEx7Bits(buttonIndex);
   buff.appendToSysEx7Bits(eventIndex);
   buff.appendToSysEx16Bits(BMCBuildData::getButtonPosition(buttonIndex,true));
@@ -255,7 +255,7 @@ void BMCEditor::pageLedMessage(bool write){
   if(write){
     if(isWriteToAllPages()){
       for(uint8_t i=0;i<BMC_MAX_PAGES;i++){
-        bmcStoreLed &item = store.pages[i].leds[index];
+        bmcStoreLed &item = pages[i].leds[index];
         item.event = incoming.get32Bits(10);
         #if BMC_NAME_LEN_LEDS > 1
           incoming.getStringFromSysEx(15,item.name,BMC_NAME_LEN_LEDS);
@@ -265,7 +265,7 @@ void BMCEditor::pageLedMessage(bool write){
         savePagesAndReloadData();
       }
     } else {
-      bmcStoreLed &item = store.pages[page].leds[index];
+      bmcStoreLed &item = pages[page].leds[index];
       item.event = incoming.get32Bits(10);
       #if BMC_NAME_LEN_LEDS > 1
         incoming.getStringFromSysEx(15,item.name,BMC_NAME_LEN_LEDS);
@@ -284,7 +284,7 @@ void BMCEditor::pageLedMessage(bool write){
   buff.prepareEditorMessage(port, deviceId, BMC_PAGEF_LED, flag, page);
   buff.appendToSysEx7Bits(BMC_MAX_LEDS); //9
 #if BMC_MAX_LEDS > 0
-  bmcStoreLed &item = store.pages[page].leds[index];
+  bmcStoreLed &item = pages[page].leds[index];
   buff.appendToSysEx7Bits(index);
   buff.appendToSysEx7Bits(BMCBuildData::getLedColor(index));
   buff.appendToSysEx16Bits(BMCBuildData::getLedPosition(index,true));
@@ -330,7 +330,7 @@ void BMCEditor::pagePwmLedMessage(bool write){
     // write new data and save, starts at byte 9
     if(isWriteToAllPages()){
       for(uint8_t i=0;i<BMC_MAX_PAGES;i++){
-        bmcStoreLed& item = store.pages[i].pwmLeds[index];
+        bmcStoreLed& item = pages[i].pwmLeds[index];
         item.event = incoming.get32Bits(10);
         #if BMC_NAME_LEN_LEDS > 1
           incoming.getStringFromSysEx(15, item.name, BMC_NAME_LEN_LEDS);
@@ -340,7 +340,7 @@ void BMCEditor::pagePwmLedMessage(bool write){
         savePagesAndReloadData();
       }
     } else {
-      bmcStoreLed &item = store.pages[page].pwmLeds[index];
+      bmcStoreLed &item = pages[page].pwmLeds[index];
       item.event = incoming.get32Bits(10);
       #if BMC_NAME_LEN_LEDS > 1
         incoming.getStringFromSysEx(15, item.name, BMC_NAME_LEN_LEDS);
@@ -360,7 +360,7 @@ void BMCEditor::pagePwmLedMessage(bool write){
 
 
 #if BMC_MAX_PWM_LEDS > 0
-  bmcStoreLed &item = store.pages[page].pwmLeds[index];
+  bmcStoreLed &item = pages[page].pwmLeds[index];
   buff.appendToSysEx7Bits(index);
   buff.appendToSysEx7Bits(BMCBuildData::getPwmLedColor(index));
   buff.appendToSysEx16Bits(BMCBuildData::getPwmLedPosition(index,true));
@@ -405,7 +405,7 @@ void BMCEditor::pagePixelMessage(bool write){
   if(write){
     if(isWriteToAllPages()){
       for(uint8_t i=0;i<BMC_MAX_PAGES;i++){
-        bmcStoreLed &item = store.pages[i].pixels[index];
+        bmcStoreLed &item = pages[i].pixels[index];
         item.event = incoming.get32Bits(10);
         #if BMC_NAME_LEN_LEDS > 1
           incoming.getStringFromSysEx(15,item.name,BMC_NAME_LEN_LEDS);
@@ -415,7 +415,7 @@ void BMCEditor::pagePixelMessage(bool write){
         savePagesAndReloadData();
       }
     } else {
-      bmcStoreLed &item = store.pages[page].pixels[index];
+      bmcStoreLed &item = pages[page].pixels[index];
       item.event = incoming.get32Bits(10);
       #if BMC_NAME_LEN_LEDS > 1
         incoming.getStringFromSysEx(15,item.name,BMC_NAME_LEN_LEDS);
@@ -434,7 +434,7 @@ void BMCEditor::pagePixelMessage(bool write){
   buff.prepareEditorMessage(port, deviceId, BMC_PAGEF_PIXEL, flag, page);
   buff.appendToSysEx7Bits(BMC_MAX_PIXELS);//9
   #if BMC_MAX_PIXELS > 0
-  bmcStoreLed &item = store.pages[page].pixels[index];
+  bmcStoreLed &item = pages[page].pixels[index];
   buff.appendToSysEx7Bits(index);
   buff.appendToSysEx7Bits(BMCBuildData::getPixelDefaultColor(index));
   buff.appendToSysEx16Bits(BMCBuildData::getPixelPosition(index,true));
@@ -476,7 +476,7 @@ void BMCEditor::pageRgbPixelMessage(bool write){
   if(write){
     if(isWriteToAllPages()){
       for(uint8_t i=0;i<BMC_MAX_PAGES;i++){
-        bmcStoreRgbLed &item = store.pages[i].rgbPixels[index];
+        bmcStoreRgbLed &item = pages[i].rgbPixels[index];
         item.red = incoming.get32Bits(10);
         item.green = incoming.get32Bits(15);
         item.blue = incoming.get32Bits(20);
@@ -488,7 +488,7 @@ void BMCEditor::pageRgbPixelMessage(bool write){
         savePagesAndReloadData();
       }
     } else {
-      bmcStoreRgbLed &item = store.pages[page].rgbPixels[index];
+      bmcStoreRgbLed &item = pages[page].rgbPixels[index];
       item.red = incoming.get32Bits(10);
       item.green = incoming.get32Bits(15);
       item.blue = incoming.get32Bits(20);
@@ -508,7 +508,7 @@ void BMCEditor::pageRgbPixelMessage(bool write){
   buff.prepareEditorMessage(port, deviceId, BMC_PAGEF_RGB_PIXEL, flag, page);
   buff.appendToSysEx7Bits(BMC_MAX_RGB_PIXELS);//9
   #if BMC_MAX_RGB_PIXELS > 0
-  bmcStoreRgbLed &item = store.pages[page].rgbPixels[index];
+  bmcStoreRgbLed &item = pages[page].rgbPixels[index];
   buff.appendToSysEx7Bits(index);
   buff.appendToSysEx7Bits(BMCBuildData::getRgbPixelDefaultColor(index));
   buff.appendToSysEx16Bits(BMCBuildData::getRgbPixelPosition(index, true));
@@ -556,7 +556,7 @@ void BMCEditor::pagePotMessage(bool write){
     // write new data and save, starts at byte 9
     if(isWriteToAllPages()){
       for(uint8_t i=0;i<BMC_MAX_PAGES;i++){
-        bmcStorePot& item = store.pages[i].pots[index];
+        bmcStorePot& item = pages[i].pots[index];
         item.ports = incoming.get8Bits(10);
         item.event = incoming.get32Bits(12);
         #if defined(BMC_USE_POT_TOE_SWITCH)
@@ -575,7 +575,7 @@ void BMCEditor::pagePotMessage(bool write){
         savePagesAndReloadData();
       }
     } else {
-      bmcStorePot& item = store.pages[page].pots[index];
+      bmcStorePot& item = pages[page].pots[index];
       item.ports = incoming.get8Bits(10);
       item.event = incoming.get32Bits(12);
       #if defined(BMC_USE_POT_TOE_SWITCH)
@@ -602,7 +602,7 @@ void BMCEditor::pagePotMessage(bool write){
   buff.prepareEditorMessage(port, deviceId, BMC_PAGEF_POT, flag, page);
   buff.appendToSysEx7Bits(BMC_MAX_POTS);//9
 #if BMC_MAX_POTS > 0
-  bmcStorePot& item = store.pages[page].pots[index];
+  bmcStorePot& item = pages[page].pots[index];
   buff.appendToSysEx7Bits(index);
   buff.appendToSysEx7Bits(BMCBuildData::getPotStyle(index));
   buff.appendToSysEx16Bits(BMCBuildData::getPotPosition(index,true));
@@ -649,7 +649,7 @@ void BMCEditor::pageEncoderMessage(bool write){
   if(write){
     if(isWriteToAllPages()){
       for(uint8_t i=0;i<BMC_MAX_PAGES;i++){
-        bmcStoreEncoder& item = store.pages[i].encoders[index];
+        bmcStoreEncoder& item = pages[i].encoders[index];
         item.mode = incoming.get8Bits(10);//2
         item.ports = incoming.get8Bits(12);//2
         item.event = incoming.get32Bits(14);
@@ -661,7 +661,7 @@ void BMCEditor::pageEncoderMessage(bool write){
         savePagesAndReloadData();
       }
     } else {
-      bmcStoreEncoder& item = store.pages[page].encoders[index];
+      bmcStoreEncoder& item = pages[page].encoders[index];
       item.mode = incoming.get8Bits(10);//2
       item.ports = incoming.get8Bits(12);//2
       item.event = incoming.get32Bits(14);
@@ -682,7 +682,7 @@ void BMCEditor::pageEncoderMessage(bool write){
   buff.prepareEditorMessage(port, deviceId, BMC_PAGEF_ENCODER, flag, page);
   buff.appendToSysEx7Bits(BMC_MAX_ENCODERS);//9
 #if BMC_MAX_ENCODERS > 0
-  bmcStoreEncoder& item = store.pages[page].encoders[index];
+  bmcStoreEncoder& item = pages[page].encoders[index];
   buff.appendToSysEx7Bits(index);
   buff.appendToSysEx16Bits(BMCBuildData::getEncoderPosition(index,true));
   buff.appendToSysEx16Bits(BMCBuildData::getEncoderPosition(index,false));
@@ -715,27 +715,27 @@ void BMCEditor::pageButtonEventShiftPositionMessage(bool write){
     uint8_t eventTarget = incoming.sysex[11];
     if(buttonIndex<BMC_MAX_BUTTONS && eventSource<BMC_MAX_BUTTON_EVENTS && eventTarget<BMC_MAX_BUTTON_EVENTS){
       if(eventSource!=eventTarget){
-        bmcStoreButtonEvent source = store.pages[page].buttons[buttonIndex].events[eventSource];
+        bmcStoreButtonEvent source = pages[page].buttons[buttonIndex].events[eventSource];
         if(eventSource>eventTarget){
           // moved up
           for(int i=(eventSource-1);i>=eventTarget;i--){
             if(i>=0 && (i+1) < BMC_MAX_BUTTON_EVENTS){
-              bmcStoreButtonEvent tmp = store.pages[page].buttons[buttonIndex].events[i];
-              store.pages[page].buttons[buttonIndex].events[i+1] = tmp;
+              bmcStoreButtonEvent tmp = pages[page].buttons[buttonIndex].events[i];
+              pages[page].buttons[buttonIndex].events[i+1] = tmp;
             }
           }
         } else if(eventSource<eventTarget){
           // moved down
           for(uint8_t i=eventSource;i<eventTarget;i++){
             if((i+1)<BMC_MAX_BUTTON_EVENTS){
-              bmcStoreButtonEvent tmp = store.pages[page].buttons[buttonIndex].events[i+1];
-              store.pages[page].buttons[buttonIndex].events[i] = tmp;
+              bmcStoreButtonEvent tmp = pages[page].buttons[buttonIndex].events[i+1];
+              pages[page].buttons[buttonIndex].events[i] = tmp;
             }
 
           }
         }
         BMC_PRINTLN("Moved button event from",eventSource,"to",eventTarget);
-        store.pages[page].buttons[buttonIndex].events[eventTarget] = source;
+        pages[page].buttons[buttonIndex].events[eventTarget] = source;
         resp = 1;
       }
       savePagesAndReloadData(page);
@@ -804,15 +804,15 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_PAGE:
 #if BMC_MAX_PAGES > 1
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStorePage x = store.pages[sourcePage];
-        store.pages[targetPage] = x;
+        bmcStorePage x = pages[sourcePage];
+        pages[targetPage] = x;
         savePagesAndReloadData(targetPage);
         success = true;
       } else {
-        bmcStorePage source = store.pages[sourcePage];
-        bmcStorePage target = store.pages[targetPage];
-        store.pages[sourcePage] = target;
-        store.pages[targetPage] = source;
+        bmcStorePage source = pages[sourcePage];
+        bmcStorePage target = pages[targetPage];
+        pages[sourcePage] = target;
+        pages[targetPage] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
@@ -823,15 +823,15 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_BUTTON:
 #if BMC_MAX_BUTTONS > 0
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStoreButton x = store.pages[sourcePage].buttons[sourceItem];
-        store.pages[targetPage].buttons[targetItem] = x;
+        bmcStoreButton x = pages[sourcePage].buttons[sourceItem];
+        pages[targetPage].buttons[targetItem] = x;
         savePagesAndReloadData(targetPage);
         success = true;
       } else {
-        bmcStoreButton source = store.pages[sourcePage].buttons[sourceItem];
-        bmcStoreButton target = store.pages[targetPage].buttons[targetItem];
-        store.pages[sourcePage].buttons[sourceItem] = target;
-        store.pages[targetPage].buttons[targetItem] = source;
+        bmcStoreButton source = pages[sourcePage].buttons[sourceItem];
+        bmcStoreButton target = pages[targetPage].buttons[targetItem];
+        pages[sourcePage].buttons[sourceItem] = target;
+        pages[targetPage].buttons[targetItem] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
@@ -841,15 +841,15 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_LED:
 #if BMC_MAX_LEDS > 0
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStoreLed x = store.pages[sourcePage].leds[sourceItem];
-        store.pages[targetPage].leds[targetItem] = x;
+        bmcStoreLed x = pages[sourcePage].leds[sourceItem];
+        pages[targetPage].leds[targetItem] = x;
         savePagesAndReloadData(targetPage);
         success = true;
       } else {
-        bmcStoreLed source = store.pages[sourcePage].leds[sourceItem];
-        bmcStoreLed target = store.pages[targetPage].leds[targetItem];
-        store.pages[sourcePage].leds[sourceItem] = target;
-        store.pages[targetPage].leds[targetItem] = source;
+        bmcStoreLed source = pages[sourcePage].leds[sourceItem];
+        bmcStoreLed target = pages[targetPage].leds[targetItem];
+        pages[sourcePage].leds[sourceItem] = target;
+        pages[targetPage].leds[targetItem] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
@@ -859,15 +859,15 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_PIXEL:
 #if BMC_MAX_PIXELS > 0
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStoreLed x = store.pages[sourcePage].pixels[sourceItem];
-        store.pages[targetPage].pixels[targetItem] = x;
+        bmcStoreLed x = pages[sourcePage].pixels[sourceItem];
+        pages[targetPage].pixels[targetItem] = x;
         savePagesAndReloadData(targetPage);
         success = true;
       } else {
-        bmcStoreLed source = store.pages[sourcePage].pixels[sourceItem];
-        bmcStoreLed target = store.pages[targetPage].pixels[targetItem];
-        store.pages[sourcePage].pixels[sourceItem] = target;
-        store.pages[targetPage].pixels[targetItem] = source;
+        bmcStoreLed source = pages[sourcePage].pixels[sourceItem];
+        bmcStoreLed target = pages[targetPage].pixels[targetItem];
+        pages[sourcePage].pixels[sourceItem] = target;
+        pages[targetPage].pixels[targetItem] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
@@ -877,15 +877,15 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_RGB_PIXEL:
 #if BMC_MAX_RGB_PIXELS > 0
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStoreRgbLed x = store.pages[sourcePage].rgbPixels[sourceItem];
-        store.pages[targetPage].rgbPixels[targetItem] = x;
+        bmcStoreRgbLed x = pages[sourcePage].rgbPixels[sourceItem];
+        pages[targetPage].rgbPixels[targetItem] = x;
         savePagesAndReloadData(targetPage);
         success = true;
       } else {
-        bmcStoreRgbLed source = store.pages[sourcePage].rgbPixels[sourceItem];
-        bmcStoreRgbLed target = store.pages[targetPage].rgbPixels[targetItem];
-        store.pages[sourcePage].rgbPixels[sourceItem] = target;
-        store.pages[targetPage].rgbPixels[targetItem] = source;
+        bmcStoreRgbLed source = pages[sourcePage].rgbPixels[sourceItem];
+        bmcStoreRgbLed target = pages[targetPage].rgbPixels[targetItem];
+        pages[sourcePage].rgbPixels[sourceItem] = target;
+        pages[targetPage].rgbPixels[targetItem] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
@@ -895,17 +895,17 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_PWM_LED:
 #if BMC_MAX_PWM_LEDS > 0
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStoreLed x = store.pages[sourcePage].pwmLeds[sourceItem];
-        store.pages[targetPage].pwmLeds[targetItem] = x;
+        bmcStoreLed x = pages[sourcePage].pwmLeds[sourceItem];
+        pages[targetPage].pwmLeds[targetItem] = x;
         if(!backupActive()){
           savePagesAndReloadData(targetPage);
           success = true;
         }
       } else {
-        bmcStoreLed source = store.pages[sourcePage].pwmLeds[sourceItem];
-        bmcStoreLed target = store.pages[targetPage].pwmLeds[targetItem];
-        store.pages[sourcePage].pwmLeds[sourceItem] = target;
-        store.pages[targetPage].pwmLeds[targetItem] = source;
+        bmcStoreLed source = pages[sourcePage].pwmLeds[sourceItem];
+        bmcStoreLed target = pages[targetPage].pwmLeds[targetItem];
+        pages[sourcePage].pwmLeds[sourceItem] = target;
+        pages[targetPage].pwmLeds[targetItem] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
@@ -915,15 +915,15 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_POT:
 #if BMC_MAX_POTS > 0
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStorePot x = store.pages[sourcePage].pots[sourceItem];
-        store.pages[targetPage].pots[targetItem] = x;
+        bmcStorePot x = pages[sourcePage].pots[sourceItem];
+        pages[targetPage].pots[targetItem] = x;
         savePagesAndReloadData(targetPage);
         success = true;
       } else {
-        bmcStorePot source = store.pages[sourcePage].pots[sourceItem];
-        bmcStorePot target = store.pages[targetPage].pots[targetItem];
-        store.pages[sourcePage].pots[sourceItem] = target;
-        store.pages[targetPage].pots[targetItem] = source;
+        bmcStorePot source = pages[sourcePage].pots[sourceItem];
+        bmcStorePot target = pages[targetPage].pots[targetItem];
+        pages[sourcePage].pots[sourceItem] = target;
+        pages[targetPage].pots[targetItem] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
@@ -933,15 +933,15 @@ void BMCEditor::pageHardwareCopySwapMessage(bool write){
     case BMC_ITEM_ID_ENCODER:
 #if BMC_MAX_ENCODERS > 0
       if(mode==BMC_PAGEF_HARDWARE_COPY){
-        bmcStoreEncoder x = store.pages[sourcePage].encoders[sourceItem];
-        store.pages[targetPage].encoders[targetItem] = x;
+        bmcStoreEncoder x = pages[sourcePage].encoders[sourceItem];
+        pages[targetPage].encoders[targetItem] = x;
         savePagesAndReloadData(targetPage);
         success = true;
       } else {
-        bmcStoreEncoder source = store.pages[sourcePage].encoders[sourceItem];
-        bmcStoreEncoder target = store.pages[targetPage].encoders[targetItem];
-        store.pages[sourcePage].encoders[sourceItem] = target;
-        store.pages[targetPage].encoders[targetItem] = source;
+        bmcStoreEncoder source = pages[sourcePage].encoders[sourceItem];
+        bmcStoreEncoder target = pages[targetPage].encoders[targetItem];
+        pages[sourcePage].encoders[sourceItem] = target;
+        pages[targetPage].encoders[targetItem] = source;
         savePagesAndReloadData(sourcePage);
         savePagesAndReloadData(targetPage);
         success = true;
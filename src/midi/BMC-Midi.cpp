@@ -83,7 +83,7 @@ void BMCMidi::send(uint8_t port, uint8_t type,
     data2 = getLocalControl(channel,data1)>0 ? 0 : 127;
   }
   if(isMidiUsbPort(port)){
-    usbMIDI.send(type, data1, data2, channel, cable);
+    usbMIDI.send(type, data1, data2, channel, getPortCable(port, cable));
   }
 
 #ifdef BMC_MIDI_SERIAL_A_ENABLED
@@ -129,9 +129,9 @@ void BMCMidi::send(uint8_t port, uint8_t type,
 #endif
 
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.send(type, data1, data2, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.send(type, data1, data2, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -165,7 +165,7 @@ void BMCMidi::sendRealTime(uint8_t port, uint8_t type, uint8_t cable){
     return;
   }
   if(isMidiUsbPort(port)){
-    usbMIDI.sendRealTime(type, cable);
+    usbMIDI.sendRealTime(type, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -188,9 +188,9 @@ void BMCMidi::sendRealTime(uint8_t port, uint8_t type, uint8_t cable){
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendRealTime(type,cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendRealTime(type,cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(
@@ -226,7 +226,7 @@ void BMCMidi::sendSysEx(uint8_t port, uint8_t *data,
     return;
   }
   if(isMidiUsbPort(port)){
-    usbMIDI.sendSysEx(size, data, hasTerm, cable);
+    usbMIDI.sendSysEx(size, data, hasTerm, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -262,9 +262,9 @@ void BMCMidi::sendSysEx(uint8_t port, uint8_t *data,
   #endif
 
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendSysEx(size, data, hasTerm, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendSysEx(size, data, hasTerm, cable);
+    });
   #endif
 
   #ifdef BMC_MIDI_BLE_ENABLED
@@ -291,7 +291,7 @@ void BMCMidi::sendSysEx(uint8_t port, uint8_t *data,
 void BMCMidi::sendProgramChange(uint8_t port, uint8_t channel,
                                 uint8_t program, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendProgramChange(program, channel, cable);
+    usbMIDI.sendProgramChange(program, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -314,9 +314,9 @@ void BMCMidi::sendProgramChange(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendProgramChange(program, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendProgramChange(program, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -348,7 +348,7 @@ void BMCMidi::sendControlChange(uint8_t port, uint8_t channel,
     }
   }
   if(isMidiUsbPort(port)){
-    usbMIDI.sendControlChange(control, value, channel, cable);
+    usbMIDI.sendControlChange(control, value, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -371,9 +371,9 @@ void BMCMidi::sendControlChange(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendControlChange(control, value , channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendControlChange(control, value, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -408,7 +408,7 @@ void BMCMidi::sendNoteOn(uint8_t port, uint8_t channel,
                         uint8_t note, uint8_t velocity,
                         uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendNoteOn(note, velocity, channel, cable);
+    usbMIDI.sendNoteOn(note, velocity, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -431,9 +431,9 @@ void BMCMidi::sendNoteOn(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendNoteOn(note, velocity, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendNoteOn(note, velocity, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -458,7 +458,7 @@ void BMCMidi::sendNoteOff(uint8_t port, uint8_t channel,
                           uint8_t note, uint8_t velocity,
                           uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendNoteOff(note, velocity, channel, cable);
+    usbMIDI.sendNoteOff(note, velocity, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -481,9 +481,9 @@ void BMCMidi::sendNoteOff(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendNoteOff(note, velocity, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendNoteOff(note, velocity, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -508,7 +508,7 @@ void BMCMidi::sendPitchBend(uint8_t port, uint8_t channel,
                             int16_t value, uint8_t cable){
   // value range for pitch bend -8192 to 8191, 0 is center
   if(isMidiUsbPort(port)){
-    usbMIDI.sendPitchBend(value, channel, cable);
+    usbMIDI.sendPitchBend(value, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -531,9 +531,9 @@ void BMCMidi::sendPitchBend(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendPitchBend(value, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendPitchBend(value, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -564,7 +564,7 @@ void BMCMidi::sendPitchBend(uint8_t port, uint8_t channel,
 void BMCMidi::sendAfterTouch(uint8_t port, uint8_t channel,
                               uint8_t pressure, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendAfterTouch(pressure, channel, cable);
+    usbMIDI.sendAfterTouch(pressure, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -587,9 +587,9 @@ void BMCMidi::sendAfterTouch(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendAfterTouch(pressure, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendAfterTouch(pressure, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -613,7 +613,7 @@ void BMCMidi::sendAfterTouchPoly(uint8_t port, uint8_t channel,
                                   uint8_t note, uint8_t pressure,
                                   uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendAfterTouchPoly(note, pressure, channel, cable);
+    usbMIDI.sendAfterTouchPoly(note, pressure, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -636,9 +636,9 @@ void BMCMidi::sendAfterTouchPoly(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendAfterTouchPoly(note, pressure, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendAfterTouchPoly(note, pressure, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -668,7 +668,7 @@ void BMCMidi::sendAfterTouchPoly(uint8_t port, uint8_t channel,
 void BMCMidi::sendTimeCodeQuarterFrame(uint8_t port, uint8_t type,
                                         uint8_t value, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendTimeCodeQuarterFrame(type, value, cable);
+    usbMIDI.sendTimeCodeQuarterFrame(type, value, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -691,9 +691,9 @@ void BMCMidi::sendTimeCodeQuarterFrame(uint8_t port, uint8_t type,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendTimeCodeQuarterFrame(type, value, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendTimeCodeQuarterFrame(type, value, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -716,7 +716,7 @@ void BMCMidi::sendTimeCodeQuarterFrame(uint8_t port, uint8_t type,
 void BMCMidi::sendSongPosition(uint8_t port, uint16_t beats,
                               uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendSongPosition(beats, cable);
+    usbMIDI.sendSongPosition(beats, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -739,9 +739,9 @@ void BMCMidi::sendSongPosition(uint8_t port, uint16_t beats,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendSongPosition(beats, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendSongPosition(beats, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -762,7 +762,7 @@ void BMCMidi::sendSongPosition(uint8_t port, uint16_t beats,
 }
 void BMCMidi::sendSongSelect(uint8_t port, uint8_t song, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendSongSelect(song, cable);
+    usbMIDI.sendSongSelect(song, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -785,9 +785,9 @@ void BMCMidi::sendSongSelect(uint8_t port, uint8_t song, uint8_t cable){
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendSongSelect(song, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendSongSelect(song, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -808,7 +808,7 @@ void BMCMidi::sendSongSelect(uint8_t port, uint8_t song, uint8_t cable){
 }
 void BMCMidi::sendTuneRequest(uint8_t port, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendTuneRequest(cable);
+    usbMIDI.sendTuneRequest(getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -831,9 +831,9 @@ void BMCMidi::sendTuneRequest(uint8_t port, uint8_t cable){
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendTuneRequest(cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendTuneRequest(cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -855,7 +855,7 @@ void BMCMidi::sendTuneRequest(uint8_t port, uint8_t cable){
 void BMCMidi::beginRpn(uint8_t port, uint8_t channel,
                         uint16_t number, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.beginRpn(number, channel, cable);
+    usbMIDI.beginRpn(number, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -878,9 +878,9 @@ void BMCMidi::beginRpn(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.beginRpn(number, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.beginRpn(number, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -903,7 +903,7 @@ void BMCMidi::beginRpn(uint8_t port, uint8_t channel,
 void BMCMidi::sendRpnValue(uint8_t port, uint8_t channel,
                             uint16_t value, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendRpnValue(value, channel, cable);
+    usbMIDI.sendRpnValue(value, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -926,9 +926,9 @@ void BMCMidi::sendRpnValue(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendRpnValue(value, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendRpnValue(value, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -951,7 +951,7 @@ void BMCMidi::sendRpnValue(uint8_t port, uint8_t channel,
 void BMCMidi::sendRpnIncrement(uint8_t port, uint8_t channel,
                                 uint8_t amount, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendRpnIncrement(amount, channel, cable);
+    usbMIDI.sendRpnIncrement(amount, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -974,9 +974,9 @@ void BMCMidi::sendRpnIncrement(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendRpnIncrement(amount, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendRpnIncrement(amount, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -999,7 +999,7 @@ void BMCMidi::sendRpnIncrement(uint8_t port, uint8_t channel,
 void BMCMidi::sendRpnDecrement(uint8_t port, uint8_t channel,
                                 uint8_t amount, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendRpnDecrement(amount, channel, cable);
+    usbMIDI.sendRpnDecrement(amount, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -1022,9 +1022,9 @@ void BMCMidi::sendRpnDecrement(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendRpnDecrement(amount, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendRpnDecrement(amount, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -1046,7 +1046,7 @@ void BMCMidi::sendRpnDecrement(uint8_t port, uint8_t channel,
 }
 void BMCMidi::endRpn(uint8_t port, uint8_t channel, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.endRpn(channel, cable);
+    usbMIDI.endRpn(channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -1069,9 +1069,9 @@ void BMCMidi::endRpn(uint8_t port, uint8_t channel, uint8_t cable){
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.endRpn(channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.endRpn(channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -1094,7 +1094,7 @@ void BMCMidi::endRpn(uint8_t port, uint8_t channel, uint8_t cable){
 void BMCMidi::beginNrpn(uint8_t port, uint8_t channel,
                         uint16_t number, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.beginNrpn(number, channel, cable);
+    usbMIDI.beginNrpn(number, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -1117,9 +1117,9 @@ void BMCMidi::beginNrpn(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.beginNrpn(number, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.beginNrpn(number, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -1142,7 +1142,7 @@ void BMCMidi::beginNrpn(uint8_t port, uint8_t channel,
 void BMCMidi::sendNrpnValue(uint8_t port, uint8_t channel,
                             uint16_t value, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendNrpnValue(value, channel, cable);
+    usbMIDI.sendNrpnValue(value, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -1165,9 +1165,9 @@ void BMCMidi::sendNrpnValue(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendNrpnValue(value, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendNrpnValue(value, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -1190,7 +1190,7 @@ void BMCMidi::sendNrpnValue(uint8_t port, uint8_t channel,
 void BMCMidi::sendNrpnIncrement(uint8_t port, uint8_t channel,
                                 uint8_t amount, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendNrpnIncrement(amount, channel, cable);
+    usbMIDI.sendNrpnIncrement(amount, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -1213,9 +1213,9 @@ void BMCMidi::sendNrpnIncrement(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendNrpnIncrement(amount, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendNrpnIncrement(amount, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -1238,7 +1238,7 @@ void BMCMidi::sendNrpnIncrement(uint8_t port, uint8_t channel,
 void BMCMidi::sendNrpnDecrement(uint8_t port, uint8_t channel,
                                 uint8_t amount, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.sendNrpnDecrement(amount, channel, cable);
+    usbMIDI.sendNrpnDecrement(amount, channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -1261,9 +1261,9 @@ void BMCMidi::sendNrpnDecrement(uint8_t port, uint8_t channel,
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.sendNrpnDecrement(amount, channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.sendNrpnDecrement(amount, channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
@@ -1285,7 +1285,7 @@ void BMCMidi::sendNrpnDecrement(uint8_t port, uint8_t channel,
 }
 void BMCMidi::endNrpn(uint8_t port, uint8_t channel, uint8_t cable){
   if(isMidiUsbPort(port)){
-    usbMIDI.endNrpn(channel, cable);
+    usbMIDI.endNrpn(channel, getPortCable(port, cable));
   }
   #ifdef BMC_MIDI_SERIAL_A_ENABLED
     if(isMidiSerialAPort(port)){
@@ -1308,9 +1308,9 @@ void BMCMidi::endNrpn(uint8_t port, uint8_t channel, uint8_t cable){
     }
   #endif
   #ifdef BMC_USB_HOST_ENABLED
-    if(isMidiHostPort(port) && globals.hostConnected()){
-      midiHost.Port.endNrpn(channel, cable);
-    }
+    sendToHostDevices(port, [&](BMCHostMidiDevice& device){
+      device.endNrpn(channel, cable);
+    });
   #endif
   #ifdef BMC_MIDI_BLE_ENABLED
     if(isMidiBlePort(port) && globals.bleConnected()){
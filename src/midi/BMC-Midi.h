@@ -31,6 +31,14 @@
 
 #include "midi/BMC-MidiRouting.h"
 
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  #include "midi/BMC-SysExStream.h"
+#endif
+
+#ifdef BMC_SYSEX_POOL_ENABLED
+  #include "midi/BMC-SysExPool.h"
+#endif
+
 class BMCMidi {
 public:
   // message holds the incoming MIDI message read from any of the ports
@@ -67,13 +75,66 @@ public:
 #endif
 #ifdef BMC_MIDI_BLE_ENABLED
       midiBle.begin();
+#endif
+#if defined(BMC_SYSEX_STREAM_ENABLED) || defined(BMC_SYSEX_POOL_ENABLED)
+  #ifdef BMC_SYSEX_STREAM_ENABLED
+      BMCSysExStream::instance() = &sysExStream;
+  #endif
+  #ifdef BMC_SYSEX_POOL_ENABLED
+      BMCSysExPool::instance() = &sysExPool;
+  #endif
+      usbMIDI.setHandleSystemExclusive(usbSysExChunk);
+  #ifdef BMC_USB_HOST_ENABLED
+      // only the first host device streams SysEx in chunks, the stream and
+      // pool have a single state for the host port
+      midiHost.Ports[0].setHandleSystemExclusive(hostSysExChunk);
+  #endif
 #endif
     BMC_PRINTLN("");
   }
+#ifdef BMC_SYSEX_POOL_ENABLED
+  bool hasSysExPoolMessage(){
+    return sysExPool.hasCompleted();
+  }
+  // the next SysEx message assembled by the pool, it's read like a message
+  // of any other port so the editor, sync modules and routing get it, the
+  // onMidiSysExAssembled callback gets every message and those larger than
+  // BMC_MIDI_SYSEX_SIZE only go to the callback, then the blocks go back
+  // to the pool
+  BMCMidiMessage readSysExPool(){
+    message.reset();
+    uint8_t port = sysExPool.takeCompleted();
+    if(port == BMC_SYSEX_POOL_NONE){
+      return message;
+    }
+    uint16_t length = sysExPool.getLength(port);
+    if(callback.midiSysExAssembled){
+      callback.midiSysExAssembled(port, length);
+    }
+    if(length <= BMC_MIDI_SYSEX_SIZE){
+      message.reset(port);
+      message.setStatus(BMC_MIDI_SYSTEM_EXCLUSIVE);
+      message.setSysExArrayLength(sysExPool.read(port, 0, message.getSysExArray(), length));
+      routing(message);
+    }
+    sysExPool.release(port);
+    return message;
+  }
+  BMCSysExPool& getSysExPool(){
+    return sysExPool;
+  }
+#endif
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  // SysEx messages starting with @prefix are passed to @handler as they arrive
+  bool addSysExStreamHandler(BMCSysExStreamHandler * handler, const uint8_t * prefix, uint8_t length){
+    return sysExStream.add(handler, prefix, length);
+  }
+#endif
   BMCMidiMessage read(){
     message.reset();
     if(usbMIDI.read()){
       message.reset(BMC_MIDI_PORT_USB_BIT);
+      message.setCable(usbMIDI.getCable());
       message.setStatus(usbMIDI.getType());
       if(message.isSystemRealTimeStatus()){
         if(!flags.read(BMC_FLAG_MIDI_REAL_TIME_BLOCK_INPUT)){
@@ -88,6 +149,20 @@ public:
       if(message.isSystemExclusive()){
         message.setData1(0);
         message.setData2(0);
+#ifdef BMC_SYSEX_STREAM_ENABLED
+        // the driver only has the last chunk, the stream already got all of it
+        if(sysExStream.wasChunked(BMC_MIDI_PORT_USB_BIT)){
+          message.setStatus(BMC_NONE);
+          return message;
+        }
+#endif
+#ifdef BMC_SYSEX_POOL_ENABLED
+        // the pool has it, see readSysExPool()
+        if(inSysExPool(message, BMC_MIDI_PORT_USB_BIT)){
+          message.setStatus(BMC_NONE);
+          return message;
+        }
+#endif
         if(usbMIDI.getSysExArrayLength() <= BMC_MIDI_SYSEX_SIZE){
           message.addSysEx(
             usbMIDI.getSysExArray(),
@@ -132,6 +207,15 @@ public:
   BMCMidiMessage readSerial(uint8_t port=0){
     message.reset();
     if(midiSerial.read(port, message, flags.read(BMC_FLAG_MIDI_REAL_TIME_BLOCK_INPUT))){
+#ifdef BMC_SYSEX_STREAM_ENABLED
+      feedSysEx(message);
+#endif
+#ifdef BMC_SYSEX_POOL_ENABLED
+      if(inSysExPool(message, port+1)){
+        message.reset();
+        return message;
+      }
+#endif
       routing(message);
       addToLocalData(message);
     }
@@ -143,6 +227,18 @@ public:
   BMCMidiMessage readHost(){
     message.reset();
     if(midiHost.read(message, flags.read(BMC_FLAG_MIDI_REAL_TIME_BLOCK_INPUT))){
+      bool chunked = false;
+#ifdef BMC_SYSEX_STREAM_ENABLED
+      chunked = message.isSystemExclusive() && message.getDevice()==0 &&
+                sysExStream.wasChunked(BMC_MIDI_PORT_HOST_BIT);
+#endif
+#ifdef BMC_SYSEX_POOL_ENABLED
+      chunked |= inSysExPool(message, BMC_MIDI_PORT_HOST_BIT);
+#endif
+      if(chunked){
+        message.reset();
+        return message;
+      }
       routing(message);
       addToLocalData(message);
     }
@@ -154,6 +250,15 @@ public:
   BMCMidiMessage readBle(){
     message.reset();
     if(midiBle.read(message, flags.read(BMC_FLAG_MIDI_REAL_TIME_BLOCK_INPUT))){
+#ifdef BMC_SYSEX_STREAM_ENABLED
+      feedSysEx(message);
+#endif
+#ifdef BMC_SYSEX_POOL_ENABLED
+      if(inSysExPool(message, BMC_MIDI_PORT_BLE_BIT)){
+        message.reset();
+        return message;
+      }
+#endif
       routing(message);
       addToLocalData(message);
     }
@@ -166,6 +271,11 @@ public:
     midiBle.disconnectBLE();
 #endif
   }
+#ifdef BMC_MIDI_BLE_ENABLED
+  BMCSerialBle& getSerialBle(){
+    return midiBle.getSerial();
+  }
+#endif
 
 #ifdef BMC_DEBUG
   void setDebugOut(bool t_debug){
@@ -189,9 +299,16 @@ public:
 #endif
 
   // *Routing*
+  // @t_port can also be a USB cable port, BMC_USB_CABLE_PORT(n), or a host
+  // device port, BMC_HOST_DEVICE_PORT(n), to route what's received on that
+  // cable or from that device
   void setRouting(uint8_t t_port, uint16_t t_data){
     midiRouting.assign(t_port, t_data);
   }
+  // the USB cable used when messages received by @t_port are routed to USB
+  void setRoutingCable(uint8_t t_port, uint8_t t_cable){
+    midiRouting.assignCable(t_port, t_cable);
+  }
 
   BMCMidiMessage getMessage(){
     return message;
@@ -266,20 +383,65 @@ public:
   void send_now(){
     usbMIDI.send_now();
     #ifdef BMC_USB_HOST_ENABLED
-      midiHost.Port.send_now();
+      for(uint8_t i = 0 ; i < BMC_USB_HOST_DEVICES ; i++){
+        if(midiHost.isConnected(i)){
+          midiHost.Ports[i].send_now();
+        }
+      }
     #endif
   }
+  // free bytes in the transmit buffer of a single port, @portBit is one of
+  // BMC_MIDI_PORT_*_BIT, ports without a hardware serial buffer return 255
+  uint8_t getTxSpace(uint8_t portBit){
+    int n = 255;
+    switch(portBit){
+      #ifdef BMC_MIDI_SERIAL_A_ENABLED
+        case BMC_MIDI_PORT_SERIAL_A_BIT: n = BMC_MIDI_SERIAL_IO_A.availableForWrite(); break;
+      #endif
+      #ifdef BMC_MIDI_SERIAL_B_ENABLED
+        case BMC_MIDI_PORT_SERIAL_B_BIT: n = BMC_MIDI_SERIAL_IO_B.availableForWrite(); break;
+      #endif
+      #ifdef BMC_MIDI_SERIAL_C_ENABLED
+        case BMC_MIDI_PORT_SERIAL_C_BIT: n = BMC_MIDI_SERIAL_IO_C.availableForWrite(); break;
+      #endif
+      #ifdef BMC_MIDI_SERIAL_D_ENABLED
+        case BMC_MIDI_PORT_SERIAL_D_BIT: n = BMC_MIDI_SERIAL_IO_D.availableForWrite(); break;
+      #endif
+    }
+    return (n > 255) ? 255 : (uint8_t) n;
+  }
+  // free bytes in the transmit buffer of a single port when it's empty, the
+  // Teensy serial ports keep one byte of their ring buffer free, ports
+  // without a hardware serial buffer return 255
+  uint8_t getTxIdleSpace(uint8_t portBit){
+    switch(portBit){
+      case BMC_MIDI_PORT_SERIAL_A_BIT:
+      case BMC_MIDI_PORT_SERIAL_B_BIT:
+      case BMC_MIDI_PORT_SERIAL_C_BIT:
+      case BMC_MIDI_PORT_SERIAL_D_BIT:
+        return BMC_MIDI_SERIAL_TX_BUFFER_SIZE - 1;
+    }
+    return 255;
+  }
   // Specific to USB HOST
-  uint16_t getHostDeviceVendorId(){
+  // bit mask of the devices connected to the host port
+  uint8_t getHostDevices(){
+    #ifdef BMC_USB_HOST_ENABLED
+      return midiHost.getConnected();
+    #else
+      return 0;
+    #endif
+  }
+  uint16_t getHostDeviceVendorId(uint8_t device=0){
     #ifdef BMC_USB_HOST_ENABLED
-      return midiHost.Port.idVendor();
+      return midiHost.getVendorId(device);
     #else
       return 0;
     #endif
   }
-  uint16_t getHostDeviceProductId(){
+  uint16_t getHostDeviceProductId(uint8_t device=0){
     #ifdef BMC_USB_HOST_ENABLED
-      return midiHost.Port.idProduct();
+      return midiHost.getProductId(device);
     #else
       return 0;
     #endif
@@ -362,13 +524,61 @@ public:
   bool matchSourceAndChannel(){
     return (channel==0 || (channel == message.getChannel()));
   }
+  // returns the port bits of @port, port presets, USB cable ports and
+  // host device ports are resolved to the ports they send to
   uint8_t getPortPreset(uint8_t port){
-    if(port>127){
-      return portPresets.preset[(port & 0x0F)];
+    port = getPresetPort(port);
+    if(BMC_IS_USB_CABLE_PORT(port)){
+      return BMC_USB;
+    } else if(BMC_IS_HOST_DEVICE_PORT(port)){
+      return BMC_HOST;
     }
     return port;
   }
+  // the USB cable to send to when sending to @port, @cable is used unless
+  // @port is a USB cable port or a port preset set to one
+  uint8_t getPortCable(uint8_t port, uint8_t cable=0){
+    port = getPresetPort(port);
+    if(BMC_IS_USB_CABLE_PORT(port)){
+      cable = port & 0x0F;
+    }
+    return (cable < BMC_USB_CABLES) ? cable : 0;
+  }
+#ifdef BMC_USB_HOST_ENABLED
+  // bit mask of the connected host devices to send to when sending to
+  // @port, all of them unless @port is a host device port
+  uint8_t getPortHostDevices(uint8_t port){
+    return midiHost.getDevices(getPresetPort(port));
+  }
+#endif
+  // true if @m was received by @port, USB cable ports and host device
+  // ports only match messages received on their cable or from their device
+  bool matchPort(uint8_t port, BMCMidiMessage& m){
+    if(!BMC_MATCH_PORT(m.getSource(), getPortPreset(port))){
+      return false;
+    }
+    port = getPresetPort(port);
+    if(BMC_IS_USB_CABLE_PORT(port)){
+      return (port & 0x0F) == m.getCable();
+    } else if(BMC_IS_HOST_DEVICE_PORT(port)){
+      return (port & 0x0F) == m.getDevice();
+    }
+    return true;
+  }
+  // the port a port preset is set to, other ports are returned as they are
+  uint8_t getPresetPort(uint8_t port){
+    return BMC_IS_PORT_PRESET(port) ? portPresets.preset[(port & 0x0F)] : port;
+  }
 private:
+#ifdef BMC_USB_HOST_ENABLED
+  // calls @send with each connected host device @port sends to, used by
+  // every send function so host device ports only reach their device
+  template <typename F> void sendToHostDevices(uint8_t port, F send){
+    if(isMidiHostPort(port) && globals.hostConnected()){
+      midiHost.forEachDevice(getPresetPort(port), send);
+    }
+  }
+#endif
   // port presets
   bmcStorePortPresets& portPresets;
   // flags
@@ -410,6 +620,53 @@ private:
 
   BMCMidiRouting midiRouting;
 
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  BMCSysExStream sysExStream;
+#endif
+#ifdef BMC_SYSEX_POOL_ENABLED
+  BMCSysExPool sysExPool;
+#endif
+#if defined(BMC_SYSEX_STREAM_ENABLED) || defined(BMC_SYSEX_POOL_ENABLED)
+  // USB and USB Host drivers pass SysEx in chunks as it arrives
+  static void usbSysExChunk(const uint8_t * data, uint16_t length, bool complete){
+    sysExChunk(BMC_MIDI_PORT_USB_BIT, data, length, complete);
+  }
+  static void hostSysExChunk(const uint8_t * data, uint16_t length, bool complete){
+    sysExChunk(BMC_MIDI_PORT_HOST_BIT, data, length, complete);
+  }
+  static void sysExChunk(uint8_t port, const uint8_t * data, uint16_t length, bool complete){
+  #ifdef BMC_SYSEX_STREAM_ENABLED
+    if(BMCSysExStream::instance()){
+      BMCSysExStream::instance()->feedChunk(port, data, length, complete);
+    }
+  #endif
+  #ifdef BMC_SYSEX_POOL_ENABLED
+    if(BMCSysExPool::instance()){
+      BMCSysExPool::instance()->feed(port, data, length);
+    }
+  #endif
+  }
+#endif
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  // Serial and BLE SysEx is only available once the MIDI library has all of it
+  void feedSysEx(BMCMidiMessage& m){
+    if(m.isSystemExclusive()){
+      uint8_t port = 0;
+      while(port < 7 && !bitRead(m.getPort(), port)){
+        port++;
+      }
+      sysExStream.feed(port, m.getSysEx(), m.size());
+    }
+  }
+#endif
+#ifdef BMC_SYSEX_POOL_ENABLED
+  // SysEx the pool has, complete or not, is read from the pool instead, if
+  // the pool dropped it the copy from the driver or MIDI library is used
+  bool inSysExPool(BMCMidiMessage& m, uint8_t port){
+    return m.isSystemExclusive() && m.getDevice()==0 && sysExPool.has(port);
+  }
+#endif
+
   bool isMidiUsbPort(uint8_t port){
     return BMCTools::isMidiUsbPort(getPortPreset(port));
   }
@@ -448,7 +705,8 @@ private:
 
   // *Routing*
   void routing(BMCMidiMessage& message){
-    uint8_t destinations = midiRouting.incoming(message);
+    uint8_t cable = 0;
+    uint8_t destinations = midiRouting.incoming(message, cable);
     if(destinations!=BMC_NONE){
       if(callback.midiPreRoute){
         // if the callback returns false we block the routing
@@ -456,7 +714,7 @@ private:
           return;
         }
       }
-      send(destinations, message);
+      send(destinations, message, cable);
     }
   }
 
@@ -22,6 +22,8 @@
 // flags
 #define BMC_ESP32_FLAG_CONNECTED 0
 #define BMC_ESP32_FLAG_RUNNING 1
+// the default MTU of 23 less 3 until the MTU exchange is supported
+#define BMC_ESP32_PACKET_SIZE 20
 
 // the following can overloaded on your config
 // nRF8001 REQ, chip select pin
@@ -119,6 +121,10 @@ public:
   uint8_t getPacketLength(){
     return midiCharacteristic.valueLength();
   }
+  // largest packet that can be sent
+  uint8_t getPacketSize(){
+    return BMC_ESP32_PACKET_SIZE;
+  }
   bool setValue(const unsigned char value[], unsigned char length){
     if(flags.read(BMC_ESP32_FLAG_CONNECTED)){
       return midiCharacteristic.setValue(value, length);
@@ -140,7 +146,7 @@ private:
   BLECharacteristic midiCharacteristic;
   BLEDescriptor descriptor;
   uint8_t packetLength = 0;
-  uint8_t packetData[20];
+  uint8_t packetData[BMC_ESP32_PACKET_SIZE];
   BMCFlags <uint8_t> flags;
   elapsedMillis nextCheckMillis;
 };
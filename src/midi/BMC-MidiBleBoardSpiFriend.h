@@ -28,6 +28,8 @@
 #include <Adafruit_BluefruitLE_SPI.h>
 #include <Adafruit_BLEGatt.h>
 
+// max length of the MIDI characteristic
+#define BMC_SPI_FRIEND_PACKET_SIZE 30
 // SPI Friend CS, chip select pin
 #ifndef BMC_BLE_SPI_PIN_CS
   #define BMC_BLE_SPI_PIN_CS 10
@@ -88,7 +90,7 @@ public:
       BMC_WARNING("BMCSpiFriend: Could not add MIDI Service");
       BMC_HALT();
     }
-    midiCharId = gatt.addCharacteristic(midiCharUUID, (0x02 | 0x04 | 0x08 | 0x10), 1, 30, BLE_DATATYPE_BYTEARRAY);
+    midiCharId = gatt.addCharacteristic(midiCharUUID, (0x02 | 0x04 | 0x08 | 0x10), 1, BMC_SPI_FRIEND_PACKET_SIZE, BLE_DATATYPE_BYTEARRAY);
     if(midiCharId == 0){
       BMC_WARNING("BMCSpiFriend: Could not add MIDI characteristic");
       BMC_HALT();
@@ -135,6 +137,10 @@ public:
   uint8_t getPacketLength(){
     return length;
   }
+  // largest packet that can be sent, the max length of the characteristic
+  uint8_t getPacketSize(){
+    return BMC_SPI_FRIEND_PACKET_SIZE;
+  }
   bool setValue(const unsigned char value[], unsigned char length){
     if(connected){
       return gatt.setChar(midiCharId, value, length);
@@ -153,17 +159,17 @@ private:
   bool connected = false;
   int length = 0;
   BMCEndlessTimer timer;
-  uint8_t buffer[30];
+  uint8_t buffer[BMC_SPI_FRIEND_PACKET_SIZE];
   uint8_t midiServiceId = 0;
   uint8_t midiCharId = 0;
   void clearBuffer(){
     length = 0;
-    memset(buffer,0,30);
+    memset(buffer,0,BMC_SPI_FRIEND_PACKET_SIZE);
   }
   void buildBuffer(){
     clearBuffer();
     while(ble.available()){
-      if(length>=30){
+      if(length>=BMC_SPI_FRIEND_PACKET_SIZE){
         break;
       }
       char c =  ble.read();
@@ -30,6 +30,8 @@
 // flags
 #define BMC_NRF8001_FLAG_CONNECTED 0
 #define BMC_NRF8001_FLAG_RUNNING 1
+// the nRF8001 doesn't negotiate the MTU, it's always 23 less 3
+#define BMC_NRF8001_PACKET_SIZE 20
 // the following can overloaded on your config
 // nRF8001 REQ, chip select pin
 #ifndef BMC_BLE_SPI_PIN_CS
@@ -50,7 +52,7 @@ public:
   BMCnRF8001():
     ble(BMC_BLE_SPI_PIN_CS, BMC_BLE_SPI_PIN_INT, BMC_BLE_SPI_PIN_RST)
     ,midiService("03B80E5A-EDE8-4B33-A751-6CE34EC4C700")
-    ,midiCharacteristic("7772E5DB-3868-4112-A1A9-F2669D106BF3", BLERead | BLEWrite | BLEWriteWithoutResponse | BLENotify, 20)
+    ,midiCharacteristic("7772E5DB-3868-4112-A1A9-F2669D106BF3", BLERead | BLEWrite | BLEWriteWithoutResponse | BLENotify, BMC_NRF8001_PACKET_SIZE)
     ,descriptor("2902", 0)
   {
     nextCheckMillis = 0;
@@ -108,6 +110,10 @@ public:
   uint8_t getPacketLength(){
     return midiCharacteristic.valueLength();
   }
+  // largest packet that can be sent
+  uint8_t getPacketSize(){
+    return BMC_NRF8001_PACKET_SIZE;
+  }
   bool setValue(const unsigned char value[], unsigned char length){
     if(flags.read(BMC_NRF8001_FLAG_CONNECTED)){
       return midiCharacteristic.setValue(value, length);
@@ -5,6 +5,17 @@
 
   Handles the Master and Slave Clock
   It uses the BpmCalculator for tap tempo and to calculate PPQ Clock ticks
+
+  As Master it also runs the transport, Start/Stop/Continue with Song
+  Position Pointer and MIDI Time Code (when compiled), and can swing the
+  outgoing clock.
+
+  Each master clock tick is due at a time computed from the last tempo
+  change instead of from the previous tick, that way a late loop delays
+  a single tick but doesn't push the rest of them back. Swing moves the
+  ticks of the second 16th note of each 8th note later and the ticks
+  of the first 16th note are spread over the extra time, the 8th notes
+  themselves don't move.
 */
 
 #ifndef BMC_MIDI_CLOCK_H
@@ -17,20 +28,40 @@
   #include "utility/BMC-ClickTrack.h"
 #endif
 
+#ifdef BMC_MTC_ENABLED
+  #include "midi/BMC-MidiTimeCode.h"
+#endif
+
 #define BMC_MIDI_CLOCK_FLAG_MASTER 0
 #define BMC_MIDI_CLOCK_FLAG_BEAT 1
 #define BMC_MIDI_CLOCK_FLAG_BPM_CHANGED 2
 #define BMC_MIDI_CLOCK_FLAG_ACTIVE 3
 #define BMC_MIDI_CLOCK_FLAG_EIGTH 4
+#define BMC_MIDI_CLOCK_FLAG_PLAYING 5
+#define BMC_MIDI_CLOCK_FLAG_ANCHORED 6
+
+// transport commands
+#define BMC_MIDI_CLOCK_TRANSPORT_START 0
+#define BMC_MIDI_CLOCK_TRANSPORT_STOP 1
+#define BMC_MIDI_CLOCK_TRANSPORT_CONTINUE 2
+#define BMC_MIDI_CLOCK_TRANSPORT_START_STOP 3
+#define BMC_MIDI_CLOCK_TRANSPORT_CONTINUE_STOP 4
+
+// swing is the percentage of an 8th note taken by it's first 16th note
+#define BMC_MIDI_CLOCK_SWING_MIN 50
+#define BMC_MIDI_CLOCK_SWING_MAX 75
 
 #define BMC_CLOCK_BPM_AVG 4
 #define BMC_MICROS_SECOND 0x3938700
 
 class BMCMidiClock {
 public:
-  BMCMidiClock(BMCMidi& t_midi):midi(t_midi){
+  BMCMidiClock(BMCMidi& t_midi):midi(t_midi)
+  #ifdef BMC_MTC_ENABLED
+    ,timeCode(t_midi)
+  #endif
+  {
     flags.reset();
-    masterTimer = 0;
     bpmCalc.begin();
   }
   void begin(){
@@ -47,6 +78,7 @@ public:
     // can be in better sync with the master that's sending the clock
     if(!isMaster() && isStartOrContinue){
       ticks = 0;
+      slaveTicks = 0;
       // this will reset the number of PPQNs in the BPM Calculator
       bpmCalc.startReceived();
     }
@@ -58,12 +90,19 @@ public:
       if(bpmSetTimer.complete()){
         assignBpm(tmpBpm);
       }
-      // check if the number of microseconds (based on the master bpm) has passed
-      if(masterTimer>=interval){
-        // reset the masterTimer
-        masterTimer -= interval;
+      #ifdef BMC_MTC_ENABLED
+        timeCode.update(midi.getListenerPorts());
+      #endif
+      // check if the tick (based on the master bpm and swing) is due
+      if(flags.read(BMC_MIDI_CLOCK_FLAG_ANCHORED) && (int32_t)(micros()-nextTick) >= 0){
         // send the Clock Message to the assigned port(s) 24 per quarter note
         midi.sendRealTime(midi.getListenerPorts(), BMC_MIDI_RT_CLOCK);
+        clockTicks++;
+        if(isPlaying()){
+          songTicks++;
+        }
+        pendingTicks++;
+        nextTick = anchor + getTickTime(clockTicks) - getTickTime(anchorTick);
         // increase the number of ticks
         ticks++;
         flags.write(BMC_MIDI_CLOCK_FLAG_EIGTH, (ticks==12));
@@ -89,6 +128,8 @@ public:
       }
       // the ticks variable is only used by the master clock
       ticks = 0;
+      slaveTicks++;
+      pendingTicks++;
       // the bmp calculator that a PPQN was received
       // if it retunrs tru then 24 ticks have been received
       if(bpmCalc.tickReceived()){
@@ -137,13 +178,121 @@ public:
 
   void setMaster(bool value){
     if(isMaster()!=value){
+      if(isPlaying()){
+        stop();
+      }
       flags.write(BMC_MIDI_CLOCK_FLAG_MASTER,value);
+      flags.off(BMC_MIDI_CLOCK_FLAG_ANCHORED);
       ticks = 0;
       bpm = 0;
-      interval = 0;
       setBpm(120);
     }
   }
+  // TRANSPORT, only works when on master clock
+  // sends Start and starts the song from the beginning
+  void start(){
+    if(!isMaster() || bpm == 0){
+      return;
+    }
+    songTicks = 0;
+    midi.sendRealTime(midi.getListenerPorts(), BMC_MIDI_RT_START);
+    play();
+  }
+  // sends Continue and plays from the current song position
+  void resume(){
+    if(!isMaster() || isPlaying() || bpm == 0){
+      return;
+    }
+    midi.sendRealTime(midi.getListenerPorts(), BMC_MIDI_RT_CONTINUE);
+    play();
+  }
+  void stop(){
+    if(!isMaster() || !isPlaying()){
+      return;
+    }
+    midi.sendRealTime(midi.getListenerPorts(), BMC_MIDI_RT_STOP);
+    flags.off(BMC_MIDI_CLOCK_FLAG_PLAYING);
+    #ifdef BMC_MTC_ENABLED
+      timeCode.stop();
+    #endif
+  }
+  void transport(uint8_t command){
+    switch(command){
+      case BMC_MIDI_CLOCK_TRANSPORT_START: start(); break;
+      case BMC_MIDI_CLOCK_TRANSPORT_STOP: stop(); break;
+      case BMC_MIDI_CLOCK_TRANSPORT_CONTINUE: resume(); break;
+      case BMC_MIDI_CLOCK_TRANSPORT_START_STOP:
+        isPlaying() ? stop() : start();
+        break;
+      case BMC_MIDI_CLOCK_TRANSPORT_CONTINUE_STOP:
+        isPlaying() ? stop() : resume();
+        break;
+    }
+  }
+  bool isPlaying(){
+    return flags.read(BMC_MIDI_CLOCK_FLAG_PLAYING);
+  }
+  // moves the song to @position (in 16th notes), the Song Position Pointer
+  // is sent while stopped so if playing the song is stopped and continued
+  void setSongPosition(uint16_t position){
+    if(!isMaster()){
+      return;
+    }
+    bool playing = isPlaying();
+    stop();
+    position = (position > 0x3FFF) ? 0x3FFF : position;
+    songTicks = (uint32_t) position * 6;
+    midi.sendSongPosition(midi.getListenerPorts(), position);
+    if(playing){
+      resume();
+    }
+  }
+  // ticks sent or received since the last time this was called,
+  // used by modules that follow the clock
+  uint8_t takeTicks(){
+    uint8_t value = pendingTicks;
+    pendingTicks = 0;
+    return value;
+  }
+  // the position used to line things up with the clock, as master it's the
+  // ticks since the song started, or since the clock started if stopped, as
+  // slave it's the ticks received since the last Start or Continue
+  uint32_t getSongTicks(){
+    if(isMaster()){
+      return isPlaying() ? songTicks : clockTicks;
+    }
+    return slaveTicks;
+  }
+  // song position in 16th notes
+  uint16_t getSongPosition(){
+    uint32_t position = songTicks / 6;
+    return (position > 0x3FFF) ? 0x3FFF : position;
+  }
+  // 50 is straight, 66 is triplet swing, up to 75
+  void setSwing(uint8_t value){
+    value = constrain(value, BMC_MIDI_CLOCK_SWING_MIN, BMC_MIDI_CLOCK_SWING_MAX);
+    if(value != swing){
+      swing = value;
+      if(flags.read(BMC_MIDI_CLOCK_FLAG_ANCHORED)){
+        // the tick already scheduled keeps it's time
+        reanchor();
+      }
+    }
+  }
+  uint8_t getSwing(){
+    return swing;
+  }
+  #ifdef BMC_MTC_ENABLED
+    void setTimeCodeRate(uint8_t fps){
+      timeCode.setRate(fps);
+    }
+    uint8_t getTimeCodeRate(){
+      return timeCode.getRate();
+    }
+    BMCMidiTimeCode& getTimeCode(){
+      return timeCode;
+    }
+  #endif
   void setBpm(uint16_t tempo=0){
     if(isMaster() && bpmCalc.isValidBpm(tempo)){
       tmpBpm = tempo;
@@ -244,12 +393,25 @@ private:
   uint8_t ticks = 0;
   uint16_t bpm = 120;
   uint16_t tmpBpm = 0;
-  unsigned long interval = 0;
+  uint8_t swing = BMC_MIDI_CLOCK_SWING_MIN;
+  // master ticks sent, the swing is based on this count
+  uint32_t clockTicks = 0;
+  // ticks since the start of the song, 6 per Song Position
+  uint32_t songTicks = 0;
+  // ticks received since the last Start or Continue
+  uint32_t slaveTicks = 0;
+  uint8_t pendingTicks = 0;
+  // time at which the tick @anchorTick was due
+  unsigned long anchor = 0;
+  uint32_t anchorTick = 0;
+  unsigned long nextTick = 0;
   #ifdef BMC_USE_CLICK_TRACK
     BMCClickTrack clickTrack;
   #endif
+  #ifdef BMC_MTC_ENABLED
+    BMCMidiTimeCode timeCode;
+  #endif
   BMCFlags <uint8_t> flags;
-  elapsedMicros masterTimer;
   BMCBpmCalculator bpmCalc;
   BMCTimer bpmSetTimer;
   BMCTimer timeout;
@@ -259,10 +421,51 @@ private:
         flags.on(BMC_MIDI_CLOCK_FLAG_BPM_CHANGED);
       }
       BMC_PRINTLN("BMCMidiClock::assignBpm",tempo);
-      bpm = tempo;
-      interval = BMCBpmCalculator::bpmToMicrosPPQN(tempo);
-      masterTimer = 0;
+      if(flags.read(BMC_MIDI_CLOCK_FLAG_ANCHORED)){
+        // the tick already scheduled keeps the time set by the old bpm
+        reanchor();
+        bpm = tempo;
+      } else {
+        bpm = tempo;
+        anchor = micros();
+        anchorTick = clockTicks;
+        nextTick = anchor;
+        flags.on(BMC_MIDI_CLOCK_FLAG_ANCHORED);
+      }
     }
   }
+  // microseconds from the start of the count to tick @n with swing
+  uint64_t getTickTime(uint32_t n){
+    // an 8th note is 12 ticks, 30,000,000 / bpm microseconds
+    uint64_t eighth = 30000000ULL;
+    uint64_t t = (uint64_t)(n / 12) * eighth;
+    uint8_t k = n % 12;
+    if(k <= 6){
+      t += (eighth * swing * k) / 600;
+    } else {
+      t += ((eighth * swing) / 100) + ((eighth * (100 - swing) * (k - 6)) / 600);
+    }
+    return t / bpm;
+  }
+  // counts from the next tick so timing changes don't move it
+  void reanchor(){
+    anchor = nextTick;
+    anchorTick = clockTicks;
+  }
+  void play(){
+    // ticks count from the song position so beats and swing line up with it
+    clockTicks = songTicks;
+    // the beat is flagged when the first tick of a quarter note is sent
+    ticks = (songTicks + 23) % 24;
+    anchor = micros();
+    anchorTick = clockTicks;
+    nextTick = anchor;
+    flags.on(BMC_MIDI_CLOCK_FLAG_ANCHORED);
+    flags.on(BMC_MIDI_CLOCK_FLAG_PLAYING);
+    #ifdef BMC_MTC_ENABLED
+      // position in milliseconds at the current tempo
+      timeCode.start(midi.getListenerPorts(), ((uint64_t) songTicks * 2500) / bpm);
+    #endif
+  }
 };
 #endif
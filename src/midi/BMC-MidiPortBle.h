@@ -12,6 +12,7 @@
 #ifdef BMC_MIDI_BLE_ENABLED
 #include "midi/BMC-SerialBle.h"
 #include <MIDI.h>
+#include "midi/BMC-MidiTransport.h"
 
 struct midiSerialBleSettings : public midi::DefaultSettings {
   static const unsigned SysExMaxSize = BMC_MIDI_SYSEX_SIZE;
@@ -21,8 +22,8 @@ class BMCMidiPortBle {
 public:
 
   BMCSerialBle SerialBle;
-  midi::SerialMIDI<BMCSerialBle> serialPort;
-  midi::MidiInterface<midi::SerialMIDI<BMCSerialBle>, midiSerialBleSettings> Port;
+  bmcSerialMIDI<BMCSerialBle, BMC_MIDI_PORT_BLE_BIT> serialPort;
+  midi::MidiInterface<bmcSerialMIDI<BMCSerialBle, BMC_MIDI_PORT_BLE_BIT>, midiSerialBleSettings> Port;
 
   BMCMidiPortBle(BMCCallbacks& cb, BMCGlobals& t_globals):
     SerialBle(t_globals),
@@ -74,6 +75,9 @@ public:
   void disconnectBLE(){
     SerialBle.disconnectBLE();
   }
+  BMCSerialBle& getSerial(){
+    return SerialBle;
+  }
 private:
   BMCCallbacks& callback;
   BMCGlobals& globals;
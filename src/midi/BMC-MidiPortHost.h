@@ -14,63 +14,160 @@
 
 #include <USBHost_t36.h>
 
+#if BMC_USE_USB_MIDI_BIG_BUFFER
+  typedef MIDIDevice_BigBuffer BMCHostMidiDevice;
+#else
+  typedef MIDIDevice BMCHostMidiDevice;
+#endif
+
+// the USB Host driver objects can't be default constructed, this builds
+// the list of constructor arguments for an array of @n of them
+#define BMC_HOST_ARGS_1 UsbHost
+#define BMC_HOST_ARGS_2 BMC_HOST_ARGS_1, UsbHost
+#define BMC_HOST_ARGS_3 BMC_HOST_ARGS_2, UsbHost
+#define BMC_HOST_ARGS_4 BMC_HOST_ARGS_3, UsbHost
+#define BMC_HOST_ARGS_5 BMC_HOST_ARGS_4, UsbHost
+#define BMC_HOST_ARGS_6 BMC_HOST_ARGS_5, UsbHost
+#define BMC_HOST_ARGS_7 BMC_HOST_ARGS_6, UsbHost
+#define BMC_HOST_ARGS_8 BMC_HOST_ARGS_7, UsbHost
+#define BMC_HOST_ARGS_EXPAND(n) BMC_HOST_ARGS_##n
+#define BMC_HOST_ARGS(n) BMC_HOST_ARGS_EXPAND(n)
+
+// Each MIDI device attached to the host port, directly or thru a hub, is
+// claimed by one of the BMC_USB_HOST_DEVICES device objects, the index of
+// that object is the device number used by BMC_HOST_DEVICE_PORT(n)
 class BMCMidiPortHost {
 public:
-  #if BMC_USE_USB_MIDI_BIG_BUFFER
-    MIDIDevice_BigBuffer Port;
-  #else
-    MIDIDevice Port;
-  #endif
+  BMCHostMidiDevice Ports[BMC_USB_HOST_DEVICES];
   BMCMidiPortHost(BMCCallbacks& cb, BMCGlobals& t_globals):
-    Port(UsbHost),
+    Ports{BMC_HOST_ARGS(BMC_USB_HOST_DEVICES)},
+#if BMC_USB_HOST_HUBS > 0
+    hubs{BMC_HOST_ARGS(BMC_USB_HOST_HUBS)},
+#endif
     callback(cb),
     globals(t_globals){
-
+    for(uint8_t i = 0 ; i < BMC_USB_HOST_DEVICES ; i++){
+      devices[i].vendorId = 0;
+      devices[i].productId = 0;
+    }
   }
   void begin(){
     BMC_PRINTLN("    BMCMidiPortHost::begin");
     UsbHost.begin();
     delay(200);
   }
+  // reads one message, each call starts with the device after the one that
+  // was read last so a device sending a lot doesn't hold back the others
   bool read(BMCMidiMessage& message, bool ignoreRealTime){
     UsbHost.Task();
-    if((Port) != globals.hostConnected()){
-      globals.setHostConnected((Port==true));
-      if(callback.hostConnection){
-        callback.hostConnection(globals.hostConnected());
-      }
+    updateDevices();
+    if(connected == 0){
+      return false;
     }
-    if(Port && Port.read()){
-      message.reset(BMC_MIDI_PORT_HOST_BIT);
-      message.setStatus(Port.getType());
-      if(message.isSystemRealTimeStatus()){
-        if(ignoreRealTime){
-          message.reset();
-          return false;
-        }
-        return true;
+    for(uint8_t n = 0 ; n < BMC_USB_HOST_DEVICES ; n++){
+      uint8_t i = nextRead;
+      nextRead = (nextRead+1 < BMC_USB_HOST_DEVICES) ? nextRead+1 : 0;
+      if(bitRead(connected, i) && Ports[i].read()){
+        return readDevice(i, message, ignoreRealTime);
       }
-      message.setData1(Port.getData1());
-      message.setData2(Port.getData2());
-      if(message.isSystemExclusive()){
-        message.setData1(0);
-        message.setData2(0);
-        if(Port.getSysExArrayLength() <= BMC_MIDI_SYSEX_SIZE){
-          message.addSysEx(Port.getSysExArray(),Port.getSysExArrayLength());
-        } else {
-          message.setStatus(BMC_NONE);
-        }
-      } else if(message.isChannelStatus()){
-        message.setChannel(Port.getChannel());
-      }
-      return true;
     }
     return false;
   }
+  // bit mask of the connected devices
+  uint8_t getConnected(){
+    return connected;
+  }
+  bool isConnected(uint8_t n){
+    return n < BMC_USB_HOST_DEVICES && bitRead(connected, n);
+  }
+  // bit mask of the connected devices @port sends to, all of them unless
+  // @port is a host device port, a port preset must be resolved first
+  uint8_t getDevices(uint8_t port){
+    if(BMC_IS_HOST_DEVICE_PORT(port)){
+      return connected & (1 << (port & 0x07));
+    }
+    return connected;
+  }
+  // calls @send with each connected device @port sends to
+  template <typename F> void forEachDevice(uint8_t port, F send){
+    uint8_t mask = getDevices(port);
+    for(uint8_t i = 0 ; mask > 0 ; i++, mask >>= 1){
+      if(mask & 0x01){
+        send(Ports[i]);
+      }
+    }
+  }
+  uint16_t getVendorId(uint8_t n){
+    return isConnected(n) ? devices[n].vendorId : 0;
+  }
+  uint16_t getProductId(uint8_t n){
+    return isConnected(n) ? devices[n].productId : 0;
+  }
 private:
+  struct bmcHostDevice {
+    uint16_t vendorId;
+    uint16_t productId;
+  };
+#if BMC_USB_HOST_HUBS > 0
+  USBHub hubs[BMC_USB_HOST_HUBS];
+#endif
   BMCCallbacks& callback;
   BMCGlobals& globals;
   USBHost UsbHost;
+  bmcHostDevice devices[BMC_USB_HOST_DEVICES];
+  uint8_t connected = 0;
+  uint8_t nextRead = 0;
+
+  // devices can be plugged and unplugged at any time, the device table
+  // is updated when a device object claims or releases a device
+  void updateDevices(){
+    for(uint8_t i = 0 ; i < BMC_USB_HOST_DEVICES ; i++){
+      bool state = Ports[i];
+      if(state == bitRead(connected, i)){
+        continue;
+      }
+      bitWrite(connected, i, state);
+      devices[i].vendorId = state ? Ports[i].idVendor() : 0;
+      devices[i].productId = state ? Ports[i].idProduct() : 0;
+      BMC_PRINTLN("USB Host Device", i, state ? "connected" : "disconnected", devices[i].vendorId, devices[i].productId);
+      if(callback.hostDeviceConnection){
+        callback.hostDeviceConnection(i, state);
+      }
+    }
+    if((connected > 0) != globals.hostConnected()){
+      globals.setHostConnected(connected > 0);
+      if(callback.hostConnection){
+        callback.hostConnection(globals.hostConnected());
+      }
+    }
+  }
+  bool readDevice(uint8_t n, BMCMidiMessage& message, bool ignoreRealTime){
+    BMCHostMidiDevice& Port = Ports[n];
+    message.reset(BMC_MIDI_PORT_HOST_BIT);
+    message.setDevice(n);
+    message.setStatus(Port.getType());
+    if(message.isSystemRealTimeStatus()){
+      if(ignoreRealTime){
+        message.reset();
+        return false;
+      }
+      return true;
+    }
+    message.setData1(Port.getData1());
+    message.setData2(Port.getData2());
+    if(message.isSystemExclusive()){
+      message.setData1(0);
+      message.setData2(0);
+      if(Port.getSysExArrayLength() <= BMC_MIDI_SYSEX_SIZE){
+        message.addSysEx(Port.getSysExArray(),Port.getSysExArrayLength());
+      } else {
+        message.setStatus(BMC_NONE);
+      }
+    } else if(message.isChannelStatus()){
+      message.setChannel(Port.getChannel());
+    }
+    return true;
+  }
 };
 
 #endif
@@ -13,6 +13,7 @@
 
 #include "HardwareSerial.h"
 #include <MIDI.h>
+#include "midi/BMC-MidiTransport.h"
 
 struct midiSerialSettings : public midi::DefaultSettings {
    static const unsigned SysExMaxSize = BMC_MIDI_SYSEX_SIZE;
@@ -29,8 +30,8 @@ struct midiSerialSettings : public midi::DefaultSettings {
 template <uint8_t SerBit>
 class BMCMidiPortSerialAWrapper {
 public:
-  midi::SerialMIDI<HardwareSerial> serialPort;
-  midi::MidiInterface<midi::SerialMIDI<HardwareSerial>, midiSerialSettings> Port;
+  bmcSerialMIDI<HardwareSerial, SerBit> serialPort;
+  midi::MidiInterface<bmcSerialMIDI<HardwareSerial, SerBit>, midiSerialSettings> Port;
   BMCMidiPortSerialAWrapper():serialPort(BMC_MIDI_SERIAL_IO_A),Port(serialPort){}
 
   void begin(uint8_t channel=MIDI_CHANNEL_OMNI){
@@ -72,8 +73,8 @@ public:
 template <uint8_t SerBit>
 class BMCMidiPortSerialBWrapper {
 public:
-  midi::SerialMIDI<HardwareSerial> serialPort;
-  midi::MidiInterface<midi::SerialMIDI<HardwareSerial>, midiSerialSettings> Port;
+  bmcSerialMIDI<HardwareSerial, SerBit> serialPort;
+  midi::MidiInterface<bmcSerialMIDI<HardwareSerial, SerBit>, midiSerialSettings> Port;
   BMCMidiPortSerialBWrapper():serialPort(BMC_MIDI_SERIAL_IO_B), Port(serialPort){}
   void begin(uint8_t channel=MIDI_CHANNEL_OMNI){
     Port.begin(channel);
@@ -114,8 +115,8 @@ public:
 template <uint8_t SerBit>
 class BMCMidiPortSerialCWrapper {
 public:
-  midi::SerialMIDI<HardwareSerial> serialPort;
-  midi::MidiInterface<midi::SerialMIDI<HardwareSerial>, midiSerialSettings> Port;
+  bmcSerialMIDI<HardwareSerial, SerBit> serialPort;
+  midi::MidiInterface<bmcSerialMIDI<HardwareSerial, SerBit>, midiSerialSettings> Port;
   BMCMidiPortSerialCWrapper():serialPort(BMC_MIDI_SERIAL_IO_C), Port(serialPort){}
   void begin(uint8_t channel=MIDI_CHANNEL_OMNI){
     Port.begin(channel);
@@ -156,8 +157,8 @@ public:
 template <uint8_t SerBit>
 class BMCMidiPortSerialDWrapper {
 public:
-  midi::SerialMIDI<HardwareSerial> serialPort;
-  midi::MidiInterface<midi::SerialMIDI<HardwareSerial>, midiSerialSettings> Port;
+  bmcSerialMIDI<HardwareSerial, SerBit> serialPort;
+  midi::MidiInterface<bmcSerialMIDI<HardwareSerial, SerBit>, midiSerialSettings> Port;
   BMCMidiPortSerialDWrapper():serialPort(BMC_MIDI_SERIAL_IO_D), Port(serialPort){}
   void begin(uint8_t channel=MIDI_CHANNEL_OMNI){
     Port.begin(channel);
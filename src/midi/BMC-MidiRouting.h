@@ -15,86 +15,92 @@
 class BMCMidiRouting {
 public:
   BMCMidiRouting(){
+    // routing back to USB uses the cable the message came from by default
+    for(uint8_t i = 0 ; i < BMC_USB_CABLES ; i++){
+      routing.usb[i].cable = i;
+    }
   }
   void begin(){
     BMC_PRINTLN("BMCMidiRouting::begin");
   }
   void assign(uint8_t t_port, uint16_t t_data){
-    switch(t_port){
-      case BMC_USB: routing.usb.setData(t_data); break;
-
-#ifdef BMC_MIDI_SERIAL_A_ENABLED
-      case BMC_SERIAL_A: routing.serialA.setData(t_data); break;
-#endif
-
-#ifdef BMC_MIDI_SERIAL_B_ENABLED
-      case BMC_SERIAL_B: routing.serialB.setData(t_data); break;
-#endif
-
-#ifdef BMC_MIDI_SERIAL_C_ENABLED
-      case BMC_SERIAL_C: routing.serialC.setData(t_data); break;
-#endif
-
-#ifdef BMC_MIDI_SERIAL_D_ENABLED
-      case BMC_SERIAL_D: routing.serialD.setData(t_data); break;
-#endif
-
-#ifdef BMC_USB_HOST_ENABLED
-      case BMC_HOST: routing.host.setData(t_data); break;
-#endif
-
-#ifdef BMC_MIDI_BLE_ENABLED
-      case BMC_BLE: routing.ble.setData(t_data); break;
-#endif
+    BMCRoutingItem * item = getItem(t_port);
+    if(item != nullptr){
+      item->setData(t_data);
     }
   }
-
-  uint8_t incoming(BMCMidiMessage m){
+  // the USB cable used when messages received by @t_port are routed to USB
+  void assignCable(uint8_t t_port, uint8_t t_cable){
+    BMCRoutingItem * item = getItem(t_port);
+    if(item != nullptr && t_cable < BMC_USB_CABLES){
+      item->cable = t_cable;
+    }
+  }
+  // returns the ports @m is routed to, @cable is set to the USB cable to use
+  uint8_t incoming(BMCMidiMessage& m, uint8_t& cable){
     if(m.getStatus()==BMC_NONE){
       return BMC_NONE;
     }
-    BMCRoutingItem item;
-    switch(m.getSource()){
-      case BMC_USB: item = routing.usb; break;
+    BMCRoutingItem * item = nullptr;
+    if(m.getSource() == BMC_USB){
+      item = getItem(BMC_USB_CABLE_PORT(m.getCable()));
+    } else if(m.getSource() == BMC_HOST){
+      item = getItem(BMC_HOST_DEVICE_PORT(m.getDevice()));
+    } else {
+      item = getItem(m.getSource());
+    }
+    if(item != nullptr && item->hasDestination()){
+      if(processFilter(m, *item)){
+        cable = item->cable;
+        return item->destinations;
+      }
+    }
+    return BMC_NONE;
+  }
+
+private:
+  BMCRoutingData routing;
+  BMCRoutingItem * getItem(uint8_t t_port){
+    if(BMC_IS_USB_CABLE_PORT(t_port)){
+      uint8_t n = t_port & 0x0F;
+      return (n < BMC_USB_CABLES) ? &routing.usb[n] : nullptr;
+    }
+#ifdef BMC_USB_HOST_ENABLED
+    if(BMC_IS_HOST_DEVICE_PORT(t_port)){
+      uint8_t n = t_port & 0x0F;
+      return (n < BMC_USB_HOST_DEVICES) ? &routing.host[n] : nullptr;
+    }
+#endif
+    switch(t_port){
+      case BMC_USB: return &routing.usb[0];
 
 #ifdef BMC_MIDI_SERIAL_A_ENABLED
-      case BMC_SERIAL_A: item = routing.serialA; break;
+      case BMC_SERIAL_A: return &routing.serialA;
 #endif
 
 #ifdef BMC_MIDI_SERIAL_B_ENABLED
-      case BMC_SERIAL_B: item = routing.serialB; break;
+      case BMC_SERIAL_B: return &routing.serialB;
 #endif
 
 #ifdef BMC_MIDI_SERIAL_C_ENABLED
-      case BMC_SERIAL_C: item = routing.serialC; break;
+      case BMC_SERIAL_C: return &routing.serialC;
 #endif
 
 #ifdef BMC_MIDI_SERIAL_D_ENABLED
-      case BMC_SERIAL_D: item = routing.serialD; break;
+      case BMC_SERIAL_D: return &routing.serialD;
 #endif
 
 #ifdef BMC_USB_HOST_ENABLED
-      case BMC_HOST: item = routing.host; break;
+      case BMC_HOST: return &routing.host[0];
 #endif
 
 #ifdef BMC_MIDI_BLE_ENABLED
-      case BMC_BLE: item = routing.ble; break;
+      case BMC_BLE: return &routing.ble;
 #endif
-      default:
-        return BMC_NONE;
-    }
-
-    if(item.hasDestination()){
-      if(processFilter(m, item)){
-        return item.destinations;
-      }
     }
-    return BMC_NONE;
+    return nullptr;
   }
-
-private:
-  BMCRoutingData routing;
-  bool processFilter(BMCMidiMessage m, BMCRoutingItem item){
+  bool processFilter(BMCMidiMessage& m, BMCRoutingItem& item){
     // filter bits
     // 0 - voice messages (cc, pc, note etc.)
     // 1 - system exclusive
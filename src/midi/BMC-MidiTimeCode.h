@@ -0,0 +1,135 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  MIDI Time Code generator used by the master clock transport.
+
+  Quarter frames are sent 4 per frame, the 8 pieces of a sequence carry the
+  time of the frame the sequence started on, sequences always start on an
+  even frame.
+
+  Each quarter frame is due at a time computed from the moment the transport
+  started instead of from the previous quarter frame so a late loop doesn't
+  push every following quarter frame back.
+
+  A Full Frame message is sent when the transport starts or moves so
+  receivers jump to the new time right away.
+*/
+#ifndef BMC_MIDI_TIME_CODE_H
+#define BMC_MIDI_TIME_CODE_H
+
+#include "utility/BMC-Def.h"
+#include "midi/BMC-Midi.h"
+
+#ifdef BMC_MTC_ENABLED
+
+class BMCMidiTimeCode {
+public:
+  BMCMidiTimeCode(BMCMidi& t_midi):midi(t_midi){
+    setRate(BMC_MTC_FPS);
+  }
+  // 24, 25 or 30 frames per second
+  void setRate(uint8_t t_fps){
+    if(t_fps == 24 || t_fps == 25 || t_fps == 30){
+      fps = t_fps;
+    }
+  }
+  uint8_t getRate(){
+    return fps;
+  }
+  // starts sending quarter frames from @ms milliseconds into the song
+  void start(uint8_t ports, uint32_t ms){
+    uint32_t frames = ((uint64_t) ms * fps) / 1000;
+    // sequences start on even frames
+    frames &= ~1UL;
+    qf = frames * 4;
+    anchorQf = qf;
+    // how far into the frame the song is, so the first quarter frame is
+    // sent when that frame would have started
+    uint32_t frameUs = ((uint64_t) frames * 1000000UL) / fps;
+    anchor = micros() - ((uint64_t) ms * 1000 - frameUs);
+    running = true;
+    sendFullFrame(ports, frames);
+  }
+  void stop(){
+    running = false;
+  }
+  bool isRunning(){
+    return running;
+  }
+  // sends the next quarter frame if it's due, returns true if it was sent
+  bool update(uint8_t ports){
+    if(!running || (int32_t)(micros() - getDue()) < 0){
+      return false;
+    }
+    uint8_t piece = qf & 0x07;
+    if(piece == 0){
+      latched = qf / 4;
+    }
+    midi.sendTimeCodeQuarterFrame(ports, piece, getPiece(piece));
+    qf++;
+    return true;
+  }
+  // frames since the start of the song of the last sequence sent
+  uint32_t getFrames(){
+    return latched;
+  }
+  uint8_t getHours(uint32_t frames){
+    return (frames / ((uint32_t) fps * 3600)) % 24;
+  }
+  uint8_t getMinutes(uint32_t frames){
+    return (frames / ((uint32_t) fps * 60)) % 60;
+  }
+  uint8_t getSeconds(uint32_t frames){
+    return (frames / fps) % 60;
+  }
+  uint8_t getFrame(uint32_t frames){
+    return frames % fps;
+  }
+private:
+  BMCMidi& midi;
+  uint8_t fps = 30;
+  bool running = false;
+  // quarter frames since the start of the song
+  uint32_t qf = 0;
+  uint32_t anchorQf = 0;
+  uint32_t latched = 0;
+  unsigned long anchor = 0;
+
+  unsigned long getDue(){
+    return anchor + (uint32_t)(((uint64_t)(qf - anchorQf) * 1000000UL) / (fps * 4));
+  }
+  // rate code in the hours byte, 0 = 24fps, 1 = 25fps, 3 = 30fps non-drop
+  uint8_t getRateCode(){
+    return (fps == 24) ? 0 : (fps == 25) ? 1 : 3;
+  }
+  uint8_t getPiece(uint8_t piece){
+    switch(piece){
+      case 0: return getFrame(latched) & 0x0F;
+      case 1: return getFrame(latched) >> 4;
+      case 2: return getSeconds(latched) & 0x0F;
+      case 3: return getSeconds(latched) >> 4;
+      case 4: return getMinutes(latched) & 0x0F;
+      case 5: return getMinutes(latched) >> 4;
+      case 6: return getHours(latched) & 0x0F;
+    }
+    return (getHours(latched) >> 4) | (getRateCode() << 1);
+  }
+  void sendFullFrame(uint8_t ports, uint32_t frames){
+    latched = frames;
+    uint8_t buff[10] = {
+      0xF0, 0x7F, 0x7F, 0x01, 0x01,
+      (uint8_t) ((getRateCode() << 5) | getHours(frames)),
+      getMinutes(frames),
+      getSeconds(frames),
+      getFrame(frames),
+      0xF7
+    };
+    midi.sendSysEx(ports, buff, 10, true);
+  }
+};
+
+#endif
+#endif
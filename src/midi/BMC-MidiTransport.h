@@ -0,0 +1,46 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  The transport the MIDI library reads Serial and BLE ports with.
+
+  With the SysEx pool enabled every byte the library reads is also fed to
+  the pool, that way SysEx is assembled as it arrives and isn't limited to
+  what fits in the library's own buffer, see BMC-SysExPool.h
+*/
+#ifndef BMC_MIDI_TRANSPORT_H
+#define BMC_MIDI_TRANSPORT_H
+
+#include "utility/BMC-Def.h"
+#include <MIDI.h>
+
+#if defined(BMC_SYSEX_POOL_ENABLED)
+#include "midi/BMC-SysExPool.h"
+
+// @Port is one of BMC_MIDI_PORT_*_BIT
+template <class SerialPort, uint8_t Port>
+class BMCSysExPoolTransport : public midi::SerialMIDI<SerialPort> {
+public:
+  BMCSysExPoolTransport(SerialPort& t_serial):
+    midi::SerialMIDI<SerialPort>(t_serial){
+  }
+  byte read(){
+    byte value = midi::SerialMIDI<SerialPort>::read();
+    if(BMCSysExPool::instance()){
+      BMCSysExPool::instance()->feed(Port, &value, 1);
+    }
+    return value;
+  }
+};
+template <class SerialPort, uint8_t Port>
+using bmcSerialMIDI = BMCSysExPoolTransport<SerialPort, Port>;
+
+#else
+
+template <class SerialPort, uint8_t Port>
+using bmcSerialMIDI = midi::SerialMIDI<SerialPort>;
+
+#endif
+#endif
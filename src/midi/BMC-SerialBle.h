@@ -26,31 +26,46 @@
 #if BMC_MIDI_BLE_BOARD == 0
   // nRF8001
   #include "midi/BMC-MidiBleBoardnRF8001.h"
-  #define BMC_BLE_MIDI_TX_BUFFER_SIZE 20
   #define BMC_BLE_PACKET_TX_INTERVAL 20
-  #define BMC_BLE_PACKET_RESEND_TX_INTERVAL 10
   #define BMC_BLE_MAX_PACKETS 2
 
 #elif BMC_MIDI_BLE_BOARD == 1
   // ESP32
   #include "midi/BMC-BMC-MidiBleBoardEsp32.h"
-  #define BMC_BLE_MIDI_TX_BUFFER_SIZE 20
   #define BMC_BLE_PACKET_TX_INTERVAL 20
-  #define BMC_BLE_PACKET_RESEND_TX_INTERVAL 10
   #define BMC_BLE_MAX_PACKETS 2
 #elif BMC_MIDI_BLE_BOARD == 2
   // ADAFRUIT BLUEFRUIT LE SPI FRIEND
   #include "midi/BMC-MidiBleBoardSpiFriend.h"
-  #define BMC_BLE_MIDI_TX_BUFFER_SIZE 30
   #define BMC_BLE_PACKET_TX_INTERVAL 1
-  #define BMC_BLE_PACKET_RESEND_TX_INTERVAL 10
   #define BMC_BLE_MAX_PACKETS 4
 #else
   #error "Invalid BLE Board defined"
 #endif
 
-#include "utility/QueueArray.h"
+#include "utility/BMC-RingBuffer.h"
 
+// the largest packet, an ATT MTU of 247 less 3, each board reports the packet
+// size it negotiated and packets are never larger than that
+#if !defined(BMC_BLE_MIDI_TX_BUFFER_SIZE)
+  #define BMC_BLE_MIDI_TX_BUFFER_SIZE 244
+#endif
+static_assert(BMC_BLE_MIDI_TX_BUFFER_SIZE >= 20 && BMC_BLE_MIDI_TX_BUFFER_SIZE <= 244, "BMC_BLE_MIDI_TX_BUFFER_SIZE must be 20 to 244");
+
+// bytes parsed from BLE packets waiting to be read by the MIDI library
+#if !defined(BMC_BLE_RX_QUEUE_SIZE)
+  #define BMC_BLE_RX_QUEUE_SIZE 256
+#endif
+
+// bytes written by the MIDI library waiting to be sent in BLE packets,
+// must fit the largest SysEx you send over BLE
+#if !defined(BMC_BLE_TX_QUEUE_SIZE)
+  #define BMC_BLE_TX_QUEUE_SIZE 512
+#endif
+
+// the longest connection interval in ms the scheduler will learn, BLE MIDI
+// devices ask for 7.5 to 15 ms, anything longer is likely a gap in the data
+#define BMC_BLE_MAX_CONNECTION_INTERVAL 100
 
 #define MAX_MS 0x01FFF //13 bits, 8192 dec
 
@@ -59,6 +74,34 @@
 #define BMC_MIDI_BLE_FLAG_STATE_CHANGED 0
 #define BMC_MIDI_BLE_FLAG_QUEUE_AVAILABLE 1
 #define BMC_MIDI_BLE_FLAG_SYSEX_OPEN 2
+#define BMC_MIDI_BLE_FLAG_TX_REFUSED 3
+#define BMC_MIDI_BLE_FLAG_TX_IDLE 4
+#define BMC_MIDI_BLE_FLAG_ACTIVE_SENSE 5
+#define BMC_MIDI_BLE_FLAG_TX_WAITING 6
+#define BMC_MIDI_BLE_FLAG_TX_DROPPING 7
+
+// result of writing a message to the packet
+#define BMC_BLE_TX_ADDED 0
+#define BMC_BLE_TX_FULL 1
+#define BMC_BLE_TX_WAIT 2
+
+struct bmcBleTxStats {
+  uint32_t packets = 0;
+  uint32_t bytes = 0;
+  // packets the BLE module didn't take on the first try
+  uint32_t refused = 0;
+  // clock messages dropped after 255 were waiting
+  uint32_t clocksDropped = 0;
+  // messages dropped because the tx queue didn't have room for them
+  uint32_t messagesDropped = 0;
+  // ms from the time the oldest byte in a packet was written until it was sent
+  uint16_t latencyMax = 0;
+  // average latency x8
+  uint32_t latencyAvg = 0;
+  // learned connection interval in ms
+  uint8_t interval = 0;
+  uint8_t packetsPerInterval = 0;
+};
 
 class BMCSerialBle {
 public:
@@ -66,6 +109,7 @@ public:
     globals(t_globals){
     memset(txBuffer,0,BMC_BLE_MIDI_TX_BUFFER_SIZE);
     txTimestamps = 1;
+    txInterval = BMC_BLE_PACKET_TX_INTERVAL << 4;
   }
   operator bool(){
     return globals.bleConnected();
@@ -86,7 +130,48 @@ public:
     return rxQueue.peek();
   }
   size_t write(uint8_t value){
-    txQueue.push(value);
+    if(!flags.read(BMC_MIDI_BLE_FLAG_TX_WAITING)){
+      flags.on(BMC_MIDI_BLE_FLAG_TX_WAITING);
+      txOldest = millis();
+    }
+    // clock and active sense are sent with whatever room is left in the packets
+    if(value == BMC_MIDI_RT_CLOCK){
+      if(txClocks < 255){
+        txClocks++;
+      } else {
+        txStats.clocksDropped++;
+      }
+      return 1;
+    } else if(value == BMC_MIDI_RT_ACTIVE_SENSE){
+      flags.on(BMC_MIDI_BLE_FLAG_ACTIVE_SENSE);
+      return 1;
+    }
+    // messages are queued whole or not at all, a status byte is only queued
+    // if the queue has room for the whole message, otherwise the bytes are
+    // dropped until the next status byte, a sysex can't be checked ahead so
+    // if it fills the queue the rest of it is dropped, the receiver discards
+    // it when the next status byte cuts it off
+    if(value >= 0x80){
+      if(flags.read(BMC_MIDI_BLE_FLAG_TX_DROPPING) && value == 0xF7){
+        // the end of a sysex that was cut off
+        flags.off(BMC_MIDI_BLE_FLAG_TX_DROPPING);
+        return 0;
+      }
+      bool room = txQueue.space() >= messageLength(value);
+      flags.write(BMC_MIDI_BLE_FLAG_TX_DROPPING, !room);
+      if(!room){
+        txStats.messagesDropped++;
+      }
+    }
+    if(flags.read(BMC_MIDI_BLE_FLAG_TX_DROPPING)){
+      return 0;
+    }
+    if(!txQueue.push(value)){
+      // only a sysex or running status data gets here
+      flags.on(BMC_MIDI_BLE_FLAG_TX_DROPPING);
+      txStats.messagesDropped++;
+      return 0;
+    }
     return 1;
   }
 
@@ -103,10 +188,15 @@ public:
   }
   void update(){
     bool state = ble.update();
+    connectionState(state);
     if(state){
+      // the MTU can be negotiated after the connection, the new size is
+      // used once the packet being built is sent
+      if(ble.getPacketSize() != txPacketLimit){
+        setPacketSize(ble.getPacketSize());
+      }
       flushBle();
     }
-    connectionState(state);
   }
   void flush(){
     // kept in a separate function to keep the flush method public
@@ -120,6 +210,40 @@ public:
   bool stateChanged(){
     return flags.toggleIfTrue(BMC_MIDI_BLE_FLAG_STATE_CHANGED);
   }
+  // bytes dropped because the rx/tx queues were full
+  uint32_t getRxOverflows(){
+    return rxQueue.getOverflows();
+  }
+  uint32_t getTxOverflows(){
+    return txQueue.getOverflows();
+  }
+  uint16_t getRxQueued(){
+    return rxQueue.count();
+  }
+  uint16_t getTxQueued(){
+    return txQueue.count();
+  }
+  bmcBleTxStats& getTxStats(){
+    return txStats;
+  }
+  void resetTxStats(){
+    uint8_t interval = txStats.interval;
+    uint8_t packets = txStats.packetsPerInterval;
+    txStats = bmcBleTxStats();
+    // these are learned, not counted
+    txStats.interval = interval;
+    txStats.packetsPerInterval = packets;
+  }
+  // bytes per packet, the negotiated MTU less 3, up to BMC_BLE_MIDI_TX_BUFFER_SIZE
+  // called by update() with the size the board reports
+  void setPacketSize(uint8_t value){
+    if(value >= 5 && value <= BMC_BLE_MIDI_TX_BUFFER_SIZE && txBufferSize == 0 && txPacketSize == 0){
+      txPacketLimit = value;
+    }
+  }
+  uint8_t getPacketSize(){
+    return txPacketLimit;
+  }
 private:
   BMCGlobals& globals;
 #if BMC_MIDI_BLE_BOARD == 0
@@ -132,9 +256,22 @@ private:
 #endif
 
   BMCFlags <uint8_t> flags;
-  QueueArray <uint8_t> rxQueue;
-  QueueArray <uint8_t> txQueue;
-  unsigned long txTime = 0;
+  BMCRingBuffer <uint8_t, BMC_BLE_RX_QUEUE_SIZE> rxQueue;
+  BMCRingBuffer <uint8_t, BMC_BLE_TX_QUEUE_SIZE> txQueue;
+  bmcBleTxStats txStats;
+  unsigned long txAttempt = 0;
+  unsigned long txAccepted = 0;
+  unsigned long txRefusedAt = 0;
+  unsigned long txOldest = 0;
+  unsigned long txBurstStart = 0;
+  uint8_t txBurstCount = 0;
+  // learned connection interval in ms with 4 bits of fraction
+  uint16_t txInterval = 0;
+  // packets taken per connection interval with 4 bits of fraction
+  uint16_t txBurst = 0;
+  // the default ATT MTU of 23 less 3 until the board reports it's packet size
+  uint8_t txPacketLimit = 20;
+  uint8_t txClocks = 0;
   uint8_t rxRunningStatus = 0;
   uint8_t txRunningStatus = 0;
   uint8_t txBuffer[BMC_BLE_MIDI_TX_BUFFER_SIZE];
@@ -142,7 +279,6 @@ private:
   uint8_t txTimestamps = 1;
   uint8_t txPacket[BMC_BLE_MIDI_TX_BUFFER_SIZE];
   uint8_t txPacketSize = 0;
-  uint8_t txAdditionalMs = 0;
   unsigned long msOffset = 0;
   unsigned long currentMillis = 0;
 
@@ -150,7 +286,9 @@ private:
     if(value != globals.bleConnected()){
       globals.setBleConnected(value);
       if(!value){
+        // anything waiting to be sent is stale by the time we reconnect
         flags.reset();
+        clearTxBuffers();
       }
       flags.on(BMC_MIDI_BLE_FLAG_STATE_CHANGED);
       BMC_PRINTLN("BLE MIDI Connection State",value);
@@ -224,9 +362,9 @@ private:
         packetIndex = parseRunningStatusMidiMessage(packet, packetSize, packetIndex, hasTimestamp);
       }
       // in case for any reason we get stuck in the loop because of a bad message
-      // we break it after 20 runs since the packet will have no more than 20 bytes
+      // we break it after as many runs as there are bytes in the packet
       maxLoops++;
-      if(maxLoops>=20){
+      if(maxLoops>=packetSize){
         #ifdef BMC_DEBUG
           if(globals.getBleDebug()){
             BMC_PRINTLN("!!!!!!!! BLE Packet was not read properly !!!!!!!!");
@@ -361,226 +499,179 @@ private:
     return index;
   }
 
-  // Write data to the BLE buffer to send it 2 packets at a time
-  // Even tho iOS says that it can receive more than 2 packets at a time
-  // in my tests it only seems to accept 2 packets per connection interval
-  // so we need to buffer any bytes written by the MIDI library,
-  // then flush them out 2 packets at a time, each packet with up to 20 bytes
-  // including header and timestamps, and each pair of packets sent within an interval of BMC_BLE_PACKET_TX_INTERVAL
-  // So the idea here is to buffer bytes without timestamps then everytime we update()
-  // we check the length of the buffer, we check the status bytes and based on that we
-  // split the bytes into 2 packets.
-  // this is slower and sortof redundant and convoluted but it's the only way I've been
-  // able to send larger System Exclusive arrays to communicate with the Editor over BLE
-  // Obviously this makes this BLE MIDI Implementation not suitable for MIDI Clock...
+  // TX SCHEDULER
+  // Bytes written by the MIDI library are queued and sent in packets of up to
+  // txPacketLimit bytes, each packet holds as many whole messages as fit,
+  // every message shares the timestamp of the packet and messages with the same
+  // status use running status so they take no room for a status or timestamp.
+  //
+  // BLE modules only take a few packets per connection interval, when a packet
+  // is refused it's kept and sent first as soon as the module takes it. The time
+  // from one packet accepted after a refusal to the next one is the connection
+  // interval, the scheduler learns it to time the retries and to batch messages,
+  // while the module is refusing packets a packet that isn't full is held for up
+  // to half an interval after a packet was accepted since that packet is likely
+  // still waiting for the connection event, that way more messages go in the next.
+  //
+  // MIDI Clock and Active Sense are queued separately and only use the room
+  // left at the end of a packet, room for 1 is kept in every packet so they are
+  // delayed but not starved. SysEx is split across as many packets as needed,
+  // real time messages wait until it's done.
   void flushBle(){
-    // if there's an unsent packet try sending it again.
-    // until this packet is sent no other packets will be sent
     if(txPacketSize>0){
-      // has enough time passed?
-      if((millis() - txTime) >= BMC_BLE_PACKET_RESEND_TX_INTERVAL){
-        #ifdef BMC_DEBUG
-          if(globals.getBleDebug()){
-            BMC_PRINTLN("-------- Trying to resend packet --------",millis());
-          }
-        #endif
-        // try sending the packet, if it's sent clear the unsent packet and the txBuffer as usual
-        // we always set the txTime to the current millis for the next pass
-        if(ble.setValue(txPacket, txPacketSize)){
-          // packet was sent, clear the buffer
-          clearTxBuffers();
-          #ifdef BMC_DEBUG
-            if(globals.getBleDebug()){
-              BMC_PRINTLN("****** PACKET WAS RE-SENT ******",millis());
-            }
-          #endif
-        } else {
-          // if the packet was not sent then we will appempt to send it again
-          // in BMC_BLE_PACKET_RESEND_TX_INTERVAL ms
-          #ifdef BMC_DEBUG
-            if(globals.getBleDebug()){
-              BMC_PRINTLN("!!!!!!!!!!!!!!!!!!!!");
-              BMC_PRINTLN("PACKET WAS NOT RE-SENT!!!!!!!!!!",millis());
-              BMC_PRINTLN("!!!!!!!!!!!!!!!!!!!!");
-            }
-          #endif
-        }
-        txTime = millis();
+      // a refused packet always goes first to keep messages in order
+      if((millis() - txAttempt) < getRetryDelay() || !sendPacket()){
+        return;
       }
-      return;
     }
-    //BMC_PRINTLN("BLE ???",txQueue.count());
-    if(txQueue.count()>0 && ( (millis() - txTime) >= txAdditionalMs ) ){
-      uint8_t totalPacketsSent = 0;
-      while(totalPacketsSent<BMC_BLE_MAX_PACKETS && txQueue.count()>0){
-        // we only want to peek at the next byte and then
-        // in writeByteToBlePacket we'll pop it, this is so we can make sure
-        // that we have enough room in the packet to send it out
-        // if we don't we leave the value for the next packet
-        uint8_t value = txQueue.peek();
-        totalPacketsSent += writeByteToBlePacket(value);
-        // if we still have more than 18 bytes it's likely that the rest of the bytes will have to
-        // fit inside 2 more packets, in which case we increase the time to wait before sending
-        // the 3rd packet
-        if(totalPacketsSent==1 && txQueue.count()>(BMC_BLE_MIDI_TX_BUFFER_SIZE-2)){
-          txAdditionalMs = BMC_BLE_MIDI_TX_BUFFER_SIZE + BMC_BLE_PACKET_TX_INTERVAL;
-        }
-      }
-      // we are done sending the txBuffer so reset the extra time
-      if(txQueue.count()==0){
-        txAdditionalMs = BMC_BLE_PACKET_TX_INTERVAL;
+    for(uint8_t i = 0 ; i < BMC_BLE_MAX_PACKETS ; i++){
+      if(!buildPacket() || !sendPacket()){
+        break;
       }
-      txTime = millis();
     }
   }
-
-  uint8_t writeByteToBlePacket(uint8_t value){
-    // @ txTimestamps the number of low timestamps that will be appended to the message
-    // if it's the end of a system exclusive just send the buffer out
-    uint8_t additionalBytes = txTimestamps;
-    if(value == 0xF7){
-      // check if there's room for the 0xF7 and it's timestamp
-      // if not then just send the current buffer and send the 0xF7 after
-      additionalBytes += 2;
-      if(txBufferSize+additionalBytes > BMC_BLE_MIDI_TX_BUFFER_SIZE){
-        return send();
+  // fills the packet, returns true when it's ready to be sent
+  bool buildPacket(){
+    uint8_t result = BMC_BLE_TX_ADDED;
+    while(result == BMC_BLE_TX_ADDED && txQueue.count()>0){
+      if(flags.read(BMC_MIDI_BLE_FLAG_SYSEX_OPEN) || txQueue.peek() == 0xF0){
+        result = writeSysExToBlePacket();
+      } else {
+        result = writeMessageToBlePacket();
       }
+    }
+    if(txBufferSize == 0 && !txRealTimePending()){
+      flags.on(BMC_MIDI_BLE_FLAG_TX_IDLE);
+      return false;
+    }
+    if(txBufferSize > 0 && result != BMC_BLE_TX_FULL && holdPacket()){
+      return false;
+    }
+    writeRealTimeToBlePacket();
+    preparePacket();
+    return true;
+  }
+  // only while the module is refusing packets, otherwise small packets cost nothing
+  bool holdPacket(){
+    unsigned long now = millis();
+    uint16_t interval = getConnectionInterval();
+    if((now - txRefusedAt) >= (unsigned long) (interval << 1)){
+      return false;
+    }
+    return (now - txAccepted) < (interval >> 1) && (now - txOldest) < interval;
+  }
+  // room left in the packet, txTimestamps includes the header byte
+  uint8_t packetRoom(){
+    return txPacketLimit - (txBufferSize + txTimestamps);
+  }
+  // room for messages, the last 2 bytes are kept for a real time message
+  uint8_t messageRoom(){
+    uint8_t room = packetRoom();
+    if(txRealTimePending()){
+      return room > 2 ? room - 2 : 0;
+    }
+    return room;
+  }
+  // real time messages wait while a sysex is split across packets, they are
+  // valid inside a sysex but not every device takes them
+  bool txRealTimePending(){
+    if(flags.read(BMC_MIDI_BLE_FLAG_SYSEX_OPEN)){
+      return false;
+    }
+    return txClocks > 0 || flags.read(BMC_MIDI_BLE_FLAG_ACTIVE_SENSE);
+  }
+  uint8_t messageLength(uint8_t status){
+    if(BMCTools::isThreeByteMidiMessage(status)){
+      return 3;
+    } else if(BMCTools::isTwoByteMidiMessage(status)){
+      return 2;
+    }
+    return 1;
+  }
+  // copies the message at the front of the queue to the packet
+  uint8_t writeMessageToBlePacket(){
+    uint8_t status = txQueue.peek();
+    uint8_t length = messageLength(status);
+    if(txQueue.count() < length){
+      // the rest of the message hasn't been written yet
+      return BMC_BLE_TX_WAIT;
+    }
+    // a running status skips the status byte and it's timestamp
+    bool running = txRunningStatus>0 && txRunningStatus == status;
+    uint8_t needed = running ? length-1 : length+(bitRead(status, 7) ? 1 : 0);
+    if(needed > messageRoom()){
+      // no room for it, it goes in the next packet
+      return BMC_BLE_TX_FULL;
+    }
+    if(running){
+      txQueue.discard(1);
+      length--;
+    } else if(bitRead(status, 7)){
       txTimestamps++;
-      txBuffer[txBufferSize++] = txQueue.pop();
-      flags.off(BMC_MIDI_BLE_FLAG_SYSEX_OPEN);
-      return send();
+      txRunningStatus = BMCTools::isRunningStatusMidiMessage(status) ? status : 0;
     }
-    // if it's the start then start collecting the bytes
-    if(value == 0xF0){
-      // if the buffer size is more than 0 then send the buffer
-      // and start this sysex in the next packet
+    txBufferSize += txQueue.read(txBuffer+txBufferSize, length);
+    return messageRoom() > 0 ? BMC_BLE_TX_ADDED : BMC_BLE_TX_FULL;
+  }
+  // sysex data is copied in spans as large as the room left in the packet
+  uint8_t writeSysExToBlePacket(){
+    if(!flags.read(BMC_MIDI_BLE_FLAG_SYSEX_OPEN)){
+      // sysex always starts a new packet
       if(txBufferSize>0){
-        return send();
+        return BMC_BLE_TX_FULL;
       }
       txTimestamps++;
+      txRunningStatus = 0;
       flags.on(BMC_MIDI_BLE_FLAG_SYSEX_OPEN);
       txBuffer[txBufferSize++] = txQueue.pop();
-      return 0;
     }
-    // if we are currently reading a sysex then dont sent it out
-    // unless we filled the buffer
-    if(flags.read(BMC_MIDI_BLE_FLAG_SYSEX_OPEN)){
-      additionalBytes++;
-      txBuffer[txBufferSize++] = txQueue.pop();
-      if((txBufferSize-1)+additionalBytes == BMC_BLE_MIDI_TX_BUFFER_SIZE){
-        return send();
-      }
-      return 0;
+    uint8_t room = messageRoom();
+    uint8_t length = 0;
+    while(length < room && length < txQueue.count() && txQueue.peek(length) < 0x80){
+      length++;
     }
-    // if it's not a sysex we can try and send multiple messages in one packet
-    // but first we check to make sure that we have room for the total bytes of the message
-    // we have to make sure we have enough room for the status + it's bytes + 1 timestamp
-    if(BMCTools::isOneByteMidiMessage(value)){
-      // single status message, we need to make sure we have enough room
-      // for the status byte and it's timestamp
-      additionalBytes += 2;
-      if(txBufferSize+additionalBytes <= BMC_BLE_MIDI_TX_BUFFER_SIZE){
-        // we have enough room for it
-        txTimestamps++;
-        txBuffer[txBufferSize++] = txQueue.pop();
-        // send the packet if the buffer is full or it's the end of the data
-        if((txBufferSize-1)+txTimestamps == BMC_BLE_MIDI_TX_BUFFER_SIZE || txQueue.count() == 0){
-          return send();
-        }
-      } else {
-        // we don't have enough room for it so flush it out and
-        // leave this status for the next packet
-        return send();
-      }
-    } else if(BMCTools::isTwoByteMidiMessage(value)){
-
-
-      // status + 1 data byte message,
-      // we need to make sure we have enough room for status + data1 + timestamp
-      additionalBytes += 3;
-      if(txRunningStatus>0 && txRunningStatus == value){
-        // this is a running status, we check if we can fit it
-        // we only need to send the next byte not the status nor the timestamp
-        additionalBytes -= 2;
-      }
-      if(txBufferSize+additionalBytes <= BMC_BLE_MIDI_TX_BUFFER_SIZE){
-        // if it's a running status pop the status byte
-        if(txRunningStatus>0 && txRunningStatus == value){
-          txQueue.pop();// pop the status byte
-        } else {
-          // it's not a running status so we increase the timestamps number
-          txTimestamps++;
-        }
-
-        // we have enough room for it, add the running status for next pass
-        if(BMCTools::isRunningStatusMidiMessage(value)){
-          txRunningStatus = value;
-        }
-
-        txBuffer[txBufferSize++] = txQueue.pop();
-
-        // send the packet if the buffer is full or it's the end of the data
-        if((txBufferSize-1)+txTimestamps == BMC_BLE_MIDI_TX_BUFFER_SIZE || txQueue.count() == 0){
-          return send();
-        }
-      } else {
-        // we don't have enough room for it so flush it out and
-        // leave this status for the next one
-        return send();
-      }
-
-
-    } else if(BMCTools::isThreeByteMidiMessage(value)){
-      // status + 2 data bytes message,
-      // we need to make sure we have enough room for, status + data1 + data2 + timestamp
-      additionalBytes += 4;
-      if(txRunningStatus>0 && txRunningStatus == value){
-        // this is a running status, we check if we can fit it
-        // otherwise we send it in the next packet
-        additionalBytes -= 2;
+    txBufferSize += txQueue.read(txBuffer+txBufferSize, length);
+    if(txQueue.count() == 0){
+      // the rest of the sysex hasn't been written yet, send what we have
+      return BMC_BLE_TX_FULL;
+    }
+    uint8_t value = txQueue.peek();
+    if(value != 0xF7){
+      // the packet is full or another status cut the sysex off
+      if(value >= 0x80){
+        flags.off(BMC_MIDI_BLE_FLAG_SYSEX_OPEN);
       }
-
-      if(txBufferSize+additionalBytes <= BMC_BLE_MIDI_TX_BUFFER_SIZE){
-        // if it's a running status pop the status byte
-        if(txRunningStatus>0 && txRunningStatus == value){
-          txQueue.pop();// pop the status byte
-        } else {
-          // it's not a running status so we increase the timestamps number
-          txTimestamps++;
-        }
-
-        // we have enough room for it
-        if(BMCTools::isRunningStatusMidiMessage(value)){
-          txRunningStatus = value;
-        }
-
-        txBuffer[txBufferSize++] = txQueue.pop();
-
-        // send the packet if the buffer is full or it's the end of the data
-        if(txBufferSize+txTimestamps == BMC_BLE_MIDI_TX_BUFFER_SIZE || txQueue.count() == 0){
-          return send();
-        }
+      return BMC_BLE_TX_FULL;
+    }
+    // the 0xF7 needs room for it's timestamp
+    if(messageRoom() < 2){
+      return BMC_BLE_TX_FULL;
+    }
+    txTimestamps++;
+    txBuffer[txBufferSize++] = txQueue.pop();
+    flags.off(BMC_MIDI_BLE_FLAG_SYSEX_OPEN);
+    return BMC_BLE_TX_FULL;
+  }
+  // clock and active sense take the room left in the packet
+  void writeRealTimeToBlePacket(){
+    while(packetRoom() >= 2 && txRealTimePending()){
+      txTimestamps++;
+      if(txClocks > 0){
+        txBuffer[txBufferSize++] = BMC_MIDI_RT_CLOCK;
+        txClocks--;
       } else {
-        // we don't have enough room for it so flush it out and
-        // leave this status for the next one
-        return send();
-      }
-    } else {
-      if(bitRead(value,7)){
-        txTimestamps++;
+        txBuffer[txBufferSize++] = BMC_MIDI_RT_ACTIVE_SENSE;
+        flags.off(BMC_MIDI_BLE_FLAG_ACTIVE_SENSE);
       }
-      txBuffer[txBufferSize++] = txQueue.pop();
-    }
-    if((txBufferSize>0 && (txBufferSize-1)+txTimestamps == BMC_BLE_MIDI_TX_BUFFER_SIZE) || txQueue.count() == 0){
-      return send();
     }
-    return 0;
   }
-  uint8_t send(){
+  // adds the header and timestamps to the buffered bytes
+  void preparePacket(){
     updateCurrentTimestamp();
+    txPacketSize = 0;
     txPacket[txPacketSize++] = getHeaderByte();
     for(uint8_t i = 0; i < txBufferSize; i++){
-      if(txPacketSize>=BMC_BLE_MIDI_TX_BUFFER_SIZE){
+      if(txPacketSize>=txPacketLimit){
         break;
       }
       if(bitRead(txBuffer[i],7)){
@@ -589,6 +680,13 @@ private:
       }
       txPacket[txPacketSize++] = txBuffer[i];
     }
+    txBufferSize = 0;
+    txTimestamps = 1;
+    txRunningStatus = 0;
+  }
+  bool sendPacket(){
+    unsigned long now = millis();
+    txAttempt = now;
 
     #ifdef BMC_DEBUG
       if(globals.getBleDebug()){
@@ -597,30 +695,66 @@ private:
       }
     #endif
 
-    if(ble.setValue(txPacket,txPacketSize)){
-      // the packet was sent, we clear all buffers for any new packets to send
-      clearTxBuffers();
-    } else {
-      // the packet was not sent, we don't clear the buffers so we can try
-      // resending the packet, we return BMC_BLE_MAX_PACKETS
+    if(!ble.setValue(txPacket, txPacketSize)){
+      // the module has no room, the packet is kept and sent before anything else
+      txStats.refused++;
+      txRefusedAt = now;
+      flags.on(BMC_MIDI_BLE_FLAG_TX_REFUSED);
       #ifdef BMC_DEBUG
         if(globals.getBleDebug()){
-          BMC_PRINTLN("!!!!!!!!!!!!!!!!!!!!");
-          BMC_PRINTLN("PACKET WAS NOT SENT!!!!!!!!!!",millis());
-          BMC_PRINTLN("!!!!!!!!!!!!!!!!!!!!");
+          BMC_PRINTLN("!!!!!!!! BLE Packet was not sent !!!!!!!!",now);
         }
       #endif
-      return BMC_BLE_MAX_PACKETS;
+      return false;
     }
-    return 1;
+    if(flags.toggleIfTrue(BMC_MIDI_BLE_FLAG_TX_REFUSED)){
+      // the module made room so a connection event went by since the
+      // last time this happened, unless we ran out of data in between
+      if(!flags.toggleIfTrue(BMC_MIDI_BLE_FLAG_TX_IDLE)){
+        learnInterval(now - txBurstStart, txBurstCount);
+      }
+      txBurstStart = now;
+      txBurstCount = 0;
+    }
+    if(txBurstCount < 255){
+      txBurstCount++;
+    }
+    uint16_t latency = ((now - txOldest) > 0xFFFF) ? 0xFFFF : (now - txOldest);
+    txStats.packets++;
+    txStats.bytes += txPacketSize;
+    txStats.latencyMax = (latency > txStats.latencyMax) ? latency : txStats.latencyMax;
+    txStats.latencyAvg = txStats.latencyAvg - (txStats.latencyAvg >> 3) + latency;
+    txAccepted = now;
+    txPacketSize = 0;
+    if(txQueue.count() == 0 && !txRealTimePending() && txBufferSize == 0){
+      flags.off(BMC_MIDI_BLE_FLAG_TX_WAITING);
+    }
+    return true;
+  }
+  void learnInterval(unsigned long sample, uint8_t packets){
+    if(sample == 0 || sample > BMC_BLE_MAX_CONNECTION_INTERVAL){
+      return;
+    }
+    // moving average of the last few samples, 4 bits of fraction
+    txInterval = ((txInterval * 3) + (sample << 4)) >> 2;
+    txBurst = ((txBurst * 3) + (packets << 4)) >> 2;
+    txStats.interval = (txInterval + 8) >> 4;
+    txStats.packetsPerInterval = (txBurst + 8) >> 4;
+  }
+  uint16_t getRetryDelay(){
+    uint16_t value = txInterval >> 6;
+    return value > 0 ? value : 1;
+  }
+  uint16_t getConnectionInterval(){
+    return (txInterval + 8) >> 4;
   }
   void clearTxBuffers(){
-    txBuffer[0] = 0;
     txBufferSize = 0;
-    txPacket[0] = 0;
     txPacketSize = 0;
     txRunningStatus = 0;
     txTimestamps = 1;
+    txClocks = 0;
+    txQueue.clear();
   }
   uint8_t getHeaderByte(){
     return (((currentMillis - msOffset) >> 7) & 0x3F) | 0x80;
@@ -0,0 +1,251 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Per port SysEx assembly, each port builds its message in a chain of
+  fixed size blocks taken from a single pool and gives them back once the
+  message was handled, that way a long SysEx on one port doesn't stop
+  other ports from receiving SysEx at the same time and the memory is only
+  used by the ports that are receiving SysEx.
+
+  USB and USB Host SysEx is fed in chunks from the MIDI drivers, Serial and
+  BLE bytes are fed as the MIDI library reads them (see BMC-MidiTransport.h)
+  so the size of a message is only limited by the free blocks. Complete
+  messages are read by BMCMidi::readSysExPool() and handled like the
+  messages of any other port.
+
+  If the pool runs out of blocks the message that needed the block is
+  dropped and counted, the most blocks ever used at once is kept so
+  BMC_SYSEX_POOL_BLOCKS can be sized for your devices.
+*/
+#ifndef BMC_SYSEX_POOL_H
+#define BMC_SYSEX_POOL_H
+
+#include "utility/BMC-Def.h"
+
+#if defined(BMC_SYSEX_POOL_ENABLED)
+
+// USB, Serial A, B, C, D, Host & BLE
+#define BMC_SYSEX_POOL_PORTS 7
+#define BMC_SYSEX_POOL_NONE 255
+
+#define BMC_SYSEX_POOL_IDLE 0
+#define BMC_SYSEX_POOL_ASSEMBLING 1
+#define BMC_SYSEX_POOL_COMPLETE 2
+
+struct bmcSysExPoolStats {
+  // blocks in use right now
+  uint8_t inUse = 0;
+  // most blocks in use at once
+  uint8_t highWater = 0;
+  // messages dropped because there were no free blocks
+  uint16_t dropped = 0;
+  // messages assembled
+  uint32_t assembled = 0;
+  // length of the largest message assembled
+  uint16_t largest = 0;
+};
+
+class BMCSysExPool {
+public:
+  BMCSysExPool(){
+    for(uint8_t i = 0 ; i < BMC_SYSEX_POOL_BLOCKS ; i++){
+      next[i] = (i+1 < BMC_SYSEX_POOL_BLOCKS) ? i+1 : BMC_SYSEX_POOL_NONE;
+    }
+    freeList = 0;
+    for(uint8_t i = 0 ; i < BMC_SYSEX_POOL_PORTS ; i++){
+      ports[i].first = BMC_SYSEX_POOL_NONE;
+      ports[i].last = BMC_SYSEX_POOL_NONE;
+      ports[i].length = 0;
+      ports[i].state = BMC_SYSEX_POOL_IDLE;
+    }
+  }
+  // bytes as they arrive, @port is one of BMC_MIDI_PORT_*_BIT
+  void feed(uint8_t port, const uint8_t * data, uint16_t length){
+    if(port >= BMC_SYSEX_POOL_PORTS){
+      return;
+    }
+    bmcSysExPoolPort& p = ports[port];
+    uint16_t i = 0;
+    while(i < length){
+      uint8_t value = data[i];
+      if(value < 0x80){
+        // copy the whole run of data bytes at once
+        uint16_t run = 1;
+        while(i+run < length && data[i+run] < 0x80){
+          run++;
+        }
+        if(p.state == BMC_SYSEX_POOL_ASSEMBLING){
+          append(port, data+i, run);
+        }
+        i += run;
+        continue;
+      }
+      i++;
+      if(value == 0xF0){
+        release(port);
+        p.state = BMC_SYSEX_POOL_ASSEMBLING;
+        append(port, &value, 1);
+      } else if(value == 0xF7){
+        if(p.state == BMC_SYSEX_POOL_ASSEMBLING && append(port, &value, 1)){
+          p.state = BMC_SYSEX_POOL_COMPLETE;
+          bitWrite(completed, port, 1);
+          stats.assembled++;
+          if(p.length > stats.largest){
+            stats.largest = p.length;
+          }
+        }
+      } else if(value < 0xF8 && p.state == BMC_SYSEX_POOL_ASSEMBLING){
+        // any status byte other than real time cuts the message off
+        release(port);
+      }
+    }
+  }
+  // returns the lowest port with a complete message and clears it, or
+  // BMC_SYSEX_POOL_NONE, the message stays in the pool until it's released
+  uint8_t takeCompleted(){
+    for(uint8_t i = 0 ; i < BMC_SYSEX_POOL_PORTS ; i++){
+      if(bitRead(completed, i)){
+        bitWrite(completed, i, 0);
+        return i;
+      }
+    }
+    return BMC_SYSEX_POOL_NONE;
+  }
+  bool hasCompleted(){
+    return completed != 0;
+  }
+  // true if @port has a message, complete or still being assembled
+  bool has(uint8_t port){
+    return port < BMC_SYSEX_POOL_PORTS && ports[port].state != BMC_SYSEX_POOL_IDLE;
+  }
+  bool isComplete(uint8_t port){
+    return port < BMC_SYSEX_POOL_PORTS && ports[port].state == BMC_SYSEX_POOL_COMPLETE;
+  }
+  // length of the message on @port, 0xF0 and 0xF7 included
+  uint16_t getLength(uint8_t port){
+    return port < BMC_SYSEX_POOL_PORTS ? ports[port].length : 0;
+  }
+  uint8_t peek(uint8_t port, uint16_t index){
+    uint8_t value = 0;
+    read(port, index, &value, 1);
+    return value;
+  }
+  // copies up to @length bytes starting at @offset into @buff,
+  // returns the number of bytes copied
+  uint16_t read(uint8_t port, uint16_t offset, uint8_t * buff, uint16_t length){
+    if(port >= BMC_SYSEX_POOL_PORTS || offset >= ports[port].length){
+      return 0;
+    }
+    bmcSysExPoolPort& p = ports[port];
+    if(length > p.length - offset){
+      length = p.length - offset;
+    }
+    uint8_t block = p.first;
+    while(offset >= BMC_SYSEX_POOL_BLOCK_SIZE){
+      block = next[block];
+      offset -= BMC_SYSEX_POOL_BLOCK_SIZE;
+    }
+    uint16_t copied = 0;
+    while(copied < length){
+      uint16_t n = BMC_SYSEX_POOL_BLOCK_SIZE - offset;
+      if(n > length - copied){
+        n = length - copied;
+      }
+      memcpy(buff + copied, &blocks[block][offset], n);
+      copied += n;
+      offset = 0;
+      block = next[block];
+    }
+    return copied;
+  }
+  // gives the blocks used by @port back to the pool
+  void release(uint8_t port){
+    if(port >= BMC_SYSEX_POOL_PORTS){
+      return;
+    }
+    bmcSysExPoolPort& p = ports[port];
+    if(p.first != BMC_SYSEX_POOL_NONE){
+      // the chain is put back at the front of the free list as it is
+      next[p.last] = freeList;
+      freeList = p.first;
+      stats.inUse -= (p.length + BMC_SYSEX_POOL_BLOCK_SIZE - 1) / BMC_SYSEX_POOL_BLOCK_SIZE;
+    }
+    p.first = BMC_SYSEX_POOL_NONE;
+    p.last = BMC_SYSEX_POOL_NONE;
+    p.length = 0;
+    p.state = BMC_SYSEX_POOL_IDLE;
+    bitWrite(completed, port, 0);
+  }
+  bmcSysExPoolStats& getStats(){
+    return stats;
+  }
+  void resetStats(){
+    uint8_t inUse = stats.inUse;
+    stats = bmcSysExPoolStats();
+    stats.inUse = inUse;
+    stats.highWater = inUse;
+  }
+  // only one pool exists, the USB drivers use this to reach it
+  static BMCSysExPool *& instance(){
+    static BMCSysExPool * ptr = nullptr;
+    return ptr;
+  }
+private:
+  struct bmcSysExPoolPort {
+    uint8_t first;
+    uint8_t last;
+    uint16_t length;
+    uint8_t state;
+  };
+  uint8_t blocks[BMC_SYSEX_POOL_BLOCKS][BMC_SYSEX_POOL_BLOCK_SIZE];
+  // the block that follows each block, in a message or in the free list
+  uint8_t next[BMC_SYSEX_POOL_BLOCKS];
+  uint8_t freeList = 0;
+  bmcSysExPoolPort ports[BMC_SYSEX_POOL_PORTS];
+  uint8_t completed = 0;
+  bmcSysExPoolStats stats;
+
+  // returns false if the message was dropped
+  bool append(uint8_t port, const uint8_t * data, uint16_t length){
+    bmcSysExPoolPort& p = ports[port];
+    while(length > 0){
+      uint16_t offset = p.length % BMC_SYSEX_POOL_BLOCK_SIZE;
+      if(offset == 0){
+        // the last block is full
+        if(freeList == BMC_SYSEX_POOL_NONE || p.length > 0xFFFF - BMC_SYSEX_POOL_BLOCK_SIZE){
+          release(port);
+          stats.dropped++;
+          return false;
+        }
+        uint8_t block = freeList;
+        freeList = next[block];
+        next[block] = BMC_SYSEX_POOL_NONE;
+        if(p.first == BMC_SYSEX_POOL_NONE){
+          p.first = block;
+        } else {
+          next[p.last] = block;
+        }
+        p.last = block;
+        stats.inUse++;
+        if(stats.inUse > stats.highWater){
+          stats.highWater = stats.inUse;
+        }
+      }
+      uint16_t n = BMC_SYSEX_POOL_BLOCK_SIZE - offset;
+      if(n > length){
+        n = length;
+      }
+      memcpy(&blocks[p.last][offset], data, n);
+      p.length += n;
+      data += n;
+      length -= n;
+    }
+    return true;
+  }
+};
+
+#endif
+#endif
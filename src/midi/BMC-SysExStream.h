@@ -0,0 +1,172 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Incremental SysEx dispatcher, SysEx bytes are handed to it as they
+  arrive and each port runs a small state machine over them, no message
+  buffer is kept so memory use is the same regardless of the SysEx size.
+
+  Handlers are registered with the bytes their messages start with
+  (0xF0 included), once a message matches a prefix every byte that
+  follows it is passed to that handler, the first handler that matches
+  gets the message.
+
+  USB and USB Host SysEx is received in chunks from the MIDI drivers so
+  there is no limit to the size of the messages, for Serial and BLE ports
+  the messages are passed once received by the MIDI library.
+*/
+#ifndef BMC_SYSEX_STREAM_H
+#define BMC_SYSEX_STREAM_H
+
+#include "utility/BMC-Def.h"
+
+#if defined(BMC_SYSEX_STREAM_ENABLED)
+
+// USB, Serial A, B, C, D, Host & BLE
+#define BMC_SYSEX_STREAM_PORTS 7
+#define BMC_SYSEX_STREAM_NONE 255
+
+class BMCSysExStreamHandler {
+public:
+  // a message with the handler's prefix started
+  virtual void sysExStreamBegin(uint8_t port){}
+  // a byte after the prefix, @index is the position of the byte in the message
+  // where 0 is the 0xF0, the 0xF7 is not passed
+  virtual void sysExStreamByte(uint8_t port, uint16_t index, uint8_t value) = 0;
+  // the message ended, @complete is false if it was cut off before it's 0xF7
+  virtual void sysExStreamEnd(uint8_t port, bool complete) = 0;
+};
+
+class BMCSysExStream {
+public:
+  BMCSysExStream(){
+    for(uint8_t i = 0 ; i < BMC_SYSEX_STREAM_PORTS ; i++){
+      state[i].active = BMC_SYSEX_STREAM_NONE;
+      state[i].index = 0;
+      state[i].candidates = 0;
+    }
+  }
+  bool add(BMCSysExStreamHandler * handler, const uint8_t * prefix, uint8_t length){
+    if(totalHandlers >= BMC_SYSEX_STREAM_MAX_HANDLERS || length == 0 || prefix[0] != 0xF0){
+      return false;
+    }
+    handlers[totalHandlers].handler = handler;
+    handlers[totalHandlers].prefix = prefix;
+    handlers[totalHandlers].length = length;
+    totalHandlers++;
+    return true;
+  }
+  // @port is one of BMC_MIDI_PORT_*_BIT
+  void feed(uint8_t port, const uint8_t * data, uint16_t length){
+    if(port >= BMC_SYSEX_STREAM_PORTS){
+      return;
+    }
+    for(uint16_t i = 0 ; i < length ; i++){
+      feed(port, data[i]);
+    }
+  }
+  void feed(uint8_t port, uint8_t value){
+    bmcSysExStreamState& s = state[port];
+    if(value == 0xF0){
+      end(port, false);
+      s.index = 0;
+      s.candidates = (1 << totalHandlers) - 1;
+    }
+    if(s.candidates == 0 && s.active == BMC_SYSEX_STREAM_NONE){
+      return;
+    }
+    if(value == 0xF7){
+      end(port, true);
+      return;
+    }
+    if(value > 0xF7){
+      // real time bytes can be mixed in, they are not part of the message
+      return;
+    }
+    if(value > 0x7F && value != 0xF0){
+      // any other status byte cuts the message off
+      end(port, false);
+      return;
+    }
+    if(s.active != BMC_SYSEX_STREAM_NONE){
+      handlers[s.active].handler->sysExStreamByte(port, s.index, value);
+    } else {
+      matchPrefix(port, value);
+    }
+    if(s.index < 0xFFFF){
+      s.index++;
+    }
+  }
+  // chunks from the USB drivers, @complete is true on the last chunk
+  void feedChunk(uint8_t port, const uint8_t * data, uint16_t length, bool complete){
+    feed(port, data, length);
+    if(!complete){
+      bitWrite(chunked, port, 1);
+    }
+  }
+  // true once if the last message on @port was larger than a single chunk,
+  // the copy the driver keeps is only the last chunk of it
+  bool wasChunked(uint8_t port){
+    if(bitRead(chunked, port)){
+      bitWrite(chunked, port, 0);
+      return true;
+    }
+    return false;
+  }
+  // only one stream object exists, the USB drivers use this to reach it
+  static BMCSysExStream *& instance(){
+    static BMCSysExStream * ptr = nullptr;
+    return ptr;
+  }
+private:
+  struct bmcSysExStreamHandlerEntry {
+    BMCSysExStreamHandler * handler = nullptr;
+    const uint8_t * prefix = nullptr;
+    uint8_t length = 0;
+  };
+  struct bmcSysExStreamState {
+    uint16_t index;
+    // handlers whose prefix matches so far
+    uint8_t candidates;
+    // handler getting the message
+    uint8_t active;
+  };
+  bmcSysExStreamHandlerEntry handlers[BMC_SYSEX_STREAM_MAX_HANDLERS];
+  uint8_t totalHandlers = 0;
+  bmcSysExStreamState state[BMC_SYSEX_STREAM_PORTS];
+  uint8_t chunked = 0;
+
+  void matchPrefix(uint8_t port, uint8_t value){
+    bmcSysExStreamState& s = state[port];
+    for(uint8_t i = 0 ; i < totalHandlers ; i++){
+      if(!bitRead(s.candidates, i)){
+        continue;
+      }
+      bmcSysExStreamHandlerEntry& h = handlers[i];
+      if(s.index >= h.length || h.prefix[s.index] != value){
+        bitWrite(s.candidates, i, 0);
+        continue;
+      }
+      if(s.index == h.length-1){
+        s.active = i;
+        s.candidates = 0;
+        h.handler->sysExStreamBegin(port);
+        return;
+      }
+    }
+  }
+  void end(uint8_t port, bool complete){
+    bmcSysExStreamState& s = state[port];
+    s.candidates = 0;
+    if(s.active != BMC_SYSEX_STREAM_NONE){
+      uint8_t n = s.active;
+      s.active = BMC_SYSEX_STREAM_NONE;
+      handlers[n].handler->sysExStreamEnd(port, complete);
+    }
+  }
+};
+
+#endif
+#endif
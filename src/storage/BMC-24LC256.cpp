@@ -83,7 +83,8 @@ BMC24LC256::BMC24LC256(BMC_eeprom_size_t deviceCapacity, byte nDevice, unsigned
     _nDevice = nDevice;
     _pageSize = pageSize;
     _eepromAddr = eepromAddr;
-    _totalCapacity = _nDevice * _dvcCapacity * 1024UL / 8;
+    _dvcBytes = _dvcCapacity * 1024UL / 8;
+    _totalCapacity = _nDevice * _dvcBytes;
     _nAddrBytes = deviceCapacity > kbits_16 ? 2 : 1;       //two address bytes needed for eeproms > 16kbits
 
     //determine the bitshift needed to isolate the chip select bits from the address to put into the control byte
@@ -109,10 +110,16 @@ byte BMC24LC256::begin(twiClockFreq_t twiFreq){
   BMC_PRINTLN("BMC24LC256::begin");
   Wire.begin();
   Wire.setClock(twiFreq); 	// TRL 21Oct2018, compatibility with other processors
-  Wire.beginTransmission(_eepromAddr);
-  if (_nAddrBytes == 2) Wire.write(0);      //high addr byte
-  Wire.write(0);                            //low addr byte
-  return Wire.endTransmission();
+  //check every device on the bus, each device is selected by the
+  //chip select bits of the first address it holds
+  for (byte i = 0; i < _nDevice; i++) {
+    Wire.beginTransmission(_eepromAddr | (byte) ((i * _dvcBytes) >> _csShift));
+    if (_nAddrBytes == 2) Wire.write(0);      //high addr byte
+    Wire.write(0);                            //low addr byte
+    byte status = Wire.endTransmission();
+    if (status != 0) return status;
+  }
+  return 0;
 }
 
 //Write bytes to external EEPROM.
@@ -129,6 +136,11 @@ byte BMC24LC256::write(unsigned long addr, byte *values, unsigned int nBytes){
         return EEPROM_ADDR_ERR;             //yes, tell the caller
     }
 
+    //drop the read ahead cache if this write overlaps it
+    if (_cacheLen > 0 && addr < _cacheAddr + _cacheLen && addr + nBytes > _cacheAddr) {
+        _cacheLen = 0;
+    }
+
     while (nBytes > 0) {
         nPage = _pageSize - ( addr & (_pageSize - 1) );
         //find min(nBytes, nPage, BUFFER_LENGTH) -- BUFFER_LENGTH is defined in the Wire library.
@@ -176,7 +188,8 @@ byte BMC24LC256::read(unsigned long addr, byte *values, unsigned int nBytes)
     }
 
     while (nBytes > 0) {
-        nPage = _pageSize - ( addr & (_pageSize - 1) );
+        //sequential reads roll over pages, only stop at the end of a device
+        nPage = _dvcBytes - ( addr % _dvcBytes );
         nRead = nBytes < nPage ? nBytes : nPage;
         nRead = BUFFER_LENGTH < nRead ? BUFFER_LENGTH : nRead;
         ctrlByte = _eepromAddr | (byte) (addr >> _csShift);
@@ -186,8 +199,10 @@ byte BMC24LC256::read(unsigned long addr, byte *values, unsigned int nBytes)
         rxStatus = Wire.endTransmission();
         if (rxStatus != 0) return rxStatus;        //read error
 
-        Wire.requestFrom(ctrlByte, nRead);
-        for (byte i=0; i<nRead; i++) values[i] = Wire.read();
+        if (Wire.requestFrom(ctrlByte, nRead) != nRead) {
+            return EEPROM_READ_ERR;               //device returned less bytes
+        }
+        for (unsigned int i=0; i<nRead; i++) values[i] = Wire.read();
 
         addr += nRead;          //increment the EEPROM address
         values += nRead;        //increment the input data pointer
@@ -210,12 +225,28 @@ byte BMC24LC256::write(unsigned long addr, byte value)
 //a status of EEPROM_ADDR_ERR is returned. For I2C errors, the status
 //from the Arduino Wire library is passed back through to the caller.
 //To distinguish error values from valid data, error values are returned as negative numbers.
+//Bytes are read BMC_24LC256_CACHE_SIZE at a time so reading consecutive
+//addresses one at a time doesn't need an i2c transaction per byte.
 int BMC24LC256::read(unsigned long addr)
 {
-    byte data;
+    if (addr >= _cacheAddr && addr < _cacheAddr + _cacheLen) {
+        return _cache[addr - _cacheAddr];
+    }
     int ret;
-
-    ret = read(addr, &data, 1);
-    return ret == 0 ? data : -ret;
+    uint16_t len = BMC_24LC256_CACHE_SIZE;
+    if (addr >= _totalCapacity) {
+        return -EEPROM_ADDR_ERR;
+    }
+    if (addr + len > _totalCapacity) {
+        len = _totalCapacity - addr;
+    }
+    ret = read(addr, _cache, len);
+    if (ret != 0) {
+        _cacheLen = 0;
+        return -ret;
+    }
+    _cacheAddr = addr;
+    _cacheLen = len;
+    return _cache[0];
 }
 #endif
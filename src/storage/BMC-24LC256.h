@@ -88,12 +88,24 @@ enum BMC_eeprom_size_t {
 
 //EEPROM addressing error, returned by write() or read() if upper address bound is exceeded
 const byte EEPROM_ADDR_ERR = 9;
+//EEPROM returned less bytes than requested, returned by read()
+const byte EEPROM_READ_ERR = 10;
+
+// bytes read ahead when reading a single byte
+#define BMC_24LC256_CACHE_SIZE 32
+
+// bytes read/compared at a time by get() and put()
+#define BMC_24LC256_BLOCK_SIZE 256
+
+#if defined(BMC_24LC256_PAGE_SIZE)
+  static_assert(BMC_24LC256_PAGE_SIZE <= BMC_24LC256_BLOCK_SIZE, "BMC_24LC256_PAGE_SIZE is larger than the buffer used by put()");
+#endif
 
 class BMC24LC256
 {
     public:
         //I2C clock frequencies
-        enum twiClockFreq_t { twiClock100kHz = 100000, twiClock400kHz = 400000 };
+        enum twiClockFreq_t { twiClock100kHz = 100000, twiClock400kHz = 400000, twiClock1MHz = 1000000 };
         BMC24LC256(BMC_eeprom_size_t deviceCapacity, byte nDevice, unsigned int pageSize, byte eepromAddr = 0x50);
         byte begin(twiClockFreq_t twiFreq = twiClock100kHz);
         byte write(unsigned long addr, byte *values, unsigned int nBytes);
@@ -108,17 +120,28 @@ class BMC24LC256
           return 0;
           //return read(addr) == value ? 0 : write(addr, &value, 1);
         }
-        template <typename T> uint8_t put(uint16_t start, const T& value){
+        // compare one page at a time and only write the pages that changed
+        template <typename T> unsigned long put(unsigned long start, const T& value){
           const byte * p = (const byte*) &value;
-          unsigned long i = start;
+          unsigned long addr = start;
           unsigned long n = sizeof(value)+start;
           unsigned long updatedBytes = 0;
+          byte buff[BMC_24LC256_BLOCK_SIZE];
 #ifdef BMC_DEBUG
           BMC_PRINTNS("24LC256 UPDATE");
           writeTime = 0;
 #endif
-          for(i=start;i<n;i++){
-            updatedBytes += update(i,*p++);
+          while(addr < n){
+            // the first and last pages may be partial
+            unsigned long len = _pageSize - (addr & (_pageSize - 1));
+            len = len > BMC_24LC256_BLOCK_SIZE ? BMC_24LC256_BLOCK_SIZE : len;
+            len = (n-addr) < len ? (n-addr) : len;
+            if(read(addr, buff, len) != 0 || memcmp(buff, p, len) != 0){
+              write(addr, (byte *) p, len);
+              updatedBytes += len;
+            }
+            addr += len;
+            p += len;
 #ifdef BMC_DEBUG
             if(writeTime>=250){
               BMC_PRINTNS(".");
@@ -131,16 +154,29 @@ class BMC24LC256
 #endif
           return updatedBytes;
         }
-        template <typename T> uint8_t get(uint16_t start, const T& value){
+        // read with sequential reads as long as the i2c buffer allows,
+        // a block that fails is read again once, returns 0 or the status
+        // of the block that failed, the bytes after it are not read
+        template <typename T> byte get(unsigned long start, const T& value){
           byte * p = (byte*) &value;
-          unsigned long i = start;
+          unsigned long addr = start;
           unsigned long n = sizeof(value)+start;
 #ifdef BMC_DEBUG
           BMC_PRINTNS("24LC256 READING");
           writeTime = 0;
 #endif
-          for (i=start;i<n;i++){
-            *p++ = (uint8_t) read(i);
+          while(addr < n){
+            unsigned long len = (n-addr) < BMC_24LC256_BLOCK_SIZE ? (n-addr) : BMC_24LC256_BLOCK_SIZE;
+            byte status = read(addr, p, len);
+            if(status != 0){
+              status = read(addr, p, len);
+            }
+            if(status != 0){
+              BMC_PRINTLN("24LC256 read error", status, "at", addr);
+              return status;
+            }
+            addr += len;
+            p += len;
 #ifdef BMC_DEBUG
             if(writeTime>=250){
               BMC_PRINTNS(".");
@@ -151,7 +187,7 @@ class BMC24LC256
 #ifdef BMC_DEBUG
           BMC_PRINTLN(".");
 #endif
-          return i;
+          return 0;
         }
         void clear(){
 #ifdef BMC_DEBUG
@@ -180,7 +216,7 @@ class BMC24LC256
           BMC_PRINTLN("******************************");
           BMC_PRINTLN("");
         }
-        uint16_t length(){
+        unsigned long length(){
           /*
           #if BMC_TEENSY_RAM_SIZE >= 262144
             #if defined(BMC_STORAGE_PARTITION_SIZE_32K)
@@ -206,6 +242,10 @@ class BMC24LC256
         byte _csShift;               //number of bits to shift address for chip select bits in control byte
         uint16_t _nAddrBytes;           //number of address bytes (1 or 2)
         unsigned long _totalCapacity;   //capacity of all EEPROM devices on the bus, in bytes
+        unsigned long _dvcBytes;        //capacity of one EEPROM device, in bytes
+        byte _cache[BMC_24LC256_CACHE_SIZE]; //bytes read ahead by read(addr)
+        unsigned long _cacheAddr = 0;   //address of the first byte in _cache
+        uint16_t _cacheLen = 0;         //number of valid bytes in _cache
         #ifdef BMC_DEBUG
         elapsedMillis writeTime = 0;
         #endif
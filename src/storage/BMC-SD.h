@@ -6,6 +6,10 @@
 
   Read and write a file to the built-in SD card on Teensy 3.6/3.5/4.0/4.1
   This file is a Raw hex with the EEPROM data
+
+  When BMC_SD_PAGED_STORE_ENABLED is defined the pages are written after
+  the store in the same file, the store is read/written in place and pages
+  are read/written individually with read() and write()
 */
 #ifndef BMC_SD_H
 #define BMC_SD_H
@@ -33,7 +37,7 @@ public:
   void setFileId(uint8_t id){
     if(fileId != id && id<BMC_FS_MAX_STORES){
       fileId = id;
-      sprintf(fileName,"BMC%03u.HEX",(uint8_t)id);
+      setFileName();
       saveFileId();
     }
   }
@@ -49,7 +53,7 @@ public:
       clear();
     } else {
       bmcFile = SD.open(fileName,FILE_READ);
-      if(bmcFile.size()!=sizeof(t)){
+      if(bmcFile.size()!=fileSize()){
         bmcFile.close();
         clear();
       }
@@ -64,12 +68,21 @@ public:
   }
   template <typename T> const T &put(uint8_t index, const T &t){
     setFileId(index);
+#if defined(BMC_SD_PAGED_STORE_ENABLED)
+    // the pages follow the store in the file so we can't remove it,
+    // instead we overwrite the store at the start of the file
+    if(!SD.exists(fileName)){
+      clear();
+    }
+    write(0, (const uint8_t *)&t, sizeof(t));
+#else
     if(SD.exists(fileName)){
       SD.remove(fileName);
     }
     bmcFile = SD.open(fileName, FILE_WRITE);
     bmcFile.write((uint8_t *)&t,sizeof(t));
     bmcFile.close();
+#endif
     return t;
   }
   void clear(){
@@ -77,12 +90,39 @@ public:
       SD.remove(fileName);
     }
     bmcFile = SD.open(fileName, FILE_WRITE);
-    uint8_t x = 0;
-    for(uint16_t i=0,n=sizeof(bmcStore);i<n;i++){
-      bmcFile.write(x);
+    // write in chunks, with the paged store the file can be several
+    // hundred KB long
+    uint8_t x[64];
+    memset(x, 0, sizeof(x));
+    for(uint32_t i=0,n=fileSize();i<n;i+=sizeof(x)){
+      bmcFile.write(x, ((n-i)<sizeof(x)) ? (n-i) : sizeof(x));
     }
     bmcFile.close();
   }
+  // the size of each store file
+  uint32_t fileSize(){
+#if defined(BMC_SD_PAGED_STORE_ENABLED)
+    return sizeof(bmcStore) + ((uint32_t)sizeof(bmcStorePage) * BMC_MAX_PAGES);
+#else
+    return sizeof(bmcStore);
+#endif
+  }
+#if defined(BMC_SD_PAGED_STORE_ENABLED)
+  // read a section of the current store file
+  void read(uint32_t offset, uint8_t * data, uint16_t len){
+    bmcFile = SD.open(fileName, FILE_READ);
+    bmcFile.seek(offset);
+    bmcFile.read(data, len);
+    bmcFile.close();
+  }
+  // write a section of the current store file, the file must already exist
+  void write(uint32_t offset, const uint8_t * data, uint16_t len){
+    bmcFile = SD.open(fileName, FILE_WRITE);
+    bmcFile.seek(offset);
+    bmcFile.write(data, len);
+    bmcFile.close();
+  }
+#endif
   uint16_t length(){
     #if BMC_TEENSY_RAM_SIZE >= 256000 && defined(BMC_STORAGE_PARTITION_SIZE_32K)
       return 32000;
@@ -95,6 +135,10 @@ private:
   uint8_t fileId = 0;
   char fileName[11];
 
+  // BMC000.HEX to BMC255.HEX
+  void setFileName(){
+    BMCFormat(fileName, sizeof(fileName)).addString("BMC").addNumber(fileId, 3).addString(".HEX");
+  }
   void loadFileId(){
     if(!SD.exists(BMC_FS_FILE_NAME)){
       fileId = 0;
@@ -104,7 +148,7 @@ private:
     bmcFile = SD.open(BMC_FS_FILE_NAME);
     bmcFile.read(&fileId,1);
     bmcFile.close();
-    sprintf(fileName,"BMC%03u.HEX",fileId);
+    setFileName();
   }
   void saveFileId(){
     if(SD.exists(BMC_FS_FILE_NAME)){
@@ -38,7 +38,7 @@
 class BMCStorage {
 public:
   #if defined(BMC_USE_24LC256)
-    BMCStorage(BMCGlobals& t_globals):globals(t_globals),STORAGE(kbits_256, 1, 32, BMC_24LC256_ADDRESS){}
+    BMCStorage(BMCGlobals& t_globals):globals(t_globals),STORAGE(kbits_256, BMC_24LC256_DEVICES, BMC_24LC256_PAGE_SIZE, BMC_24LC256_ADDRESS){}
   #else
     BMCStorage(BMCGlobals& t_globals):globals(t_globals){}
   #endif
@@ -47,8 +47,10 @@ public:
     BMC_PRINTLN("BMCStorage::begin (SD CARD)");
     STORAGE.begin();
   #elif defined(BMC_USE_24LC256)
-    BMC_PRINTLN("BMCStorage::begin (24LC256)");
-    #if BMC_I2C_FREQ == 400000
+    BMC_PRINTLN("BMCStorage::begin (24LC256)", BMC_24LC256_DEVICES, "devices");
+    #if BMC_I2C_FREQ == 1000000
+      uint8_t t = STORAGE.begin(BMC24LC256::twiClock1MHz);
+    #elif BMC_I2C_FREQ == 400000
       uint8_t t = STORAGE.begin(BMC24LC256::twiClock400kHz);
     #else
       uint8_t t = STORAGE.begin(BMC24LC256::twiClock100kHz);
@@ -143,14 +145,19 @@ public:
     #endif
   }
 
-  template <typename T> void get(uint16_t address, const T& file){
+  // returns false if the 24LC256 failed to read it
+  template <typename T> bool get(uint32_t address, const T& file){
     #ifdef BMC_DEBUG
       debugStartTiming("Reading");
     #endif
+    bool ok = true;
 
     #ifdef BMC_SD_CARD_ENABLED
       // load the bmcStore Struct from SD Card
       STORAGE.get(address, file);
+    #elif defined(BMC_USE_24LC256)
+      // load the bmcStore Struct from EEPROM, the Wire status is kept
+      ok = (STORAGE.get(address, file) == 0);
     #else
       // load the bmcStore Struct from EEPROM
       STORAGE.get(address, file);
@@ -159,8 +166,9 @@ public:
     #ifdef BMC_DEBUG
       debugStopTiming();
     #endif
+    return ok;
   }
-  template <typename T> void set(uint16_t address, const T& file){
+  template <typename T> void set(uint32_t address, const T& file){
     #ifdef BMC_DEBUG
       debugStartTiming("Updating");
     #endif
@@ -178,6 +186,54 @@ public:
       debugStopTiming();
     #endif
   }
+#if defined(BMC_SD_PAGED_STORE_ENABLED)
+  // read/write a single page of the current store file,
+  // pages are located right after the store
+  void getPage(uint8_t n, bmcStorePage& t){
+    STORAGE.read(getPageOffset(n), (uint8_t *)&t, sizeof(bmcStorePage));
+  }
+  void setPage(uint8_t n, const bmcStorePage& t){
+    #ifdef BMC_DEBUG
+      debugStartTiming("Updating Page");
+    #endif
+
+    STORAGE.write(getPageOffset(n), (const uint8_t *)&t, sizeof(bmcStorePage));
+
+    #ifdef BMC_DEBUG
+      debugStopTiming();
+    #endif
+  }
+  uint32_t getPageOffset(uint8_t n){
+    return sizeof(bmcStore) + ((uint32_t)sizeof(bmcStorePage) * n);
+  }
+#endif
+#if defined(BMC_STORAGE_JOURNAL_ENABLED) || defined(BMC_FAST_BOOT_ENABLED)
+  // raw access used by the journal and fast boot, the 24LC256 writes all
+  // bytes in a single page write, the built-in EEPROM only updates changed bytes
+  // returns false if the 24LC256 failed to read it twice, like get()
+  bool read(uint32_t address, uint8_t * data, uint16_t len){
+    #if defined(BMC_USE_24LC256)
+      if(STORAGE.read(address, data, len) == 0){
+        return true;
+      }
+      return STORAGE.read(address, data, len) == 0;
+    #else
+      for(uint16_t i = 0 ; i < len ; i++){
+        data[i] = STORAGE.read(address+i);
+      }
+      return true;
+    #endif
+  }
+  void write(uint32_t address, uint8_t * data, uint16_t len){
+    #if defined(BMC_USE_24LC256)
+      STORAGE.write(address, data, len);
+    #else
+      for(uint16_t i = 0 ; i < len ; i++){
+        STORAGE.update(address+i, data[i]);
+      }
+    #endif
+  }
+#endif
   void clear(){
     #ifdef BMC_DEBUG
       debugStartTiming("Clearing");
@@ -198,11 +254,11 @@ public:
       debugStopTiming();
     #endif
   }
-  uint16_t length(){
+  uint32_t length(){
     // Get the number of bytes of EEPROM
     return STORAGE.length();
   }
-  uint16_t getLength(){
+  uint32_t getLength(){
     return length();
   }
 private:
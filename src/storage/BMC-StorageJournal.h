@@ -0,0 +1,478 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Wear-leveled journal for data that changes often, used when
+  BMC_USE_STORAGE_JOURNAL is defined in your config (EEPROM/24LC256 only).
+
+  The last BMC_STORAGE_JOURNAL_SIZE bytes of the EEPROM are reserved for
+  the journal, the space is split into 16 byte records, each record holds
+  a sequence number, an id, the store address, 9 bytes of data and a CRC.
+
+  Instead of rewriting settings and sketch bytes at their address in the
+  store every time they are saved, the part that changed is appended to the
+  journal, one record each time update() is called so saving never blocks.
+  The current preset, set list, song and stopwatch are also kept here.
+
+  Records are appended in a circle, slots holding the newest copy of a record
+  are skipped (they are the only data that has to be kept) so every other
+  slot gets written the same number of times. When the store is written to
+  its address in full a "checkpoint" is added, records older than it for
+  that store are no longer used.
+
+  If every slot holds a record that is still needed (records of many stores
+  are left behind) the settings and sketch bytes records are written to the
+  address of their store followed by a checkpoint for each of those stores,
+  their slots are then reused, no record is lost and no slot is erased.
+
+  At startup all records are read, after a store is loaded the newest valid
+  copy of each record is applied to it, a record interrupted by a power loss
+  will fail the CRC and the previous copy is used instead.
+*/
+#ifndef BMC_STORAGE_JOURNAL_H
+#define BMC_STORAGE_JOURNAL_H
+
+#include "utility/BMC-Def.h"
+#include "storage/BMC-Storage.h"
+
+#if defined(BMC_STORAGE_JOURNAL_ENABLED)
+
+#define BMC_JOURNAL_RECORD_SIZE 16
+#define BMC_JOURNAL_DATA_SIZE 9
+#define BMC_JOURNAL_SLOTS (BMC_STORAGE_JOURNAL_SIZE/BMC_JOURNAL_RECORD_SIZE)
+#define BMC_JOURNAL_NONE 255
+
+// record ids, 0 and 255 are never used since those are the values
+// of erased bytes
+#define BMC_JOURNAL_ID_NONE 0
+#define BMC_JOURNAL_ID_CHECKPOINT 254
+// settings are split into multiple records
+#define BMC_JOURNAL_ID_SETTINGS 1
+#define BMC_JOURNAL_SETTINGS_CHUNKS ((sizeof(bmcStoreGlobalSettings)+BMC_JOURNAL_DATA_SIZE-1)/BMC_JOURNAL_DATA_SIZE)
+// sketch bytes come after settings
+#define BMC_JOURNAL_ID_SKETCH_BYTES (BMC_JOURNAL_ID_SETTINGS+BMC_JOURNAL_SETTINGS_CHUNKS)
+#if BMC_MAX_SKETCH_BYTES > 0
+  #define BMC_JOURNAL_SKETCH_BYTES_CHUNKS ((BMC_MAX_SKETCH_BYTES+BMC_JOURNAL_DATA_SIZE-1)/BMC_JOURNAL_DATA_SIZE)
+#else
+  #define BMC_JOURNAL_SKETCH_BYTES_CHUNKS 0
+#endif
+// these are not part of the store, they are not tied to a store address
+#define BMC_JOURNAL_ID_PRESET (BMC_JOURNAL_ID_SKETCH_BYTES+BMC_JOURNAL_SKETCH_BYTES_CHUNKS)
+#define BMC_JOURNAL_ID_STOPWATCH (BMC_JOURNAL_ID_PRESET+1)
+#define BMC_JOURNAL_IDS (BMC_JOURNAL_ID_STOPWATCH+1)
+
+// pending and available keep 1 bit per record id
+static_assert(BMC_JOURNAL_IDS <= 32, "BMCStorageJournal supports up to 32 record ids, lower BMC_MAX_SKETCH_BYTES");
+
+struct __attribute__ ((packed)) bmcJournalRecord {
+  uint32_t seq = 0;
+  uint8_t id = 0;
+  uint8_t store = 0;
+  uint8_t data[BMC_JOURNAL_DATA_SIZE];
+  uint8_t crc = 0;
+};
+
+struct __attribute__ ((packed)) bmcJournalPreset {
+  uint16_t preset = 0;
+  uint8_t setList = 0;
+  uint8_t song = 0;
+};
+
+class BMCStorageJournal {
+public:
+  BMCStorageJournal(bmcStore& t_store, BMCStorage& t_storage):
+                    store(t_store), storage(t_storage){
+    memset(values, 0, sizeof(values));
+  }
+  // read all records, must be called before the first store is loaded
+  // @length is the size of the EEPROM
+  void begin(uint32_t length){
+    start = ((length-BMC_STORAGE_JOURNAL_SIZE)/BMC_JOURNAL_RECORD_SIZE)*BMC_JOURNAL_RECORD_SIZE;
+    seq = 0;
+    head = 0;
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      bmcJournalRecord r;
+      readSlot(i, r);
+      slotId[i] = isValid(r) ? r.id : BMC_JOURNAL_ID_NONE;
+      slotStore[i] = r.store;
+      slotSeq[i] = r.seq;
+      if(slotId[i] != BMC_JOURNAL_ID_NONE && r.seq >= seq){
+        seq = r.seq+1;
+        head = (i+1) % BMC_JOURNAL_SLOTS;
+      }
+    }
+    // the preset and stopwatch records are the same for all stores
+    for(uint8_t id = BMC_JOURNAL_ID_PRESET ; id < BMC_JOURNAL_IDS ; id++){
+      uint8_t slot = findNewest(id, 0);
+      if(slot != BMC_JOURNAL_NONE){
+        bmcJournalRecord r;
+        readSlot(slot, r);
+        memcpy(values[id], r.data, BMC_JOURNAL_DATA_SIZE);
+        bitWrite(available, id, 1);
+      }
+    }
+    BMC_PRINTLN("BMCStorageJournal::begin", BMC_JOURNAL_SLOTS, "slots at", start, "next seq", seq);
+  }
+  // first byte used by the journal, stores must end before it
+  uint32_t getStart(){
+    return start;
+  }
+  // apply the newest records of this store address to the store in RAM
+  // call after the store is read from EEPROM
+  void restore(uint8_t t_storeAddress){
+    storeAddress = t_storeAddress;
+    for(uint8_t id = BMC_JOURNAL_ID_SETTINGS ; id < BMC_JOURNAL_ID_PRESET ; id++){
+      uint8_t slot = findNewest(id, storeAddress);
+      if(slot != BMC_JOURNAL_NONE && isLive(slot)){
+        bmcJournalRecord r;
+        readSlot(slot, r);
+        setChunk(id, r.data);
+        restored++;
+      }
+      getChunk(id, values[id]);
+      bitWrite(available, id, 1);
+      bitWrite(pending, id, 0);
+    }
+  }
+  // queue the settings, only the records that changed are written
+  void saveSettings(){
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SETTINGS_CHUNKS ; i++){
+      bitWrite(pending, BMC_JOURNAL_ID_SETTINGS+i, 1);
+    }
+  }
+  void saveSketchBytes(){
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SKETCH_BYTES_CHUNKS ; i++){
+      bitWrite(pending, BMC_JOURNAL_ID_SKETCH_BYTES+i, 1);
+    }
+  }
+  void savePreset(bmcJournalPreset& t){
+    saveValue(BMC_JOURNAL_ID_PRESET, (uint8_t *) &t, sizeof(bmcJournalPreset));
+  }
+  bool getPreset(bmcJournalPreset& t){
+    return getValue(BMC_JOURNAL_ID_PRESET, (uint8_t *) &t, sizeof(bmcJournalPreset));
+  }
+  void saveStopwatch(BMCStopwatch& t){
+    uint8_t buff[BMC_JOURNAL_DATA_SIZE];
+    buff[0] = t.running;
+    memcpy(&buff[1], &t.timeout, 4);
+    memcpy(&buff[5], &t.current, 4);
+    saveValue(BMC_JOURNAL_ID_STOPWATCH, buff, BMC_JOURNAL_DATA_SIZE);
+  }
+  bool getStopwatch(BMCStopwatch& t){
+    uint8_t buff[BMC_JOURNAL_DATA_SIZE];
+    if(!getValue(BMC_JOURNAL_ID_STOPWATCH, buff, BMC_JOURNAL_DATA_SIZE)){
+      return false;
+    }
+    t.running = buff[0];
+    memcpy(&t.timeout, &buff[1], 4);
+    memcpy(&t.current, &buff[5], 4);
+    t.hours = (t.current/3600) % 24;
+    t.minutes = (t.current/60) % 60;
+    t.seconds = t.current % 60;
+    return true;
+  }
+  // the settings and sketch bytes of the current store were written to their
+  // address, older records for it are no longer needed
+  void checkpoint(){
+    for(uint8_t id = BMC_JOURNAL_ID_SETTINGS ; id < BMC_JOURNAL_ID_PRESET ; id++){
+      getChunk(id, values[id]);
+      bitWrite(pending, id, 0);
+    }
+    append(BMC_JOURNAL_ID_CHECKPOINT, values[0], storeAddress);
+  }
+  // write one pending record per call
+  void update(){
+    if(pending > 0){
+      writeNext();
+    }
+  }
+  // write all pending records now
+  void flush(){
+    while(pending > 0){
+      writeNext();
+    }
+  }
+  // erase all records, used when the store was erased
+  void erase(){
+    bmcJournalRecord r;
+    memset(&r, 0, sizeof(bmcJournalRecord));
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      storage.write(start+(i*BMC_JOURNAL_RECORD_SIZE), (uint8_t *) &r, BMC_JOURNAL_RECORD_SIZE);
+    }
+    reset();
+  }
+  // forget all records, used after the entire EEPROM was cleared
+  void reset(){
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      slotId[i] = BMC_JOURNAL_ID_NONE;
+    }
+    head = 0;
+    pending = 0;
+    available = 0;
+  }
+  uint8_t getHead(){
+    return head;
+  }
+  uint32_t getSeq(){
+    return seq;
+  }
+  uint32_t getWrites(){
+    return writes;
+  }
+  uint32_t getSkipped(){
+    return skipped;
+  }
+  uint32_t getRestored(){
+    return restored;
+  }
+  uint32_t getCompactions(){
+    return compactions;
+  }
+  // time it took to write the last record in microseconds
+  uint32_t getLastWriteTime(){
+    return lastWriteTime;
+  }
+  uint8_t getLiveRecords(){
+    uint8_t n = 0;
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      n += isLive(i);
+    }
+    return n;
+  }
+
+private:
+  bmcStore& store;
+  BMCStorage& storage;
+  uint32_t start = 0;
+  uint8_t head = 0;
+  uint8_t storeAddress = 0;
+  uint32_t seq = 0;
+  // bits of records waiting to be written
+  uint32_t pending = 0;
+  // bits of records that have a value in values[]
+  uint32_t available = 0;
+  // the last value written of each record
+  uint8_t values[BMC_JOURNAL_IDS][BMC_JOURNAL_DATA_SIZE];
+  // header of each slot so we don't have to read it to find a free slot
+  uint32_t slotSeq[BMC_JOURNAL_SLOTS];
+  uint8_t slotId[BMC_JOURNAL_SLOTS];
+  uint8_t slotStore[BMC_JOURNAL_SLOTS];
+  uint32_t writes = 0;
+  uint32_t skipped = 0;
+  uint32_t restored = 0;
+  uint32_t compactions = 0;
+  uint32_t lastWriteTime = 0;
+
+  bool isStoreRecord(uint8_t id){
+    return id >= BMC_JOURNAL_ID_SETTINGS && id < BMC_JOURNAL_ID_PRESET;
+  }
+  void saveValue(uint8_t id, uint8_t * data, uint8_t len){
+    uint8_t buff[BMC_JOURNAL_DATA_SIZE];
+    memset(buff, 0, BMC_JOURNAL_DATA_SIZE);
+    memcpy(buff, data, len);
+    if(bitRead(available, id) && memcmp(buff, values[id], BMC_JOURNAL_DATA_SIZE) == 0){
+      return;
+    }
+    memcpy(values[id], buff, BMC_JOURNAL_DATA_SIZE);
+    bitWrite(available, id, 1);
+    bitWrite(pending, id, 1);
+  }
+  bool getValue(uint8_t id, uint8_t * data, uint8_t len){
+    if(!bitRead(available, id)){
+      return false;
+    }
+    memcpy(data, values[id], len);
+    return true;
+  }
+  // location of each record id within the store
+  uint8_t * getChunkPointer(uint8_t id, uint8_t& len){
+    uint16_t size = sizeof(bmcStoreGlobalSettings);
+    uint8_t * p = (uint8_t *) &store.global.settings;
+    uint8_t n = id - BMC_JOURNAL_ID_SETTINGS;
+#if BMC_MAX_SKETCH_BYTES > 0
+    if(id >= BMC_JOURNAL_ID_SKETCH_BYTES){
+      size = BMC_MAX_SKETCH_BYTES;
+      p = store.global.sketchBytes;
+      n = id - BMC_JOURNAL_ID_SKETCH_BYTES;
+    }
+#endif
+    uint16_t offset = n * BMC_JOURNAL_DATA_SIZE;
+    len = (size-offset) < BMC_JOURNAL_DATA_SIZE ? (size-offset) : BMC_JOURNAL_DATA_SIZE;
+    return p + offset;
+  }
+  void getChunk(uint8_t id, uint8_t * data){
+    uint8_t len = 0;
+    uint8_t * p = getChunkPointer(id, len);
+    memset(data, 0, BMC_JOURNAL_DATA_SIZE);
+    memcpy(data, p, len);
+  }
+  void setChunk(uint8_t id, uint8_t * data){
+    uint8_t len = 0;
+    uint8_t * p = getChunkPointer(id, len);
+    memcpy(p, data, len);
+  }
+  void writeNext(){
+    uint8_t id = 0;
+    while(!bitRead(pending, id)){
+      id++;
+    }
+    bitWrite(pending, id, 0);
+    if(isStoreRecord(id)){
+      uint8_t buff[BMC_JOURNAL_DATA_SIZE];
+      getChunk(id, buff);
+      if(memcmp(buff, values[id], BMC_JOURNAL_DATA_SIZE) == 0){
+        // this part of the store didn't change
+        skipped++;
+        return;
+      }
+      memcpy(values[id], buff, BMC_JOURNAL_DATA_SIZE);
+    }
+    append(id, values[id], isStoreRecord(id) ? storeAddress : 0);
+  }
+  void append(uint8_t id, uint8_t * data, uint8_t t_store){
+    uint8_t slot = findFreeSlot();
+    if(slot == BMC_JOURNAL_NONE){
+      compact();
+      slot = findFreeSlot();
+      if(slot == BMC_JOURNAL_NONE){
+        // only preset and stopwatch records left, can't happen with
+        // the minimum journal size
+        return;
+      }
+    }
+    bmcJournalRecord r;
+    r.seq = seq++;
+    r.id = id;
+    r.store = t_store;
+    memcpy(r.data, data, BMC_JOURNAL_DATA_SIZE);
+    r.crc = crc8((uint8_t *) &r, BMC_JOURNAL_RECORD_SIZE-1);
+    unsigned long t = micros();
+    storage.write(start+(slot*BMC_JOURNAL_RECORD_SIZE), (uint8_t *) &r, BMC_JOURNAL_RECORD_SIZE);
+    lastWriteTime = micros()-t;
+    slotId[slot] = r.id;
+    slotStore[slot] = r.store;
+    slotSeq[slot] = r.seq;
+    head = (slot+1) % BMC_JOURNAL_SLOTS;
+    writes++;
+  }
+  // every slot holds a record that is still needed, this only happens
+  // if records of other stores are left behind. The data of each settings
+  // and sketch bytes record is written to the address of it's store, then
+  // a checkpoint is added for every store that was written so those slots
+  // can be reused. If the power is lost before the checkpoint the records
+  // are still there and hold the same data that was written to the store.
+  void compact(){
+    compactions++;
+    // 1 bit per store address that had records written to it
+    uint8_t folded[32];
+    memset(folded, 0, sizeof(folded));
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      if(!isStoreRecord(slotId[i]) || !isLive(i)){
+        continue;
+      }
+      bmcJournalRecord r;
+      readSlot(i, r);
+      uint8_t len = 0;
+      uint8_t * p = getChunkPointer(r.id, len);
+      uint32_t address = getGlobalOffset(r.store);
+      address += (uint32_t)(p - ((uint8_t *) &store.global));
+      storage.write(address, r.data, len);
+      bitWrite(folded[r.store >> 3], r.store & 0x07, 1);
+    }
+    for(uint16_t t_store = 0 ; t_store < 256 ; t_store++){
+      if(!bitRead(folded[t_store >> 3], t_store & 0x07)){
+        continue;
+      }
+      // the checkpoint takes the slot of one of the records of this store,
+      // the others are older than the checkpoint and are reused later
+      for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+        if(isStoreRecord(slotId[i]) && slotStore[i] == t_store){
+          slotId[i] = BMC_JOURNAL_ID_NONE;
+          break;
+        }
+      }
+      append(BMC_JOURNAL_ID_CHECKPOINT, values[0], t_store);
+    }
+  }
+  // address of store.global of a store in EEPROM
+  uint32_t getGlobalOffset(uint8_t t_store){
+    uint32_t header = (uint32_t)(((uint8_t *) &store.global) - ((uint8_t *) &store));
+    return (t_store * sizeof(bmcStore)) + header;
+  }
+  // the first slot from the head that isn't holding a record we still need
+  uint8_t findFreeSlot(){
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      uint8_t slot = (head+i) % BMC_JOURNAL_SLOTS;
+      if(!isLive(slot)){
+        return slot;
+      }
+    }
+    return BMC_JOURNAL_NONE;
+  }
+  uint8_t findNewest(uint8_t id, uint8_t t_store){
+    uint8_t slot = BMC_JOURNAL_NONE;
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      if(slotId[i] != id || slotStore[i] != t_store){
+        continue;
+      }
+      if(slot == BMC_JOURNAL_NONE || slotSeq[i] > slotSeq[slot]){
+        slot = i;
+      }
+    }
+    return slot;
+  }
+  // a slot is live if it holds the newest copy of a record, a checkpoint is
+  // live while there are older records of its store in the journal
+  bool isLive(uint8_t slot){
+    uint8_t id = slotId[slot];
+    if(id == BMC_JOURNAL_ID_NONE){
+      return false;
+    }
+    for(uint8_t i = 0 ; i < BMC_JOURNAL_SLOTS ; i++){
+      if(i == slot || slotStore[i] != slotStore[slot]){
+        continue;
+      }
+      if(id == BMC_JOURNAL_ID_CHECKPOINT){
+        if(isStoreRecord(slotId[i]) && slotSeq[i] < slotSeq[slot]){
+          return true;
+        }
+      } else if(slotSeq[i] > slotSeq[slot]){
+        if(slotId[i] == id){
+          return false;
+        }
+        if(isStoreRecord(id) && slotId[i] == BMC_JOURNAL_ID_CHECKPOINT){
+          return false;
+        }
+      }
+    }
+    return id != BMC_JOURNAL_ID_CHECKPOINT;
+  }
+  void readSlot(uint8_t slot, bmcJournalRecord& r){
+    storage.read(start+(slot*BMC_JOURNAL_RECORD_SIZE), (uint8_t *) &r, BMC_JOURNAL_RECORD_SIZE);
+  }
+  bool isValid(bmcJournalRecord& r){
+    if(r.id == BMC_JOURNAL_ID_NONE || r.id == 255){
+      return false;
+    }
+    if(r.id >= BMC_JOURNAL_IDS && r.id != BMC_JOURNAL_ID_CHECKPOINT){
+      return false;
+    }
+    return r.crc == crc8((uint8_t *) &r, BMC_JOURNAL_RECORD_SIZE-1);
+  }
+  // CRC-8, polynomial 0x07
+  uint8_t crc8(uint8_t * data, uint8_t len){
+    uint8_t crc = 0;
+    for(uint8_t i = 0 ; i < len ; i++){
+      crc ^= data[i];
+      for(uint8_t b = 0 ; b < 8 ; b++){
+        crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+      }
+    }
+    return crc;
+  }
+};
+
+#endif
+#endif
@@ -141,6 +141,15 @@
   struct __attribute__ ((packed)) bmcStoreGlobalTempoToTap {
     uint32_t event = 0;
   };
+  // Tempo To Tap device profile, 0 uses the default of each value
+  struct __attribute__ ((packed)) bmcStoreGlobalTempoToTapProfile {
+    // number of taps sent
+    uint8_t taps = 0;
+    // number of tap intervals the device averages
+    uint8_t window = 0;
+    // BPM the tempo has to drift before tapping again
+    uint8_t threshold = 0;
+  };
   // Port Presets
   struct __attribute__ ((packed)) bmcStorePortPresets {
     uint8_t preset[16];
@@ -155,6 +164,43 @@
     uint32_t event = 0;
     uint32_t timeout = 0;
   };
+  // Sequences, a library item sent at a clock tick of the sequence
+  struct __attribute__ ((packed)) bmcStoreGlobalSequenceStep {
+    uint16_t tick = 0;
+    bmcLibrary_t event = 0;
+  };
+  struct __attribute__ ((packed)) bmcStoreGlobalSequence {
+    // number of steps used
+    uint8_t length = 0;
+    // bit 0 loop
+    uint8_t flags = 0;
+    // start on the next multiple of this many beats, 0 starts right away
+    uint8_t quantize = 0;
+    // length of the loop in ticks, 0 to loop after the last step
+    uint16_t ticks = 0;
+    bmcStoreGlobalSequenceStep steps[BMC_MAX_SEQUENCE_STEPS];
+  };
+  struct __attribute__ ((packed)) bmcStoreGlobalModulator {
+    // BMC_MODULATOR_SHAPE_*
+    uint8_t shape = 0;
+    // BMC_MODULATOR_OUTPUT_*
+    uint8_t output = 0;
+    // bit 0 loop, bit 1 clock sync
+    uint8_t flags = 0;
+    uint8_t ports = 0;
+    // 1 to 16
+    uint8_t channel = 1;
+    // milliseconds between updates, 0 for the default
+    uint8_t interval = 0;
+    // CC#, CC# 0 to 31 for 14-bit CC or the NRPN number
+    uint16_t number = 0;
+    // 0 to 127 for CC, 0 to 16383 for the rest, 8192 is the center
+    // of a pitch bend
+    uint16_t min = 0;
+    uint16_t max = 0;
+    // length of a cycle in milliseconds, in clock ticks if synced
+    uint16_t period = 0;
+  };
   // Settings object
   struct __attribute__ ((packed)) bmcStoreGlobalSettings {
     uint32_t flags = 0;
@@ -220,6 +266,15 @@
     #if BMC_MAX_TIMED_EVENTS > 0
       bmcStoreGlobalTimedEvents timedEvents[BMC_MAX_TIMED_EVENTS];
     #endif
+    #if BMC_MAX_SEQUENCES > 0
+      bmcStoreGlobalSequence sequences[BMC_MAX_SEQUENCES];
+    #endif
+    #if BMC_MAX_MODULATORS > 0
+      bmcStoreGlobalModulator modulators[BMC_MAX_MODULATORS];
+    #endif
+    #if defined(BMC_TEMPO_TO_TAP_PROFILES_ENABLED)
+      bmcStoreGlobalTempoToTapProfile tempoToTapProfiles[BMC_MAX_TEMPO_TO_TAP];
+    #endif
   };
 
 
@@ -227,7 +282,12 @@
     uint16_t crc = 0;
     uint16_t version = 0;
     bmcStoreGlobal global;
-    bmcStorePage pages[BMC_MAX_PAGES];
+    // when the paged store is enabled pages are stored right after the global
+    // data in the SD Card file but they are not part of the store in RAM,
+    // they are loaded on demand by BMCStorePages
+    #if !defined(BMC_SD_PAGED_STORE_ENABLED)
+      bmcStorePage pages[BMC_MAX_PAGES];
+    #endif
   };
 
 #endif
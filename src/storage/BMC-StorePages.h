@@ -0,0 +1,245 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Access to the pages of the store, always use pages[n] instead of
+  store.pages[n].
+
+  By default all pages are part of the bmcStore struct and this class only
+  returns a reference to them.
+
+  When BMC_USE_SD_PAGED_STORE is defined in your config (SD Card only) pages
+  are NOT kept in RAM, only global data is, instead BMC_SD_PAGED_STORE_SLOTS
+  pages are loaded at a time into "slots", when a page that isn't loaded is
+  requested the least recently used slot is replaced by it. The current page
+  is never replaced and the pages before and after it are prefetched by
+  update() so going to the next/previous page doesn't have to touch the SD Card.
+  Pages out of range are not loaded, an empty page is returned instead.
+
+  Each slot keeps a checksum of the page when it was loaded/saved, if a slot
+  has been edited (by the editor) and it's replaced, it's written back to the
+  SD Card first. Keep in mind this means that pages edited during a backup
+  that were replaced will have already been written if the backup is canceled.
+*/
+#ifndef BMC_STORE_PAGES_H
+#define BMC_STORE_PAGES_H
+
+#include "utility/BMC-Def.h"
+#include "storage/BMC-Storage.h"
+
+#define BMC_STORE_PAGES_NONE 255
+
+class BMCStorePages {
+public:
+  BMCStorePages(bmcStore& t_store, BMCStorage& t_storage):
+                store(t_store), storage(t_storage){
+    reset();
+  }
+  bmcStorePage& operator[](uint8_t n){
+    return get(n);
+  }
+
+#if !defined(BMC_SD_PAGED_STORE_ENABLED)
+  bmcStorePage& get(uint8_t n){
+    return store.pages[n];
+  }
+  void setCurrent(uint8_t n){}
+  void update(){}
+  void save(uint8_t n){}
+  void saveAll(){}
+  void reset(){}
+#else
+  bmcStorePage& get(uint8_t n){
+    if(n >= BMC_MAX_PAGES){
+      return getInvalid(n);
+    }
+    // most requests are for the current page, skip the search
+    if(slotPage[lastSlot] != n){
+      uint8_t slot = findSlot(n);
+      if(slot == BMC_STORE_PAGES_NONE){
+        slot = load(n);
+        misses++;
+      } else {
+        hits++;
+      }
+      lastSlot = slot;
+    }
+    slotUsed[lastSlot] = ++usage;
+    return slots[lastSlot];
+  }
+  // set the page currently in use, this page will never be replaced
+  // the next time update() is called the pages before and after it
+  // will be loaded
+  void setCurrent(uint8_t n){
+    if(n >= BMC_MAX_PAGES){
+      return;
+    }
+    current = n;
+    get(n);
+    prefetchStep = (BMC_MAX_PAGES > 1) ? 2 : 0;
+  }
+  // prefetch one neighbouring page per call so a page change
+  // only takes the time of reading a single page
+  void update(){
+    if(prefetchStep == 0){
+      return;
+    }
+    prefetchStep--;
+    uint8_t n = current;
+    if(prefetchStep == 1){
+      n = (current+1 < BMC_MAX_PAGES) ? current+1 : 0;
+    } else {
+      n = (current > 0) ? current-1 : BMC_MAX_PAGES-1;
+    }
+    if(n != current && findSlot(n) == BMC_STORE_PAGES_NONE){
+      load(n);
+      prefetched++;
+    }
+  }
+  // write a page to the SD Card if it's loaded
+  void save(uint8_t n){
+    uint8_t slot = findSlot(n);
+    if(slot != BMC_STORE_PAGES_NONE){
+      write(slot);
+    }
+  }
+  // write all loaded pages that have changed
+  void saveAll(){
+    for(uint8_t i = 0 ; i < BMC_SD_PAGED_STORE_SLOTS ; i++){
+      if(slotPage[i] != BMC_STORE_PAGES_NONE && isDirty(i)){
+        write(i);
+      }
+    }
+  }
+  // discard all loaded pages, used when the store is reloaded
+  void reset(){
+    for(uint8_t i = 0 ; i < BMC_SD_PAGED_STORE_SLOTS ; i++){
+      slotPage[i] = BMC_STORE_PAGES_NONE;
+      slotUsed[i] = 0;
+      slotChecksum[i] = 0;
+    }
+    lastSlot = 0;
+    usage = 0;
+    prefetchStep = 0;
+  }
+  uint8_t getSlotPage(uint8_t slot){
+    return slot < BMC_SD_PAGED_STORE_SLOTS ? slotPage[slot] : BMC_STORE_PAGES_NONE;
+  }
+  uint32_t getHits(){
+    return hits;
+  }
+  uint32_t getMisses(){
+    return misses;
+  }
+  uint32_t getPrefetched(){
+    return prefetched;
+  }
+  // number of requests for pages out of range
+  uint32_t getRejected(){
+    return rejected;
+  }
+  // time it took to read the last page that was loaded in microseconds
+  uint32_t getLastLoadTime(){
+    return lastLoadTime;
+  }
+  // the longest it took to read a page in microseconds
+  uint32_t getMaxLoadTime(){
+    return maxLoadTime;
+  }
+#endif
+
+private:
+  bmcStore& store;
+  BMCStorage& storage;
+
+#if defined(BMC_SD_PAGED_STORE_ENABLED)
+  bmcStorePage slots[BMC_SD_PAGED_STORE_SLOTS];
+  uint8_t slotPage[BMC_SD_PAGED_STORE_SLOTS];
+  uint32_t slotUsed[BMC_SD_PAGED_STORE_SLOTS];
+  uint16_t slotChecksum[BMC_SD_PAGED_STORE_SLOTS];
+  uint8_t lastSlot = 0;
+  uint8_t current = 0;
+  uint8_t prefetchStep = 0;
+  uint32_t usage = 0;
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+  uint32_t prefetched = 0;
+  uint32_t rejected = 0;
+  uint32_t lastLoadTime = 0;
+  uint32_t maxLoadTime = 0;
+
+  // an empty page that isn't cached or saved, returned for pages that
+  // don't exist instead of replacing a slot with another page
+  bmcStorePage invalid;
+
+  bmcStorePage& getInvalid(uint8_t n){
+    BMC_PRINTLN("BMCStorePages page", n, "out of range");
+    invalid = bmcStorePage();
+    rejected++;
+    return invalid;
+  }
+  uint8_t findSlot(uint8_t n){
+    for(uint8_t i = 0 ; i < BMC_SD_PAGED_STORE_SLOTS ; i++){
+      if(slotPage[i] == n){
+        return i;
+      }
+    }
+    return BMC_STORE_PAGES_NONE;
+  }
+  // pick the least recently used slot, empty slots first,
+  // the current page is never picked
+  uint8_t findFreeSlot(){
+    uint8_t slot = BMC_STORE_PAGES_NONE;
+    for(uint8_t i = 0 ; i < BMC_SD_PAGED_STORE_SLOTS ; i++){
+      if(slotPage[i] == BMC_STORE_PAGES_NONE){
+        return i;
+      }
+      if(slotPage[i] == current){
+        continue;
+      }
+      if(slot == BMC_STORE_PAGES_NONE || slotUsed[i] < slotUsed[slot]){
+        slot = i;
+      }
+    }
+    return slot;
+  }
+  uint8_t load(uint8_t n){
+    uint8_t slot = findFreeSlot();
+    if(slotPage[slot] != BMC_STORE_PAGES_NONE && isDirty(slot)){
+      write(slot);
+    }
+    unsigned long t = micros();
+    storage.getPage(n, slots[slot]);
+    lastLoadTime = micros() - t;
+    if(lastLoadTime > maxLoadTime){
+      maxLoadTime = lastLoadTime;
+    }
+    slotPage[slot] = n;
+    slotUsed[slot] = ++usage;
+    slotChecksum[slot] = checksum(slot);
+    return slot;
+  }
+  void write(uint8_t slot){
+    storage.setPage(slotPage[slot], slots[slot]);
+    slotChecksum[slot] = checksum(slot);
+  }
+  bool isDirty(uint8_t slot){
+    return checksum(slot) != slotChecksum[slot];
+  }
+  // Fletcher-16 of the page
+  uint16_t checksum(uint8_t slot){
+    const uint8_t * p = (const uint8_t *) &slots[slot];
+    uint16_t a = 0;
+    uint16_t b = 0;
+    for(uint16_t i = 0 ; i < sizeof(bmcStorePage) ; i++){
+      a = (a + p[i]) % 255;
+      b = (b + a) % 255;
+    }
+    return (b << 8) | a;
+  }
+#endif
+};
+
+#endif
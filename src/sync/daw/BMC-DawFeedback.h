@@ -0,0 +1,212 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Logic Control feedback for surfaces without motorized faders, keeps the
+  14-bit fader positions and V-Pot rings sent by the DAW and renders them
+  as LED masks for LED rings and pixel strips of any length (up to 32).
+
+  Channels whose fader or ring changed are flagged so only those are
+  re-rendered, the 8 channel strips are 0 to 7 and the master fader is 8.
+
+  Pots controlling a fader use soft takeover, the pot won't send anything
+  until it reaches or crosses the position of the fader in the DAW, that
+  way the DAW value doesn't jump when the pot is moved.
+*/
+#ifndef BMC_DAW_FEEDBACK_H
+#define BMC_DAW_FEEDBACK_H
+
+#include "utility/BMC-Def.h"
+
+#ifdef BMC_USE_DAW_LC
+
+// 14-bit position of a fader at it's max, Logic sends 14843 at +6db
+#if !defined(BMC_DAW_FADER_MAX)
+  #define BMC_DAW_FADER_MAX 14843
+#endif
+
+// 14-bit distance from the DAW position at which a pot is picked up
+#if !defined(BMC_DAW_TAKEOVER_WINDOW)
+  #define BMC_DAW_TAKEOVER_WINDOW 256
+#endif
+
+// milliseconds after a pot sends a position in which fader positions sent
+// back by the DAW are treated as the echo of the pot and not a new position
+#if !defined(BMC_DAW_TAKEOVER_ECHO)
+  #define BMC_DAW_TAKEOVER_ECHO 250
+#endif
+
+// 8 channels + master
+#define BMC_DAW_FEEDBACK_FADERS 9
+#define BMC_DAW_FEEDBACK_MASTER 8
+#define BMC_DAW_FEEDBACK_NO_POT 0xFFFF
+
+class BMCDawFeedback {
+public:
+  BMCDawFeedback(){
+    reset();
+  }
+  void reset(){
+    for(uint8_t i = 0 ; i < BMC_DAW_FEEDBACK_FADERS ; i++){
+      position[i] = 0;
+      potLast[i] = BMC_DAW_FEEDBACK_NO_POT;
+      potSent[i] = 0;
+    }
+    for(uint8_t i = 0 ; i < 8 ; i++){
+      ring[i] = 0;
+    }
+    known = 0;
+    pickedUp = 0;
+    fadersChanged = 0;
+    ringsChanged = 0;
+  }
+  // raw 14-bit pitch bend value of a fader
+  void setFader(uint8_t n, uint16_t value){
+    if(n >= BMC_DAW_FEEDBACK_FADERS){
+      return;
+    }
+    value &= 0x3FFF;
+    if(bitRead(pickedUp, n) && (millis() - potSent[n]) > BMC_DAW_TAKEOVER_ECHO){
+      // moved by the DAW (mouse or automation), the pot has to catch it again
+      bitWrite(pickedUp, n, 0);
+    }
+    bitWrite(known, n, 1);
+    if(value != position[n]){
+      position[n] = value;
+      bitWrite(fadersChanged, n, 1);
+    }
+  }
+  uint16_t getFader(uint8_t n){
+    return n < BMC_DAW_FEEDBACK_FADERS ? position[n] : 0;
+  }
+  // raw V-Pot ring byte, bit 6 center led, bits 4-5 mode, bits 0-3 position
+  void setVPot(uint8_t n, uint8_t value){
+    if(n < 8 && value != ring[n]){
+      ring[n] = value;
+      bitWrite(ringsChanged, n, 1);
+    }
+  }
+  bool getVPotCentered(uint8_t n){
+    return n < 8 && bitRead(ring[n], 6);
+  }
+  // returns true once if the fader changed since it was last taken
+  bool takeFaderChanged(uint8_t n){
+    if(n < BMC_DAW_FEEDBACK_FADERS && bitRead(fadersChanged, n)){
+      bitWrite(fadersChanged, n, 0);
+      return true;
+    }
+    return false;
+  }
+  bool takeVPotChanged(uint8_t n){
+    if(n < 8 && bitRead(ringsChanged, n)){
+      bitWrite(ringsChanged, n, 0);
+      return true;
+    }
+    return false;
+  }
+  bool hasChanges(){
+    return fadersChanged > 0 || ringsChanged > 0;
+  }
+  // leds lit by the fader on a strip of @count leds, bit 0 is the bottom led,
+  // any position above 0 lights at least 1 led
+  uint32_t getFaderLeds(uint8_t n, uint8_t count){
+    if(n >= BMC_DAW_FEEDBACK_FADERS || count == 0 || count > 32){
+      return 0;
+    }
+    uint32_t value = (position[n] > BMC_DAW_FADER_MAX) ? BMC_DAW_FADER_MAX : position[n];
+    uint8_t lit = (value * count + (BMC_DAW_FADER_MAX-1)) / BMC_DAW_FADER_MAX;
+    return lit > 0 ? range(0, lit-1) : 0;
+  }
+  // leds lit by the V-Pot on a ring of @count leds, the 11 positions of the
+  // Logic Control ring are spread over the leds, bit 0 is the first led
+  uint32_t getVPotLeds(uint8_t n, uint8_t count){
+    if(n >= 8 || count == 0 || count > 32){
+      return 0;
+    }
+    uint8_t value = ring[n] & 0x0F;
+    if(value == 0 || value > 11){
+      return 0;
+    }
+    uint8_t last = count-1;
+    uint8_t center = last/2;
+    uint8_t led = ((value-1) * last + 5) / 10;
+    switch((ring[n] >> 4) & 0x03){
+      case 0:
+        // single dot
+        return range(led, led);
+      case 1:
+        // boost/cut, from the center to the position
+        return (led < center) ? range(led, center) : range(center, led);
+      case 2:
+        // wrap, from the first led to the position
+        return range(0, led);
+      case 3:
+        // spread, grows out from the center
+        {
+          if(value > 6){
+            return range(0, last);
+          }
+          uint8_t width = ((value-1) * center + 2) / 5;
+          uint8_t hi = center + width;
+          return range(center - width, (hi > last) ? last : hi);
+        }
+    }
+    return 0;
+  }
+  // a pot assigned to a fader moved, @value is the 14-bit position of the pot,
+  // returns true if the position should be sent to the DAW
+  bool takeover(uint8_t n, uint16_t value){
+    if(n >= BMC_DAW_FEEDBACK_FADERS){
+      return false;
+    }
+    uint16_t prev = potLast[n];
+    potLast[n] = value;
+    if(!bitRead(pickedUp, n)){
+      uint16_t daw = position[n];
+      uint16_t distance = (value > daw) ? value - daw : daw - value;
+      bool crossed = prev != BMC_DAW_FEEDBACK_NO_POT &&
+                     ((prev <= daw && value >= daw) || (prev >= daw && value <= daw));
+      // the DAW hasn't sent this fader yet so there's nothing to jump from
+      if(!bitRead(known, n) || distance <= BMC_DAW_TAKEOVER_WINDOW || crossed){
+        bitWrite(pickedUp, n, 1);
+      }
+    }
+    if(bitRead(pickedUp, n)){
+      potSent[n] = millis();
+      position[n] = value;
+      bitWrite(fadersChanged, n, 1);
+      return true;
+    }
+    return false;
+  }
+  bool isPickedUp(uint8_t n){
+    return n < BMC_DAW_FEEDBACK_FADERS && bitRead(pickedUp, n);
+  }
+  // pots have to catch the DAW position again, used when banking
+  void releasePots(){
+    pickedUp = 0;
+    for(uint8_t i = 0 ; i < BMC_DAW_FEEDBACK_FADERS ; i++){
+      potLast[i] = BMC_DAW_FEEDBACK_NO_POT;
+    }
+  }
+private:
+  uint16_t position[BMC_DAW_FEEDBACK_FADERS];
+  uint16_t potLast[BMC_DAW_FEEDBACK_FADERS];
+  unsigned long potSent[BMC_DAW_FEEDBACK_FADERS];
+  uint8_t ring[8];
+  // 1 bit per fader
+  uint16_t known = 0;
+  uint16_t pickedUp = 0;
+  uint16_t fadersChanged = 0;
+  uint8_t ringsChanged = 0;
+
+  // mask with leds @lo to @hi lit
+  uint32_t range(uint8_t lo, uint8_t hi){
+    return (0xFFFFFFFFUL >> (31-hi)) & (0xFFFFFFFFUL << lo);
+  }
+};
+
+#endif
+#endif
@@ -9,15 +9,31 @@
 
 #include "utility/BMC-Def.h"
 #include "midi/BMC-MidiClock.h"
+#include "sync/daw/BMC-DawMeters.h"
+#include "sync/daw/BMC-DawFeedback.h"
 
 #ifdef BMC_USE_DAW_LC
 
+// USB cable the DAW sees the control surface on
+#if !defined(BMC_DAW_USB_CABLE)
+  #define BMC_DAW_USB_CABLE 0
+#endif
+
+#if BMC_DAW_USB_CABLE >= BMC_USB_CABLES
+  #error "BMC_DAW_USB_CABLE must be lower than BMC_USB_CABLES"
+#endif
+
+#define BMC_DAW_PORT BMC_USB_CABLE_PORT(BMC_DAW_USB_CABLE)
+
 class BMCDawLogicControl {
 private:
   BMCMidi& midi;
   bmcStoreGlobal& global;
   BMCCallbacks& callback;
   BMCLogicControlData controller;
+  BMCDawMeters meters;
+  BMCDawFeedback feedback;
+  bool meterReceived = false;
 public:
   BMCDawLogicControl(BMCMidi& t_midi, bmcStoreGlobal& t_global, BMCCallbacks& cb):
               midi(t_midi),
@@ -27,15 +43,46 @@ public:
     //
   }
   void update(){
-    controller.update();
+    if(feedback.hasChanges()){
+      updateFeedback();
+    }
+    // meters only change on a decay tick or when the DAW sent a new level
+    if(!meters.update() && !meterReceived){
+      return;
+    }
+    meterReceived = false;
     for(uint8_t i=0;i<8;i++){
-      if(controller.getMeterChanged(i) && callback.dawChannelMeterUpdate){
-        uint8_t level = controller.getMeter(i);
-        uint8_t overload = controller.getMeterOverload(i);
-        callback.dawChannelMeterUpdate(i, level, overload);
+      if(meters.takeChanged(i) && callback.dawChannelMeterUpdate){
+        callback.dawChannelMeterUpdate(i, meters.getMeter(i), meters.getOverload(i));
       }
     }
   }
+  uint8_t getMeter(uint8_t channel){
+    return meters.getMeter(channelStrip(channel));
+  }
+  uint8_t getMeterPeak(uint8_t channel){
+    return meters.getPeak(channelStrip(channel));
+  }
+  // the first track shown on channel strip 1, 0 to BMC_DAW_METER_TRACKS-8
+  void setMeterBankOffset(uint8_t value){
+    meters.setBankOffset(value);
+  }
+  uint8_t getMeterBankOffset(){
+    return meters.getBankOffset();
+  }
+  // 14-bit position of a fader, 0 to 7 channels, 8 selected, 9 master
+  uint16_t getFaderPosition(uint8_t channel){
+    return feedback.getFader(faderIndex(channel));
+  }
+  uint32_t getFaderLeds(uint8_t channel, uint8_t count){
+    return feedback.getFaderLeds(faderIndex(channel), count);
+  }
+  uint32_t getVPotLeds(uint8_t channel, uint8_t count){
+    return feedback.getVPotLeds(channelStrip(channel), count);
+  }
+  bool getPotPickedUp(uint8_t channel){
+    return feedback.isPickedUp(faderIndex(channel));
+  }
   uint8_t getSelectedChannel(){
     return controller.getSelectedChannel();
   }
@@ -43,7 +90,7 @@ public:
     return controller.getVPotValue(channel, ledN);
   }
   bool incoming(BMCMidiMessage d){
-    if(!d.matchSource(BMC_USB)){
+    if(!midi.matchPort(BMC_DAW_PORT, d)){
       return false;
     }
     if(d.isSysEx()){
@@ -64,6 +111,7 @@ public:
         uint8_t mode = (v >> 4) & 0x03;
         uint8_t value = v & 0x0F;
         controller.setVPot(c-0x30, v);
+        feedback.setVPot(ch, v);
         if(callback.dawChannelVPotUpdate){
           callback.dawChannelVPotUpdate(ch, value, centered, mode);
         }
@@ -78,7 +126,8 @@ public:
       if(d.getChannel()==1){
         uint8_t ch = (c>>4) & 0x07;
         uint8_t level = c & 0x0F;
-        controller.setMeter(ch, level);
+        meters.set(ch, level);
+        meterReceived = true;
         if(callback.dawRecievedChannelMeter){
           callback.dawRecievedChannelMeter(ch, level);
         }
@@ -154,6 +203,7 @@ public:
       }
     } else if(d.isPitchBend()){
       uint8_t ch = d.getChannel()-1;
+      feedback.setFader(ch, d.getPitchValue());
       int value = d.getPitchValue() & 0x3FFC;
       value = map(value, 0, 14843, (-8192), 6651);
       // 6651
@@ -185,6 +235,8 @@ public:
         break;
       case 0x02:
         controller.setOnline();
+        meters.reset();
+        feedback.reset();
         if(callback.dawOnline){
           callback.dawOnline(true);
         }
@@ -223,6 +275,8 @@ public:
         break;
       case 0x0F:
         controller.setOffline();
+        meters.reset();
+        feedback.reset();
         if(callback.dawOnline){
           callback.dawOnline(false);
         }
@@ -284,19 +338,19 @@ public:
       case BMC_DAW_LED_CMD_AUTOMATION_GROUP:      return controller.getAutomationGroup();
       case BMC_DAW_LED_CMD_UTILITY_SAVE:          return controller.getUtilitySave();
       case BMC_DAW_LED_CMD_UTILITY_UNDO:          return controller.getUtilityUndo();
-      case BMC_DAW_LED_CMD_METER_PEAK:            return controller.getMeterOverload(ch);
-      case BMC_DAW_LED_CMD_METER_1:               return controller.getMeter(ch, 1)>0;
-      case BMC_DAW_LED_CMD_METER_2:               return controller.getMeter(ch, 2)>0;
-      case BMC_DAW_LED_CMD_METER_3:               return controller.getMeter(ch, 3)>0;
-      case BMC_DAW_LED_CMD_METER_4:               return controller.getMeter(ch, 4)>0;
-      case BMC_DAW_LED_CMD_METER_5:               return controller.getMeter(ch, 5)>0;
-      case BMC_DAW_LED_CMD_METER_6:               return controller.getMeter(ch, 6)>0;
-      case BMC_DAW_LED_CMD_METER_7:               return controller.getMeter(ch, 7)>0;
-      case BMC_DAW_LED_CMD_METER_8:               return controller.getMeter(ch, 8)>0;
-      case BMC_DAW_LED_CMD_METER_9:               return controller.getMeter(ch, 9)>0;
-      case BMC_DAW_LED_CMD_METER_10:              return controller.getMeter(ch, 10)>0;
-      case BMC_DAW_LED_CMD_METER_11:              return controller.getMeter(ch, 11)>0;
-      case BMC_DAW_LED_CMD_METER_12:              return controller.getMeter(ch, 12)>0;
+      case BMC_DAW_LED_CMD_METER_PEAK:            return meters.getOverload(channelStrip(ch));
+      case BMC_DAW_LED_CMD_METER_1:               return meters.getMeter(channelStrip(ch), 1)>0;
+      case BMC_DAW_LED_CMD_METER_2:               return meters.getMeter(channelStrip(ch), 2)>0;
+      case BMC_DAW_LED_CMD_METER_3:               return meters.getMeter(channelStrip(ch), 3)>0;
+      case BMC_DAW_LED_CMD_METER_4:               return meters.getMeter(channelStrip(ch), 4)>0;
+      case BMC_DAW_LED_CMD_METER_5:               return meters.getMeter(channelStrip(ch), 5)>0;
+      case BMC_DAW_LED_CMD_METER_6:               return meters.getMeter(channelStrip(ch), 6)>0;
+      case BMC_DAW_LED_CMD_METER_7:               return meters.getMeter(channelStrip(ch), 7)>0;
+      case BMC_DAW_LED_CMD_METER_8:               return meters.getMeter(channelStrip(ch), 8)>0;
+      case BMC_DAW_LED_CMD_METER_9:               return meters.getMeter(channelStrip(ch), 9)>0;
+      case BMC_DAW_LED_CMD_METER_10:              return meters.getMeter(channelStrip(ch), 10)>0;
+      case BMC_DAW_LED_CMD_METER_11:              return meters.getMeter(channelStrip(ch), 11)>0;
+      case BMC_DAW_LED_CMD_METER_12:              return meters.getMeter(channelStrip(ch), 12)>0;
       case BMC_DAW_LED_CMD_VPOT_1:                return controller.getVPotValue(ch, 1)>0;
       case BMC_DAW_LED_CMD_VPOT_2:                return controller.getVPotValue(ch, 2)>0;
       case BMC_DAW_LED_CMD_VPOT_3:                return controller.getVPotValue(ch, 3)>0;
@@ -313,6 +367,19 @@ public:
       case BMC_DAW_LED_CMD_BEATS:                 return controller.getBeats();
       case BMC_DAW_LED_CMD_RUDE_SOLO:             return controller.getRudeSolo();
       case BMC_DAW_LED_CMD_RELAY:                 return controller.getRelay();
+      case BMC_DAW_LED_CMD_FADER_1:
+      case BMC_DAW_LED_CMD_FADER_2:
+      case BMC_DAW_LED_CMD_FADER_3:
+      case BMC_DAW_LED_CMD_FADER_4:
+      case BMC_DAW_LED_CMD_FADER_5:
+      case BMC_DAW_LED_CMD_FADER_6:
+      case BMC_DAW_LED_CMD_FADER_7:
+      case BMC_DAW_LED_CMD_FADER_8:
+      case BMC_DAW_LED_CMD_FADER_9:
+      case BMC_DAW_LED_CMD_FADER_10:
+      case BMC_DAW_LED_CMD_FADER_11:
+      case BMC_DAW_LED_CMD_FADER_12:
+        return bitRead(feedback.getFaderLeds(faderIndex(ch), 12), cmd-BMC_DAW_LED_CMD_FADER_1);
     }
     return false;
   }
@@ -333,10 +400,34 @@ public:
       case BMC_DAW_BTN_CMD_ASSIGN_PLUGIN: sendNote(0x2B, release); break;
       case BMC_DAW_BTN_CMD_ASSIGN_EQ: sendNote(0x2C, release); break;
       case BMC_DAW_BTN_CMD_ASSIGN_INSTR: sendNote(0x2D, release); break;
-      case BMC_DAW_BTN_CMD_BANK_LEFT: sendNote(0x2E, release); break;
-      case BMC_DAW_BTN_CMD_BANK_RIGHT: sendNote(0x2F, release); break;
-      case BMC_DAW_BTN_CMD_CHANNEL_LEFT: sendNote(0x30, release); break;
-      case BMC_DAW_BTN_CMD_CHANNEL_RIGHT: sendNote(0x31, release); break;
+      case BMC_DAW_BTN_CMD_BANK_LEFT:
+        sendNote(0x2E, release);
+        if(!release){
+          meters.bankScroll(false, 8);
+          feedback.releasePots();
+        }
+        break;
+      case BMC_DAW_BTN_CMD_BANK_RIGHT:
+        sendNote(0x2F, release);
+        if(!release){
+          meters.bankScroll(true, 8);
+          feedback.releasePots();
+        }
+        break;
+      case BMC_DAW_BTN_CMD_CHANNEL_LEFT:
+        sendNote(0x30, release);
+        if(!release){
+          meters.bankScroll(false, 1);
+          feedback.releasePots();
+        }
+        break;
+      case BMC_DAW_BTN_CMD_CHANNEL_RIGHT:
+        sendNote(0x31, release);
+        if(!release){
+          meters.bankScroll(true, 1);
+          feedback.releasePots();
+        }
+        break;
       case BMC_DAW_BTN_CMD_FLIP: sendNote(0x32, release); break;
       case BMC_DAW_BTN_CMD_GLOBAL: sendNote(0x33, release); break;
       case BMC_DAW_BTN_CMD_NAMEVAL: sendNote(0x34, release); break;
@@ -397,11 +488,29 @@ public:
     }
   }
 
+  // channel 8 and up is the selected channel
+  uint8_t channelStrip(uint8_t ch){
+    return (ch>=8) ? controller.getSelectedChannel() : ch;
+  }
+  uint8_t faderIndex(uint8_t ch){
+    return (ch==9) ? BMC_DAW_FEEDBACK_MASTER : channelStrip(ch);
+  }
+  // only channels whose fader or ring changed are passed to the sketch
+  void updateFeedback(){
+    for(uint8_t i=0;i<BMC_DAW_FEEDBACK_FADERS;i++){
+      if(feedback.takeFaderChanged(i) && callback.dawFaderFeedback){
+        callback.dawFaderFeedback(i, feedback.getFader(i));
+      }
+      if(i<8 && feedback.takeVPotChanged(i) && callback.dawVPotFeedback){
+        callback.dawVPotFeedback(i, feedback.getVPotLeds(i, 11), feedback.getVPotCentered(i));
+      }
+    }
+  }
   void sendNote(uint8_t note, bool release=false){
     if(!release){
-      midi.sendNoteOn(BMC_USB, 1, note, 127);
+      midi.sendNoteOn(BMC_DAW_PORT, 1, note, 127);
     } else {
-      midi.sendNoteOff(BMC_USB, 1, note, 0);
+      midi.sendNoteOff(BMC_DAW_PORT, 1, note, 0);
     }
   }
   // V-POT
@@ -410,7 +519,17 @@ public:
       ch = controller.getSelectedChannel();
     }
     uint8_t value = (clockwise ? 1 : 65)+extraTicks;
-    midi.sendControlChange(BMC_USB, 1, 0x10 | ch, value);
+    midi.sendControlChange(BMC_DAW_PORT, 1, 0x10 | ch, value);
+  }
+  // a pot used as a fader, @ch 0 to 7 channels, 8 selected, 9 master,
+  // the position is only sent once the pot picks up the DAW fader
+  void sendPotFader(uint8_t ch, uint8_t value){
+    uint8_t n = faderIndex(ch);
+    uint16_t position = map(value, 0, 127, 0, BMC_DAW_FADER_MAX);
+    if(!controller.isOnline() || !feedback.takeover(n, position)){
+      return;
+    }
+    midi.sendPitchBend(BMC_DAW_PORT, n+1, ((int) position) - 8192);
   }
   // encoder as fader not yet implemented
   void sendEncoderFader(uint8_t ch, bool clockwise, uint8_t extraTicks){
@@ -443,14 +562,14 @@ public:
     // fader at max/+6db = 14843 / signed 6651
     // fader at unity/0db = 12441 / signed 4249
     // fader at min/infinity = 0 / signed-8192
-    midi.sendPitchBend(BMC_USB, ch, volume);
+    midi.sendPitchBend(BMC_DAW_PORT, ch, volume);
   }
 
 
   // scrub wheel
   void sendTransportScrubWheel(bool clockwise, uint8_t extraTicks){
     uint8_t value = (clockwise ? 1 : 65)+extraTicks;
-    midi.sendControlChange(BMC_USB, 1, 0x3C, value);
+    midi.sendControlChange(BMC_DAW_PORT, 1, 0x3C, value);
   }
   void sendHostConnectionQuery(){
     //BMC_PRINTLN("sendHostConnectionQuery");
@@ -462,7 +581,7 @@ public:
   		0x4F, 0x4E, 0x45, 0x69,            // Challenge Code
   		0xF7                               // EOX
   	};
-    midi.sendSysEx(BMC_USB, reply, 18, true);
+    midi.sendSysEx(BMC_DAW_PORT, reply, 18, true);
   }
   void sendHostConnectionConfirmation(){
     //BMC_PRINTLN("sendHostConnectionConfirmation");
@@ -474,7 +593,7 @@ public:
   		0x4F, 0x4E, 0x45, 0x69,            // Challenge Code
   		0xF7                               // EOX
   	};
-    midi.sendSysEx(BMC_USB, reply, 18, true);
+    midi.sendSysEx(BMC_DAW_PORT, reply, 18, true);
   }
   void sendVersionReply(){
     //BMC_PRINTLN("sendVersionReply");
@@ -485,7 +604,7 @@ public:
       'V', '2', '.', '5', '3',      // Version
       0xF7,                         // EOX
     };
-    midi.sendSysEx(BMC_USB, reply, 12, true);
+    midi.sendSysEx(BMC_DAW_PORT, reply, 12, true);
   }
 
 };
@@ -0,0 +1,233 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Logic Control channel meters, levels of all tracks are kept in one array
+  as 8.8 fixed point values and decay together on a single timer tick.
+
+  The DAW only sends meters for the 8 channel strips on the surface, the
+  bank offset maps those strips to tracks so up to BMC_DAW_METER_TRACKS
+  tracks keep their levels as you bank thru them.
+
+  Only tracks with a level, peak or overload are processed on each tick and
+  the segments shown for each track are packed 2 per byte, tracks whose
+  shown segments or peak changed are flagged so only those are sent to
+  LEDs/pixels.
+*/
+#ifndef BMC_DAW_METERS_H
+#define BMC_DAW_METERS_H
+
+#include "utility/BMC-Def.h"
+
+#ifdef BMC_USE_DAW_LC
+
+// must be a multiple of 8 up to 64
+#if !defined(BMC_DAW_METER_TRACKS)
+  #define BMC_DAW_METER_TRACKS 64
+#endif
+
+// milliseconds between decay ticks
+#if !defined(BMC_DAW_METER_TICK)
+  #define BMC_DAW_METER_TICK 30
+#endif
+
+// milliseconds for a meter to drop one segment, Logic Control uses 300
+#if !defined(BMC_DAW_METER_DECAY)
+  #define BMC_DAW_METER_DECAY 300
+#endif
+
+// milliseconds the peak segment is held before it drops to the level
+#if !defined(BMC_DAW_METER_PEAK_HOLD)
+  #define BMC_DAW_METER_PEAK_HOLD 1000
+#endif
+
+#if BMC_DAW_METER_TRACKS < 8 || BMC_DAW_METER_TRACKS > 64 || (BMC_DAW_METER_TRACKS % 8) != 0
+  #error "BMC_DAW_METER_TRACKS must be a multiple of 8 from 8 to 64"
+#endif
+
+#define BMC_DAW_METER_MAX_LEVEL 12
+// 8.8 fixed point amount a meter drops on each tick
+#define BMC_DAW_METER_DECAY_STEP ((uint16_t)((256UL*BMC_DAW_METER_TICK)/BMC_DAW_METER_DECAY))
+#define BMC_DAW_METER_PEAK_TICKS ((uint8_t)(BMC_DAW_METER_PEAK_HOLD/BMC_DAW_METER_TICK))
+#define BMC_DAW_METER_BYTES (BMC_DAW_METER_TRACKS/8)
+
+static_assert((BMC_DAW_METER_PEAK_HOLD/BMC_DAW_METER_TICK) <= 255,
+              "BMC_DAW_METER_PEAK_HOLD can be up to 255 ticks of BMC_DAW_METER_TICK");
+
+class BMCDawMeters {
+public:
+  BMCDawMeters(){
+    reset();
+    tick.start(BMC_DAW_METER_TICK);
+  }
+  void reset(){
+    for(uint8_t i = 0 ; i < BMC_DAW_METER_TRACKS ; i++){
+      level[i] = 0;
+      peak[i] = 0;
+      hold[i] = 0;
+    }
+    for(uint8_t i = 0 ; i < BMC_DAW_METER_TRACKS/2 ; i++){
+      shown[i] = 0;
+    }
+    for(uint8_t i = 0 ; i < BMC_DAW_METER_BYTES ; i++){
+      active[i] = 0;
+      overload[i] = 0;
+      changed[i] = 0;
+    }
+    offset = 0;
+  }
+  // returns true on the ticks where meters were decayed
+  bool update(){
+    if(!tick){
+      return false;
+    }
+    for(uint8_t b = 0 ; b < BMC_DAW_METER_BYTES ; b++){
+      uint8_t bits = active[b];
+      while(bits){
+        // lowest set bit, skips idle tracks 8 at a time
+        uint8_t n = (b << 3) + __builtin_ctz(bits);
+        bits &= bits - 1;
+        decay(n);
+      }
+    }
+    return true;
+  }
+  // raw Logic Control meter value of a channel strip from channel pressure
+  // 0x0-0xC level, 0xE set overload, 0xF clear overload
+  void set(uint8_t strip, uint8_t value){
+    uint8_t n = getTrack(strip);
+    if(n >= BMC_DAW_METER_TRACKS){
+      return;
+    }
+    if(value == 0x0E){
+      if(!bitRead(overload[n>>3], n&7)){
+        bitWrite(overload[n>>3], n&7, 1);
+        flagChanged(n);
+      }
+      return;
+    } else if(value == 0x0F){
+      if(bitRead(overload[n>>3], n&7)){
+        bitWrite(overload[n>>3], n&7, 0);
+        flagChanged(n);
+      }
+      return;
+    } else if(value > BMC_DAW_METER_MAX_LEVEL){
+      return;
+    }
+    uint16_t v = value << 8;
+    // a lower level lets the meter fall at the decay rate
+    if(v > level[n]){
+      level[n] = v;
+    }
+    if(value >= peak[n]){
+      if(value > peak[n]){
+        flagChanged(n);
+      }
+      peak[n] = value;
+      hold[n] = BMC_DAW_METER_PEAK_TICKS;
+    }
+    bitWrite(active[n>>3], n&7, 1);
+    show(n);
+  }
+  // the first track shown on channel strip 1
+  void setBankOffset(uint8_t value){
+    value = (value > BMC_DAW_METER_TRACKS-8) ? BMC_DAW_METER_TRACKS-8 : value;
+    if(value != offset){
+      offset = value;
+      // the strips now show other tracks
+      for(uint8_t i = 0 ; i < 8 ; i++){
+        flagChanged(offset+i);
+      }
+    }
+  }
+  uint8_t getBankOffset(){
+    return offset;
+  }
+  void bankScroll(bool up, uint8_t amount){
+    if(up){
+      setBankOffset(offset + amount);
+    } else {
+      setBankOffset(offset > amount ? offset - amount : 0);
+    }
+  }
+  // segments lit on a channel strip, if @segment is passed returns 0 when
+  // that segment isn't lit
+  uint8_t getMeter(uint8_t strip, uint8_t segment=0){
+    uint8_t value = getTrackMeter(getTrack(strip));
+    return (segment > 0 && value < segment) ? 0 : value;
+  }
+  uint8_t getPeak(uint8_t strip){
+    uint8_t n = getTrack(strip);
+    return n < BMC_DAW_METER_TRACKS ? peak[n] : 0;
+  }
+  bool getOverload(uint8_t strip){
+    uint8_t n = getTrack(strip);
+    return n < BMC_DAW_METER_TRACKS && bitRead(overload[n>>3], n&7);
+  }
+  uint8_t getTrackMeter(uint8_t n){
+    if(n >= BMC_DAW_METER_TRACKS){
+      return 0;
+    }
+    return (shown[n>>1] >> ((n&1)<<2)) & 0x0F;
+  }
+  // returns true once if the segments of the strip changed
+  bool takeChanged(uint8_t strip){
+    uint8_t n = getTrack(strip);
+    if(n < BMC_DAW_METER_TRACKS && bitRead(changed[n>>3], n&7)){
+      bitWrite(changed[n>>3], n&7, 0);
+      return true;
+    }
+    return false;
+  }
+private:
+  uint16_t level[BMC_DAW_METER_TRACKS];
+  uint8_t peak[BMC_DAW_METER_TRACKS];
+  uint8_t hold[BMC_DAW_METER_TRACKS];
+  // segments shown, 2 tracks per byte
+  uint8_t shown[BMC_DAW_METER_TRACKS/2];
+  // 1 bit per track
+  uint8_t active[BMC_DAW_METER_BYTES];
+  uint8_t overload[BMC_DAW_METER_BYTES];
+  uint8_t changed[BMC_DAW_METER_BYTES];
+  uint8_t offset = 0;
+  BMCEndlessTimer tick;
+
+  uint8_t getTrack(uint8_t strip){
+    return (strip < 8) ? offset + strip : BMC_DAW_METER_TRACKS;
+  }
+  void flagChanged(uint8_t n){
+    bitWrite(changed[n>>3], n&7, 1);
+  }
+  void decay(uint8_t n){
+    level[n] = (level[n] > BMC_DAW_METER_DECAY_STEP) ? level[n] - BMC_DAW_METER_DECAY_STEP : 0;
+    if(hold[n] > 0){
+      hold[n]--;
+    }
+    // once the hold expires the peak follows the level
+    if(hold[n] == 0 && peak[n] > 0){
+      uint8_t value = (level[n] + 255) >> 8;
+      if(value != peak[n]){
+        peak[n] = value;
+        flagChanged(n);
+      }
+    }
+    if(level[n] == 0 && peak[n] == 0){
+      bitWrite(active[n>>3], n&7, 0);
+    }
+    show(n);
+  }
+  // segments are the level rounded up so a meter only goes dark at 0
+  void show(uint8_t n){
+    uint8_t segments = (level[n] + 255) >> 8;
+    if(segments != getTrackMeter(n)){
+      uint8_t shift = (n&1)<<2;
+      shown[n>>1] = (shown[n>>1] & ~(0x0F << shift)) | (segments << shift);
+      flagChanged(n);
+    }
+  }
+};
+
+#endif
+#endif
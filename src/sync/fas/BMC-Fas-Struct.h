@@ -18,6 +18,26 @@
 #if defined(BMC_USE_FAS)
 
 #include "sync/fas/BMC-Fas-Def.h"
+#include "utility/BMC-ParamCache.h"
+
+// number of parameters that can be assigned to a slot to be kept synced
+#if !defined(BMC_FAS_MAX_SYNCED_PARAMETERS)
+  #define BMC_FAS_MAX_SYNCED_PARAMETERS 8
+#endif
+#if BMC_FAS_MAX_SYNCED_PARAMETERS > 32
+  #undef BMC_FAS_MAX_SYNCED_PARAMETERS
+  #define BMC_FAS_MAX_SYNCED_PARAMETERS 32
+#endif
+
+// each synced parameter can have an X and Y value, the cache is kept
+// at twice that size, other parameters received are cached if there's room
+#if BMC_FAS_MAX_SYNCED_PARAMETERS <= 8
+  #define BMC_FAS_PARAM_CACHE_SIZE 32
+#elif BMC_FAS_MAX_SYNCED_PARAMETERS <= 16
+  #define BMC_FAS_PARAM_CACHE_SIZE 64
+#else
+  #define BMC_FAS_PARAM_CACHE_SIZE 128
+#endif
 
 // Fractal Device ID, only AX8 supported at the moment
 // ------------------------
@@ -178,67 +198,37 @@ struct BMCFasData {
   BMCFasBlockStates blocks;
   BMCFasLooper looper;
 
-  uint16_t parameters[8];
-  uint16_t parametersX[8];
-  uint16_t parametersY[8];
-  uint8_t parametersSyncedX = 0;
-  uint8_t parametersSyncedY = 0;
+  // block id and parameter id of each synced parameter slot
+  uint16_t parameters[BMC_FAS_MAX_SYNCED_PARAMETERS];
+  // last value received of each parameter
+  BMCParamCache <uint32_t, BMC_FAS_PARAM_CACHE_SIZE> paramCache;
+  uint32_t paramKey(uint8_t block, uint8_t param){
+    return ((uint32_t) (blocks.isY(block) ? 1 : 0) << 16) | (block<<8) | param;
+  }
   void paramReset(){
-    parametersSyncedX = 0;
-    parametersSyncedY = 0;
+    paramCache.clear();
   }
   void paramSet(uint8_t slot, uint8_t block, uint8_t param){
-    slot &= 0x07;
+    if(slot >= BMC_FAS_MAX_SYNCED_PARAMETERS){
+      return;
+    }
     parameters[slot] = (block<<8) | param;
-    bitWrite(parametersSyncedX, slot, 0);
-    bitWrite(parametersSyncedY, slot, 0);
   }
+  // returns true if the value changed
   bool paramReceived(uint8_t block, uint8_t param, uint16_t value){
-    uint8_t slot = paramFindSlot(block, param);
-    if(slot>7){
-      return false;
-    }
-    if(blocks.isX(block)){
-      parametersX[slot] = value;
-      bitWrite(parametersSyncedX, slot, 1);
-    } else {
-      parametersY[slot] = value;
-      bitWrite(parametersSyncedY, slot, 1);
-    }
-    return true;
+    return paramCache.set(paramKey(block, param), value);
   }
   bool paramIsSynced(uint8_t block, uint8_t param){
-    uint8_t slot = paramFindSlot(block, param);
-    if(slot>7){
-      return true;
-    }
-    if(blocks.isX(block)){
-      return bitRead(parametersSyncedX, slot);
-    }
-    return bitRead(parametersSyncedY, slot);
+    return paramCache.has(paramKey(block, param));
   }
   uint16_t paramGetValue(uint8_t block, uint8_t param){
-    return paramGetValue(paramFindSlot(block, param));
+    return paramCache.getValue(paramKey(block, param));
   }
   uint16_t paramGetValue(uint8_t slot){
-    if(slot>7){
+    if(slot >= BMC_FAS_MAX_SYNCED_PARAMETERS){
       return 0;
     }
-    uint8_t block = (parameters[slot]>>8) & 0xFF;
-    if(blocks.isX(block)){
-      return parametersX[slot];
-    } else {
-      return parametersY[slot];
-    }
-    return 0;
-  }
-  uint8_t paramFindSlot(uint8_t block, uint8_t param){
-    for(uint8_t i=0;i<8;i++){
-      if(parameters[i]==((block<<8) | param)){
-        return i;
-      }
-    }
-    return 255;
+    return paramGetValue((parameters[slot]>>8) & 0xFF, parameters[slot] & 0xFF);
   }
   bool getLooperState(){
     return looper.isEnabled();
@@ -288,6 +278,7 @@ struct BMCFasData {
     channel = 0;
     preset = 0xFFFF;
     scene = 0;
+    paramReset();
   }
 };
 #endif
@@ -8,12 +8,17 @@ BMCFas::BMCFas(BMCMidi& t_midi, BMCGlobals& t_globals):
 {
   device.reset();
   findDeviceTimer.stop();
+  syncPendingReset();
 }
 void BMCFas::begin(){
   BMC_INFO("FAS Sync Version 1.0");
   BMC_INFO("On Axe FX II to use the tuner toggle or tempo beat you MUST enable Real Time MIDI");
   flags.on(BMC_FAS_FLAG_DEVICE_SEARCH);
   findDeviceTimer.start(1000);
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  static const uint8_t prefix[4] = {0xF0, 0x00, 0x01, 0x74};
+  midi.addSysExStreamHandler(this, prefix, 4);
+#endif
 }
 void BMCFas::update(){
   // search for response from FAS device, try up to 10 times every 5 seconds
@@ -99,6 +104,13 @@ bool BMCFas::incoming(BMCMidiMessage& message){
 
   timeConnectionStart();
 
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  // already read from the SysEx stream
+  if(message.sysex[5]==BMC_FAS_FUNC_ID_BLOCKS_DATA || message.sysex[5]==BMC_FAS_FUNC_ID_PRESET_NAME){
+    return true;
+  }
+#endif
+
   // messages that don't have a Checksum
   switch(message.sysex[5]){
     case BMC_FAS_FUNC_ID_MIDI_TEMPO_BEAT:{
@@ -192,12 +204,17 @@ bool BMCFas::incoming(BMCMidiMessage& message){
     }
       return true;
     case BMC_FAS_FUNC_ID_BLOCKS_DATA:{
-      if(!connected() || !isFractMessage(message, 5)){
+      // header, function id, checksum and 0xF7 plus 5 bytes per block
+      if(!connected() || !isFractMessage(message, 8) || ((message.size()-8) % 5) != 0){
         return false;
       }
-      // crc used to know if there's a change within the blocks
-      uint8_t crc = device.blocks.getCRC();
-      device.blocks.reset();
+      // the blocks of the current preset are only replaced by a valid message
+      if(!message.validateChecksum()){
+        BMC_PRINTLN("!!!  FAS Received Bad CRC  !!!");
+        return false;
+      }
+      BMCFasBlockStates blocks;
+      blocks.reset();
       BMC_PRINTLN("--> FAS BLOCKS RECEIVED:", (message.size()-8)/5);
       for(uint8_t i = 6; i < message.size()-2; i+=5){
         uint32_t block = message.get32BitsLSBFirst(i);
@@ -213,17 +230,12 @@ bool BMCFas::incoming(BMCMidiMessage& message){
         }
       }
   #endif
-        device.blocks.set(blockId, isEngaged, !isX);
-      }
-      if(midi.callback.fasBlocksChange){
-        device.blocks.createCRC();
-        if(crc!=device.blocks.getCRC()){
-          midi.callback.fasBlocksChange();
-        }
-      }
-      if(flags.toggleIfTrue(BMC_FAS_FLAG_SYNC_EXPECT_BLOCKS)){
-        resyncTimer.start(BMC_FAS_RESYNC_QUEUE_TIMEOUT);
+        blocks.set(blockId, isEngaged, !isX);
       }
+      // crc used to know if there's a change within the blocks
+      uint8_t crc = device.blocks.getCRC();
+      device.blocks = blocks;
+      blocksReceived(crc);
     }
       return true;
   }
@@ -285,7 +297,10 @@ bool BMCFas::incoming(BMCMidiMessage& message){
         }
         BMC_PRINTLN("--> FAS BLOCK Bypass:", blockId, value==0?"engaged":"bypassed");
       } else {
-        device.paramReceived(blockId, paramId, value);
+        if(device.paramReceived(blockId, paramId, value) && midi.callback.fasParameterChange){
+          midi.callback.fasParameterChange(blockId, paramId, value);
+        }
+        syncReceived(BMC_FAS_FUNC_ID_BLOCK_PARAM);
         requestSyncParameters();
         if(midi.callback.fasBlockParameterReceived){
           uint8_t strLen = message.size()-(18+2);
@@ -319,13 +334,7 @@ bool BMCFas::incoming(BMCMidiMessage& message){
       }
       strcpy(device.presetName, "");
       message.getStringFromSysEx(6, device.presetName, 32);
-      BMC_PRINTLN("--> FAS PRESET NAME:", device.presetName);
-      if(flags.toggleIfTrue(BMC_FAS_FLAG_SYNC_EXPECT_PRESET_NAME)){
-        resyncTimer.start(BMC_FAS_RESYNC_QUEUE_TIMEOUT);
-      }
-      if(midi.callback.fasPresetName){
-        midi.callback.fasPresetName(device.presetName);
-      }
+      presetNameReceived();
     }
       return true;
     case BMC_FAS_FUNC_ID_GET_PRESET_NUMBER:{
@@ -333,16 +342,22 @@ bool BMCFas::incoming(BMCMidiMessage& message){
         return false;
       }
       uint16_t value = message.get14Bits(6);
-      if(device.preset!=value){
+      bool presetChanged = device.preset!=value;
+      if(presetChanged){
         device.paramReset();
+        flags.off(BMC_FAS_FLAG_SYNC_NAME_KNOWN);
         if(midi.callback.fasPresetChange){
           midi.callback.fasPresetChange(value);
         }
       }
       device.preset = value;
       BMC_PRINTLN("--> FAS PRESET NUMBER:", debugPrintPreset());
+      syncReceived(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER);
       if(flags.toggleIfTrue(BMC_FAS_FLAG_SYNC_EXPECT_PRESET)){
-        resyncTimer.start(BMC_FAS_RESYNC_TIMEOUT);
+        // same preset, the name we have is still good
+        if(!presetChanged && flags.read(BMC_FAS_FLAG_SYNC_NAME_KNOWN)){
+          flags.off(BMC_FAS_FLAG_SYNC_EXPECT_PRESET_NAME);
+        }
       } else {
         receivedReSync();
         flags.off(BMC_FAS_FLAG_SYNC_EXPECT_PRESET);
@@ -357,16 +372,19 @@ bool BMCFas::incoming(BMCMidiMessage& message){
       }
       uint8_t value = message.get7Bits(6);
       if(device.scene!=value){
-        flags.on(BMC_FAS_FLAG_SYNC_PARAM_SYNC_BEGIN);
-        requestSyncParameters();
+        // during a resync the queue starts the parameters once the
+        // preset and blocks are known
+        if(!flags.read(BMC_FAS_FLAG_SYNC_EXPECT_SCENE)){
+          beginParameterSync(true);
+        }
         if(midi.callback.fasSceneChange){
           midi.callback.fasSceneChange(value);
         }
       }
       device.scene = value;
       BMC_PRINTLN("--> FAS SCENE NUMBER:", device.scene+1);
+      syncReceived(BMC_FAS_FUNC_ID_SCENE_NUMBER);
       if(flags.toggleIfTrue(BMC_FAS_FLAG_SYNC_EXPECT_SCENE)){
-        resyncTimer.start(BMC_FAS_RESYNC_QUEUE_TIMEOUT);
         if(device.id==BMC_FAS_DEVICE_ID_AX8){
           flags.off(BMC_FAS_FLAG_SYNC_EXPECT_BLOCKS);
         }
@@ -401,9 +419,127 @@ bool BMCFas::incoming(BMCMidiMessage& message){
   }
   return false;
 }
+// @crc is the crc of the blocks before they were updated
+void BMCFas::blocksReceived(uint8_t crc){
+  if(midi.callback.fasBlocksChange){
+    device.blocks.createCRC();
+    if(crc!=device.blocks.getCRC()){
+      midi.callback.fasBlocksChange();
+    }
+  }
+  flags.off(BMC_FAS_FLAG_SYNC_EXPECT_BLOCKS);
+  syncReceived(BMC_FAS_FUNC_ID_BLOCKS_DATA);
+}
+void BMCFas::presetNameReceived(){
+  BMC_PRINTLN("--> FAS PRESET NAME:", device.presetName);
+  flags.off(BMC_FAS_FLAG_SYNC_EXPECT_PRESET_NAME);
+  flags.on(BMC_FAS_FLAG_SYNC_NAME_KNOWN);
+  syncReceived(BMC_FAS_FUNC_ID_PRESET_NAME);
+  if(midi.callback.fasPresetName){
+    midi.callback.fasPresetName(device.presetName);
+  }
+}
 
+#ifdef BMC_SYSEX_STREAM_ENABLED
+// Block data and preset names are read as the bytes arrive so their
+// size is not limited by BMC_MIDI_SYSEX_SIZE
+void BMCFas::sysExStreamBegin(uint8_t port){
+  streamFuncId = 0;
+  if(!connected() || bit(port)!=device.getPort()){
+    return;
+  }
+  timeConnectionStart();
+  // 0xF0, 0x00, 0x01 are in the crc, 0x74 is the last byte so far
+  streamCrc = (0xF0 & 0x7F) ^ 0x00 ^ 0x01;
+  streamLast = 0x74;
+  // function id 0 is not used, it means the message is ignored
+  streamFuncId = 0xFF;
+}
+void BMCFas::sysExStreamByte(uint8_t port, uint16_t index, uint8_t value){
+  if(streamFuncId==0){
+    return;
+  }
+  streamCrc ^= streamLast;
+  streamLast = value;
+  if(index==5){
+    streamFuncId = value;
+    streamPos = 0;
+    streamCount = 0;
+    if(value==BMC_FAS_FUNC_ID_BLOCKS_DATA){
+      streamBlocks.reset();
+    } else if(value==BMC_FAS_FUNC_ID_PRESET_NAME){
+      memset(streamName, 0, sizeof(streamName));
+    } else {
+      streamFuncId = 0;
+    }
+    return;
+  }
+  if(index<6){
+    return;
+  }
+  if(streamFuncId==BMC_FAS_FUNC_ID_BLOCKS_DATA){
+    // each block is 32 bits sent as 5 midi words, LSB first
+    streamWord[streamPos++] = value;
+    if(streamPos==5){
+      uint32_t block = BMC_MIDI_WORDS_TO_INT(streamWord[4],streamWord[3],streamWord[2],streamWord[1],streamWord[0]) & BMC_MASK_32;
+      streamBlocks.set((block>>24) & 0xFF, bitRead(block, 0), !bitRead(block, 1));
+      streamPos = 0;
+      streamCount++;
+    }
+  } else if(streamFuncId==BMC_FAS_FUNC_ID_PRESET_NAME){
+    if(streamPos < sizeof(streamName)-1){
+      streamName[streamPos++] = (char) value;
+    }
+  }
+}
+void BMCFas::sysExStreamEnd(uint8_t port, bool complete){
+  uint8_t funcId = streamFuncId;
+  streamFuncId = 0;
+  if(!complete || funcId==0){
+    return;
+  }
+  if(funcId==BMC_FAS_FUNC_ID_BLOCKS_DATA){
+    // the checksum is the only byte after the last block
+    if(streamPos!=1 || streamCrc!=streamLast){
+      BMC_PRINTLN("!!!  FAS Received Bad CRC  !!!");
+      return;
+    }
+    BMC_PRINTLN("--> FAS BLOCKS RECEIVED:", streamCount);
+    uint8_t crc = device.blocks.getCRC();
+    device.blocks = streamBlocks;
+    blocksReceived(crc);
+  } else if(funcId==BMC_FAS_FUNC_ID_PRESET_NAME){
+    if(streamCrc!=streamLast){
+      BMC_PRINTLN("!!!  FAS Received Bad CRC  !!!");
+      return;
+    }
+    strcpy(device.presetName, streamName);
+    presetNameReceived();
+  }
+}
+#endif
 
-
+bool BMCFas::isValidFasFunction(uint8_t funcId){
+  switch(funcId){
+    case BMC_FAS_FUNC_ID_BLOCK_PARAM:
+    case BMC_FAS_FUNC_ID_FIRMWARE:
+    case BMC_FAS_FUNC_ID_BLOCKS_DATA:
+    case BMC_FAS_FUNC_ID_TUNER_INFO:
+    case BMC_FAS_FUNC_ID_PRESET_NAME:
+    case BMC_FAS_FUNC_ID_BLOCK_XY:
+    case BMC_FAS_FUNC_ID_CPU:
+    case BMC_FAS_FUNC_ID_GET_PRESET_NUMBER:
+    case BMC_FAS_FUNC_ID_GET_MIDI_CHANNEL:
+    case BMC_FAS_FUNC_ID_RESYNC:
+    case BMC_FAS_FUNC_ID_LOOPER:
+    case BMC_FAS_FUNC_ID_SCENE_NUMBER:
+    case BMC_FAS_FUNC_ID_SET_PRESET_NUMBER:
+    case BMC_FAS_FUNC_ID_DISCONNECT:
+    case BMC_FAS_FUNC_ID_GENERAL_PURPOSE:
+      return true;
+  }
+  return false;
+}
 
 
 
@@ -411,7 +547,7 @@ bool BMCFas::incoming(BMCMidiMessage& message){
 // DEBUGGING
 
 #ifdef BMC_DEBUG
-String BMCFas::debugPrintDeviceName(uint8_t id){
+const char * BMCFas::debugPrintDeviceName(uint8_t id){
   switch(id){
     case BMC_FAS_DEVICE_ID_AXE_FX_II:         return "Axe Fx II";
     case BMC_FAS_DEVICE_ID_AXE_FX_II_XL:      return "Axe Fx II XL";
@@ -422,8 +558,10 @@ String BMCFas::debugPrintDeviceName(uint8_t id){
   }
   return "";
 }
-String BMCFas::debugPrintPreset(){
-  char buff[30];
+const char * BMCFas::debugPrintPreset(){
+  // only used for debug output, it's overwritten on every call
+  static char buff[30];
+  BMCFormat output(buff, sizeof(buff));
   switch(device.id){
     case BMC_FAS_DEVICE_ID_AXE_FX_II:
     case BMC_FAS_DEVICE_ID_AXE_FX_II_XL:
@@ -431,19 +569,19 @@ String BMCFas::debugPrintPreset(){
       uint8_t preset = (device.preset & 0x7F)+1;
       uint8_t bank = ((device.preset>>7) & 0x7F);
       bank = constrain(bank, 0, 25);
-      sprintf(buff, "(%03u) BANK: %c | PRESET: %03u", device.preset, (char) bmcAlphabet[bank], preset);
-      String output(buff);
-      return output;
+      output.addChar('(').addNumber(device.preset, 3).addString(") BANK: ");
+      output.addChar((char) bmcAlphabet[bank]).addString(" | PRESET: ").addNumber(preset, 3);
+      break;
     }
     case BMC_FAS_DEVICE_ID_AX8:{
       uint8_t preset = (device.preset & 0x07)+1;
       uint8_t bank = (device.preset>>3)+1;
-      sprintf(buff, "(%03u) BANK: %02u | PRESET: %01u", device.preset, bank, preset);
-      String output(buff);
-      return output;
+      output.addChar('(').addNumber(device.preset, 3).addString(") BANK: ");
+      output.addNumber(bank, 2).addString(" | PRESET: ").addNumber(preset, 1);
+      break;
     }
   }
-  return "";
+  return output.get();
 }
 void BMCFas::debugPrintFasMessageInfo(BMCMidiMessage& message){
   char str[50];
@@ -470,27 +608,6 @@ void BMCFas::debugPrintFasMessageInfo(BMCMidiMessage& message){
     BMC_PRINTLN("--> FAS MESSAGE RECEIVED, ID:", message.sysex[5], str, "SIZE:", message.size());
   }
 }
-bool BMCFas::isValidFasFunction(uint8_t funcId){
-  switch(funcId){
-    case BMC_FAS_FUNC_ID_BLOCK_PARAM:
-    case BMC_FAS_FUNC_ID_FIRMWARE:
-    case BMC_FAS_FUNC_ID_BLOCKS_DATA:
-    case BMC_FAS_FUNC_ID_TUNER_INFO:
-    case BMC_FAS_FUNC_ID_PRESET_NAME:
-    case BMC_FAS_FUNC_ID_BLOCK_XY:
-    case BMC_FAS_FUNC_ID_CPU:
-    case BMC_FAS_FUNC_ID_GET_PRESET_NUMBER:
-    case BMC_FAS_FUNC_ID_GET_MIDI_CHANNEL:
-    case BMC_FAS_FUNC_ID_RESYNC:
-    case BMC_FAS_FUNC_ID_LOOPER:
-    case BMC_FAS_FUNC_ID_SCENE_NUMBER:
-    case BMC_FAS_FUNC_ID_SET_PRESET_NUMBER:
-    case BMC_FAS_FUNC_ID_DISCONNECT:
-    case BMC_FAS_FUNC_ID_GENERAL_PURPOSE:
-      return true;
-  }
-  return false;
-}
 #endif
 
 #endif
@@ -52,6 +52,8 @@
 #define BMC_FAS_FLAG_TEMPO_RECEIVED               11
 #define BMC_FAS_FLAG_LOOPER_TRACK_AVAILABLE       12
 #define BMC_FAS_FLAG_CONNECTION_LOST              13
+#define BMC_FAS_FLAG_SYNC_RUNNING                 14
+#define BMC_FAS_FLAG_SYNC_NAME_KNOWN              15
 
 
 #define BMC_FAS_TUNER_FLAG_ACTIVE                 0
@@ -67,6 +69,12 @@
 #define BMC_FAS_RESYNC_QUEUE_TIMEOUT 250
 #define BMC_FAS_CONNECTION_LOST_TIMEOUT 5000
 
+// max number of resync requests waiting for a response at the same time,
+// a request with no response after BMC_FAS_RESYNC_TIMEOUT is sent again
+#ifndef BMC_FAS_SYNC_MAX_IN_FLIGHT
+  #define BMC_FAS_SYNC_MAX_IN_FLIGHT 3
+#endif
+
 // function id list for Axe Fx II and AX8
 #define BMC_FAS_FUNC_ID_BLOCK_PARAM           0x02
 #define BMC_FAS_FUNC_ID_FIRMWARE              0x08
@@ -101,7 +109,11 @@
 #define BMC_FAS_FUNC_ID_DISCONNECT            0x42
 #define BMC_FAS_FUNC_ID_GENERAL_PURPOSE       0x64
 
-class BMCFas {
+class BMCFas
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  : public BMCSysExStreamHandler
+#endif
+{
 private:
   BMCMidi& midi;
   BMCGlobals& globals;
@@ -113,19 +125,44 @@ private:
   BMCTimer tunerTimeout;
   BMCTimer looperTimeout;
   BMCTimer connectionLost;
+  // function ids of the resync requests waiting for a response, 0 if free
+  uint8_t syncPending[BMC_FAS_SYNC_MAX_IN_FLIGHT];
+  BMCTimer syncPendingTimeout[BMC_FAS_SYNC_MAX_IN_FLIGHT];
+  unsigned long syncStart = 0;
+  uint16_t syncLatency = 0;
+  uint16_t syncLatencyMax = 0;
+  uint16_t syncCount = 0;
+  uint16_t syncRetries = 0;
   BMCFasData device;
+  // 1 bit per synced parameter slot requested in the current sync pass
+  uint32_t paramRequested = 0;
   BMCTunerData tunerData;
   uint8_t attempts = 0;
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  // state of the Fractal SysEx being read from the stream, only block data
+  // and preset names are read this way, everything else goes thru incoming()
+  uint8_t streamFuncId = 0;
+  // xor of all bytes so far except the last one, which may be the checksum
+  uint8_t streamCrc = 0;
+  uint8_t streamLast = 0;
+  uint8_t streamPos = 0;
+  uint8_t streamCount = 0;
+  // blocks are read here and only replace device.blocks if the
+  // message is complete and the checksum is valid
+  BMCFasBlockStates streamBlocks;
+  uint8_t streamWord[5];
+  char streamName[32];
+#endif
   bool isAxe3(uint8_t id){
     return (id==BMC_FAS_DEVICE_ID_AXE_FX_III || id==BMC_FAS_DEVICE_ID_FM3);
   }
 
 #ifdef BMC_DEBUG
-  String debugPrintDeviceName(uint8_t id);
-  String debugPrintPreset();
+  const char * debugPrintDeviceName(uint8_t id);
+  const char * debugPrintPreset();
   void debugPrintFasMessageInfo(BMCMidiMessage& message);
-  bool isValidFasFunction(uint8_t funcId);
 #endif
+  bool isValidFasFunction(uint8_t funcId);
 
   void timeConnectionStart(){
     flags.off(BMC_FAS_FLAG_CONNECTION_LOST);
@@ -138,6 +175,11 @@ public:
   void begin();
   void update();
   bool incoming(BMCMidiMessage& message);
+#ifdef BMC_SYSEX_STREAM_ENABLED
+  void sysExStreamBegin(uint8_t port);
+  void sysExStreamByte(uint8_t port, uint16_t index, uint8_t value);
+  void sysExStreamEnd(uint8_t port, bool complete);
+#endif
 
   void setSyncedParameter(uint8_t slot, uint8_t block, uint8_t parameter){
     device.paramSet(slot, block, parameter);
@@ -149,7 +191,7 @@ public:
     return device.paramGetValue(slot);
   }
   void sendChangeSyncedParameter(uint8_t slot, uint16_t value){
-    if(slot>7){
+    if(slot>=BMC_FAS_MAX_SYNCED_PARAMETERS){
       return;
     }
     uint8_t block = device.parameters[slot]>>8;
@@ -197,6 +239,22 @@ public:
   bool syncing(){
     return flags.read(BMC_FAS_FLAG_SYNCING);
   }
+  // milliseconds from the first request of the last resync until
+  // all of it's responses were received
+  uint16_t getSyncLatency(){
+    return syncLatency;
+  }
+  uint16_t getSyncLatencyMax(){
+    return syncLatencyMax;
+  }
+  // number of completed resyncs
+  uint16_t getSyncCount(){
+    return syncCount;
+  }
+  // number of resync requests that had to be sent again
+  uint16_t getSyncRetries(){
+    return syncRetries;
+  }
   bool looperEnable(bool value){
     if(value!=device.getLooperState()){
       device.looper.changeState(value);
@@ -355,6 +413,7 @@ public:
     findDeviceTimer.stop();
     startSyncTimer.stop();
     resyncTimer.stop();
+    syncPendingReset();
     tunerTimeout.stop();
     looperTimeout.stop();
     tunerData.reset();
@@ -571,6 +630,9 @@ private:
       true // should it trigger MIDI Out activity
     );
   }
+  // BMC-Fas.cpp
+  void blocksReceived(uint8_t crc);
+  void presetNameReceived();
   // received the resync message
   void receivedReSync(bool quick=false){
     if(resyncTimer.active()){
@@ -597,11 +659,24 @@ private:
       resyncTimer.start(750);
     }
   }
+  // start requesting the synced parameters, @restart starts a new pass
+  // even if one is already running
+  void beginParameterSync(bool restart){
+    if(restart || !flags.read(BMC_FAS_FLAG_SYNC_PARAM_SYNC_BEGIN)){
+      flags.on(BMC_FAS_FLAG_SYNC_PARAM_SYNC_BEGIN);
+      paramRequested = 0;
+    }
+    requestSyncParameters();
+  }
   bool requestSyncParameters(){
     if(!flags.read(BMC_FAS_FLAG_SYNC_PARAM_SYNC_BEGIN)){
       return false;
     }
-    for(uint8_t i = 0 ; i < 8 ; i++){
+    // parameters are requested one at a time, the response requests the next one
+    if(syncIsPending(BMC_FAS_FUNC_ID_BLOCK_PARAM)){
+      return true;
+    }
+    for(uint8_t i = 0 ; i < BMC_FAS_MAX_SYNCED_PARAMETERS ; i++){
       if(device.parameters[i]==0){
         continue;
       }
@@ -610,6 +685,15 @@ private:
       if(!device.blocks.isLoaded(block) || device.paramIsSynced(block, param)){
         continue;
       }
+      // requested once per pass, a parameter the device doesn't reply to
+      // or that was dropped from the cache isn't requested again
+      if(bitRead(paramRequested, i)){
+        continue;
+      }
+      if(!syncRequestSent(BMC_FAS_FUNC_ID_BLOCK_PARAM)){
+        return true;
+      }
+      bitWrite(paramRequested, i, 1);
       BMC_PRINTLN("***** FAS Request Synced Parameters",block, param);
       controlBlockParameter(block, param, 0, false);
       return true;
@@ -632,25 +716,120 @@ private:
   }
 
 
+  // Resync requests in flight, responses are matched by their function id
+  void syncPendingReset(){
+    for(uint8_t i = 0 ; i < BMC_FAS_SYNC_MAX_IN_FLIGHT ; i++){
+      syncPending[i] = 0;
+      syncPendingTimeout[i].stop();
+    }
+  }
+  bool syncIsPending(uint8_t funcId){
+    for(uint8_t i = 0 ; i < BMC_FAS_SYNC_MAX_IN_FLIGHT ; i++){
+      if(syncPending[i] == funcId){
+        return true;
+      }
+    }
+    return false;
+  }
+  bool syncIsIdle(){
+    for(uint8_t i = 0 ; i < BMC_FAS_SYNC_MAX_IN_FLIGHT ; i++){
+      if(syncPending[i] != 0){
+        return false;
+      }
+    }
+    return true;
+  }
+  // false if there's no room for another request
+  bool syncRequestSent(uint8_t funcId){
+    for(uint8_t i = 0 ; i < BMC_FAS_SYNC_MAX_IN_FLIGHT ; i++){
+      if(syncPending[i] == 0){
+        syncPending[i] = funcId;
+        syncPendingTimeout[i].start(BMC_FAS_RESYNC_TIMEOUT);
+        return true;
+      }
+    }
+    return false;
+  }
+  void syncReceived(uint8_t funcId){
+    for(uint8_t i = 0 ; i < BMC_FAS_SYNC_MAX_IN_FLIGHT ; i++){
+      if(syncPending[i] == funcId){
+        syncPending[i] = 0;
+        syncPendingTimeout[i].stop();
+        return;
+      }
+    }
+  }
+  // send the request if its data is still expected and it's not already in flight
+  void syncRequest(uint8_t flag, uint8_t funcId){
+    if(!flags.read(flag) || syncIsPending(funcId) || !syncRequestSent(funcId)){
+      return;
+    }
+    if(funcId == BMC_FAS_FUNC_ID_SCENE_NUMBER){
+      requestScene();
+    } else {
+      sendBasicSysEx(funcId);
+    }
+  }
+  bool syncExpectsData(){
+    return flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PRESET) ||
+          flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PRESET_NAME) ||
+          flags.read(BMC_FAS_FLAG_SYNC_EXPECT_BLOCKS) ||
+          flags.read(BMC_FAS_FLAG_SYNC_EXPECT_SCENE) ||
+          flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PARAMETERS);
+  }
   // Preset Sync Queue
+  // once resyncTimer is done all the independent requests are sent back
+  // to back, up to BMC_FAS_SYNC_MAX_IN_FLIGHT at a time, the preset name
+  // waits for the preset number so it can be skipped if the preset didn't
+  // change and parameters wait for the preset, blocks and scene
   void presetSyncQueue(){
-    // sync preset
-    if(connected() && resyncTimer.complete()){
-      resyncTimer.start(BMC_FAS_RESYNC_TIMEOUT);
-      if(flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PRESET)){
-        requestPresetNumber();
-      } else if(flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PRESET_NAME)){
-        requestPresetName();
-      } else if(flags.read(BMC_FAS_FLAG_SYNC_EXPECT_BLOCKS)){
-        sendBasicSysEx(BMC_FAS_FUNC_ID_BLOCKS_DATA);
-      } else if(flags.read(BMC_FAS_FLAG_SYNC_EXPECT_SCENE)){
-        requestScene();
-      } else if(flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PARAMETERS)){
-        flags.on(BMC_FAS_FLAG_SYNC_PARAM_SYNC_BEGIN);
-        requestSyncParameters();
-      } else {
-        resyncTimer.stop();
-        BMC_INFO("FAS RE-SYNC COMPLETE");
+    if(!connected()){
+      return;
+    }
+    if(resyncTimer.active()){
+      if(!resyncTimer.complete()){
+        return;
+      }
+      if(!flags.read(BMC_FAS_FLAG_SYNC_RUNNING)){
+        flags.on(BMC_FAS_FLAG_SYNC_RUNNING);
+        syncStart = millis();
+      }
+    }
+    if(!flags.read(BMC_FAS_FLAG_SYNC_RUNNING)){
+      return;
+    }
+    // requests without a response are dropped so they are sent again
+    for(uint8_t i = 0 ; i < BMC_FAS_SYNC_MAX_IN_FLIGHT ; i++){
+      if(syncPending[i] != 0 && syncPendingTimeout[i].complete()){
+        BMC_PRINTLN("FAS RE-SYNC REQUEST TIMED OUT", syncPending[i]);
+        syncPending[i] = 0;
+        syncRetries++;
+      }
+    }
+    syncRequest(BMC_FAS_FLAG_SYNC_EXPECT_PRESET, BMC_FAS_FUNC_ID_GET_PRESET_NUMBER);
+    syncRequest(BMC_FAS_FLAG_SYNC_EXPECT_BLOCKS, BMC_FAS_FUNC_ID_BLOCKS_DATA);
+    syncRequest(BMC_FAS_FLAG_SYNC_EXPECT_SCENE, BMC_FAS_FUNC_ID_SCENE_NUMBER);
+    if(!flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PRESET)){
+      syncRequest(BMC_FAS_FLAG_SYNC_EXPECT_PRESET_NAME, BMC_FAS_FUNC_ID_PRESET_NAME);
+    }
+    // a new preset clears the parameters so they wait for the preset number too
+    if(flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PARAMETERS) &&
+      !flags.read(BMC_FAS_FLAG_SYNC_EXPECT_PRESET) &&
+      !flags.read(BMC_FAS_FLAG_SYNC_EXPECT_BLOCKS) &&
+      !flags.read(BMC_FAS_FLAG_SYNC_EXPECT_SCENE)){
+      beginParameterSync(false);
+    }
+    if(!syncExpectsData() && syncIsIdle()){
+      flags.off(BMC_FAS_FLAG_SYNC_RUNNING);
+      unsigned long elapsed = millis() - syncStart;
+      syncLatency = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t) elapsed;
+      if(syncLatency > syncLatencyMax){
+        syncLatencyMax = syncLatency;
+      }
+      syncCount++;
+      BMC_INFO("FAS RE-SYNC COMPLETE", syncLatency, "ms");
+      if(midi.callback.fasSyncComplete){
+        midi.callback.fasSyncComplete(syncLatency);
       }
     }
   }
@@ -3,6 +3,15 @@
   Copyright (c) 2020 RoxXxtar.com
   Licensed under the MIT license.
   See LICENSE file in the project root for full license information.
+
+  Keeps track of the Helix state from the Control Changes and Program Changes
+  the Helix sends on it's port, snapshot, preset, setlist, footswitches and
+  looper are cached as they are received.
+
+  Changes are published after BMC_HELIX_DEBOUNCE milliseconds without a new
+  change (or BMC_HELIX_DEBOUNCE_MAX since the first one) so scrolling thru
+  snapshots only updates the LEDs and triggers the callbacks once it settles,
+  LED events always read the published state.
 */
 #ifndef BMC_HELIX_H
 #define BMC_HELIX_H
@@ -11,29 +20,124 @@
 
 #ifdef BMC_USE_HELIX
 
+#if !defined(BMC_HELIX_DEBOUNCE)
+  #define BMC_HELIX_DEBOUNCE 30
+#endif
+
+#if !defined(BMC_HELIX_DEBOUNCE_MAX)
+  #define BMC_HELIX_DEBOUNCE_MAX 150
+#endif
+
+// Helix Floor footswitches FS1 to FS5 and FS7 to FS11
+#define BMC_HELIX_CC_FS1 49
+#define BMC_HELIX_CC_FS11 58
+#define BMC_HELIX_CC_SETLIST 32
+#define BMC_HELIX_CC_LOOPER_RECORD 60
+#define BMC_HELIX_CC_LOOPER_PLAY 61
+#define BMC_HELIX_CC_LOOPER_PLAY_ONCE 62
+#define BMC_HELIX_CC_LOOPER_REVERSE 65
+#define BMC_HELIX_CC_LOOPER_HALF 66
+#define BMC_HELIX_CC_LOOPER_BLOCK 67
+
+#define BMC_HELIX_MAX_FOOTSWITCHES 10
+
+// bits of the looper state
+#define BMC_HELIX_LOOPER_RECORDING 0
+#define BMC_HELIX_LOOPER_OVERDUBBING 1
+#define BMC_HELIX_LOOPER_PLAYING 2
+#define BMC_HELIX_LOOPER_REVERSED 3
+#define BMC_HELIX_LOOPER_HALF 4
+#define BMC_HELIX_LOOPER_ACTIVE 5
+
+struct bmcHelixState {
+  uint8_t snapshot = 0;
+  uint8_t preset = 0;
+  uint8_t setlist = 0;
+  uint8_t looper = 0;
+  uint16_t footswitches = 0;
+};
+
 class BMCHelix {
 public:
   BMCHelix(BMCMidi& t_midi) : midi(t_midi){
     //
   }
   void update(){
+    // control changes sent by other BMC events to the snapshot cc
     uint8_t cc = midi.getLocalControl(channel,BMC_HELIX_CC_SNAPSHOT);
-    if(channel!=0 && cc!=snapshot){
+    if(channel!=0 && cc!=localSnapshot){
+      localSnapshot = cc;
       if(cc<getMaxSnapshots()){
-        snapshot = cc;
+        setState(state.snapshot, cc);
       }
     }
-    //snapshot
+    if(debounce.complete() || (changed && (millis()-changedSince) >= BMC_HELIX_DEBOUNCE_MAX)){
+      publish();
+    }
   }
-  void incoming(BMCMidiMessage m){
+  void incoming(BMCMidiMessage& m){
     // used to read incoming messages
-    if(m.matchSource(port)){
-      if(m.isControlChange() && m.matchChannel(channel)){
-        if(m.isData1(BMC_HELIX_CC_SNAPSHOT)){
-          snapshot = m.getData2();
+    if(!m.matchSource(port) || !m.matchChannel(channel)){
+      return;
+    }
+    if(m.isProgramChange()){
+      setState(state.preset, m.getData1());
+      return;
+    }
+    if(!m.isControlChange()){
+      return;
+    }
+    uint8_t cc = m.getData1();
+    bool on = m.getData2() >= 64;
+    if(cc >= BMC_HELIX_CC_FS1 && cc <= BMC_HELIX_CC_FS11){
+      uint16_t fs = state.footswitches;
+      bitWrite(fs, cc-BMC_HELIX_CC_FS1, on);
+      setState(state.footswitches, fs);
+      return;
+    }
+    uint8_t looper = state.looper;
+    switch(cc){
+      case BMC_HELIX_CC_SNAPSHOT:
+        if(m.getData2() < getMaxSnapshots()){
+          setState(state.snapshot, m.getData2());
         }
-      }
+        return;
+      case BMC_HELIX_CC_SETLIST:
+        setState(state.setlist, m.getData2());
+        return;
+      case BMC_HELIX_CC_LOOPER_RECORD:
+        // 64-127 record, 0-63 overdub
+        bitWrite(looper, BMC_HELIX_LOOPER_RECORDING, on);
+        bitWrite(looper, BMC_HELIX_LOOPER_OVERDUBBING, !on);
+        bitWrite(looper, BMC_HELIX_LOOPER_PLAYING, 1);
+        break;
+      case BMC_HELIX_CC_LOOPER_PLAY:
+        // 64-127 play, 0-63 stop
+        bitWrite(looper, BMC_HELIX_LOOPER_RECORDING, 0);
+        bitWrite(looper, BMC_HELIX_LOOPER_OVERDUBBING, 0);
+        bitWrite(looper, BMC_HELIX_LOOPER_PLAYING, on);
+        break;
+      case BMC_HELIX_CC_LOOPER_PLAY_ONCE:
+        bitWrite(looper, BMC_HELIX_LOOPER_RECORDING, 0);
+        bitWrite(looper, BMC_HELIX_LOOPER_OVERDUBBING, 0);
+        bitWrite(looper, BMC_HELIX_LOOPER_PLAYING, 1);
+        break;
+      case BMC_HELIX_CC_LOOPER_REVERSE:
+        bitWrite(looper, BMC_HELIX_LOOPER_REVERSED, on);
+        break;
+      case BMC_HELIX_CC_LOOPER_HALF:
+        bitWrite(looper, BMC_HELIX_LOOPER_HALF, on);
+        break;
+      case BMC_HELIX_CC_LOOPER_BLOCK:
+        bitWrite(looper, BMC_HELIX_LOOPER_ACTIVE, on);
+        if(!on){
+          looper = 0;
+        }
+        break;
+      default:
+        return;
     }
+    setState(state.looper, looper);
   }
   void setDeviceId(uint8_t value){
     switch(value & 0x0F){
@@ -54,11 +158,35 @@ public:
     uint8_t x = 0;
     port = bitWrite(x,value,1);
   }
+  // the published state, the same the leds show
   uint8_t getSnapshot(){
-    return snapshot;
+    return published.snapshot;
   }
   bool isSnapshot(uint8_t t_value){
-    return snapshot==t_value;
+    return published.snapshot==t_value;
+  }
+  uint8_t getPreset(){
+    return published.preset;
+  }
+  bool isPreset(uint8_t t_value){
+    return published.preset==t_value;
+  }
+  uint8_t getSetList(){
+    return published.setlist;
+  }
+  // @n is 0 to 9 for FS1-FS5 and FS7-FS11
+  bool isFootswitchOn(uint8_t n){
+    return n < BMC_HELIX_MAX_FOOTSWITCHES && bitRead(published.footswitches, n);
+  }
+  uint8_t getLooperState(){
+    return published.looper;
+  }
+  // @n is one of BMC_HELIX_LOOPER_*
+  bool isLooper(uint8_t n){
+    return bitRead(published.looper, n);
+  }
+  bool looperRecordingOrDubbing(){
+    return isLooper(BMC_HELIX_LOOPER_RECORDING) || isLooper(BMC_HELIX_LOOPER_OVERDUBBING);
   }
   void command(uint8_t t_id, uint8_t t_valueA, uint8_t t_valueB){
     switch(t_id){
@@ -83,9 +211,7 @@ public:
     }
   }
   void snapshotScroll(bool up){
-    //getMaxSnapshots()
-    //snapshot
-    BMCScroller <uint8_t> scroller(snapshot, 0, getMaxSnapshots()-1);
+    BMCScroller <uint8_t> scroller(state.snapshot, 0, getMaxSnapshots()-1);
     setSnapshot(scroller.scroll(1, up, true));
   }
   void tap(){
@@ -100,29 +226,24 @@ public:
         midi.sendControlChange(port, channel, BMC_HELIX_CC_SNAPSHOT, t_value);
         if(t_value==8){
           // next snapshot
-          if((snapshot+1)>=getMaxSnapshots()){
-            snapshot = 0;
-          }
+          setState(state.snapshot, ((state.snapshot+1)>=getMaxSnapshots()) ? 0 : state.snapshot+1);
         } else if(t_value==9){
           // prev snapshot
-          if(snapshot==0){
-            snapshot = getMaxSnapshots()-1;
-          }
+          setState(state.snapshot, (state.snapshot==0) ? getMaxSnapshots()-1 : state.snapshot-1);
         } else {
-          snapshot = t_value;
+          setState(state.snapshot, t_value);
         }
-
       }
     } else {
       if(validateSnapshot(t_value)){
         midi.sendControlChange(port, channel, BMC_HELIX_CC_SNAPSHOT, t_value);
-        snapshot = t_value;
+        setState(state.snapshot, t_value);
       }
     }
   }
   void toggleSnapshot(uint8_t a, uint8_t b){
     if(validateSnapshot(a) && validateSnapshot(b)){
-      setSnapshot((snapshot==a)?b:a);
+      setSnapshot((state.snapshot==a)?b:a);
     }
   }
 
@@ -131,8 +252,48 @@ private:
   uint8_t id = 0;
   uint8_t channel = 0;
   uint8_t port = 0;
-  uint8_t snapshot = 0;
   uint8_t maxSnapshots = 3;
+  uint8_t localSnapshot = 0;
+  // state as received and the state last published
+  bmcHelixState state;
+  bmcHelixState published;
+  bool changed = false;
+  unsigned long changedSince = 0;
+  BMCTimer debounce;
+
+  template <typename T>
+  void setState(T& field, T value){
+    if(field == value){
+      return;
+    }
+    field = value;
+    if(!changed){
+      changed = true;
+      changedSince = millis();
+    }
+    debounce.start(BMC_HELIX_DEBOUNCE);
+  }
+  void setState(uint8_t& field, int value){
+    setState(field, (uint8_t) value);
+  }
+  void publish(){
+    debounce.stop();
+    changed = false;
+    bmcHelixState prev = published;
+    published = state;
+    if(prev.snapshot != published.snapshot && midi.callback.helixSnapshotChange){
+      midi.callback.helixSnapshotChange(published.snapshot);
+    }
+    if(prev.preset != published.preset && midi.callback.helixPresetChange){
+      midi.callback.helixPresetChange(published.preset);
+    }
+    if(prev.footswitches != published.footswitches && midi.callback.helixFootswitchesChange){
+      midi.callback.helixFootswitchesChange(published.footswitches);
+    }
+    if(prev.looper != published.looper && midi.callback.helixLooperChange){
+      midi.callback.helixLooperChange(published.looper);
+    }
+  }
 
   bool isDevice(uint8_t t_value){
     return id == t_value;
@@ -4,33 +4,78 @@
   Licensed under the MIT license.
   See LICENSE file in the project root for full license information.
 
-  Wrapper to control/read from Kemper Profilers, not tested but based on documentation
+  Sync with Kemper Profilers, based on the Kemper MIDI Parameter documentation.
 
-  This class is not Tested, if you own a Kemper profiler please help development
-  visit RoxXxtar.com/contact and message me.
-  Currently i'm trying to get my hands on a Kemper for testing once I do I will
-  implement the whole thing ;-)
+  The device is found by broadcasting a parameter request on all ports
+  except USB and BLE, the first port that answers is used from then on.
+  Once connected BMC sends the bidirectional beacon so the Kemper reports
+  it's own changes and keeps renewing it's lease while connected.
 
+  All requests go thru a queue that sends them at a fixed pace with only
+  a few waiting on a response at a time, the Kemper drops requests when
+  they come in faster than it can answer them.
+
+  A sync reads the rig name, performance name and the on/off state of
+  the effect modules (Stomp A, B, C, D, X, MOD, Delay and Reverb), it runs
+  after connecting and every time the rig changes.
+
+  SysEx format
   1: 0xF0
   2: 0x00
   3: 0x20
   4: 0x33
-  5: 0x02
-  6: 0x7F
-  7: message id
-  n: payload
+  5: product type
+  6: device id (0x7F = omni)
+  7: function code
+  8: instance (always 0)
+  9: address page
+  10: parameter number
+  n: payload, 14-bit values are MSB first
   n+payload: 0xF7
-
 */
 #ifndef BMC_KEMPER_H
 #define BMC_KEMPER_H
 #include "utility/BMC-Def.h"
 #if defined(BMC_USE_KEMPER)
 
+#include "utility/BMC-ParamCache.h"
+
 #if !defined(BMC_KEMPER_DEVICE_ID)
   #define BMC_KEMPER_DEVICE_ID 0x7F
 #endif
 
+// number of received parameter values kept, must be a power of 2
+#if !defined(BMC_KEMPER_PARAM_CACHE_SIZE)
+  #define BMC_KEMPER_PARAM_CACHE_SIZE 32
+#endif
+
+// requests waiting to be sent
+#if !defined(BMC_KEMPER_REQUEST_QUEUE_SIZE)
+  #define BMC_KEMPER_REQUEST_QUEUE_SIZE 16
+#endif
+
+// requests sent and waiting on a response at the same time
+#if !defined(BMC_KEMPER_MAX_IN_FLIGHT)
+  #define BMC_KEMPER_MAX_IN_FLIGHT 2
+#endif
+
+// minimum milliseconds between 2 requests
+#if !defined(BMC_KEMPER_REQUEST_INTERVAL)
+  #define BMC_KEMPER_REQUEST_INTERVAL 20
+#endif
+
+// milliseconds to wait on a response before sending the request again
+#if !defined(BMC_KEMPER_REQUEST_TIMEOUT)
+  #define BMC_KEMPER_REQUEST_TIMEOUT 250
+#endif
+
+#define BMC_KEMPER_REQUEST_RETRIES 2
+#define BMC_KEMPER_CONNECTION_LOST_TIMEOUT 3000
+// the lease is in units of 2 seconds, renewed at half of it
+#define BMC_KEMPER_BEACON_LEASE 5
+#define BMC_KEMPER_BEACON_RENEW ((BMC_KEMPER_BEACON_LEASE*2000UL)/2)
+#define BMC_KEMPER_NAME_LENGTH 32
+
 #define BMC_KEMPER_FN_CODE_PARAM_CHANGE 0x01
 #define BMC_KEMPER_FN_CODE_MULTI_PARAM_CHANGE 0x02
 #define BMC_KEMPER_FN_CODE_STRING_PARAM 0x03
@@ -42,40 +87,274 @@
 #define BMC_KEMPER_FN_CODE_REQUEST_STRING_PARAM 0x43
 #define BMC_KEMPER_FN_CODE_REQUEST_EXT_STRING_PARAM 0x47
 #define BMC_KEMPER_FN_CODE_REQUEST_PARAM_RENDERED_STRING 0x7C
+#define BMC_KEMPER_FN_CODE_BEACON 0x7E
+
+// beacon flags
+#define BMC_KEMPER_BEACON_FLAG_INIT 0x01
+#define BMC_KEMPER_BEACON_FLAG_SYSEX 0x02
+#define BMC_KEMPER_BEACON_FLAG_ECHO 0x04
+#define BMC_KEMPER_BEACON_FLAG_NOFE 0x08
+#define BMC_KEMPER_BEACON_FLAG_NOCTR 0x10
+#define BMC_KEMPER_BEACON_FLAG_TINFO 0x20
+
+// string parameters
+#define BMC_KEMPER_STRING_RIG_NAME 0x0001
+// extended string parameters
+#define BMC_KEMPER_EXT_STRING_PERFORMANCE_NAME 0x4000
+
+// request types
+#define BMC_KEMPER_REQUEST_NONE 0
+#define BMC_KEMPER_REQUEST_PARAM 1
+#define BMC_KEMPER_REQUEST_STRING 2
+#define BMC_KEMPER_REQUEST_EXT_STRING 3
+
+// effect modules
+#define BMC_KEMPER_MODULE_STOMP_A 0
+#define BMC_KEMPER_MODULE_STOMP_B 1
+#define BMC_KEMPER_MODULE_STOMP_C 2
+#define BMC_KEMPER_MODULE_STOMP_D 3
+#define BMC_KEMPER_MODULE_STOMP_X 4
+#define BMC_KEMPER_MODULE_MOD 5
+#define BMC_KEMPER_MODULE_DELAY 6
+#define BMC_KEMPER_MODULE_REVERB 7
+#define BMC_KEMPER_MAX_MODULES 8
+
+#define BMC_KEMPER_FLAG_DEVICE_SEARCH 0
+#define BMC_KEMPER_FLAG_CONNECTED 1
+#define BMC_KEMPER_FLAG_CONNECTION_CHANGED 2
+#define BMC_KEMPER_FLAG_CONNECTION_LOST 3
+#define BMC_KEMPER_FLAG_SYNC_RUNNING 4
+#define BMC_KEMPER_FLAG_RIG_CHANGED 5
+#define BMC_KEMPER_FLAG_MODULES_CHANGED 6
+
+struct bmcKemperRequest {
+  uint16_t param = 0;
+  uint8_t type = BMC_KEMPER_REQUEST_NONE;
+  uint8_t retries = 0;
+};
 
 class BMCKemper {
 public:
   BMCKemper(BMCMidi& t_midi):midi(t_midi){
-
+    rigName[0] = 0;
+    performanceName[0] = 0;
+    findDeviceTimer.stop();
+    requestsReset();
+  }
+  void begin(){
+    BMC_INFO("Kemper Sync Version 1.0");
+    flags.on(BMC_KEMPER_FLAG_DEVICE_SEARCH);
+    findDeviceTimer.start(1000);
   }
   void update(){
-
+    // search for a response from the Kemper, try up to 10 times every 5 seconds
+    if(flags.read(BMC_KEMPER_FLAG_DEVICE_SEARCH)){
+      if(attempts<10 && findDeviceTimer.complete()){
+        BMC_PRINTLN("   >> Looking for Kemper Device <<   ");
+        sendDeviceSearch();
+        findDeviceTimer.start(5000);
+        attempts++;
+      }
+      return;
+    }
+    if(!connected()){
+      return;
+    }
+    if(connectionLost.complete()){
+      if(flags.read(BMC_KEMPER_FLAG_CONNECTION_LOST)){
+        BMC_PRINTLN("No response from Kemper, connection lost...");
+        disconnect();
+        connect();
+        return;
+      }
+      // nothing received for a while, ask for something one last time
+      flags.on(BMC_KEMPER_FLAG_CONNECTION_LOST);
+      requestParameter(BMC_KEMPER_PARAM_RIG_VOLUME);
+      connectionLost.start(BMC_KEMPER_CONNECTION_LOST_TIMEOUT);
+    }
+    if(beaconTimer.complete()){
+      sendBeacon();
+    }
+    if(resyncTimer.complete()){
+      sync();
+    }
+    requestsUpdate();
   }
   void setChannel(uint8_t t_channel){
     channel = (t_channel & 0x0F) + 1;
   }
   void setPort(uint8_t t_port){
     // remove the port preset, ble and usb bits
-    port = t_port & 0xC1;
+    port = t_port & B00111110;
   }
   void incoming(BMCMidiMessage& message){
-    if(!isKemperSysExMessage()){
+    if(flags.read(BMC_KEMPER_FLAG_DEVICE_SEARCH)){
+      if(isKemperSysExMessage(message, 8)){
+        deviceFound(message.getPort());
+      }
+      return;
+    }
+    if(!connected() || !(message.getPort() & port)){
+      return;
+    }
+    if(isKemperSysExMessage(message)){
+      received();
       parseIncomingSysEx(message);
-    } else if(!isKemperMidiMessage()){
+    } else if(isKemperMidiMessage(message)){
       parseIncomingMidi(message);
     }
   }
+  bool connected(){
+    return flags.read(BMC_KEMPER_FLAG_CONNECTED);
+  }
+  bool connectionStateChanged(){
+    return flags.toggleIfTrue(BMC_KEMPER_FLAG_CONNECTION_CHANGED);
+  }
+  bool connect(){
+    if(connected() || flags.read(BMC_KEMPER_FLAG_DEVICE_SEARCH)){
+      return false;
+    }
+    attempts = 0;
+    flags.on(BMC_KEMPER_FLAG_DEVICE_SEARCH);
+    findDeviceTimer.trigger();
+    return true;
+  }
+  bool disconnect(){
+    if(!connected()){
+      return false;
+    }
+    BMC_PRINTLN("--> Kemper Disconnect");
+    flags.reset();
+    findDeviceTimer.stop();
+    connectionLost.stop();
+    beaconTimer.stop();
+    resyncTimer.stop();
+    requestsReset();
+    params.clear();
+    modules = 0;
+    modulesKnown = 0;
+    slot = 0xFF;
+    program = 0xFF;
+    rigName[0] = 0;
+    performanceName[0] = 0;
+    attempts = 0;
+    flags.on(BMC_KEMPER_FLAG_CONNECTION_CHANGED);
+    if(midi.callback.kemperConnection){
+      midi.callback.kemperConnection(false);
+    }
+    return true;
+  }
+  // request the rig names and module states again
+  void sync(){
+    if(!connected()){
+      return;
+    }
+    resyncTimer.stop();
+    if(!flags.read(BMC_KEMPER_FLAG_SYNC_RUNNING)){
+      flags.on(BMC_KEMPER_FLAG_SYNC_RUNNING);
+      syncStart = millis();
+    }
+    queueRequest(BMC_KEMPER_REQUEST_STRING, BMC_KEMPER_STRING_RIG_NAME);
+    queueRequest(BMC_KEMPER_REQUEST_EXT_STRING, BMC_KEMPER_EXT_STRING_PERFORMANCE_NAME);
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_MODULES ; i++){
+      queueRequest(BMC_KEMPER_REQUEST_PARAM, getModuleParameter(i));
+    }
+  }
+  bool syncing(){
+    return flags.read(BMC_KEMPER_FLAG_SYNC_RUNNING);
+  }
+  // true once after the rig name changed
+  bool rigChanged(){
+    return flags.toggleIfTrue(BMC_KEMPER_FLAG_RIG_CHANGED);
+  }
+  // true once after any module changed it's state
+  bool modulesChanged(){
+    return flags.toggleIfTrue(BMC_KEMPER_FLAG_MODULES_CHANGED);
+  }
+  char * getRigName(){
+    return rigName;
+  }
+  char * getPerformanceName(){
+    return performanceName;
+  }
+  // rig slot of the performance 0 to 4, 255 if unknown
+  uint8_t getSlot(){
+    return slot;
+  }
+  // last program change sent or received, 255 if unknown
+  uint8_t getProgram(){
+    return program;
+  }
+  // select rig slot 0 to 4 of the current performance
+  void setSlot(uint8_t n){
+    if(n > 4){
+      return;
+    }
+    midi.sendControlChange(port, channel, BMC_KEMPER_CC_FIRST_RIG+n, 1);
+    slot = n;
+    rigSelected();
+  }
+  void setProgram(uint8_t n){
+    midi.sendProgramChange(port, channel, n & 0x7F);
+    program = n & 0x7F;
+    rigSelected();
+  }
+  // @n is one of BMC_KEMPER_MODULE_*
+  bool isModuleOn(uint8_t n){
+    return n < BMC_KEMPER_MAX_MODULES && bitRead(modules, n);
+  }
+  bool isModuleKnown(uint8_t n){
+    return n < BMC_KEMPER_MAX_MODULES && bitRead(modulesKnown, n);
+  }
+  void setModule(uint8_t n, bool state){
+    if(n >= BMC_KEMPER_MAX_MODULES){
+      return;
+    }
+    sendSetParameter(getModuleParameter(n), state ? 1 : 0);
+    // the kemper doesn't echo our own changes back
+    moduleReceived(n, state);
+  }
+  void toggleModule(uint8_t n){
+    setModule(n, !isModuleOn(n));
+  }
+  // last value received for a parameter, 0 if it hasn't been received
+  uint16_t getParameter(uint8_t page, uint8_t param){
+    return getParameter(param|(page<<8));
+  }
+  uint16_t getParameter(uint16_t param){
+    return params.getValue(param);
+  }
+  bool isParameterReceived(uint16_t param){
+    return params.has(param);
+  }
+  // milliseconds the last sync took
+  uint16_t getSyncLatency(){
+    return syncLatency;
+  }
+  uint16_t getSyncLatencyMax(){
+    return syncLatencyMax;
+  }
+  uint16_t getSyncCount(){
+    return syncCount;
+  }
+  uint16_t getRequestRetries(){
+    return requestRetries;
+  }
+  uint8_t getRequestsQueued(){
+    return queueLength;
+  }
 
   // change a parameter value to kemper
-  void sendSetParameter(uint8_t page, uint8_t param, uint8_t value){
+  void sendSetParameter(uint8_t page, uint8_t param, uint16_t value){
     sendSetParameter(param|(page<<8), value);
   }
   void sendSetParameter(uint16_t param, uint16_t value){
     BMCMidiMessage message;
     prepSysEx(message, BMC_KEMPER_FN_CODE_PARAM_CHANGE);
-    message.appendToSysEx14BitsLSBFirst(param);
-    message.appendToSysEx14BitsLSBFirst(value);
+    appendParameter(message, param);
+    message.appendToSysEx14Bits(value);
     sendSysEx(message);
+    params.set(param, value);
   }
   // take value as a percentage from 0 to 100, non-float
   void sendSetParameterPercentage(uint8_t page, uint8_t param, uint8_t value){
@@ -83,72 +362,374 @@ public:
   }
   void sendSetParameterPercentage(uint16_t param, uint8_t value){
     value = constrain(value, 0, 100);
-    sendSetParameter(param, map(value, 0, 100, 0, 0xFFFFFFFF));
+    sendSetParameter(param, (uint16_t) map(value, 0, 100, 0, 0x3FFF));
   }
 
-  // Request a single parameter
+  // Queue a request for a single parameter
   void requestParameter(uint8_t page, uint8_t param){
     requestParameter(param|(page<<8));
   }
-  // Request a single parameter
   void requestParameter(uint16_t param){
-    BMCMidiMessage message;
-    prepSysEx(message, BMC_KEMPER_FN_CODE_REQUEST_SINGLE_PARAM);
-    message.appendToSysEx14BitsLSBFirst(param);
-    sendSysEx(message);
+    queueRequest(BMC_KEMPER_REQUEST_PARAM, param);
   }
-
-
-  // Request a string parameter
+  // Queue a request for a string parameter
   void requestStringParameter(uint8_t page, uint8_t param){
     requestStringParameter(param|(page<<8));
   }
-  // Request a string parameter
   void requestStringParameter(uint16_t param){
-    BMCMidiMessage message;
-    prepSysEx(message, BMC_KEMPER_FN_CODE_REQUEST_STRING_PARAM);
-    message.appendToSysEx14BitsLSBFirst(param);
-    sendSysEx(message);
+    queueRequest(BMC_KEMPER_REQUEST_STRING, param);
   }
 private:
   BMCMidi& midi;
-  uint8_t channel = 0;
+  BMCFlags <uint8_t> flags;
+  uint8_t channel = 1;
   uint8_t port = 0;
-  uint16_t rig = 0;
+  uint8_t attempts = 0;
+  uint8_t slot = 0xFF;
+  uint8_t program = 0xFF;
+  // bits of the modules that are on and modules whose state was received
+  uint8_t modules = 0;
+  uint8_t modulesKnown = 0;
+  char rigName[BMC_KEMPER_NAME_LENGTH];
+  char performanceName[BMC_KEMPER_NAME_LENGTH];
+  BMCParamCache <uint16_t, BMC_KEMPER_PARAM_CACHE_SIZE> params;
+  BMCTimer findDeviceTimer;
+  BMCTimer connectionLost;
+  BMCTimer beaconTimer;
+  BMCTimer resyncTimer;
+  // queued requests, oldest first
+  bmcKemperRequest queue[BMC_KEMPER_REQUEST_QUEUE_SIZE];
+  uint8_t queueHead = 0;
+  uint8_t queueLength = 0;
+  // requests waiting for a response
+  bmcKemperRequest pending[BMC_KEMPER_MAX_IN_FLIGHT];
+  BMCTimer pendingTimeout[BMC_KEMPER_MAX_IN_FLIGHT];
+  unsigned long lastRequest = 0;
+  unsigned long syncStart = 0;
+  uint16_t syncLatency = 0;
+  uint16_t syncLatencyMax = 0;
+  uint16_t syncCount = 0;
+  uint16_t requestRetries = 0;
+
+  uint16_t getModuleParameter(uint8_t n){
+    switch(n){
+      case BMC_KEMPER_MODULE_STOMP_A: return BMC_KEMPER_PARAM_STOMP_A_ON_OFF_4_MIX;
+      case BMC_KEMPER_MODULE_STOMP_B: return BMC_KEMPER_PARAM_STOMP_B_ON_OFF_4_MIX;
+      case BMC_KEMPER_MODULE_STOMP_C: return BMC_KEMPER_PARAM_STOMP_C_ON_OFF_4_MIX;
+      case BMC_KEMPER_MODULE_STOMP_D: return BMC_KEMPER_PARAM_STOMP_D_ON_OFF_4_MIX;
+      case BMC_KEMPER_MODULE_STOMP_X: return BMC_KEMPER_PARAM_STOMP_X_ON_OFF_4_MIX;
+      case BMC_KEMPER_MODULE_MOD: return BMC_KEMPER_PARAM_STOMP_MOD_ON_OFF_4_MIX;
+      case BMC_KEMPER_MODULE_DELAY: return BMC_KEMPER_PARAM_STOMP_DELAY_ON_OFF_4_MIX;
+      case BMC_KEMPER_MODULE_REVERB: return BMC_KEMPER_PARAM_REVERB_ON_OFF__CUTS_TAIL_;
+    }
+    return 0;
+  }
+  uint8_t getModuleFromParameter(uint16_t param){
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_MODULES ; i++){
+      if(getModuleParameter(i) == param){
+        return i;
+      }
+    }
+    return BMC_KEMPER_MAX_MODULES;
+  }
+  void deviceFound(uint8_t t_port){
+    port = t_port & B00111110;
+    if(port == 0){
+      return;
+    }
+    BMC_INFO("KEMPER FOUND DEVICE", BMCTools::getPortName(port));
+    flags.off(BMC_KEMPER_FLAG_DEVICE_SEARCH);
+    flags.on(BMC_KEMPER_FLAG_CONNECTED);
+    flags.on(BMC_KEMPER_FLAG_CONNECTION_CHANGED);
+    findDeviceTimer.stop();
+    attempts = 0;
+    received();
+    sendBeacon();
+    if(midi.callback.kemperConnection){
+      midi.callback.kemperConnection(true);
+    }
+    sync();
+  }
+  // any message from the kemper means it's still there
+  void received(){
+    flags.off(BMC_KEMPER_FLAG_CONNECTION_LOST);
+    connectionLost.start(BMC_KEMPER_CONNECTION_LOST_TIMEOUT);
+  }
+  // the rig takes a moment to load before it reports it's new state
+  void rigSelected(){
+    modulesKnown = 0;
+    resyncTimer.start(100);
+  }
+  void moduleReceived(uint8_t n, bool state){
+    if(isModuleKnown(n) && isModuleOn(n) == state){
+      return;
+    }
+    bitWrite(modules, n, state);
+    bitWrite(modulesKnown, n, 1);
+    flags.on(BMC_KEMPER_FLAG_MODULES_CHANGED);
+    if(midi.callback.kemperModulesChange){
+      midi.callback.kemperModulesChange();
+    }
+  }
+
+  // request scheduler
+  void requestsReset(){
+    queueHead = 0;
+    queueLength = 0;
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_IN_FLIGHT ; i++){
+      pending[i].type = BMC_KEMPER_REQUEST_NONE;
+      pendingTimeout[i].stop();
+    }
+  }
+  bool isQueued(uint8_t type, uint16_t param){
+    for(uint8_t i = 0 ; i < queueLength ; i++){
+      bmcKemperRequest& r = queue[(queueHead+i) % BMC_KEMPER_REQUEST_QUEUE_SIZE];
+      if(r.type == type && r.param == param){
+        return true;
+      }
+    }
+    return findPending(type, param) < BMC_KEMPER_MAX_IN_FLIGHT;
+  }
+  void queueRequest(uint8_t type, uint16_t param, uint8_t retries=0){
+    if(!connected() || queueLength >= BMC_KEMPER_REQUEST_QUEUE_SIZE || isQueued(type, param)){
+      return;
+    }
+    bmcKemperRequest& r = queue[(queueHead+queueLength) % BMC_KEMPER_REQUEST_QUEUE_SIZE];
+    r.type = type;
+    r.param = param;
+    r.retries = retries;
+    queueLength++;
+  }
+  uint8_t findPending(uint8_t type, uint16_t param){
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_IN_FLIGHT ; i++){
+      if(type != BMC_KEMPER_REQUEST_NONE && pending[i].type == type && pending[i].param == param){
+        return i;
+      }
+    }
+    return BMC_KEMPER_MAX_IN_FLIGHT;
+  }
+  uint8_t findFreePending(){
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_IN_FLIGHT ; i++){
+      if(pending[i].type == BMC_KEMPER_REQUEST_NONE){
+        return i;
+      }
+    }
+    return BMC_KEMPER_MAX_IN_FLIGHT;
+  }
+  void requestsUpdate(){
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_IN_FLIGHT ; i++){
+      if(pending[i].type != BMC_KEMPER_REQUEST_NONE && pendingTimeout[i].complete()){
+        bmcKemperRequest r = pending[i];
+        pending[i].type = BMC_KEMPER_REQUEST_NONE;
+        if(r.retries < BMC_KEMPER_REQUEST_RETRIES){
+          requestRetries++;
+          queueRequest(r.type, r.param, r.retries+1);
+        }
+      }
+    }
+    if(queueLength > 0 && (millis()-lastRequest) >= BMC_KEMPER_REQUEST_INTERVAL){
+      uint8_t n = findFreePending();
+      if(n < BMC_KEMPER_MAX_IN_FLIGHT){
+        pending[n] = queue[queueHead];
+        queueHead = (queueHead+1) % BMC_KEMPER_REQUEST_QUEUE_SIZE;
+        queueLength--;
+        pendingTimeout[n].start(BMC_KEMPER_REQUEST_TIMEOUT);
+        lastRequest = millis();
+        sendRequest(pending[n]);
+      }
+    }
+    if(syncing() && queueLength == 0 && isIdle()){
+      flags.off(BMC_KEMPER_FLAG_SYNC_RUNNING);
+      syncLatency = millis()-syncStart;
+      if(syncLatency > syncLatencyMax){
+        syncLatencyMax = syncLatency;
+      }
+      syncCount++;
+      BMC_INFO("KEMPER SYNC COMPLETE", syncLatency, "ms");
+      if(midi.callback.kemperSyncComplete){
+        midi.callback.kemperSyncComplete(syncLatency);
+      }
+    }
+  }
+  bool isIdle(){
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_IN_FLIGHT ; i++){
+      if(pending[i].type != BMC_KEMPER_REQUEST_NONE){
+        return false;
+      }
+    }
+    return true;
+  }
+  // a response arrived, frees it's slot if it was requested
+  void responseReceived(uint8_t type, uint16_t param){
+    uint8_t n = findPending(type, param);
+    if(n < BMC_KEMPER_MAX_IN_FLIGHT){
+      pending[n].type = BMC_KEMPER_REQUEST_NONE;
+      pendingTimeout[n].stop();
+    }
+  }
+  void sendRequest(bmcKemperRequest& r){
+    BMCMidiMessage message;
+    switch(r.type){
+      case BMC_KEMPER_REQUEST_PARAM:
+        prepSysEx(message, BMC_KEMPER_FN_CODE_REQUEST_SINGLE_PARAM);
+        appendParameter(message, r.param);
+        break;
+      case BMC_KEMPER_REQUEST_STRING:
+        prepSysEx(message, BMC_KEMPER_FN_CODE_REQUEST_STRING_PARAM);
+        appendParameter(message, r.param);
+        break;
+      case BMC_KEMPER_REQUEST_EXT_STRING:
+        prepSysEx(message, BMC_KEMPER_FN_CODE_REQUEST_EXT_STRING_PARAM);
+        appendExtendedParameter(message, r.param);
+        break;
+      default:
+        return;
+    }
+    sendSysEx(message);
+  }
+
   void parseIncomingSysEx(BMCMidiMessage& message){
-    if(message.size()<7){
+    if(message.size()<10){
       return;
     }
-    uint8_t code = message.get7Bits(6);
-    switch(code){
-      // respond to param change request
+    switch(message.get7Bits(6)){
       case BMC_KEMPER_FN_CODE_PARAM_CHANGE:
         receivedParameterValue(message);
         break;
+      case BMC_KEMPER_FN_CODE_MULTI_PARAM_CHANGE:
+        receivedMultiParameterValue(message);
+        break;
       case BMC_KEMPER_FN_CODE_STRING_PARAM:
         receivedStringParameterValue(message);
         break;
+      case BMC_KEMPER_FN_CODE_EXT_STRING_CHANGE:
+        receivedExtendedStringValue(message);
+        break;
     }
   }
   void parseIncomingMidi(BMCMidiMessage& message){
-
+    if(message.isProgramChange()){
+      if(program != message.getData1()){
+        program = message.getData1();
+        rigSelected();
+      }
+    } else if(message.isControlChange()){
+      uint8_t cc = message.getData1();
+      if(cc >= BMC_KEMPER_CC_FIRST_RIG && cc <= BMC_KEMPER_CC_FIFTH_RIG){
+        slot = cc-BMC_KEMPER_CC_FIRST_RIG;
+        rigSelected();
+      }
+    }
   }
-  void receivedParameterValue(BMCMidiMessage& message){
-    uint16_t param = message.get14BitsLSBFirst(7);
-    uint16_t value = message.get14BitsLSBFirst(9);
+  void parameterReceived(uint16_t param, uint16_t value){
+    responseReceived(BMC_KEMPER_REQUEST_PARAM, param);
+    params.set(param, value);
+    uint8_t module = getModuleFromParameter(param);
+    if(module < BMC_KEMPER_MAX_MODULES){
+      moduleReceived(module, value > 0);
+    }
     if(midi.callback.kemperParamReceived){
       midi.callback.kemperParamReceived(param, value);
     }
   }
+  void receivedParameterValue(BMCMidiMessage& message){
+    if(message.size()<13){
+      return;
+    }
+    parameterReceived(getParameterAddress(message), message.get14Bits(10));
+  }
+  // all values of a page starting at the parameter number
+  void receivedMultiParameterValue(BMCMidiMessage& message){
+    uint16_t param = getParameterAddress(message);
+    for(uint16_t i = 10 ; (i+2) < message.size() ; i += 2, param++){
+      parameterReceived(param, message.get14Bits(i));
+    }
+  }
   void receivedStringParameterValue(BMCMidiMessage& message){
-    uint16_t param = message.get14BitsLSBFirst(7);
-    uint8_t len = message.size()-8;
-    char str[len+1];
-    message.getStringFromSysEx(9, str, len);
+    uint16_t param = getParameterAddress(message);
+    responseReceived(BMC_KEMPER_REQUEST_STRING, param);
+    char str[BMC_KEMPER_NAME_LENGTH];
+    uint8_t len = getString(message, 10, str);
+    if(param == BMC_KEMPER_STRING_RIG_NAME){
+      if(strcmp(str, rigName) != 0){
+        strcpy(rigName, str);
+        flags.on(BMC_KEMPER_FLAG_RIG_CHANGED);
+        BMC_INFO("KEMPER RIG", rigName);
+        if(midi.callback.kemperRigChange){
+          midi.callback.kemperRigChange(rigName);
+        }
+        // the rig was changed on the kemper, read the new module states
+        if(!syncing()){
+          sync();
+        }
+      }
+    }
     if(midi.callback.kemperStringReceived){
       midi.callback.kemperStringReceived(param, str, len);
     }
   }
+  void receivedExtendedStringValue(BMCMidiMessage& message){
+    if(message.size()<15){
+      return;
+    }
+    uint32_t id = 0;
+    for(uint8_t i = 8 ; i < 13 ; i++){
+      id = (id << 7) | message.get7Bits(i);
+    }
+    responseReceived(BMC_KEMPER_REQUEST_EXT_STRING, (uint16_t) id);
+    if(id == BMC_KEMPER_EXT_STRING_PERFORMANCE_NAME){
+      getString(message, 13, performanceName);
+    }
+  }
+  // copy a null terminated string starting at @start, returns it's length
+  uint8_t getString(BMCMidiMessage& message, uint16_t start, char* str){
+    uint8_t len = 0;
+    for(uint16_t i = start ; (i+1) < message.size() && len < BMC_KEMPER_NAME_LENGTH-1 ; i++){
+      if(message.sysex[i] == 0){
+        break;
+      }
+      str[len++] = (char) message.sysex[i];
+    }
+    str[len] = 0;
+    return len;
+  }
+  uint16_t getParameterAddress(BMCMidiMessage& message){
+    return (message.get7Bits(8) << 8) | message.get7Bits(9);
+  }
+  void appendParameter(BMCMidiMessage& message, uint16_t param){
+    message.appendToSysEx7Bits(param >> 8);
+    message.appendToSysEx7Bits(param & 0x7F);
+  }
+  // extended parameters are 32-bit ids sent as 5 midi words
+  void appendExtendedParameter(BMCMidiMessage& message, uint32_t param){
+    for(int8_t i = 4 ; i >= 0 ; i--){
+      message.appendToSysEx7Bits((param >> (i*7)) & 0x7F);
+    }
+  }
+  void sendBeacon(){
+    BMCMidiMessage message;
+    prepSysEx(message, BMC_KEMPER_FN_CODE_BEACON);
+    message.appendToSysEx7Bits(0x40);
+    message.appendToSysEx7Bits(0x02);
+    message.appendToSysEx7Bits(BMC_KEMPER_BEACON_FLAG_SYSEX);
+    message.appendToSysEx7Bits(BMC_KEMPER_BEACON_LEASE);
+    sendSysEx(message);
+    beaconTimer.start(BMC_KEMPER_BEACON_RENEW);
+  }
+  void sendDeviceSearch(){
+    // ask for the rig volume on all ports except USB and BLE
+    BMCMidiMessage message;
+    prepSysEx(message, BMC_KEMPER_FN_CODE_REQUEST_SINGLE_PARAM);
+    appendParameter(message, BMC_KEMPER_PARAM_RIG_VOLUME);
+    midi.sendSysEx(
+      B00111110, // send to all ports except USB and BLE
+      message.getSysEx(), // the sysex array
+      message.size(), // the sysex array length
+      false, // does it have the 0xF0 & 0xF7 bytes
+      0, // cable, used for USB
+      true // should it trigger MIDI Out activity
+    );
+  }
   void sendSysEx(BMCMidiMessage& message){
     midi.sendSysEx(
       port, // syn port(s)
@@ -167,7 +748,7 @@ private:
   void sendNRPN(uint16_t param, uint32_t value){
     midi.sendControlChange(port, channel, 99, ((param >> 8) & 0x7F));
     midi.sendControlChange(port, channel, 98, (param & 0x7F));
-    midi.sendControlChange(port, channel, 6, ((value >> 8) & 0x7F));
+    midi.sendControlChange(port, channel, 6, ((value >> 7) & 0x7F));
     midi.sendControlChange(port, channel, 38, (value & 0x7F));
   }
   void prepSysEx(BMCMidiMessage& message, uint8_t messageId){
@@ -178,6 +759,7 @@ private:
     message.appendToSysEx7Bits(2); // Product Type 0x02 = Kemper Profiler
     message.appendToSysEx7Bits(BMC_KEMPER_DEVICE_ID); // Device ID 0x7F = OMNI (See Manual)
     message.appendToSysEx7Bits(messageId);
+    message.appendToSysEx7Bits(0x00); // instance
   }
 
   bool isKemperSysExMessage(BMCMidiMessage& message, uint8_t minLength=5){
@@ -188,10 +770,10 @@ private:
       message.sysex[3]==0x33
     );
   }
-  bool isKemperMidiMessage(BMCMidiMessage& message, uint8_t minLength=5){
+  bool isKemperMidiMessage(BMCMidiMessage& message){
     return (message.isControlChange() ||
             message.isProgramChange()) &&
-            midi.getChannel()==channel;
+            message.getChannel()==channel;
   }
   void tunerNote(uint8_t note, char* str){
 		switch(note){
@@ -6783,14 +6783,8 @@ return BMC_BUTTON_RGB_PIXEL_MERGE_32_BTN;
 return 0;
 }
 static BMCSketchByteData getSketchByteData(uint8_t index){
-  char defaultName[BMC_NAME_LEN_SKETCH_BYTES] = "";
-  if(index>9){
-    sprintf(defaultName,"Byte %02u",(uint8_t)index);
-  } else {
-    sprintf(defaultName,"Byte %01u",(uint8_t)index);
-  }
   BMCSketchByteData buffer;
-  strcpy(buffer.name,defaultName);
+  BMCFormat(buffer.name, BMC_NAME_LEN_SKETCH_BYTES).addString("Byte ").addNumber(index);
   buffer.initialValue = 0;
   buffer.min = 0;
   buffer.max = 255;
@@ -29,6 +29,10 @@ public:
     timedEventCustom = 0;
 #endif
 
+#if BMC_MAX_SEQUENCES > 0
+    sequenceStep = 0;
+#endif
+
 #if BMC_MAX_LIBRARY > 0
     libraryCustom = 0;
 #endif
@@ -78,6 +82,7 @@ public:
     midiActivity = 0;
     midiLocalUpdate = 0;
     midiPreRoute = 0;
+    midiSysExAssembled = 0;
     valueStream = 0;
     firstLoop = 0;
     midUpdate = 0;
@@ -92,6 +97,7 @@ public:
 
 #ifdef BMC_USB_HOST_ENABLED
     hostConnection = 0;
+    hostDeviceConnection = 0;
 #endif
 
 #ifdef BMC_MIDI_BLE_ENABLED
@@ -114,12 +120,21 @@ public:
     dawRecievedChannelRecReady = 0;
     dawRecievedLedState = 0;
     dawReceivedTimeCodeDigit = 0;
+    dawFaderFeedback = 0;
+    dawVPotFeedback = 0;
 #endif
 
 #ifdef BMC_USE_BEATBUDDY
     beatBuddyBeatLocation = 0;
 #endif
 
+#ifdef BMC_USE_HELIX
+    helixSnapshotChange = 0;
+    helixPresetChange = 0;
+    helixFootswitchesChange = 0;
+    helixLooperChange = 0;
+#endif
+
 #ifdef BMC_USE_FAS
     fasConnection = 0;
     fasPresetChange = 0;
@@ -132,9 +147,15 @@ public:
     fasLooperReceived = 0;
     fasCpuReceived = 0;
     fasBlockParameterReceived = 0;
+    fasSyncComplete = 0;
+    fasParameterChange = 0;
 #endif
 
-#ifdef BMC_USE_FAS
+#ifdef BMC_USE_KEMPER
+    kemperConnection = 0;
+    kemperRigChange = 0;
+    kemperModulesChange = 0;
+    kemperSyncComplete = 0;
     kemperParamReceived = 0;
     kemperStringReceived = 0;
 #endif
@@ -155,6 +176,10 @@ public:
   void (*timedEventCustom)(uint8_t id, uint8_t a, uint8_t b, uint8_t c);
 #endif
 
+#if BMC_MAX_SEQUENCES > 0
+  void (*sequenceStep)(uint8_t n, bmcLibrary_t event);
+#endif
+
 #if BMC_MAX_LIBRARY > 0
   void (*libraryCustom)(uint8_t id);
 #endif
@@ -214,6 +239,7 @@ public:
   void (*midiActivity)(bool in, bool out);
   void (*midiLocalUpdate)();
   bool (*midiPreRoute)(BMCMidiMessage& data, uint8_t destinations);
+  void (*midiSysExAssembled)(uint8_t port, uint16_t length);
 
   void (*valueStream)(BMCValueStream item);
   void (*presetChanged)(bmcPreset_t n);
@@ -231,6 +257,7 @@ public:
 
 #ifdef BMC_USB_HOST_ENABLED
     void (*hostConnection)(bool state);
+    void (*hostDeviceConnection)(uint8_t device, bool state);
 #endif
 
 #ifdef BMC_MIDI_BLE_ENABLED
@@ -253,6 +280,8 @@ public:
     void (*dawRecievedChannelRecReady)(uint8_t channel, bool state);
     void (*dawRecievedLedState)(uint8_t channel, bool state);
     void (*dawReceivedTimeCodeDigit)(uint8_t digit, uint8_t value);
+    void (*dawFaderFeedback)(uint8_t channel, uint16_t position);
+    void (*dawVPotFeedback)(uint8_t channel, uint16_t leds, bool centered);
 
 
 #endif
@@ -261,6 +290,13 @@ public:
   void (*beatBuddyBeatLocation)(uint8_t t_location, uint8_t numerator);
 #endif
 
+#ifdef BMC_USE_HELIX
+  void (*helixSnapshotChange)(uint8_t n);
+  void (*helixPresetChange)(uint8_t n);
+  void (*helixFootswitchesChange)(uint16_t states);
+  void (*helixLooperChange)(uint8_t state);
+#endif
+
 #ifdef BMC_USE_FAS
   void (*fasConnection)(bool state);
   void (*fasPresetChange)(uint16_t n);
@@ -273,10 +309,16 @@ public:
   void (*fasLooperReceived)(uint8_t state, uint8_t position);
   void (*fasCpuReceived)(uint8_t n);
   void (*fasBlockParameterReceived)(uint8_t block, uint8_t param, uint16_t value, char* str, uint8_t strLen);
+  void (*fasSyncComplete)(uint16_t latency);
+  void (*fasParameterChange)(uint8_t block, uint8_t param, uint16_t value);
 
 #endif
 
-#ifdef BMC_USE_FAS
+#ifdef BMC_USE_KEMPER
+  void (*kemperConnection)(bool state);
+  void (*kemperRigChange)(char* name);
+  void (*kemperModulesChange)();
+  void (*kemperSyncComplete)(uint16_t latency);
   void (*kemperParamReceived)(uint16_t param, uint16_t value);
   void (*kemperStringReceived)(uint16_t param, char* str, uint8_t len);
 #endif
@@ -39,6 +39,15 @@
   #define BMC_LIMIT_MIN_TIMED_EVENTS 0
   #define BMC_LIMIT_MAX_TIMED_EVENTS 127
 
+  #define BMC_LIMIT_MIN_SEQUENCES 0
+  #define BMC_LIMIT_MAX_SEQUENCES 16
+
+  #define BMC_LIMIT_MIN_SEQUENCE_STEPS 1
+  #define BMC_LIMIT_MAX_SEQUENCE_STEPS 64
+
+  #define BMC_LIMIT_MIN_MODULATORS 0
+  #define BMC_LIMIT_MAX_MODULATORS 16
+
   #define BMC_LIMIT_MIN_TEMPO_TO_TAP 0
   #define BMC_LIMIT_MAX_TEMPO_TO_TAP 32
 
@@ -56,6 +65,9 @@
 
   #if defined(BMC_I2C_FREQ_100K)
     #define BMC_I2C_FREQ 100000
+  #elif defined(BMC_I2C_FREQ_1M)
+    // only for devices that support Fast-mode Plus like the 24FC256
+    #define BMC_I2C_FREQ 1000000
   #else
     #define BMC_I2C_FREQ 400000
   #endif
@@ -151,8 +163,49 @@
     #define BMC_DEVICE_NAME "BMC"
   #endif
 
+  // number of USB MIDI cables, each one shows up as a separate MIDI port
+  // on the computer, Teensyduino sets MIDI_NUM_CABLES from the USB Type,
+  // 4 for "MIDIx4" and 16 for "MIDIx16"
+  #if !defined(BMC_USB_CABLES)
+    #if defined(MIDI_NUM_CABLES)
+      #define BMC_USB_CABLES MIDI_NUM_CABLES
+    #else
+      #define BMC_USB_CABLES 1
+    #endif
+  #endif
+  #if BMC_USB_CABLES < 1 || BMC_USB_CABLES > 16
+    #error "BMC_USB_CABLES must be between 1 and 16"
+  #endif
+  // the editor only connects on this USB cable
+  #if defined(BMC_EDITOR_USB_CABLE) && BMC_EDITOR_USB_CABLE >= BMC_USB_CABLES
+    #error "BMC_EDITOR_USB_CABLE must be lower than BMC_USB_CABLES"
+  #endif
+
   #if defined(BMC_USE_USB_HOST) && BMC_TEENSY_HAS_USB_HOST == true
     #define BMC_USB_HOST_ENABLED
+    // MIDI devices that can be attached to the host port at once thru a hub
+    #if !defined(BMC_USB_HOST_DEVICES)
+      #define BMC_USB_HOST_DEVICES 1
+    #endif
+    #if BMC_USB_HOST_DEVICES < 1 || BMC_USB_HOST_DEVICES > 8
+      #error "BMC_USB_HOST_DEVICES must be between 1 and 8"
+    #endif
+    // hubs between the host port and the devices, a 7 port hub is usually
+    // 2 hubs in one
+    #if !defined(BMC_USB_HOST_HUBS)
+      #if BMC_USB_HOST_DEVICES > 1
+        #define BMC_USB_HOST_HUBS 2
+      #else
+        #define BMC_USB_HOST_HUBS 0
+      #endif
+    #endif
+    #if BMC_USB_HOST_HUBS < 0 || BMC_USB_HOST_HUBS > 8
+      #error "BMC_USB_HOST_HUBS must be between 0 and 8"
+    #endif
+  #else
+    // the routing still keeps one item for the host port
+    #undef BMC_USB_HOST_DEVICES
+    #define BMC_USB_HOST_DEVICES 1
   #endif
 
   #if defined(BMC_USE_MIDI_SERIAL_A) && defined(BMC_MIDI_SERIAL_IO_A)
@@ -185,6 +238,53 @@
     #endif
   #endif
 
+  // SysEx bytes are passed to the sync modules as they arrive
+  // see src/midi/BMC-SysExStream.h
+  #if defined(BMC_USE_SYSEX_STREAM)
+    #define BMC_SYSEX_STREAM_ENABLED
+    #if !defined(BMC_SYSEX_STREAM_MAX_HANDLERS)
+      #define BMC_SYSEX_STREAM_MAX_HANDLERS 4
+    #endif
+    #if BMC_SYSEX_STREAM_MAX_HANDLERS < 1
+      #undef BMC_SYSEX_STREAM_MAX_HANDLERS
+      #define BMC_SYSEX_STREAM_MAX_HANDLERS 1
+    #endif
+    #if BMC_SYSEX_STREAM_MAX_HANDLERS > 8
+      #undef BMC_SYSEX_STREAM_MAX_HANDLERS
+      #define BMC_SYSEX_STREAM_MAX_HANDLERS 8
+    #endif
+  #endif
+
+  // SysEx is assembled on each port in blocks from a shared pool
+  // see src/midi/BMC-SysExPool.h
+  #if defined(BMC_USE_SYSEX_POOL)
+    #define BMC_SYSEX_POOL_ENABLED
+    #if !defined(BMC_SYSEX_POOL_BLOCKS)
+      #define BMC_SYSEX_POOL_BLOCKS 32
+    #endif
+    #if !defined(BMC_SYSEX_POOL_BLOCK_SIZE)
+      #define BMC_SYSEX_POOL_BLOCK_SIZE 64
+    #endif
+    #if BMC_SYSEX_POOL_BLOCKS < 2 || BMC_SYSEX_POOL_BLOCKS > 254
+      #error "BMC_SYSEX_POOL_BLOCKS must be between 2 and 254"
+    #endif
+    #if BMC_SYSEX_POOL_BLOCK_SIZE < 16 || BMC_SYSEX_POOL_BLOCK_SIZE > 1024
+      #error "BMC_SYSEX_POOL_BLOCK_SIZE must be between 16 and 1024"
+    #endif
+  #endif
+
+  // MIDI Time Code sent by the master clock transport
+  // see src/midi/BMC-MidiTimeCode.h
+  #if defined(BMC_USE_MTC)
+    #define BMC_MTC_ENABLED
+    #if !defined(BMC_MTC_FPS)
+      #define BMC_MTC_FPS 30
+    #endif
+    #if BMC_MTC_FPS != 24 && BMC_MTC_FPS != 25 && BMC_MTC_FPS != 30
+      #error "BMC_MTC_FPS must be 24, 25 or 30"
+    #endif
+  #endif
+
   #ifndef BMC_MAX_SKETCH_BYTES
     #define BMC_MAX_SKETCH_BYTES 0
   #endif
@@ -200,6 +300,69 @@
     #define BMC_SD_CARD_ENABLED
   #endif
 
+  // load settings and the first page at startup and the rest of the store
+  // in the background, EEPROM and 24LC256 only
+  #if !defined(BMC_SD_CARD_ENABLED) && defined(BMC_USE_FAST_BOOT)
+    #define BMC_FAST_BOOT_ENABLED
+    #if !defined(BMC_FAST_BOOT_BLOCK_SIZE)
+      #define BMC_FAST_BOOT_BLOCK_SIZE 128
+    #endif
+  #endif
+
+  // multiple 24LC256 chips are used as a single address space,
+  // chips must have consecutive i2c addresses starting at BMC_24LC256_ADDRESS
+  #if defined(BMC_USE_24LC256)
+    #if !defined(BMC_24LC256_DEVICES)
+      #define BMC_24LC256_DEVICES 1
+    #endif
+    #if BMC_24LC256_DEVICES < 1
+      #undef BMC_24LC256_DEVICES
+      #define BMC_24LC256_DEVICES 1
+    #endif
+    #if BMC_24LC256_DEVICES > 8
+      #undef BMC_24LC256_DEVICES
+      #define BMC_24LC256_DEVICES 8
+    #endif
+    // the 24LC256 has 64 byte pages
+    #if !defined(BMC_24LC256_PAGE_SIZE)
+      #define BMC_24LC256_PAGE_SIZE 64
+    #endif
+  #endif
+
+  // Paged store, pages are kept in the SD Card and only a few of them
+  // are loaded into RAM at a time, see src/storage/BMC-StorePages.h
+  #if defined(BMC_SD_CARD_ENABLED) && defined(BMC_USE_SD_PAGED_STORE)
+    #define BMC_SD_PAGED_STORE_ENABLED
+    #if !defined(BMC_SD_PAGED_STORE_SLOTS)
+      #define BMC_SD_PAGED_STORE_SLOTS 3
+    #endif
+    #if BMC_SD_PAGED_STORE_SLOTS < 2
+      #undef BMC_SD_PAGED_STORE_SLOTS
+      #define BMC_SD_PAGED_STORE_SLOTS 2
+    #endif
+    #if BMC_SD_PAGED_STORE_SLOTS > 16
+      #undef BMC_SD_PAGED_STORE_SLOTS
+      #define BMC_SD_PAGED_STORE_SLOTS 16
+    #endif
+  #endif
+
+  // Journal for settings, sketch bytes, preset and stopwatch state,
+  // EEPROM and 24LC256 only, see src/storage/BMC-StorageJournal.h
+  #if !defined(BMC_SD_CARD_ENABLED) && defined(BMC_USE_STORAGE_JOURNAL)
+    #define BMC_STORAGE_JOURNAL_ENABLED
+    #if !defined(BMC_STORAGE_JOURNAL_SIZE)
+      #define BMC_STORAGE_JOURNAL_SIZE 512
+    #endif
+    #if BMC_STORAGE_JOURNAL_SIZE < 256
+      #undef BMC_STORAGE_JOURNAL_SIZE
+      #define BMC_STORAGE_JOURNAL_SIZE 256
+    #endif
+    #if BMC_STORAGE_JOURNAL_SIZE > 2048
+      #undef BMC_STORAGE_JOURNAL_SIZE
+      #define BMC_STORAGE_JOURNAL_SIZE 2048
+    #endif
+  #endif
+
   #if defined(BMC_STORAGE_PARTITION_SIZE_32K)
     #if BMC_TEENSY_RAM_SIZE < 256000
       #undef BMC_STORAGE_PARTITION_SIZE_32K
@@ -247,6 +410,11 @@
     #undef BMC_MAX_TEMPO_TO_TAP
     #define BMC_MAX_TEMPO_TO_TAP BMC_LIMIT_MAX_TEMPO_TO_TAP
   #endif
+  // a profile per tempo to tap device, adding them changes the size of the
+  // store so it's opt-in, see src/utility/BMC-TempoToTap.h
+  #if defined(BMC_USE_TEMPO_TO_TAP_PROFILES) && BMC_MAX_TEMPO_TO_TAP > 0
+    #define BMC_TEMPO_TO_TAP_PROFILES_ENABLED
+  #endif
 
   // Sketch bytes
   #if !defined(BMC_MAX_SKETCH_BYTES)
@@ -301,6 +469,21 @@
     #endif
   #endif
 
+  // size of the transmit buffer of the Serial MIDI ports, 64 bytes in the
+  // Teensy core, set it if your sketch adds memory with addMemoryForWrite()
+  #if !defined(BMC_MIDI_SERIAL_TX_BUFFER_SIZE)
+    #define BMC_MIDI_SERIAL_TX_BUFFER_SIZE 64
+  #endif
+  #if BMC_MIDI_SERIAL_TX_BUFFER_SIZE < 2 || BMC_MIDI_SERIAL_TX_BUFFER_SIZE > 256
+    #error "BMC_MIDI_SERIAL_TX_BUFFER_SIZE must be between 2 and 256"
+  #endif
+
+  // Preset items are sent to each port on it's own and
+  // library delay events can pause a port, see src/utility/BMC-PresetRecall.h
+  #if defined(BMC_USE_PRESET_PIPELINE) && BMC_MAX_LIBRARY > 0 && BMC_MAX_PRESETS > 0
+    #define BMC_PRESET_PIPELINE_ENABLED
+  #endif
+
   #if defined(BMC_USE_POT_TOE_SWITCH)
     #if (BMC_MAX_POTS == 0 && BMC_MAX_GLOBAL_POTS == 0)
       #undef BMC_USE_POT_TOE_SWITCH
@@ -355,6 +538,35 @@
     #define BMC_MAX_TIMED_EVENTS BMC_LIMIT_MAX_TIMED_EVENTS
   #endif
 
+  // sequences check, steps are library items so the library is required
+  #if !defined(BMC_MAX_SEQUENCES) || BMC_MAX_LIBRARY == 0
+    #undef BMC_MAX_SEQUENCES
+    #define BMC_MAX_SEQUENCES BMC_LIMIT_MIN_SEQUENCES
+  #endif
+  #if BMC_MAX_SEQUENCES > BMC_LIMIT_MAX_SEQUENCES
+    #undef BMC_MAX_SEQUENCES
+    #define BMC_MAX_SEQUENCES BMC_LIMIT_MAX_SEQUENCES
+  #endif
+  #if !defined(BMC_MAX_SEQUENCE_STEPS)
+    #define BMC_MAX_SEQUENCE_STEPS 16
+  #endif
+  #if BMC_MAX_SEQUENCE_STEPS < BMC_LIMIT_MIN_SEQUENCE_STEPS
+    #undef BMC_MAX_SEQUENCE_STEPS
+    #define BMC_MAX_SEQUENCE_STEPS BMC_LIMIT_MIN_SEQUENCE_STEPS
+  #elif BMC_MAX_SEQUENCE_STEPS > BMC_LIMIT_MAX_SEQUENCE_STEPS
+    #undef BMC_MAX_SEQUENCE_STEPS
+    #define BMC_MAX_SEQUENCE_STEPS BMC_LIMIT_MAX_SEQUENCE_STEPS
+  #endif
+
+  // modulators check
+  #if !defined(BMC_MAX_MODULATORS)
+    #define BMC_MAX_MODULATORS BMC_LIMIT_MIN_MODULATORS
+  #endif
+  #if BMC_MAX_MODULATORS > BMC_LIMIT_MAX_MODULATORS
+    #undef BMC_MAX_MODULATORS
+    #define BMC_MAX_MODULATORS BMC_LIMIT_MAX_MODULATORS
+  #endif
+
 
   // hardware check
   #if !defined(BMC_MAX_BUTTON_EVENTS) && BMC_MAX_BUTTON > 0
@@ -32,6 +32,24 @@ public:
         break;
     }
   }
+  // bytes sent by send() including the 0xF0 and 0xF7 of each message
+  uint16_t getLength(uint8_t mode, uint8_t indexA, uint8_t indexB=255){
+    switch(mode & 0x03){
+      case BMC_CUSTOM_SYSEX_SEND_A:
+        return getLength(indexA);
+      case BMC_CUSTOM_SYSEX_SEND_B:
+        return getLength(indexA) + getLength(indexB);
+      case BMC_CUSTOM_SYSEX_SEND_MERGE:
+        if(indexA < BMC_MAX_CUSTOM_SYSEX && indexB < BMC_MAX_CUSTOM_SYSEX){
+          return global.customSysEx[indexA].length + global.customSysEx[indexB].length + 2;
+        }
+        break;
+    }
+    return 0;
+  }
+  uint16_t getLength(uint8_t index){
+    return (index < BMC_MAX_CUSTOM_SYSEX) ? (global.customSysEx[index].length + 2) : 0;
+  }
   void send(uint8_t port, uint8_t index){
     if(index < BMC_MAX_CUSTOM_SYSEX){
       bmcStoreGlobalCustomSysEx& a = global.customSysEx[index];
@@ -375,6 +375,7 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_ITEM_ID_SETLIST 22
 #define BMC_ITEM_ID_SETLIST_SONG 23
 #define BMC_ITEM_ID_TIMED_EVENT 24
+#define BMC_ITEM_ID_KEMPER_RIG 25
 
 
 #define BMC_ITEM_ID_MIDI_PROGRAM BMC_MIDI_PROGRAM_CHANGE
@@ -411,6 +412,16 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_STOPWATCH_CMD_TOGGLE 3
 #define BMC_STOPWATCH_CMD_TOGGLE_RESET 4
 
+// Boot stages, in the order they happen
+#define BMC_BOOT_STAGE_START 0 // begin() was called
+#define BMC_BOOT_STAGE_MIDI 1 // midi ports are ready
+#define BMC_BOOT_STAGE_SETTINGS 2 // settings are loaded, midi routing is set
+#define BMC_BOOT_STAGE_HARDWARE 3 // hardware pins are setup
+#define BMC_BOOT_STAGE_READY 4 // begin() is done
+#define BMC_BOOT_STAGE_PAGE 5 // first update(), the first page is assigned
+#define BMC_BOOT_STAGE_STORE 6 // the entire store is loaded
+#define BMC_BOOT_STAGE_COUNT 7
+
 // Click Track Commands
 #define BMC_CLICK_TRACK_MUTE 0
 #define BMC_CLICK_TRACK_UNMUTE 1
@@ -442,22 +453,34 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_ALL_PORTS       127
 
 // use to send to Port Presets
-#define BMC_PORTP_0     B1000000 //128
-#define BMC_PORTP_1     B1000000 //129
-#define BMC_PORTP_2     B1000001 //130
-#define BMC_PORTP_3     B1000001 //131
-#define BMC_PORTP_4     B1000010 //132
-#define BMC_PORTP_5     B1000010 //133
-#define BMC_PORTP_6     B1000011 //134
-#define BMC_PORTP_7     B1000011 //135
-#define BMC_PORTP_8     B1000100 //136
-#define BMC_PORTP_9     B1000100 //137
-#define BMC_PORTP_10    B1000101 //138
-#define BMC_PORTP_11    B1000101 //139
-#define BMC_PORTP_12    B1000110 //140
-#define BMC_PORTP_13    B1000110 //141
-#define BMC_PORTP_14    B1000111 //142
-#define BMC_PORTP_15    B1000111 //143
+#define BMC_PORTP_0     128
+#define BMC_PORTP_1     129
+#define BMC_PORTP_2     130
+#define BMC_PORTP_3     131
+#define BMC_PORTP_4     132
+#define BMC_PORTP_5     133
+#define BMC_PORTP_6     134
+#define BMC_PORTP_7     135
+#define BMC_PORTP_8     136
+#define BMC_PORTP_9     137
+#define BMC_PORTP_10    138
+#define BMC_PORTP_11    139
+#define BMC_PORTP_12    140
+#define BMC_PORTP_13    141
+#define BMC_PORTP_14    142
+#define BMC_PORTP_15    143
+
+// use to send to USB MIDI on a specific cable (USB cable port), these are
+// virtual ports that can be used anywhere a port or port preset is used
+// BMC_USB_CABLE_PORT(0) sends to cable 0 same as BMC_USB
+#define BMC_USB_CABLE_PORT(n) (0x90 | ((n) & 0x0F))
+#define BMC_IS_PORT_PRESET(p) (((p) & 0xF0) == 0x80)
+#define BMC_IS_USB_CABLE_PORT(p) (((p) & 0xF0) == 0x90)
+
+// use to send to a single device attached to the USB Host port (host
+// device port), BMC_HOST sends to all of them
+#define BMC_HOST_DEVICE_PORT(n) (0xA0 | ((n) & 0x0F))
+#define BMC_IS_HOST_DEVICE_PORT(p) (((p) & 0xF0) == 0xA0)
 
 
 
@@ -599,56 +622,8 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
   #define BMC_BLE_MIDI_DEVICE_NAME "BMC BLE MIDI"
 #endif
 
-// the following are templates for value streams
-// these strings are the message that will be passed when value streams are triggered
-// these can all be overloaded in the config file
-// make sure you follow the format of each
-// these can not exceed 30 characters including the EOL
-
-// used when changing pages
-#ifndef BMC_STREAM_TEMPL_PAGE
-  #define BMC_STREAM_TEMPL_PAGE "Page %03u %s"
-#endif
-
-// used when changing presets
-#ifndef BMC_STREAM_TEMPL_PRESET
-  #define BMC_STREAM_TEMPL_PRESET "Preset %03u %s"
-#endif
-
-// used when changing setlists
-#ifndef BMC_STREAM_TEMPL_SETLIST
-  #define BMC_STREAM_TEMPL_SETLIST "SetList %03u %s"
-#endif
-
-// used when changing songs
-#ifndef BMC_STREAM_TEMPL_SETLIST_SONG
-  #define BMC_STREAM_TEMPL_SETLIST_SONG "Song %03u %s"
-#endif
-
-// used when sending midi program change
-#ifndef BMC_STREAM_TEMPL_MIDI_PC
-  #define BMC_STREAM_TEMPL_MIDI_PC "Program Ch:%02u PC:%03u"
-#endif
-
-// used when sending midi control change
-#ifndef BMC_STREAM_TEMPL_MIDI_CC
-  #define BMC_STREAM_TEMPL_MIDI_CC "Control Ch:%02u CC:%03u V:%03u"
-#endif
-
-// used when sending midi note on
-#ifndef BMC_STREAM_TEMPL_MIDI_NOTE_ON
-  #define BMC_STREAM_TEMPL_MIDI_NOTE_ON "Note On Ch:%02u N:%03u V:%03u"
-#endif
-
-// used when sending midi note off
-#ifndef BMC_STREAM_TEMPL_MIDI_NOTE_OFF
-  #define BMC_STREAM_TEMPL_MIDI_NOTE_OFF "Note Off Ch:%02u N:%03u V:%03u"
-#endif
-
-// used when midi clock bpm has changed
-#ifndef BMC_STREAM_TEMPL_MIDI_CLOCK_BPM
-  #define BMC_STREAM_TEMPL_MIDI_CLOCK_BPM "BPM %03u"
-#endif
+// templates for value streams, these can be overloaded in the config file
+#include "utility/BMC-StreamTemplates.h"
 
 #define BMC_FS_MAX_STORES 32
 
@@ -940,7 +915,7 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_BUTTON_EVENT_TYPE_NL_RELAY_CONTROL_TOGGLE 34
 #define BMC_BUTTON_EVENT_TYPE_L_RELAY_CONTROL_TOGGLE 35
 #define BMC_BUTTON_EVENT_TYPE_MIDI_REAL_TIME_BLOCK 36
-// id 37 available
+#define BMC_BUTTON_EVENT_TYPE_MASTER_CLOCK_TRANSPORT 37
 #define BMC_BUTTON_EVENT_TYPE_STOPWATCH 38
 #define BMC_BUTTON_EVENT_TYPE_BLE_DISCONNECT 39
 #define BMC_BUTTON_EVENT_TYPE_PWM_LED_TEMP_BLINK 40
@@ -955,7 +930,9 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_BUTTON_EVENT_TYPE_PROGRAM_BANKING_SCROLL 49
 #define BMC_BUTTON_EVENT_TYPE_PROGRAM_BANKING_TRIGGER 50
 #define BMC_BUTTON_EVENT_TYPE_TYPER_CMD 51
-// id 51 to id 79 availabel
+#define BMC_BUTTON_EVENT_TYPE_SEQUENCE 52
+#define BMC_BUTTON_EVENT_TYPE_MODULATOR 53
+// id 54 to id 79 availabel
 #define BMC_BUTTON_EVENT_TYPE_FAS_COMMAND 80
 #define BMC_BUTTON_EVENT_TYPE_FAS_PRESET 81
 #define BMC_BUTTON_EVENT_TYPE_FAS_PRESET_SCROLL 82
@@ -1011,6 +988,9 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_LED_EVENT_TYPE_BUTTON_RAW 22
 #define BMC_LED_EVENT_TYPE_GLOBAL_BUTTON_RAW 23
 #define BMC_LED_EVENT_TYPE_DAW 24
+#define BMC_LED_EVENT_TYPE_HELIX_PRESET 25
+#define BMC_LED_EVENT_TYPE_HELIX_FOOTSWITCH 26
+#define BMC_LED_EVENT_TYPE_HELIX_LOOPER 27
 
 #define BMC_LED_EVENT_TYPE_FAS_STATE 80
 #define BMC_LED_EVENT_TYPE_FAS_PRESET 81
@@ -1203,6 +1183,18 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_DAW_LED_CMD_BEATS 60
 #define BMC_DAW_LED_CMD_RUDE_SOLO 61
 #define BMC_DAW_LED_CMD_RELAY 62
+#define BMC_DAW_LED_CMD_FADER_1 63
+#define BMC_DAW_LED_CMD_FADER_2 64
+#define BMC_DAW_LED_CMD_FADER_3 65
+#define BMC_DAW_LED_CMD_FADER_4 66
+#define BMC_DAW_LED_CMD_FADER_5 67
+#define BMC_DAW_LED_CMD_FADER_6 68
+#define BMC_DAW_LED_CMD_FADER_7 69
+#define BMC_DAW_LED_CMD_FADER_8 70
+#define BMC_DAW_LED_CMD_FADER_9 71
+#define BMC_DAW_LED_CMD_FADER_10 72
+#define BMC_DAW_LED_CMD_FADER_11 73
+#define BMC_DAW_LED_CMD_FADER_12 74
 // **********************************
 //         BMC DAW LED NOTES
 // **********************************
@@ -2145,6 +2137,7 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_POT_EVENT_TYPE_PITCH 5
 #define BMC_POT_EVENT_TYPE_PITCH_UP 6
 #define BMC_POT_EVENT_TYPE_PITCH_DOWN 7
+#define BMC_POT_EVENT_TYPE_DAW_FADER 8
 
 // 8 user defined events
 // this feature will be added to the editor and documented later on
@@ -2214,6 +2207,8 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_TRIGGER_EVENT_TYPE_GLOBAL_BUTTON 18
 #define BMC_TRIGGER_EVENT_TYPE_ENCODER 19
 #define BMC_TRIGGER_EVENT_TYPE_GLOBAL_ENCODER 20
+#define BMC_TRIGGER_EVENT_TYPE_SEQUENCE 21
+#define BMC_TRIGGER_EVENT_TYPE_MODULATOR 22
 #define BMC_TRIGGER_EVENT_TYPE_CUSTOM 127
 
 // TIMED EVENT TYPES
@@ -2228,6 +2223,8 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #define BMC_TIMED_EVENT_TYPE_PAGE 9
 #define BMC_TIMED_EVENT_TYPE_PRESET 10
 #define BMC_TIMED_EVENT_TYPE_MASTER_CLOCK 11
+#define BMC_TIMED_EVENT_TYPE_SEQUENCE 12
+#define BMC_TIMED_EVENT_TYPE_MODULATOR 13
 #define BMC_TIMED_EVENT_TYPE_CUSTOM 127
 
 /*
@@ -2320,6 +2317,7 @@ const char bmcAlphabet[26] = {'A','B','C','D','E','F','G','H','I','J','K','L','M
 #include "utility/BMC-Scroller.h"
 #include "utility/BMC-Structs.h"
 #include "utility/BMC-PixelColors.h"
+#include "utility/BMC-Format.h"
 #include "utility/BMC-BuildData.h"
 #include "utility/BMC-MidiMessage.h"
 #include "utility/BMC-MidiControl.h"
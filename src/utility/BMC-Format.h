@@ -0,0 +1,124 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Formats strings into a fixed size char array without sprintf or the
+  String class so nothing is allocated, used for value streams and names
+  passed to the sketch and for debug output.
+
+  The output is always null terminated, anything that doesn't fit is cut off.
+
+  addTemplate() takes the BMC_STREAM_TEMPL_* strings, these are printf
+  style but only %u, %d, %s and %% are supported, a width with a leading 0
+  pads numbers with zeros, for example "Page %03u %s"
+*/
+#ifndef BMC_FORMAT_H
+#define BMC_FORMAT_H
+
+#include <Arduino.h>
+
+class BMCFormat {
+public:
+  BMCFormat(char * t_buff, uint8_t t_size):buff(t_buff),size(t_size){
+    clear();
+  }
+  void clear(){
+    length = 0;
+    if(size > 0){
+      buff[0] = 0;
+    }
+  }
+  BMCFormat& addChar(char c){
+    if(length+1 < size){
+      buff[length++] = c;
+      buff[length] = 0;
+    }
+    return *this;
+  }
+  BMCFormat& addString(const char * str){
+    if(str != nullptr){
+      while(*str && length+1 < size){
+        buff[length++] = *str++;
+      }
+      buff[length] = 0;
+    }
+    return *this;
+  }
+  // @digits is the minimum number of digits, padded with zeros
+  BMCFormat& addNumber(uint32_t value, uint8_t digits=0){
+    // a uint32_t has at most 10 digits
+    char tmp[10];
+    uint8_t n = 0;
+    do {
+      tmp[n++] = '0' + (value % 10);
+      value /= 10;
+    } while(value > 0 && n < 10);
+    while(digits > n){
+      addChar('0');
+      digits--;
+    }
+    while(n > 0){
+      addChar(tmp[--n]);
+    }
+    return *this;
+  }
+  BMCFormat& addSigned(int32_t value, uint8_t digits=0){
+    if(value < 0){
+      addChar('-');
+      return addNumber(-((int64_t) value), digits);
+    }
+    return addNumber(value, digits);
+  }
+  // numbers are used in the order their % appears in the template
+  BMCFormat& addTemplate(const char * templ, const char * str,
+                         int32_t a=0, int32_t b=0, int32_t c=0){
+    int32_t numbers[3] = {a, b, c};
+    uint8_t next = 0;
+    while(*templ){
+      if(*templ != '%'){
+        addChar(*templ++);
+        continue;
+      }
+      templ++;
+      if(*templ == '%'){
+        addChar(*templ++);
+        continue;
+      }
+      uint8_t digits = 0;
+      while(*templ >= '0' && *templ <= '9'){
+        digits = (digits * 10) + (*templ++ - '0');
+      }
+      switch(*templ){
+        case 'u':
+          addNumber(next < 3 ? (uint32_t) numbers[next++] : 0, digits);
+          break;
+        case 'd':
+        case 'i':
+          addSigned(next < 3 ? numbers[next++] : 0, digits);
+          break;
+        case 's':
+          addString(str);
+          break;
+        case 0:
+          // template ended with a %
+          return *this;
+      }
+      templ++;
+    }
+    return *this;
+  }
+  const char * get(){
+    return buff;
+  }
+  uint8_t getLength(){
+    return length;
+  }
+private:
+  char * buff;
+  uint8_t size = 0;
+  uint8_t length = 0;
+};
+
+#endif
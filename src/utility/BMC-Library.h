@@ -38,12 +38,18 @@
 #if BMC_MAX_CUSTOM_SYSEX > 0
   #include "utility/BMC-CustomSysEx.h"
 #endif
+#if BMC_MAX_MODULATORS > 0
+  #include "utility/BMC-RingBuffer.h"
+#endif
 
 #define BMC_LIBRARY_FLAG_CHANGE_AVAILABLE 0
 #define BMC_LIBRARY_FLAG_SET_PAGE 1
 #define BMC_LIBRARY_FLAG_SET_BPM  2
 #define BMC_LIBRARY_FLAG_SET_PIXEL_PROGRAM  3
 
+#define BMC_LIBRARY_EVENT_DELAY 4
+#define BMC_LIBRARY_EVENT_MODULATOR 5
+
 class BMCLibrary {
 public:
   #if BMC_MAX_CUSTOM_SYSEX > 0
@@ -86,12 +92,17 @@ public:
         pixelProgram = BMC_GET_BYTE(1, global.library[index].event);
         flags.on(BMC_LIBRARY_FLAG_SET_PIXEL_PROGRAM);
         flags.on(BMC_LIBRARY_FLAG_CHANGE_AVAILABLE);
+      } else if(status==BMC_LIBRARY_EVENT_MODULATOR){
+        #if BMC_MAX_MODULATORS > 0
+          queueModulatorCommand(global.library[index].event);
+        #endif
       } else if(status==BMC_EVENT_TYPE_CUSTOM){
         uint8_t value = mergeDataBytes(global.library[index].event) & 0xFF;
         if(callback.libraryCustom){
           callback.libraryCustom(value);
         }
       }
+      // BMC_LIBRARY_EVENT_DELAY is only used by the preset recall pipeline
     }
   }
   void sendWithDifferentPorts(bmcLibrary_t index, uint8_t ports){
@@ -115,6 +126,10 @@ public:
         pixelProgram = BMC_GET_BYTE(1, global.library[index].event);
         flags.on(BMC_LIBRARY_FLAG_SET_PIXEL_PROGRAM);
         flags.on(BMC_LIBRARY_FLAG_CHANGE_AVAILABLE);
+      } else if(status==BMC_LIBRARY_EVENT_MODULATOR){
+        #if BMC_MAX_MODULATORS > 0
+          queueModulatorCommand(global.library[index].event);
+        #endif
       } else if(status==BMC_EVENT_TYPE_CUSTOM){
         uint8_t value = mergeDataBytes(global.library[index].event) & 0xFF;
         if(callback.libraryCustom){
@@ -153,6 +168,19 @@ public:
   uint8_t getPixelProgramChange(){
     return pixelProgram;
   }
+  #if BMC_MAX_MODULATORS > 0
+    // modulator commands are queued so more than one can be sent in a loop,
+    // returns false once all of them were read
+    bool getModulatorCommand(uint8_t& n, uint8_t& cmd){
+      if(modulatorCommands.isEmpty()){
+        return false;
+      }
+      uint16_t value = modulatorCommands.pop();
+      n = value & 0xFF;
+      cmd = value >> 8;
+      return true;
+    }
+  #endif
 
   // these are here to make it easier to access a library message from the outside
   uint32_t getEvent(bmcLibrary_t n){
@@ -202,6 +230,26 @@ public:
     }
     return BMC_GET_BYTE(3, global.library[n].event);
   }
+  // milliseconds of a delay event (status 4), 14-bit value
+  uint16_t getDelay(bmcLibrary_t n){
+    if(n>=BMC_MAX_LIBRARY){
+      return 0;
+    }
+    return mergeDataBytes(global.library[n].event);
+  }
+  // bytes sent to each port by a Custom SysEx event, 0 for other events
+  uint16_t getSysExLength(bmcLibrary_t n){
+    if(n>=BMC_MAX_LIBRARY){
+      return 0;
+    }
+    #if BMC_MAX_CUSTOM_SYSEX > 0
+      uint8_t status = getStatus(n);
+      if(status>=0xF0 && status<=0xF2){
+        return customSysEx.getLength(getCustomSysExMode(status), getData1(n), getData2(n));
+      }
+    #endif
+    return 0;
+  }
 #if BMC_NAME_LEN_LIBRARY > 1
   void getName(bmcLibrary_t n, char* t_string){
     strcpy(t_string, global.library[n].name);
@@ -219,6 +267,14 @@ private:
   uint8_t page = 0;
   uint8_t pixelProgram = 0;
   uint16_t bpm = 0;
+  #if BMC_MAX_MODULATORS > 0
+    BMCRingBuffer <uint16_t, 8> modulatorCommands;
+    // data1 = modulator, data2 = BMC_MODULATOR_CMD_*
+    void queueModulatorCommand(uint32_t t_event){
+      modulatorCommands.push(BMC_GET_BYTE(1, t_event) | (BMC_GET_BYTE(2, t_event) << 8));
+      flags.on(BMC_LIBRARY_FLAG_CHANGE_AVAILABLE);
+    }
+  #endif
 
   uint16_t mergeDataBytes(uint32_t t_event){
     uint16_t b = (t_event>>8) & 0xFFFF;
@@ -228,13 +284,15 @@ private:
   #if BMC_MAX_CUSTOM_SYSEX > 0
     BMCCustomSysEx& customSysEx;
     void sendCustomSysEx(bmcLibrary_t index, uint8_t status, uint8_t ports){
-      uint8_t mode = BMC_CUSTOM_SYSEX_SEND_A;
+      customSysEx.send(getCustomSysExMode(status), ports, getData1(index), getData2(index));
+    }
+    uint8_t getCustomSysExMode(uint8_t status){
       if(status==0xF1){
-        mode = BMC_CUSTOM_SYSEX_SEND_B;
+        return BMC_CUSTOM_SYSEX_SEND_B;
       } else if(status==0xF2){
-        mode = BMC_CUSTOM_SYSEX_SEND_MERGE;
+        return BMC_CUSTOM_SYSEX_SEND_MERGE;
       }
-      customSysEx.send(mode, ports, getData1(index), getData2(index));
+      return BMC_CUSTOM_SYSEX_SEND_A;
     }
   #endif
 };
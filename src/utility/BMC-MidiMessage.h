@@ -14,6 +14,10 @@
 
 struct BMCMidiMessage {
   uint8_t ports = 0;
+  // USB cable the message was received on
+  uint8_t cable = 0;
+  // USB Host device the message was received from
+  uint8_t device = 0;
   uint8_t status = 0;
   uint8_t channel = 0;
   uint8_t data1 = 0;
@@ -28,6 +32,8 @@ struct BMCMidiMessage {
   uint8_t getData2()  { return data2; }
   uint8_t getPort()   { return ports; }
   uint8_t getSource() { return getPort(); }
+  uint8_t getCable()  { return cable; }
+  uint8_t getDevice() { return device; }
 
   void setStatus(uint8_t t_status)    { status = t_status; }
   void setChannel(uint8_t t_channel)  { channel = t_channel; }
@@ -35,6 +41,8 @@ struct BMCMidiMessage {
   void setData2(uint8_t t_data2)      { data2 = t_data2; }
   void setPort(uint8_t t_port)        { ports = t_port; }
   void setSource(uint8_t t_port)      { setPort(t_port); }
+  void setCable(uint8_t t_cable)      { cable = t_cable & 0x0F; }
+  void setDevice(uint8_t t_device)    { device = t_device; }
   // reset all data in the struct
   void reset(uint8_t sourcePortBit=0){
     memset(sysex, 0, BMC_MIDI_SYSEX_SIZE);
@@ -43,6 +51,8 @@ struct BMCMidiMessage {
     setData1(0);
     setData2(0);
     setPort(0);
+    setCable(0);
+    setDevice(0);
     bitWrite(ports, sourcePortBit, 1);
   }
   void addRaw(uint8_t t_port, uint8_t t_status,
@@ -379,7 +389,7 @@ struct BMCMidiMessage {
   // str = char string array
   // length = length of the string (including null)
   // no more than 32 characters should be allowed including the EOL
-  void appendCharArrayToSysEx(char *str, uint8_t length){
+  void appendCharArrayToSysEx(const char *str, uint8_t length){
     for(uint8_t i = 0, n = length-1 ; i < length ; i++){
       // max 32 characters
       if(i==32){
@@ -395,6 +405,11 @@ struct BMCMidiMessage {
       }
     }
   }
+  // appends the string and it's null terminator
+  void appendCharArrayToSysEx(const char *str){
+    size_t len = strlen(str);
+    appendCharArrayToSysEx(str, (len > 32 ? 32 : len)+1);
+  }
   // same as above but with a String instead
   void appendCharArrayToSysEx(String str){
     // create a buffer
@@ -0,0 +1,318 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Modulators send a wave to a Control Change, a 14-bit Control Change, an
+  NRPN or Pitch Bend, for sweeps and swells without a pot. Each one has a
+  shape (ramp, triangle, sine or random sample & hold), a range, a period
+  and a number of milliseconds between updates, they can play once or loop.
+
+  The period is in milliseconds or, when synced, in clock ticks (24 per
+  quarter note) of the master or incoming clock, between ticks a synced
+  modulator moves at the current tempo and waits for the next tick if the
+  clock is late or stopped.
+
+  Control Changes are checked against the last value sent or received on
+  that channel (the same values used by CC toggles) and only sent if they
+  changed, 14-bit CC and NRPN values are checked as a whole and when they
+  change the MSB and LSB are always sent together, MSB first, so a receiver
+  never combines half of the new value with half of the old one. Pitch Bend
+  is only sent if it changed since the last update.
+*/
+#ifndef BMC_MODULATORS_H
+#define BMC_MODULATORS_H
+
+#include "utility/BMC-Def.h"
+
+#if BMC_MAX_MODULATORS > 0
+
+#define BMC_MODULATOR_SHAPE_RAMP 0
+#define BMC_MODULATOR_SHAPE_TRIANGLE 1
+#define BMC_MODULATOR_SHAPE_SINE 2
+#define BMC_MODULATOR_SHAPE_RANDOM 3
+
+#define BMC_MODULATOR_OUTPUT_CC 0
+#define BMC_MODULATOR_OUTPUT_CC14 1
+#define BMC_MODULATOR_OUTPUT_NRPN 2
+#define BMC_MODULATOR_OUTPUT_PITCH 3
+
+#define BMC_MODULATOR_FLAG_LOOP 0
+#define BMC_MODULATOR_FLAG_SYNC 1
+
+// commands used by button, trigger, timed and library events
+#define BMC_MODULATOR_CMD_START 0
+#define BMC_MODULATOR_CMD_STOP 1
+#define BMC_MODULATOR_CMD_TOGGLE 2
+#define BMC_MODULATOR_CMD_STOP_ALL 3
+
+// milliseconds between updates when the modulator doesn't set it
+#define BMC_MODULATOR_DEFAULT_INTERVAL 10
+
+// a quarter of a sine wave, 0 to 90 degrees in 64 steps
+const uint16_t bmcModulatorSine[65] = {
+  0,804,1608,2410,3212,4011,4808,5602,
+  6393,7179,7962,8739,9512,10278,11039,11793,
+  12539,13279,14010,14732,15446,16151,16846,17530,
+  18204,18868,19519,20159,20787,21403,22005,22594,
+  23170,23731,24279,24811,25329,25832,26319,26790,
+  27245,27683,28105,28510,28898,29268,29621,29956,
+  30273,30571,30852,31113,31356,31580,31785,31971,
+  32137,32285,32412,32521,32609,32678,32728,32757,
+  32767
+};
+
+class BMCModulators {
+public:
+  BMCModulators(BMCMidi& t_midi, bmcStoreGlobal& t_global):
+                midi(t_midi),
+                global(t_global)
+  {
+    stopAll();
+  }
+  // called when the modulators in the store have changed
+  void buildListeners(){
+    stopAll();
+  }
+  // clock ticks sent or received since the last call
+  void tick(uint8_t ticks, uint16_t bpm){
+    // 24 ticks per quarter note
+    tickUs = (bpm > 0) ? (2500000UL / bpm) : 0;
+    if(ticks == 0){
+      return;
+    }
+    lastTickUs = micros();
+    for(uint8_t i = 0 ; i < BMC_MAX_MODULATORS ; i++){
+      if(bitRead(running, i)){
+        state[i].ticks += ticks;
+      }
+    }
+  }
+  void start(uint8_t n){
+    if(n >= BMC_MAX_MODULATORS || global.modulators[n].period == 0){
+      return;
+    }
+    bmcModulatorState& s = state[n];
+    s.start = micros();
+    s.ticks = 0;
+    s.random = getRandom();
+    bitWrite(running, n, 1);
+    // the first value is sent on the next update
+    bitWrite(sent, n, 0);
+    BMC_PRINTLN("BMCModulators start", n);
+  }
+  // the last value sent is kept
+  void stop(uint8_t n){
+    if(n < BMC_MAX_MODULATORS){
+      bitWrite(running, n, 0);
+    }
+  }
+  void stopAll(){
+    running = 0;
+  }
+  void toggle(uint8_t n){
+    if(isRunning(n)){
+      stop(n);
+    } else {
+      start(n);
+    }
+  }
+  void command(uint8_t n, uint8_t cmd){
+    switch(cmd){
+      case BMC_MODULATOR_CMD_START: start(n); break;
+      case BMC_MODULATOR_CMD_STOP: stop(n); break;
+      case BMC_MODULATOR_CMD_TOGGLE: toggle(n); break;
+      case BMC_MODULATOR_CMD_STOP_ALL: stopAll(); break;
+    }
+  }
+  bool isRunning(uint8_t n){
+    return n < BMC_MAX_MODULATORS && bitRead(running, n);
+  }
+  // last value sent
+  uint16_t getValue(uint8_t n){
+    return n < BMC_MAX_MODULATORS ? state[n].value : 0;
+  }
+  void update(){
+    if(running == 0){
+      return;
+    }
+    unsigned long now = millis();
+    for(uint8_t i = 0 ; i < BMC_MAX_MODULATORS ; i++){
+      if(!bitRead(running, i)){
+        continue;
+      }
+      bmcStoreGlobalModulator& item = global.modulators[i];
+      bmcModulatorState& s = state[i];
+      uint8_t interval = (item.interval > 0) ? item.interval : BMC_MODULATOR_DEFAULT_INTERVAL;
+      if(bitRead(sent, i) && (now - s.updated) < interval){
+        continue;
+      }
+      s.updated = now;
+      uint32_t cycles = 0;
+      uint16_t phase = getPhase(item, s, cycles);
+      bool done = false;
+      if(cycles > 0){
+        if(!bitRead(item.flags, BMC_MODULATOR_FLAG_LOOP)){
+          // a ramp stays at the top, the other shapes end where they started
+          phase = (item.shape == BMC_MODULATOR_SHAPE_RAMP) ? 0xFFFF : 0;
+          done = true;
+        } else {
+          s.random = getRandom();
+        }
+      }
+      send(i, getScaledValue(item, getWave(item.shape, phase, s.random)));
+      if(done){
+        bitWrite(running, i, 0);
+      }
+    }
+  }
+private:
+  struct bmcModulatorState {
+    // micros at the start of the current cycle, or when it was started
+    // if it's synced
+    unsigned long start = 0;
+    // clock ticks since the start of the current cycle
+    uint32_t ticks = 0;
+    unsigned long updated = 0;
+    uint16_t random = 0;
+    uint16_t value = 0;
+  };
+  BMCMidi& midi;
+  bmcStoreGlobal& global;
+  bmcModulatorState state[BMC_MAX_MODULATORS];
+  // 1 bit per modulator
+  uint16_t running = 0;
+  // a value was sent since the modulator started
+  uint16_t sent = 0;
+  // micros at the last clock tick and between ticks at the current tempo
+  unsigned long lastTickUs = 0;
+  uint32_t tickUs = 0;
+  uint32_t seed = 0x2545F491;
+
+  // position in the current cycle 0 to 65535, whole cycles that ended since
+  // the last call are added to @cycles and the cycle start moves forward
+  uint16_t getPhase(bmcStoreGlobalModulator& item, bmcModulatorState& s, uint32_t& cycles){
+    uint32_t period = item.period;
+    if(bitRead(item.flags, BMC_MODULATOR_FLAG_SYNC)){
+      if(s.ticks >= period){
+        cycles = s.ticks / period;
+        s.ticks -= cycles * period;
+      }
+      // time since the last tick, or since the start if no tick came yet
+      uint32_t fraction = 0;
+      if(tickUs > 0){
+        unsigned long from = ((int32_t)(lastTickUs - s.start) > 0) ? lastTickUs : s.start;
+        uint32_t elapsed = micros() - from;
+        fraction = (elapsed >= tickUs) ? 0xFFFF : (((uint64_t) elapsed << 16) / tickUs);
+      }
+      return ((((uint64_t) s.ticks) << 16) + fraction) / period;
+    }
+    uint32_t periodUs = period * 1000;
+    uint32_t elapsed = micros() - s.start;
+    if(elapsed >= periodUs){
+      cycles = elapsed / periodUs;
+      s.start += cycles * periodUs;
+      elapsed -= cycles * periodUs;
+    }
+    return ((uint64_t) elapsed << 16) / periodUs;
+  }
+  // 0 to 65535 for a @phase of 0 to 65535
+  uint16_t getWave(uint8_t shape, uint16_t phase, uint16_t random){
+    switch(shape){
+      case BMC_MODULATOR_SHAPE_TRIANGLE:
+        return (phase < 0x8000) ? (phase << 1) : ((0xFFFF - phase) << 1);
+      case BMC_MODULATOR_SHAPE_SINE:
+        // starts at the bottom like the triangle, 1-cos
+        return 32767 - getSine(phase + 0x4000);
+      case BMC_MODULATOR_SHAPE_RANDOM:
+        return random;
+    }
+    return phase;
+  }
+  // -32767 to 32767, a full wave for a @phase of 0 to 65535
+  int16_t getSine(uint16_t phase){
+    uint8_t quadrant = phase >> 14;
+    uint16_t x = phase & 0x3FFF;
+    if(quadrant & 1){
+      x = 0x4000 - x;
+    }
+    uint8_t index = x >> 8;
+    int32_t value = bmcModulatorSine[index];
+    if(index < 64){
+      value += ((int32_t)(bmcModulatorSine[index+1] - value) * (x & 0xFF)) >> 8;
+    }
+    return (quadrant & 2) ? -value : value;
+  }
+  // min is used when the wave is 0 and max when it's 65535, max can be lower
+  // than min to flip the wave
+  uint16_t getScaledValue(bmcStoreGlobalModulator& item, uint16_t wave){
+    uint16_t limit = (item.output == BMC_MODULATOR_OUTPUT_CC) ? 127 : 16383;
+    uint16_t min = (item.min > limit) ? limit : item.min;
+    uint16_t max = (item.max > limit) ? limit : item.max;
+    uint16_t range = (max > min) ? (max - min) : (min - max);
+    uint16_t offset = (((uint32_t) range * wave) + 32767) / 65535;
+    return (max > min) ? (min + offset) : (min - offset);
+  }
+  void send(uint8_t n, uint16_t value){
+    bmcStoreGlobalModulator& item = global.modulators[n];
+    bool force = !bitRead(sent, n);
+    switch(item.output){
+      case BMC_MODULATOR_OUTPUT_CC:
+        sendControl(item, item.number & 0x7F, value, false);
+        break;
+      case BMC_MODULATOR_OUTPUT_CC14:{
+        // MSB on CC 0 to 31 and LSB on CC 32 to 63
+        uint8_t msb = item.number & 0x1F;
+        if(force || getLocalControl14(item, msb, msb + 32) != value){
+          sendControl14(item, msb, msb + 32, value);
+        }
+        break;
+      }
+      case BMC_MODULATOR_OUTPUT_NRPN:{
+        // the NRPN number is sent once when the modulator starts, then
+        // again only if something else selected another parameter
+        bool selected = sendControl(item, 99, (item.number >> 7) & 0x7F, force);
+        selected |= sendControl(item, 98, item.number & 0x7F, force);
+        if(selected || value != state[n].value || getLocalControl14(item, 6, 38) != value){
+          sendControl14(item, 6, 38, value);
+        }
+        break;
+      }
+      case BMC_MODULATOR_OUTPUT_PITCH:
+        if(force || value != state[n].value){
+          midi.sendPitchBend(item.ports, item.channel, (int16_t) value - 8192);
+        }
+        break;
+    }
+    state[n].value = value;
+    bitWrite(sent, n, 1);
+  }
+  // returns true if the control change was sent
+  bool sendControl(bmcStoreGlobalModulator& item, uint8_t control, uint8_t value, bool force){
+    if(!force && midi.getLocalControl(item.channel, control) == value){
+      return false;
+    }
+    midi.sendControlChange(item.ports, item.channel, control, value);
+    return true;
+  }
+  // both halves of a 14-bit value, MSB first
+  void sendControl14(bmcStoreGlobalModulator& item, uint8_t msb, uint8_t lsb, uint16_t value){
+    midi.sendControlChange(item.ports, item.channel, msb, (value >> 7) & 0x7F);
+    midi.sendControlChange(item.ports, item.channel, lsb, value & 0x7F);
+  }
+  // the 14-bit value last sent or received on @msb and @lsb
+  uint16_t getLocalControl14(bmcStoreGlobalModulator& item, uint8_t msb, uint8_t lsb){
+    return ((uint16_t) midi.getLocalControl(item.channel, msb) << 7) | midi.getLocalControl(item.channel, lsb);
+  }
+  // xorshift, only used for the random sample & hold
+  uint16_t getRandom(){
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed >> 16;
+  }
+};
+
+#endif
+#endif
@@ -0,0 +1,194 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Fixed size parameter cache used by the device sync classes to keep the
+  last value received for a parameter.
+
+  Entries are stored in an open addressed table with linear probing, the
+  key is whatever the sync class uses to identify a parameter (for example
+  block and parameter id), each entry keeps it's value, the time it was
+  last updated and a dirty flag that stays on until it's read with
+  takeDirty(), that way displays/leds only update what changed.
+
+  Capacity must be a power of 2 and should be about twice the number of
+  parameters you expect to keep so lookups stay short. When the cache is
+  full the parameter that was updated the longest time ago is dropped to
+  make room, set() always keeps the new value.
+*/
+#ifndef BMC_PARAM_CACHE_H
+#define BMC_PARAM_CACHE_H
+
+#include "utility/BMC-Def.h"
+
+#define BMC_PARAM_CACHE_EMPTY   0
+#define BMC_PARAM_CACHE_USED    1
+#define BMC_PARAM_CACHE_REMOVED 2
+
+template <typename key_t, uint8_t capacity>
+class BMCParamCache {
+  static_assert(capacity > 0 && capacity <= 128 && (capacity & (capacity-1)) == 0,
+                "BMCParamCache capacity must be a power of 2 up to 128");
+public:
+  BMCParamCache(){
+    clear();
+  }
+  void clear(){
+    for(uint8_t i = 0 ; i < capacity ; i++){
+      entries[i].state = BMC_PARAM_CACHE_EMPTY;
+      entries[i].dirty = false;
+    }
+    total = 0;
+    evictions = 0;
+  }
+  // returns true if the parameter is new or it's value changed
+  bool set(key_t key, uint16_t value){
+    // a single probe finds the key or the first removed/empty entry for it
+    uint8_t index = hash(key);
+    uint8_t slot = capacity;
+    for(uint8_t i = 0 ; i < capacity ; i++){
+      bmcParamCacheEntry& e = entries[index];
+      if(e.state == BMC_PARAM_CACHE_USED && e.key == key){
+        e.updated = millis();
+        if(e.value == value){
+          return false;
+        }
+        e.value = value;
+        e.dirty = true;
+        return true;
+      }
+      if(e.state != BMC_PARAM_CACHE_USED && slot >= capacity){
+        slot = index;
+      }
+      if(e.state == BMC_PARAM_CACHE_EMPTY){
+        break;
+      }
+      index = (index+1) & (capacity-1);
+    }
+    if(slot >= capacity){
+      // full, the oldest entry makes room for this one
+      slot = evict();
+      evictions++;
+    }
+    index = slot;
+    entries[index].key = key;
+    entries[index].value = value;
+    entries[index].updated = millis();
+    entries[index].state = BMC_PARAM_CACHE_USED;
+    entries[index].dirty = true;
+    total++;
+    return true;
+  }
+  bool has(key_t key){
+    return find(key) < capacity;
+  }
+  bool get(key_t key, uint16_t& value){
+    uint8_t index = find(key);
+    if(index < capacity){
+      value = entries[index].value;
+      return true;
+    }
+    return false;
+  }
+  uint16_t getValue(key_t key, uint16_t fallback=0){
+    uint16_t value = fallback;
+    get(key, value);
+    return value;
+  }
+  // milliseconds since the parameter was last received, 0xFFFFFFFF if unknown
+  unsigned long getAge(key_t key){
+    uint8_t index = find(key);
+    if(index < capacity){
+      return millis() - entries[index].updated;
+    }
+    return 0xFFFFFFFF;
+  }
+  bool isDirty(key_t key){
+    uint8_t index = find(key);
+    return index < capacity && entries[index].dirty;
+  }
+  // get the next parameter that changed and clear it's dirty flag,
+  // returns false once there are no more changed parameters
+  bool takeDirty(key_t& key, uint16_t& value){
+    for(uint8_t i = 0 ; i < capacity ; i++){
+      if(entries[i].state == BMC_PARAM_CACHE_USED && entries[i].dirty){
+        entries[i].dirty = false;
+        key = entries[i].key;
+        value = entries[i].value;
+        return true;
+      }
+    }
+    return false;
+  }
+  bool remove(key_t key){
+    uint8_t index = find(key);
+    if(index >= capacity){
+      return false;
+    }
+    // leave a marker so entries placed after this one can still be found
+    entries[index].state = BMC_PARAM_CACHE_REMOVED;
+    entries[index].dirty = false;
+    total--;
+    return true;
+  }
+  uint8_t size(){
+    return total;
+  }
+  uint8_t getCapacity(){
+    return capacity;
+  }
+  // entries dropped to make room since the cache was cleared
+  uint16_t getEvictions(){
+    return evictions;
+  }
+private:
+  struct bmcParamCacheEntry {
+    key_t key;
+    uint16_t value;
+    uint8_t state;
+    bool dirty;
+    unsigned long updated;
+  };
+  bmcParamCacheEntry entries[capacity];
+  uint8_t total = 0;
+  uint16_t evictions = 0;
+
+  uint8_t hash(key_t key){
+    // fibonacci hashing, the top bits are the best mixed
+    return (uint8_t) ((((uint32_t) key) * 2654435769UL) >> 24) & (capacity-1);
+  }
+  // index of the key, capacity if not found
+  uint8_t find(key_t key){
+    uint8_t index = hash(key);
+    for(uint8_t i = 0 ; i < capacity ; i++){
+      bmcParamCacheEntry& e = entries[index];
+      if(e.state == BMC_PARAM_CACHE_EMPTY){
+        break;
+      }
+      if(e.state == BMC_PARAM_CACHE_USED && e.key == key){
+        return index;
+      }
+      index = (index+1) & (capacity-1);
+    }
+    return capacity;
+  }
+  // remove the entry updated the longest time ago, only called when every
+  // entry is used, returns it's index
+  uint8_t evict(){
+    uint8_t oldest = 0;
+    unsigned long now = millis();
+    for(uint8_t i = 1 ; i < capacity ; i++){
+      if((now - entries[i].updated) > (now - entries[oldest].updated)){
+        oldest = i;
+      }
+    }
+    entries[oldest].state = BMC_PARAM_CACHE_REMOVED;
+    entries[oldest].dirty = false;
+    total--;
+    return oldest;
+  }
+};
+
+#endif
@@ -0,0 +1,237 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Pipelined preset recall, the items of a preset are expanded into a
+  batch of messages and each output port works thru its own part of
+  the batch, a port waiting on a delay item or with a full transmit
+  buffer doesn't hold back the other ports.
+
+  Items without a port (page, bpm, pixel program, custom) are executed in
+  the order they are in the preset, once every port has sent the items
+  before it (and finished any delay before it), ports don't send the items
+  after it until it was executed.
+
+  Library events with status BMC_LIBRARY_EVENT_DELAY pause the ports they
+  are assigned to for the amount of milliseconds in their data bytes.
+
+  Custom SysEx is only sent once the transmit buffer of the port has room
+  for all of it, or is empty if the SysEx is larger than the buffer, the
+  size of an empty buffer comes from BMCMidi::getTxIdleSpace().
+
+  Each item keeps the port byte of the event, when it only goes to one port
+  (a USB cable port, a host device port or a port preset set to one) that
+  byte is what's sent so BMCMidi resolves the cable or device.
+*/
+#ifndef BMC_PRESET_RECALL_H
+#define BMC_PRESET_RECALL_H
+#if BMC_MAX_LIBRARY > 0 && BMC_MAX_PRESETS > 0 && defined(BMC_PRESET_PIPELINE_ENABLED)
+
+#include "utility/BMC-Def.h"
+
+// USB, Serial A, B, C, D, Host & BLE
+#define BMC_PRESET_RECALL_PORTS 7
+
+struct bmcPresetRecallItem {
+  uint32_t event = 0;
+  bmcLibrary_t index = 0;
+  // the port byte of the event or the ports passed to start()
+  uint8_t port = 0;
+  // the port bits it resolves to
+  uint8_t ports = 0;
+};
+
+class BMCPresetRecall {
+public:
+  BMCPresetRecall(BMCMidi& t_midi, BMCLibrary& t_library):
+            midi(t_midi),
+            library(t_library)
+  {
+    for(uint8_t i = 0 ; i < BMC_PRESET_RECALL_PORTS ; i++){
+      latency[i] = 0;
+      txIdle[i] = midi.getTxIdleSpace(i);
+    }
+  }
+  // a new recall replaces whatever is left of the previous one
+  void start(bmcStoreGlobalPresets& preset, bool overridePorts, uint8_t ports){
+    length = 0;
+    pending = 0;
+    draining = 0;
+    startTime = micros();
+    for(uint8_t i = 0, n = preset.length ; i < n && i < BMC_MAX_PRESET_ITEMS ; i++){
+      bmcLibrary_t index = preset.events[i];
+      if(index >= BMC_MAX_LIBRARY){
+        continue;
+      }
+      uint32_t event = library.getEvent(index);
+      uint8_t status = BMC_GET_BYTE(0, event);
+      bmcPresetRecallItem& item = items[length++];
+      item.index = index;
+      if(!hasPorts(status)){
+        // executed by update() in it's place in the preset
+        item.event = event;
+        item.port = 0;
+        item.ports = 0;
+        continue;
+      }
+      item.port = overridePorts ? ports : BMC_GET_BYTE(3, event);
+      item.ports = midi.getPortPreset(item.port) & 0x7F;
+      // toggled control changes are resolved once so every port gets the same value
+      if((status & 0xF0) == BMC_MIDI_CONTROL_CHANGE && BMC_GET_BYTE(2, event) > 127){
+        uint8_t data2 = midi.getLocalControl((status & 0x0F)+1, BMC_GET_BYTE(1, event)) > 0 ? 0 : 127;
+        event = (event & 0xFF00FFFF) | ((uint32_t) data2 << 16);
+      }
+      item.event = event;
+      pending |= item.ports;
+    }
+    barrier = findBarrier(0);
+    for(uint8_t i = 0 ; i < BMC_PRESET_RECALL_PORTS ; i++){
+      position[i] = 0;
+      if(bitRead(pending, i)){
+        latency[i] = 0;
+        waitStart[i] = 0;
+        waitTime[i] = 0;
+      }
+    }
+    update();
+  }
+  void update(){
+    if(pending == 0 && draining == 0 && barrier >= length){
+      return;
+    }
+    // one item per port on each pass so all ports start transmitting
+    // at the same time, stop once nothing could be sent
+    bool sent = true;
+    while(sent){
+      sent = false;
+      for(uint8_t i = 0 ; i < BMC_PRESET_RECALL_PORTS ; i++){
+        if(bitRead(pending, i) && sendNext(i)){
+          sent = true;
+        }
+      }
+      if(runBarrier()){
+        sent = true;
+      }
+    }
+    // ports with a hardware buffer are done when the last byte has left it
+    for(uint8_t i = 0 ; i < BMC_PRESET_RECALL_PORTS && draining > 0 ; i++){
+      if(bitRead(draining, i) && midi.getTxSpace(i) >= txIdle[i]){
+        bitWrite(draining, i, 0);
+        latency[i] = micros() - startTime;
+      }
+    }
+  }
+  bool active(){
+    return (pending | draining) > 0 || barrier < length;
+  }
+  // microseconds from the start of the last recall until the last byte
+  // for port @n was sent, @n is one of BMC_MIDI_PORT_*_BIT
+  // 0 if the port was not part of that recall
+  uint32_t getLatency(uint8_t n){
+    return (n < BMC_PRESET_RECALL_PORTS) ? latency[n] : 0;
+  }
+private:
+  BMCMidi& midi;
+  BMCLibrary& library;
+  bmcPresetRecallItem items[BMC_MAX_PRESET_ITEMS];
+  uint8_t length = 0;
+  // the next item without a port, ports wait here until it's executed
+  uint8_t barrier = 0;
+  // ports that still have items to send
+  uint8_t pending = 0;
+  // ports that sent everything but their transmit buffer is not empty yet
+  uint8_t draining = 0;
+  unsigned long startTime = 0;
+  uint8_t position[BMC_PRESET_RECALL_PORTS];
+  unsigned long waitStart[BMC_PRESET_RECALL_PORTS];
+  uint16_t waitTime[BMC_PRESET_RECALL_PORTS];
+  uint32_t latency[BMC_PRESET_RECALL_PORTS];
+  // free space of an empty transmit buffer, raised if more is ever seen
+  uint8_t txIdle[BMC_PRESET_RECALL_PORTS];
+
+  bool hasPorts(uint8_t status){
+    return (status > 127 && status <= 0xF2) || status == BMC_LIBRARY_EVENT_DELAY;
+  }
+  uint8_t findBarrier(uint8_t n){
+    while(n < length && hasPorts(BMC_GET_BYTE(0, items[n].event))){
+      n++;
+    }
+    return n;
+  }
+  // execute the item without a port once every port got to it
+  bool runBarrier(){
+    if(barrier >= length){
+      return false;
+    }
+    for(uint8_t i = 0 ; i < BMC_PRESET_RECALL_PORTS ; i++){
+      if(bitRead(pending, i) && (position[i] < barrier || waitTime[i] > 0)){
+        return false;
+      }
+    }
+    library.send(items[barrier].index);
+    barrier = findBarrier(barrier+1);
+    return true;
+  }
+  bool sendNext(uint8_t p){
+    if(waitTime[p] > 0){
+      if((millis() - waitStart[p]) < waitTime[p]){
+        return false;
+      }
+      waitTime[p] = 0;
+    }
+    uint8_t mask = bit(p);
+    while(position[p] < length && !(items[position[p]].ports & mask)){
+      position[p]++;
+    }
+    uint8_t space = midi.getTxSpace(p);
+    if(space > txIdle[p]){
+      txIdle[p] = space;
+    }
+    if(position[p] < length && position[p] > barrier){
+      // the next item of this port comes after an item without a port
+      // that wasn't executed yet
+      return false;
+    }
+    if(position[p] >= length){
+      bitWrite(pending, p, 0);
+      if(space < txIdle[p]){
+        bitWrite(draining, p, 1);
+      } else {
+        latency[p] = micros() - startTime;
+      }
+      return false;
+    }
+    bmcPresetRecallItem& item = items[position[p]];
+    uint8_t status = BMC_GET_BYTE(0, item.event);
+    if(status == BMC_LIBRARY_EVENT_DELAY){
+      waitStart[p] = millis();
+      waitTime[p] = library.getDelay(item.index);
+      position[p]++;
+      return true;
+    }
+    // the port byte goes along when this is the only port it sends to
+    uint8_t port = (item.ports == mask) ? item.port : mask;
+    if(status < 0xF0){
+      // a channel message is at most 3 bytes
+      if(space < 3){
+        return false;
+      }
+      midi.send(port, item.event);
+    } else {
+      // wait for room for the whole SysEx, one that is larger than the
+      // buffer is sent once the buffer is empty
+      uint16_t length = library.getSysExLength(item.index);
+      if(space < length && space < txIdle[p]){
+        return false;
+      }
+      library.sendWithDifferentPorts(item.index, port);
+    }
+    position[p]++;
+    return true;
+  }
+};
+
+#endif
+#endif
@@ -12,6 +12,9 @@
 #define BMC_FLAG_PRESETS_BANK_CHANGED 1
 
 #include "utility/BMC-Def.h"
+#if defined(BMC_PRESET_PIPELINE_ENABLED)
+  #include "utility/BMC-PresetRecall.h"
+#endif
 
 class BMCPresets {
 public:
@@ -19,8 +22,23 @@ public:
             midi(t_midi),
             global(t_global),
             library(t_library)
+            #if defined(BMC_PRESET_PIPELINE_ENABLED)
+              ,recall(t_midi, t_library)
+            #endif
   {
   }
+#if defined(BMC_PRESET_PIPELINE_ENABLED)
+  // sends what's left of the last recall, must be called on every loop
+  void update(){
+    recall.update();
+  }
+  bool recallActive(){
+    return recall.active();
+  }
+  uint32_t getRecallLatency(uint8_t n){
+    return recall.getLatency(n);
+  }
+#endif
   void set(bmcPreset_t index=0, bool overridePorts=false, uint8_t ports=0){
     send(index, overridePorts, ports);
   }
@@ -55,6 +73,9 @@ public:
       return;
     }
 
+#if defined(BMC_PRESET_PIPELINE_ENABLED)
+    recall.start(global.presets[index], overridePorts, ports);
+#else
     for(uint8_t i = 0, n = global.presets[index].length ; i < n ; i++){
       if(i>=BMC_MAX_PRESET_ITEMS){
         break;
@@ -65,6 +86,7 @@ public:
         library.send(global.presets[index].events[i]);
       }
     }
+#endif
   }
   //
   void scroll(uint8_t t_amount, bool t_up, bool t_endless){
@@ -151,6 +173,15 @@ public:
     }
     return 0;
   }
+  // name of the preset without copying it, empty if presets have no names
+  const char * getName(bmcPreset_t n){
+#if BMC_NAME_LEN_PRESETS > 1
+    if(n<BMC_MAX_PRESETS){
+      return global.presets[n].name;
+    }
+#endif
+    return "";
+  }
   void getName(bmcPreset_t n, char* t_string){
 #if BMC_NAME_LEN_PRESETS > 1
     if(n<BMC_MAX_PRESETS){
@@ -167,6 +198,9 @@ private:
   BMCMidi& midi;
   bmcStoreGlobal& global;
   BMCLibrary& library;
+#if defined(BMC_PRESET_PIPELINE_ENABLED)
+  BMCPresetRecall recall;
+#endif
   BMCFlags <uint8_t> flags;
   const uint8_t totalBanks = (uint8_t) ceil((BMC_MAX_PRESETS * 1.0) / BMC_MAX_PRESETS_PER_BANK);
 };
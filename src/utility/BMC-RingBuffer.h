@@ -0,0 +1,135 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Fixed size single producer/single consumer ring buffer, the memory is
+  part of the object so nothing is allocated at runtime.
+
+  Size must be a power of 2, head and tail are free running counters that
+  are masked when used as an index, that way all slots can be used and a
+  full buffer is told apart from an empty one without a flag.
+
+  Only the producer writes head and only the consumer writes tail so a
+  single writer (an ISR for example) and a single reader can use it at the
+  same time without disabling interrupts.
+
+  Values pushed when the buffer is full are dropped and counted, see
+  getOverflows()
+*/
+#ifndef BMC_RING_BUFFER_H
+#define BMC_RING_BUFFER_H
+
+#include <Arduino.h>
+
+template <typename T, uint16_t size>
+class BMCRingBuffer {
+  static_assert(size > 1 && size <= 32768 && (size & (size-1)) == 0,
+                "BMCRingBuffer size must be a power of 2 up to 32768");
+public:
+  BMCRingBuffer(){}
+  // PRODUCER
+  bool push(T value){
+    uint16_t h = head;
+    if((uint16_t)(h - tail) >= size){
+      overflows++;
+      return false;
+    }
+    buffer[h & (size-1)] = value;
+    head = h + 1;
+    return true;
+  }
+  // pushes all of @data or nothing, returns false if it didn't fit
+  bool push(const T * data, uint16_t length){
+    uint16_t h = head;
+    if(length > size - (uint16_t)(h - tail)){
+      overflows++;
+      return false;
+    }
+    for(uint16_t i = 0 ; i < length ; i++){
+      buffer[(h + i) & (size-1)] = data[i];
+    }
+    head = h + length;
+    return true;
+  }
+  uint16_t space(){
+    return size - count();
+  }
+  // CONSUMER
+  T pop(){
+    uint16_t t = tail;
+    if(t == head){
+      return 0;
+    }
+    T value = buffer[t & (size-1)];
+    tail = t + 1;
+    return value;
+  }
+  T peek(uint16_t offset=0){
+    if(offset >= count()){
+      return 0;
+    }
+    return buffer[(tail + offset) & (size-1)];
+  }
+  // the largest block of values that can be read without wrapping,
+  // @data points to the first value, consume it with discard()
+  uint16_t span(const T *& data){
+    uint16_t t = tail;
+    uint16_t index = t & (size-1);
+    uint16_t available = (uint16_t)(head - t);
+    data = &buffer[index];
+    return (available < (size - index)) ? available : (size - index);
+  }
+  // copies up to @length values into @data, returns the values copied
+  uint16_t read(T * data, uint16_t length){
+    uint16_t copied = 0;
+    while(copied < length){
+      const T * block;
+      uint16_t n = span(block);
+      if(n == 0){
+        break;
+      }
+      n = (n < (length - copied)) ? n : (length - copied);
+      memcpy(data + copied, block, n * sizeof(T));
+      discard(n);
+      copied += n;
+    }
+    return copied;
+  }
+  void discard(uint16_t length){
+    uint16_t available = count();
+    tail += (length < available) ? length : available;
+  }
+  // SHARED
+  uint16_t count(){
+    return (uint16_t)(head - tail);
+  }
+  bool isEmpty(){
+    return head == tail;
+  }
+  bool isFull(){
+    return count() >= size;
+  }
+  // only safe when nothing is being pushed
+  void clear(){
+    tail = head;
+  }
+  uint16_t getCapacity(){
+    return size;
+  }
+  // values dropped because the buffer was full
+  uint32_t getOverflows(){
+    return overflows;
+  }
+  void resetOverflows(){
+    overflows = 0;
+  }
+private:
+  T buffer[size];
+  volatile uint16_t head = 0;
+  volatile uint16_t tail = 0;
+  volatile uint32_t overflows = 0;
+};
+
+#endif
@@ -0,0 +1,198 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Clock synced sequences, each sequence is a list of library items and the
+  clock tick (24 per quarter note) at which each one is sent, from the
+  master clock or the incoming clock.
+
+  Steps are sorted by tick when the store is loaded and when a sequence that
+  was edited from the sketch starts, the sequences that are playing wait in
+  a queue sorted by the tick their next step is due, on each clock tick only
+  the front of the queue is checked so idle or waiting sequences cost nothing.
+
+  A sequence can start right away or on the next multiple of a number of
+  beats (for example the next bar) and can loop, the loop length is set in
+  ticks, if it's 0 the loop starts again on the tick after the last step.
+*/
+#ifndef BMC_SEQUENCER_H
+#define BMC_SEQUENCER_H
+
+#include "utility/BMC-Def.h"
+
+#if BMC_MAX_SEQUENCES > 0
+
+#define BMC_SEQUENCE_FLAG_LOOP 0
+
+// commands used by button, trigger and timed events
+#define BMC_SEQUENCE_CMD_START 0
+#define BMC_SEQUENCE_CMD_STOP 1
+#define BMC_SEQUENCE_CMD_TOGGLE 2
+#define BMC_SEQUENCE_CMD_STOP_ALL 3
+
+class BMCSequencer {
+public:
+  BMCSequencer(bmcStoreGlobal& t_global):global(t_global){
+    stopAll();
+  }
+  // called when the sequences in the store have changed
+  void buildListeners(){
+    stopAll();
+    for(uint8_t i = 0 ; i < BMC_MAX_SEQUENCES ; i++){
+      sortSteps(global.sequences[i]);
+    }
+    unsorted = 0;
+  }
+  // sequence @n was edited, it's stopped and it's steps are sorted the next
+  // time it starts, sorting right away would move the steps the sketch is
+  // still setting by their index
+  void edited(uint8_t n){
+    if(n < BMC_MAX_SEQUENCES){
+      stop(n);
+      bitWrite(unsorted, n, 1);
+    }
+  }
+  // a clock tick was sent or received
+  void tick(){
+    now++;
+  }
+  // @songTicks is the position of the next clock tick, used to start on a
+  // multiple of the quantize beats of the sequence
+  void start(uint8_t n, uint32_t songTicks){
+    if(n >= BMC_MAX_SEQUENCES || global.sequences[n].length == 0){
+      return;
+    }
+    stop(n);
+    bmcStoreGlobalSequence& item = global.sequences[n];
+    if(bitRead(unsorted, n)){
+      sortSteps(item);
+      bitWrite(unsorted, n, 0);
+    }
+    uint32_t due = now;
+    if(item.quantize > 0){
+      uint32_t q = (uint32_t) item.quantize * 24;
+      // the clock tick on the boundary is counted by the next tick()
+      due = now + ((q - (songTicks % q)) % q) + 1;
+    }
+    startTick[n] = due;
+    step[n] = 0;
+    bitWrite(playing, n, 1);
+    enqueue(n, due + item.steps[0].tick);
+    BMC_PRINTLN("BMCSequencer start", n, "in", due - now, "ticks");
+  }
+  void stop(uint8_t n){
+    if(n >= BMC_MAX_SEQUENCES || !bitRead(playing, n)){
+      return;
+    }
+    bitWrite(playing, n, 0);
+    for(uint8_t i = 0 ; i < queued ; i++){
+      if(queue[i].sequence == n){
+        remove(i);
+        break;
+      }
+    }
+  }
+  void stopAll(){
+    playing = 0;
+    queued = 0;
+  }
+  void toggle(uint8_t n, uint32_t songTicks){
+    if(isPlaying(n)){
+      stop(n);
+    } else {
+      start(n, songTicks);
+    }
+  }
+  void command(uint8_t n, uint8_t cmd, uint32_t songTicks){
+    switch(cmd){
+      case BMC_SEQUENCE_CMD_START: start(n, songTicks); break;
+      case BMC_SEQUENCE_CMD_STOP: stop(n); break;
+      case BMC_SEQUENCE_CMD_TOGGLE: toggle(n, songTicks); break;
+      case BMC_SEQUENCE_CMD_STOP_ALL: stopAll(); break;
+    }
+  }
+  bool isPlaying(uint8_t n){
+    return n < BMC_MAX_SEQUENCES && bitRead(playing, n);
+  }
+  // index of the next step the sequence will send
+  uint8_t getStep(uint8_t n){
+    return n < BMC_MAX_SEQUENCES ? step[n] : 0;
+  }
+  // returns true with the library item of a step that is due, call it
+  // until it returns false, steps are returned in the order they are due
+  bool getDueStep(uint8_t& n, bmcLibrary_t& event){
+    if(queued == 0 || (int32_t)(now - queue[0].due) < 0){
+      return false;
+    }
+    n = queue[0].sequence;
+    remove(0);
+    bmcStoreGlobalSequence& item = global.sequences[n];
+    event = item.steps[step[n]].event;
+    step[n]++;
+    if(step[n] >= item.length){
+      if(!bitRead(item.flags, BMC_SEQUENCE_FLAG_LOOP)){
+        bitWrite(playing, n, 0);
+        return true;
+      }
+      // the loop is at least as long as the last step
+      uint32_t last = item.steps[item.length-1].tick;
+      startTick[n] += (item.ticks > last) ? item.ticks : last + 1;
+      step[n] = 0;
+    }
+    enqueue(n, startTick[n] + item.steps[step[n]].tick);
+    return true;
+  }
+private:
+  struct bmcSequencerItem {
+    uint32_t due;
+    uint8_t sequence;
+  };
+  bmcStoreGlobal& global;
+  // clock ticks counted since boot
+  uint32_t now = 0;
+  // 1 bit per sequence
+  uint16_t playing = 0;
+  // 1 bit per sequence edited since it's steps were sorted
+  uint16_t unsorted = 0xFFFF;
+  uint32_t startTick[BMC_MAX_SEQUENCES];
+  uint8_t step[BMC_MAX_SEQUENCES];
+  bmcSequencerItem queue[BMC_MAX_SEQUENCES];
+  uint8_t queued = 0;
+
+  void enqueue(uint8_t n, uint32_t due){
+    uint8_t i = queued;
+    // sequences due at the same tick keep the order they were queued in
+    while(i > 0 && (int32_t)(queue[i-1].due - due) > 0){
+      queue[i] = queue[i-1];
+      i--;
+    }
+    queue[i].due = due;
+    queue[i].sequence = n;
+    queued++;
+  }
+  void remove(uint8_t index){
+    for(uint8_t i = index ; i+1 < queued ; i++){
+      queue[i] = queue[i+1];
+    }
+    queued--;
+  }
+  void sortSteps(bmcStoreGlobalSequence& item){
+    if(item.length > BMC_MAX_SEQUENCE_STEPS){
+      item.length = BMC_MAX_SEQUENCE_STEPS;
+    }
+    for(uint8_t i = 1 ; i < item.length ; i++){
+      bmcStoreGlobalSequenceStep value = item.steps[i];
+      uint8_t e = i;
+      while(e > 0 && item.steps[e-1].tick > value.tick){
+        item.steps[e] = item.steps[e-1];
+        e--;
+      }
+      item.steps[e] = value;
+    }
+  }
+};
+
+#endif
+#endif
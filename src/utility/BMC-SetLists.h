@@ -36,7 +36,7 @@ public:
       return;
     }
     song = n;
-    if(global.setLists[n].length > n){
+    if(global.setLists[setList].length > n){
       presets.set(global.setLists[setList].songs[n]);
     }
     BMC_PRINTLN("Song #", n);
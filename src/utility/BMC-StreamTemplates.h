@@ -0,0 +1,64 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  The templates used to build the name of value streams, see
+  BMC.sketchStream.cpp, formatted with BMCFormat::addTemplate()
+*/
+#ifndef BMC_STREAM_TEMPLATES_H
+#define BMC_STREAM_TEMPLATES_H
+
+// the following are templates for value streams
+// these strings are the message that will be passed when value streams are triggered
+// these can all be overloaded in the config file
+// make sure you follow the format of each
+// these can not exceed 30 characters including the EOL
+
+// used when changing pages
+#ifndef BMC_STREAM_TEMPL_PAGE
+  #define BMC_STREAM_TEMPL_PAGE "Page %03u %s"
+#endif
+
+// used when changing presets
+#ifndef BMC_STREAM_TEMPL_PRESET
+  #define BMC_STREAM_TEMPL_PRESET "Preset %03u %s"
+#endif
+
+// used when changing setlists
+#ifndef BMC_STREAM_TEMPL_SETLIST
+  #define BMC_STREAM_TEMPL_SETLIST "SetList %03u %s"
+#endif
+
+// used when changing songs
+#ifndef BMC_STREAM_TEMPL_SETLIST_SONG
+  #define BMC_STREAM_TEMPL_SETLIST_SONG "Song %03u %s"
+#endif
+
+// used when sending midi program change
+#ifndef BMC_STREAM_TEMPL_MIDI_PC
+  #define BMC_STREAM_TEMPL_MIDI_PC "Program Ch:%02u PC:%03u"
+#endif
+
+// used when sending midi control change
+#ifndef BMC_STREAM_TEMPL_MIDI_CC
+  #define BMC_STREAM_TEMPL_MIDI_CC "Control Ch:%02u CC:%03u V:%03u"
+#endif
+
+// used when sending midi note on
+#ifndef BMC_STREAM_TEMPL_MIDI_NOTE_ON
+  #define BMC_STREAM_TEMPL_MIDI_NOTE_ON "Note On Ch:%02u N:%03u V:%03u"
+#endif
+
+// used when sending midi note off
+#ifndef BMC_STREAM_TEMPL_MIDI_NOTE_OFF
+  #define BMC_STREAM_TEMPL_MIDI_NOTE_OFF "Note Off Ch:%02u N:%03u V:%03u"
+#endif
+
+// used when midi clock bpm has changed
+#ifndef BMC_STREAM_TEMPL_MIDI_CLOCK_BPM
+  #define BMC_STREAM_TEMPL_MIDI_CLOCK_BPM "BPM %03u"
+#endif
+
+#endif
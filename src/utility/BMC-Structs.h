@@ -30,6 +30,26 @@ struct BMCRunTime {
     return seconds;
   }
 };
+// micros() at each stage of the startup, see BMC_BOOT_STAGE_* in BMC-Def.h
+struct BMCBootStages {
+  uint32_t stage[BMC_BOOT_STAGE_COUNT];
+  BMCBootStages(){
+    memset(stage, 0, sizeof(stage));
+  }
+  // only the first time a stage is reached is kept
+  void set(uint8_t n){
+    if(n < BMC_BOOT_STAGE_COUNT && stage[n] == 0){
+      stage[n] = micros();
+    }
+  }
+  uint32_t get(uint8_t n){
+    return n < BMC_BOOT_STAGE_COUNT ? stage[n] : 0;
+  }
+  // time from the start of begin() to the stage in microseconds
+  uint32_t elapsed(uint8_t n){
+    return get(n) > 0 ? get(n) - stage[BMC_BOOT_STAGE_START] : 0;
+  }
+};
 struct BMCTunerData {
   uint8_t stringNumber = 0;
   uint8_t note = 0;
@@ -399,6 +419,8 @@ struct BMCRoutingItem {
   uint8_t destinations = 0;
   uint8_t filters = 0;
   uint8_t channel = 0;
+  // USB cable used when routed to USB, not part of the stored routing data
+  uint8_t cable = 0;
   void setData(uint16_t t_data){
     destinations = t_data & 0x7F;
     filters = (t_data>>7) & 0x0F;
@@ -409,12 +431,14 @@ struct BMCRoutingItem {
   }
 };
 struct BMCRoutingData {
-  BMCRoutingItem usb;
+  // one for each USB cable, usb[0] is the USB port routing
+  BMCRoutingItem usb[BMC_USB_CABLES];
   BMCRoutingItem serialA;
   BMCRoutingItem serialB;
   BMCRoutingItem serialC;
   BMCRoutingItem serialD;
-  BMCRoutingItem host;
+  // one for each USB Host device, host[0] is the host port routing
+  BMCRoutingItem host[BMC_USB_HOST_DEVICES];
   BMCRoutingItem ble;
 };
 struct BMCMidiTimeSignature {
@@ -461,81 +485,12 @@ struct BMCMidiTimeSignature {
   }
 };
 
-struct BMCLogicControlChannelVU {
-  // bits 0=overload, 1=changed
-  BMCFlags <uint8_t> flags;
-  BMCEndlessTimer meterDecayTimer;
-  uint8_t meter = 0;
-  uint8_t lastPeak = 0;
-  void reset(){
-    flags.reset();
-    meter = 0;
-    lastPeak = 0;
-  }
-
-  BMCLogicControlChannelVU(){
-    meterDecayTimer.start(300);
-  }
-  void update(){
-    if(meter>0 && meterDecayTimer){
-      meter--;
-      flags.on(1);
-    }
-  }
-  bool hasChanged(){
-    return flags.toggleIfTrue(1);
-  }
-  bool getOverload(){
-    return flags.read(0);
-  }
-  uint8_t getPeak(){
-    return lastPeak;
-  }
-  uint8_t getMeter(uint8_t max=0){
-    if(max > 0 && (meter < max)){
-      return 0;
-    }
-    return meter;
-  }
-  void setMeter(uint8_t value){
-    if(assignMeterValue(value)){
-      meterDecayTimer.restart();
-    }
-  }
-  bool assignMeterValue(uint8_t value){
-    switch(value){
-      case 0x0D:
-        break;
-      case 0x0E:
-        // set the overload
-        if(!flags.read(0)){flags.on(1);}
-        flags.on(0);
-        return true;
-      case 0x0F:
-        // remove the overload
-        if(flags.read(0)){flags.on(1);}
-        flags.off(0);
-        return true;
-      default:
-        // get the last peak state
-        if(value != lastPeak){
-          meter = value;
-          flags.on(1);
-        }
-        lastPeak = value;
-        return true;
-    }
-    return false;
-  }
-};
 struct BMCLogicControlChannel {
   // state bits: 0=rec, 1=solo, 2=mute, 3=select, 4=signal
   uint8_t states = 0;
   int fader = 0;
   uint8_t vPot = 0;
-  BMCLogicControlChannelVU vu;
   void reset(){
-    vu.reset();
     states = 0;
     fader = 0;
     vPot = 0;
@@ -547,9 +502,6 @@ struct BMCLogicControlChannel {
   bool getSelectState(){  return bitRead(states, 3);}
   bool getSignalState(){  return bitRead(states, 4);}
 
-  void update(){
-    vu.update();
-  }
   uint8_t getVPot(){
     return vPot;
   }
@@ -636,16 +588,11 @@ struct BMCLogicControlData {
     flags = 0;
     selected = 0;
     states = 0;
-    for(uint8_t i=0;i<9;i++){
+    for(uint8_t i=0;i<8;i++){
       channel[i].reset();
     }
   }
 
-  void update(){
-    for(uint8_t i=0;i<9;i++){
-      channel[i].update();
-    }
-  }
   void setOnline(){
     reset();
     bitWrite(flags, 0, 1);
@@ -765,19 +712,6 @@ struct BMCLogicControlData {
     return chAllowed(n) ? channel[chCheck(n)].getVPotValue(ledN) : 0;
   }
 
-  bool getMeterOverload(uint8_t n){
-    return chAllowed(n) ? channel[chCheck(n)].vu.getOverload() : false;
-  }
-  uint8_t getMeter(uint8_t n, uint8_t max=0){
-    return chAllowed(n) ? channel[chCheck(n)].vu.getMeter(max) : 0;
-  }
-  uint8_t getMeterPeak(uint8_t n){
-    return chAllowed(n) ? channel[chCheck(n)].vu.getPeak() : 0;
-  }
-  uint8_t getMeterChanged(uint8_t n){
-    return chAllowed(n) ? channel[chCheck(n)].vu.hasChanged() : 0;
-  }
-
   // set the state
   void setRecState(uint8_t n, bool value){     if(chAllowed(n)){channel[n].setRecState(value);}}
   void setSoloState(uint8_t n, bool value){    if(chAllowed(n)){channel[n].setSoloState(value);}}
@@ -785,7 +719,6 @@ struct BMCLogicControlData {
   void setSelectState(uint8_t n, bool value){  if(chAllowed(n)){channel[n].setSelectState(value);}}
   void setSignalState(uint8_t n, bool value){  if(chAllowed(n)){channel[n].setSignalState(value);}}
   void setVPot(uint8_t n, uint8_t value){      if(chAllowed(n)){channel[n].setVPot(value);}}
-  void setMeter(uint8_t n, uint8_t value){     if(chAllowed(n)){channel[n].vu.setMeter(value);}}
 
   void setVolume(uint8_t n, int value){
     if(chAllowed(n)){
@@ -3,6 +3,23 @@
   Copyright (c) 2020 RoxXxtar.com
   Licensed under the MIT license.
   See LICENSE file in the project root for full license information.
+
+  Sends the Tap Tempo message of each device when the Master/Slave clock
+  tempo changes, simulating you tapping the tempo in.
+
+  Taps are sent on the beats of the clock instead of from a timer so they
+  are exactly a beat apart and in phase with the clock, a device that uses
+  the last tap as it's downbeat lines up with the clock too.
+
+  Each device has a profile, the number of taps to send, the number of
+  intervals the device averages (at least that many intervals + 1 are sent
+  so the average only has taps at the new tempo) and how far in BPM the
+  tempo has to drift from the last tempo tapped before the device is tapped
+  again, that way small changes of an incoming clock don't keep tapping.
+
+  Profiles are kept in the store so they are only available when
+  BMC_USE_TEMPO_TO_TAP_PROFILES is defined, otherwise every device uses the
+  defaults below.
 */
 #ifndef BMC_TEMPO_TO_TAP_H
 #define BMC_TEMPO_TO_TAP_H
@@ -11,6 +28,10 @@
 
 #include "utility/BMC-Def.h"
 
+// used when the profile of a device is left at 0
+#define BMC_TEMPO_TO_TAP_DEFAULT_TAPS 4
+#define BMC_TEMPO_TO_TAP_DEFAULT_THRESHOLD 1
+
 class BMCTempoToTap {
 public:
   // constructor, pass the midi and store.global data objects from BMC.h
@@ -20,65 +41,94 @@ public:
   {
     reset();
   }
-  // check if the next tap should be sent
-  // this must run within every loop so the timer can send each tap
-  void update(){
-    if(timer.complete()){
-      if(count>=3){
-        // all done
-        reset();
-        return;
+  // the tempo changed, taps are queued for the devices that drifted too far
+  // from the last tempo they were tapped to, the taps are sent by beat()
+  void send(uint16_t tempo){
+    if(!BMCBpmCalculator::isValidBpm(tempo)){
+      return;
+    }
+    for(uint8_t i=0;i<BMC_MAX_TEMPO_TO_TAP;i++){
+      if(!isValid(global.tempoToTap[i].event)){
+        continue;
+      }
+      if(tapped[i]>0 && getDrift(tapped[i], tempo) < getThreshold(i)){
+        continue;
       }
-      sendTaps();
-      count++;
+      // a burst already being sent starts over so the device only
+      // averages taps at the new tempo
+      tapped[i] = tempo;
+      pending[i] = getTaps(i);
+      BMC_PRINTLN("BMCTempoToTap device", i, "taps", pending[i], "bpm:", tempo);
     }
   }
-  // start sending the taps based on the specified Tempo
-  void send(uint16_t tempo){
-    if(lastBpm==tempo){
-      return;
+  // tap all devices again at @tempo, for example after they were turned on
+  void retap(uint16_t tempo){
+    reset();
+    send(tempo);
+  }
+  // must be called on every beat of the clock
+  void beat(){
+    for(uint8_t i=0;i<BMC_MAX_TEMPO_TO_TAP;i++){
+      if(pending[i]>0){
+        midi.send(global.tempoToTap[i].event);
+        pending[i]--;
+        BMC_PRINTLN("Sending Tap bpm:", tapped[i], "event:", global.tempoToTap[i].event);
+      }
     }
-    if(BMCBpmCalculator::isValidBpm(tempo)){
-      if(bpm == tempo){
-        if(timer.active()){
-          return;
-        }
-      } else {
-        timer.stop();
-        reset();
+  }
+  // true if any device has taps left to send
+  bool isTapping(){
+    for(uint8_t i=0;i<BMC_MAX_TEMPO_TO_TAP;i++){
+      if(pending[i]>0){
+        return true;
       }
-      bpm = tempo;
-      sendTaps();
     }
+    return false;
+  }
+  // tempo device @n was last tapped to, 0 if it wasn't tapped yet
+  uint16_t getTappedBpm(uint8_t n){
+    return (n<BMC_MAX_TEMPO_TO_TAP) ? tapped[n] : 0;
+  }
+  // number of taps sent to device @n, at least the averaging window + 1
+  uint8_t getTaps(uint8_t n){
+#if defined(BMC_TEMPO_TO_TAP_PROFILES_ENABLED)
+    bmcStoreGlobalTempoToTapProfile& profile = global.tempoToTapProfiles[n];
+    uint8_t taps = (profile.taps>0) ? profile.taps : BMC_TEMPO_TO_TAP_DEFAULT_TAPS;
+    if(profile.window<taps){
+      return taps;
+    }
+    // a window of 255 can't have one more tap
+    return (profile.window<255) ? (profile.window+1) : 255;
+#else
+    return BMC_TEMPO_TO_TAP_DEFAULT_TAPS;
+#endif
+  }
+  uint8_t getThreshold(uint8_t n){
+#if defined(BMC_TEMPO_TO_TAP_PROFILES_ENABLED)
+    uint8_t threshold = global.tempoToTapProfiles[n].threshold;
+    return (threshold>0) ? threshold : BMC_TEMPO_TO_TAP_DEFAULT_THRESHOLD;
+#else
+    return BMC_TEMPO_TO_TAP_DEFAULT_THRESHOLD;
+#endif
   }
 private:
   // reference to midi object from BMC.h
   BMCMidi& midi;
   // reference to store.global from BMC.h
   bmcStoreGlobal& global;
-  // timer used to send each midi message
-  BMCTimer timer;
-  // number of taps that have been sent
-  uint8_t count = 0;
-  // the bpm for the taps interval
-  uint16_t bpm = 0;
-  // the last bpm sent out
-  uint16_t lastBpm = 0;
-  // set the current number of taps that were sent to 0
+  // taps left to send to each device
+  uint8_t pending[BMC_MAX_TEMPO_TO_TAP];
+  // the tempo each device was last tapped to
+  uint16_t tapped[BMC_MAX_TEMPO_TO_TAP];
+  // forget the tempo of every device
   void reset(){
-    count = 0;
-  }
-  // send the MIDI Message out for each trigger
-  void sendTaps(){
-    lastBpm = bpm;
     for(uint8_t i=0;i<BMC_MAX_TEMPO_TO_TAP;i++){
-      if(isValid(global.tempoToTap[i].event)){
-      //if(BMC_GET_BYTE(0,global.tempoToTap[i].event)>0 && BMC_GET_BYTE(3,global.tempoToTap[i].event)>0){
-        midi.send(global.tempoToTap[i].event);
-        BMC_PRINTLN("Sending Tap bpm:", bpm, "event:", global.tempoToTap[i].event);
-      }
+      pending[i] = 0;
+      tapped[i] = 0;
     }
-    timer.start(BMCBpmCalculator::bpmToMillis(bpm));
+  }
+  uint16_t getDrift(uint16_t a, uint16_t b){
+    return (a>b) ? (a-b) : (b-a);
   }
   bool isValid(uint32_t event){
     return hasEvent(event) && hasPorts(event);
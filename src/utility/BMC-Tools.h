@@ -49,7 +49,7 @@ public:
   static bool isMidiBlePort(uint8_t port){
     return bitRead(port,BMC_MIDI_PORT_BLE_BIT);
   }
-  static String getPortName(uint8_t port){
+  static const char * getPortName(uint8_t port){
     if(isMidiUsbPort(port)){
       return "USB";
     } else if(isMidiSerialAPort(port)){
@@ -67,10 +67,10 @@ public:
     }
     return "";
   }
-  static String getPortsName(uint8_t port){
+  static const char * getPortsName(uint8_t port){
     return getPortName(port);
   }
-  static String printPortsNames(uint8_t port){
+  static const char * printPortsNames(uint8_t port){
     if(isMidiUsbPort(port)){
       BMC_PRINT("USB, ");
     } else if(isMidiSerialAPort(port)){
@@ -88,7 +88,7 @@ public:
     }
     return "";
   }
-  static String getMidiStatusName(uint8_t status){
+  static const char * getMidiStatusName(uint8_t status){
     switch(status){
       case BMC_MIDI_RT_CLOCK:
         return "Clock";
@@ -132,7 +132,7 @@ public:
   static bool isMidiClockLedEvent(uint32_t t_value){
     return ((t_value&0xFF)==BMC_LED_EVENT_TYPE_CLOCK_SYNC);
   }
-  static String getButtonTriggerName(uint8_t t_trigger){
+  static const char * getButtonTriggerName(uint8_t t_trigger){
     switch(t_trigger){
       case BMC_BUTTON_PRESS_TYPE_PRESS:
         return "Press";
@@ -201,6 +201,7 @@ public:
       case BMC_MIDI_TIME_CODE_QUARTER_FRAME:
       case BMC_MIDI_SONG_SELECT:
       case BMC_MIDI_PROGRAM_CHANGE:
+      case BMC_MIDI_AFTER_TOUCH:
         return true;
     }
     return false;
@@ -212,7 +213,6 @@ public:
       case BMC_MIDI_NOTE_ON:
       case BMC_MIDI_AFTER_TOUCH_POLY:
       case BMC_MIDI_CONTROL_CHANGE:
-      case BMC_MIDI_AFTER_TOUCH:
       case BMC_MIDI_PITCH_BEND:
       case BMC_MIDI_SONG_POSITION:
         return true;
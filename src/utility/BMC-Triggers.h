@@ -13,6 +13,9 @@
 
 #define BMC_TRIGGERS_FLAG_AVAILABLE 0
 
+// must be a power of 2
+#define BMC_TRIGGERS_BUCKETS 16
+
 class BMCTriggers {
 public:
   BMCTriggers(BMCMidi& t_midi, bmcStoreGlobal& t_global):
@@ -20,21 +23,57 @@ public:
     incoming(midi.message),
     global(t_global)
   {
-
+    memset(bucketStart, 0, sizeof(bucketStart));
   }
   void buildListeners(){
-
     flags.off(BMC_TRIGGERS_FLAG_AVAILABLE);
     totalReadableTriggers = 0;
+    // count the active triggers in each bucket first, then place them
+    // so each bucket holds its trigger indexes in ascending order
+    uint8_t counts[BMC_TRIGGERS_BUCKETS];
+    memset(counts, 0, BMC_TRIGGERS_BUCKETS);
     for(uint8_t i=0;i<BMC_MAX_TRIGGERS;i++){
       bmcStoreGlobalTriggers& trigger = global.triggers[i];
       if(active(trigger.source) != BMC_NONE){
         flags.on(BMC_TRIGGERS_FLAG_AVAILABLE);
         totalReadableTriggers = i+1;
+        counts[getBucket(trigger.source)]++;
+      }
+    }
+    bucketStart[0] = 0;
+    for(uint8_t i=0;i<BMC_TRIGGERS_BUCKETS;i++){
+      bucketStart[i+1] = bucketStart[i] + counts[i];
+      counts[i] = bucketStart[i];
+    }
+    for(uint8_t i=0;i<totalReadableTriggers;i++){
+      bmcStoreGlobalTriggers& trigger = global.triggers[i];
+      if(active(trigger.source) != BMC_NONE){
+        sorted[counts[getBucket(trigger.source)]++] = i;
       }
     }
+    candidateStart = 0;
+    totalCandidates = 0;
     BMC_PRINTLN("BMCTriggers::buildListeners() ",totalReadableTriggers);
   }
+  // builds the incoming event once and finds the bucket of triggers
+  // that share its status, channel and data1, returns the number of
+  // candidates, only those have to be checked with isValidCandidate()
+  uint8_t findCandidates(){
+    incomingEvent = incoming.getEvent();
+    uint8_t bucket = getBucket(incomingEvent);
+    candidateStart = bucketStart[bucket];
+    totalCandidates = bucketStart[bucket+1] - candidateStart;
+    return totalCandidates;
+  }
+  uint8_t getCandidate(uint8_t n){
+    return (n < totalCandidates) ? sorted[candidateStart+n] : BMC_MAX_TRIGGERS;
+  }
+  bool isValidCandidate(uint8_t index){
+    if(index>=BMC_MAX_TRIGGERS){
+      return false;
+    }
+    return match(global.triggers[index].source, incomingEvent);
+  }
   uint8_t available(){
     return totalReadableTriggers;
   }
@@ -43,7 +82,7 @@ public:
       return false;
     }
     bmcStoreGlobalTriggers& trigger = global.triggers[index];
-    return (active(trigger.source) && match(trigger.source));
+    return (active(trigger.source) && match(trigger.source, incoming.getEvent()));
   }
   uint32_t getEvent(uint8_t index){
     if(index>=BMC_MAX_TRIGGERS){
@@ -76,17 +115,31 @@ private:
   bmcStoreGlobal& global;
   BMCFlags <uint8_t> flags;
   uint8_t totalReadableTriggers = 0;
+  // trigger indexes grouped by the hash of their status, channel and data1
+  uint8_t sorted[BMC_MAX_TRIGGERS];
+  uint8_t bucketStart[BMC_TRIGGERS_BUCKETS+1];
+  uint8_t candidateStart = 0;
+  uint8_t totalCandidates = 0;
+  uint32_t incomingEvent = 0;
+
+  // status+channel are in the first byte, data1 in the second, every
+  // 4 bits of the 15 are folded in so consecutive CCs or Notes don't
+  // share a bucket
+  uint8_t getBucket(uint32_t event){
+    uint16_t key = event & 0x7FFF;
+    return (key ^ (key >> 4) ^ (key >> 8) ^ (key >> 12)) & (BMC_TRIGGERS_BUCKETS-1);
+  }
 
   bool active(uint32_t source){
     return BMC_GET_MIDI_STATUS(BMC_GET_BYTE(0,source)) != BMC_NONE;
   }
-  bool match(uint32_t trigger){
+  bool match(uint32_t trigger, uint32_t event){
     if(incoming.getStatus()==BMC_NONE){
       return false;
     }
     uint8_t data2 = (trigger>>15) & 0x7F;
     uint8_t data2Operator = (trigger>>22) & 0x03;
-    if(matchEvent(incoming.getEvent(),trigger)){
+    if(matchEvent(event,trigger)){
       if(incoming.isProgramChange()){
         return true;
       }
@@ -113,8 +166,10 @@ private:
   bool matchStatusAndData1(uint32_t source, uint32_t target){
     return ((source & 0x7FFF) == (target & 0x7FFF));
   }
+  // the port of the trigger is matched against the incoming message so
+  // port presets and USB cable ports can be used
   bool matchPort(uint32_t source, uint32_t target){
-    return BMCTools::matchPort(BMC_GET_BYTE(3,source), BMC_GET_BYTE(3,target));
+    return midi.matchPort(BMC_GET_BYTE(3,target), incoming);
   }
 };
 
@@ -0,0 +1,88 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Fake BLE board for the BLE test, takes a few packets per connection event
+  like a real module and keeps every packet it sent, the test sets the
+  packet size it reports as if a new MTU was negotiated and hands it packets
+  to receive.
+*/
+#ifndef BMC_MIDI_BLE_BOARD_NRF8001_H
+#define BMC_MIDI_BLE_BOARD_NRF8001_H
+
+#include "utility/BMC-Def.h"
+#include <vector>
+
+class BMCnRF8001;
+// set by begin() so the test can reach the board inside each BMCSerialBle
+static BMCnRF8001 * bmcTestBoards[2];
+static uint8_t bmcTestBoardCount = 0;
+
+class BMCnRF8001 {
+public:
+  bool connected = true;
+  // set to make the module refuse every packet
+  bool refuse = false;
+  uint8_t packetSize = 20;
+  // packets taken per connection event
+  uint8_t slots = 4;
+  unsigned long interval = 8;
+  std::vector< std::vector<uint8_t> > sent;
+
+  void begin(){
+    if(bmcTestBoardCount < 2){
+      bmcTestBoards[bmcTestBoardCount++] = this;
+    }
+  }
+  void disconnectBLE(){
+    connected = false;
+  }
+  bool update(){
+    unsigned long now = millis();
+    if((now - lastEvent) >= interval){
+      lastEvent = now;
+      used = 0;
+    }
+    return connected;
+  }
+  int available(){
+    int length = rxPending ? rxLength : 0;
+    rxPending = false;
+    return length;
+  }
+  unsigned const char* getPacket() const {
+    return rx;
+  }
+  uint8_t getPacketLength(){
+    return rxLength;
+  }
+  uint8_t getPacketSize(){
+    return packetSize;
+  }
+  bool setValue(const unsigned char value[], unsigned char length){
+    if(!connected || refuse || used >= slots || length > packetSize){
+      return false;
+    }
+    used++;
+    sent.push_back(std::vector<uint8_t>(value, value + length));
+    return true;
+  }
+  // a packet from the central
+  void receive(const std::vector<uint8_t>& packet){
+    rxLength = 0;
+    for(size_t i = 0 ; i < packet.size() && i < sizeof(rx) ; i++){
+      rx[rxLength++] = packet[i];
+    }
+    rxPending = true;
+  }
+private:
+  unsigned long lastEvent = 0;
+  uint8_t used = 0;
+  uint8_t rx[255];
+  uint8_t rxLength = 0;
+  bool rxPending = false;
+};
+
+#endif
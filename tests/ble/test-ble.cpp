@@ -0,0 +1,263 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCSerialBle sending thru a fake BLE board, every packet sent is fed to a
+  second BMCSerialBle to check that the messages come out whole. Checks the
+  packet size follows the size the board reports, that a full tx queue
+  drops whole messages, that the scheduler learns the connection interval
+  and packets per interval of the board, that clock and active sense only
+  take the room left in the packets and that a long stall doesn't overflow
+  the average latency.
+
+  g++ -std=gnu++14 -I tests/ble -I tests/common -I src tests/ble/test-ble.cpp -o test-ble
+*/
+#include "bmc-test.h"
+#include "utility/BMC-Def.h"
+#include "midi/BMC-SerialBle.h"
+
+BMCGlobals txGlobals;
+BMCGlobals rxGlobals;
+BMCSerialBle tx(txGlobals);
+BMCSerialBle rx(rxGlobals);
+std::vector<uint8_t> written;
+std::vector<uint8_t> received;
+
+void write(uint8_t value){
+  if(tx.write(value) == 1){
+    written.push_back(value);
+  }
+}
+void writeControl(uint8_t control, uint8_t value){
+  write(0xB0);
+  write(control & 0x7F);
+  write(value & 0x7F);
+}
+// runs the sender until everything queued was sent
+void drain(){
+  for(uint16_t i = 0 ; i < 500 ; i++){
+    bmcTestAdvanceMs(1);
+    tx.update();
+  }
+  CHECK_EQ(tx.getTxQueued(), 0);
+}
+// every packet sent goes thru the receiver, the bytes it parsed are kept
+void receive(BMCnRF8001& board){
+  for(size_t i = 0 ; i < board.sent.size() ; i++){
+    bmcTestBoards[1]->receive(board.sent[i]);
+    while(rx.available() > 0){
+      received.push_back(rx.read());
+    }
+  }
+  board.sent.clear();
+}
+size_t largestPacket(BMCnRF8001& board){
+  size_t value = 0;
+  for(size_t i = 0 ; i < board.sent.size() ; i++){
+    value = board.sent[i].size() > value ? board.sent[i].size() : value;
+  }
+  return value;
+}
+
+// the status of each message in a packet, running status messages get the
+// status they are running on, only channel and real time messages are used
+std::vector<uint8_t> messagesIn(const std::vector<uint8_t>& packet){
+  std::vector<uint8_t> messages;
+  uint8_t running = 0;
+  size_t i = 1;
+  while(i < packet.size()){
+    if(bitRead(packet[i], 7)){
+      // timestamp then status
+      uint8_t status = packet[i+1];
+      messages.push_back(status);
+      if(status < 0xF0){
+        running = status;
+        i += 2 + 2;
+      } else {
+        i += 2;
+      }
+    } else {
+      messages.push_back(running);
+      i += 2;
+    }
+  }
+  return messages;
+}
+bool isRealTime(uint8_t status){
+  return status == BMC_MIDI_RT_CLOCK || status == BMC_MIDI_RT_ACTIVE_SENSE;
+}
+
+void testPacketSize(BMCnRF8001& board){
+  written.clear();
+  received.clear();
+  for(uint8_t i = 0 ; i < 40 ; i++){
+    writeControl(i, i);
+  }
+  drain();
+  CHECK_EQ(tx.getPacketSize(), 20);
+  CHECK(largestPacket(board) <= 20);
+  CHECK(board.sent.size() > 1);
+  // the central negotiated a larger MTU
+  board.packetSize = 100;
+  for(uint8_t i = 0 ; i < 80 ; i++){
+    writeControl(i, 127-i);
+  }
+  drain();
+  CHECK_EQ(tx.getPacketSize(), 100);
+  CHECK(largestPacket(board) > 20);
+  CHECK(largestPacket(board) <= 100);
+  // a packet with more messages than the 20 the receiver used to parse
+  receive(board);
+  CHECK(received == written);
+}
+
+void testFullQueue(BMCnRF8001& board){
+  written.clear();
+  received.clear();
+  // nothing is sent while writing so the queue fills up
+  for(uint16_t i = 0 ; i < 200 ; i++){
+    writeControl(i, i);
+  }
+  uint16_t queued = BMC_BLE_TX_QUEUE_SIZE - (BMC_BLE_TX_QUEUE_SIZE % 3);
+  CHECK_EQ(tx.getTxQueued(), queued);
+  CHECK_EQ(tx.getTxStats().messagesDropped, 200 - (queued / 3));
+  drain();
+  receive(board);
+  CHECK(received == written);
+  // a sysex larger than the queue is cut off, the 0xF7 isn't queued alone
+  written.clear();
+  received.clear();
+  write(0xF0);
+  for(uint16_t i = 0 ; i < BMC_BLE_TX_QUEUE_SIZE ; i++){
+    write(i & 0x7F);
+  }
+  tx.write(0xF7);
+  CHECK_EQ(tx.getTxQueued(), BMC_BLE_TX_QUEUE_SIZE);
+  drain();
+  writeControl(7, 100);
+  drain();
+  receive(board);
+  CHECK_EQ(received.size(), BMC_BLE_TX_QUEUE_SIZE + 3);
+  CHECK_EQ(received[received.size()-3], 0xB0);
+  CHECK_EQ(received.back(), 100);
+  for(size_t i = 0 ; i < received.size() ; i++){
+    CHECK(received[i] != 0xF7);
+  }
+}
+
+// the board takes board.slots packets every board.interval ms
+void testScheduler(BMCnRF8001& board){
+  for(uint8_t i = 0 ; i < 160 ; i++){
+    writeControl(i, i);
+  }
+  drain();
+  CHECK_EQ(tx.getTxStats().interval, 8);
+  CHECK_EQ(tx.getTxStats().packetsPerInterval, 4);
+  // the central moved to a longer interval with less packets
+  board.interval = 15;
+  board.slots = 2;
+  for(uint8_t n = 0 ; n < 3 ; n++){
+    for(uint8_t i = 0 ; i < 160 ; i++){
+      writeControl(i, i);
+    }
+    drain();
+  }
+  CHECK_EQ(tx.getTxStats().interval, 15);
+  CHECK_EQ(tx.getTxStats().packetsPerInterval, 2);
+  // stats that are learned survive a reset
+  tx.resetTxStats();
+  CHECK_EQ(tx.getTxStats().interval, 15);
+  board.interval = 8;
+  board.slots = 4;
+  board.sent.clear();
+}
+
+void testRealTime(BMCnRF8001& board){
+  board.sent.clear();
+  // a clock every 6 messages, all waiting when the first packet is built
+  for(uint8_t i = 0 ; i < 60 ; i++){
+    writeControl(i, i);
+    if((i % 6) == 0){
+      tx.write(BMC_MIDI_RT_CLOCK);
+    }
+  }
+  tx.write(BMC_MIDI_RT_ACTIVE_SENSE);
+  drain();
+  size_t lastControl = 0;
+  for(size_t i = 0 ; i < board.sent.size() ; i++){
+    std::vector<uint8_t> messages = messagesIn(board.sent[i]);
+    for(size_t j = 0 ; j < messages.size() ; j++){
+      if(!isRealTime(messages[j])){
+        lastControl = i;
+      }
+    }
+  }
+  uint16_t controls = 0;
+  uint16_t clocks = 0;
+  uint16_t activeSense = 0;
+  for(size_t i = 0 ; i < board.sent.size() ; i++){
+    std::vector<uint8_t> messages = messagesIn(board.sent[i]);
+    uint8_t realTime = 0;
+    for(size_t j = 0 ; j < messages.size() ; j++){
+      if(isRealTime(messages[j])){
+        realTime++;
+        clocks += (messages[j] == BMC_MIDI_RT_CLOCK) ? 1 : 0;
+        activeSense += (messages[j] == BMC_MIDI_RT_ACTIVE_SENSE) ? 1 : 0;
+      } else {
+        // real time messages go at the end of the packet
+        CHECK_EQ(realTime, 0);
+        controls++;
+      }
+    }
+    if(i < lastControl){
+      // while messages are waiting a real time message only takes the
+      // room kept at the end of the packet, it's not starved either
+      CHECK_EQ(realTime, 1);
+      CHECK(board.sent[i].size() >= (size_t) (board.packetSize - 1));
+    }
+  }
+  CHECK_EQ(controls, 60);
+  CHECK_EQ(clocks, 10);
+  CHECK_EQ(activeSense, 1);
+  CHECK(lastControl > 2);
+  board.sent.clear();
+}
+
+void testLatency(BMCnRF8001& board){
+  tx.resetTxStats();
+  board.refuse = true;
+  for(uint8_t i = 0 ; i < 80 ; i++){
+    writeControl(i, i);
+  }
+  // 20 seconds without a connection event
+  for(uint16_t i = 0 ; i < 2000 ; i++){
+    bmcTestAdvanceMs(10);
+    tx.update();
+  }
+  board.refuse = false;
+  drain();
+  bmcBleTxStats& stats = tx.getTxStats();
+  CHECK(stats.packets >= 8);
+  CHECK(stats.latencyMax >= 20000);
+  CHECK(stats.latencyAvg > 0xFFFF);
+  CHECK(stats.latencyAvg <= (uint32_t) stats.latencyMax * 8);
+  board.sent.clear();
+}
+
+int main(){
+  tx.begin(0);
+  rx.begin(0);
+  CHECK_EQ(bmcTestBoardCount, 2);
+  BMCnRF8001& board = *bmcTestBoards[0];
+  tx.update();
+  CHECK(txGlobals.bleConnected());
+  testPacketSize(board);
+  board.packetSize = 20;
+  testFullQueue(board);
+  testScheduler(board);
+  testRealTime(board);
+  testLatency(board);
+  return BMC_TEST_RESULT();
+}
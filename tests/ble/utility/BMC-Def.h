@@ -0,0 +1,78 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the BLE test, only the parts of BMC
+  that BMCSerialBle uses, the board is the fake one in
+  midi/BMC-MidiBleBoardnRF8001.h next to this folder.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+#include "utility/BMC-Flags.h"
+
+#define BMC_MIDI_BLE_ENABLED
+#define BMC_MIDI_BLE_BOARD 0
+
+#define BMC_PRINTLN(...)
+#define BMC_PRINT_ARRAY(...)
+
+#define BMC_MIDI_NOTE_OFF 0x80
+#define BMC_MIDI_NOTE_ON 0x90
+#define BMC_MIDI_AFTER_TOUCH_POLY 0xA0
+#define BMC_MIDI_CONTROL_CHANGE 0xB0
+#define BMC_MIDI_PROGRAM_CHANGE 0xC0
+#define BMC_MIDI_AFTER_TOUCH 0xD0
+#define BMC_MIDI_PITCH_BEND 0xE0
+#define BMC_MIDI_SYSTEM_EXCLUSIVE 0xF0
+#define BMC_MIDI_TIME_CODE_QUARTER_FRAME 0xF1
+#define BMC_MIDI_SONG_POSITION 0xF2
+#define BMC_MIDI_SONG_SELECT 0xF3
+#define BMC_MIDI_RT_CLOCK 0xF8
+#define BMC_MIDI_RT_ACTIVE_SENSE 0xFE
+
+class BMCGlobals {
+public:
+  bool bleConnected(){ return connected; }
+  void setBleConnected(bool value){ connected = value; }
+  bool getBleDebug(){ return false; }
+private:
+  bool connected = false;
+};
+
+class BMCTools {
+public:
+  static uint8_t getStatus(uint8_t value){
+    return (value < 0xF0) ? (value & 0xF0) : value;
+  }
+  static bool isTwoByteMidiMessage(uint8_t value){
+    switch(getStatus(value)){
+      case BMC_MIDI_TIME_CODE_QUARTER_FRAME:
+      case BMC_MIDI_SONG_SELECT:
+      case BMC_MIDI_PROGRAM_CHANGE:
+      case BMC_MIDI_AFTER_TOUCH:
+        return true;
+    }
+    return false;
+  }
+  static bool isThreeByteMidiMessage(uint8_t value){
+    switch(getStatus(value)){
+      case BMC_MIDI_NOTE_OFF:
+      case BMC_MIDI_NOTE_ON:
+      case BMC_MIDI_AFTER_TOUCH_POLY:
+      case BMC_MIDI_CONTROL_CHANGE:
+      case BMC_MIDI_PITCH_BEND:
+      case BMC_MIDI_SONG_POSITION:
+        return true;
+    }
+    return false;
+  }
+  static bool isRunningStatusMidiMessage(uint8_t value){
+    return value >= 0x80 && value <= 0xEF;
+  }
+};
+
+#endif
@@ -0,0 +1,39 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  The parts of the Arduino core used by the classes under test, the clock
+  only moves when the test moves it.
+*/
+#ifndef BMC_TEST_ARDUINO_H
+#define BMC_TEST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// the test moves the clock, starts at 1 second so a time of 0 is never "now"
+static unsigned long bmcTestMicros = 1000000UL;
+static inline unsigned long micros(){ return bmcTestMicros; }
+static inline unsigned long millis(){ return bmcTestMicros / 1000UL; }
+static inline void bmcTestAdvanceUs(unsigned long us){ bmcTestMicros += us; }
+static inline void bmcTestAdvanceMs(unsigned long ms){ bmcTestMicros += ms * 1000UL; }
+static inline void delay(unsigned long ms){ bmcTestAdvanceMs(ms); }
+
+typedef uint8_t byte;
+
+#define bit(b) (1UL << (b))
+#define bitRead(v, b) (((v) >> (b)) & 0x01)
+#define bitSet(v, b) ((v) |= (1UL << (b)))
+#define bitClear(v, b) ((v) &= ~(1UL << (b)))
+#define bitWrite(v, b, x) ((x) ? bitSet(v, b) : bitClear(v, b))
+#define constrain(a, l, h) ((a) < (l) ? (l) : ((a) > (h) ? (h) : (a)))
+static inline long map(long x, long inMin, long inMax, long outMin, long outMax){
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+#endif
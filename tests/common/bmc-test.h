@@ -0,0 +1,33 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Shared by the host tests, CHECK macros and the result main() returns,
+  see Arduino.h for the parts of the Arduino core the tests fake.
+*/
+#ifndef BMC_TEST_H
+#define BMC_TEST_H
+
+#include "Arduino.h"
+
+static int bmcTestFailures = 0;
+#define CHECK(cond) do { \
+  if(!(cond)){ \
+    printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+    bmcTestFailures++; \
+  } \
+} while(0)
+#define CHECK_EQ(a, b) do { \
+  long long _a = (long long) (a); \
+  long long _b = (long long) (b); \
+  if(_a != _b){ \
+    printf("%s:%d: CHECK_EQ failed: %s = %lld, %s = %lld\n", __FILE__, __LINE__, #a, _a, #b, _b); \
+    bmcTestFailures++; \
+  } \
+} while(0)
+// returned by main()
+#define BMC_TEST_RESULT() (printf("%s: %s\n", __FILE__, bmcTestFailures ? "FAILED" : "OK"), bmcTestFailures ? 1 : 0)
+
+#endif
@@ -0,0 +1,52 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/midi/BMC-Midi.h for the FAS test, keeps every SysEx sent
+  until the simulated Axe-Fx in test-fas.cpp takes it.
+*/
+#ifndef BMC_MIDI_H
+#define BMC_MIDI_H
+
+#include <vector>
+
+struct BMCCallbacks {
+  void (*fasConnection)(bool) = 0;
+  void (*fasPresetChange)(uint16_t) = 0;
+  void (*fasPresetName)(char *) = 0;
+  void (*fasSceneChange)(uint8_t) = 0;
+  void (*fasBlocksChange)() = 0;
+  void (*fasParameterChange)(uint8_t, uint8_t, uint16_t) = 0;
+  void (*fasBlockParameterReceived)(uint8_t, uint8_t, uint16_t, char *, uint8_t) = 0;
+  void (*fasCpuReceived)(uint8_t) = 0;
+  void (*fasTunerStateChange)(bool) = 0;
+  void (*fasTunerReceived)(BMCTunerData&) = 0;
+  void (*fasLooperStateChange)(bool) = 0;
+  void (*fasLooperReceived)(uint8_t, uint8_t) = 0;
+  void (*fasSyncComplete)(uint16_t) = 0;
+};
+
+class BMCMidi {
+public:
+  BMCCallbacks callback;
+  std::vector<BMCMidiMessage> sent;
+  // BMCFas sends SysEx without 0xF0 and 0xF7, they are added the way the
+  // MIDI library does so it looks like it does on the wire
+  void sendSysEx(uint8_t port, uint8_t * data, uint16_t size, bool, uint8_t, bool){
+    BMCMidiMessage m;
+    m.setStatus(BMC_MIDI_SYSTEM_EXCLUSIVE);
+    m.setPort(port);
+    m.appendSysExByte(0xF0);
+    for(uint16_t i = 0 ; i < size ; i++){
+      m.appendSysExByte(data[i]);
+    }
+    m.appendSysExByte(0xF7);
+    sent.push_back(m);
+  }
+  void sendControlChange(uint8_t, uint8_t, uint8_t, uint8_t){}
+  void sendProgramChange(uint8_t, uint8_t, uint8_t){}
+};
+
+#endif
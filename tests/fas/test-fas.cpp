@@ -0,0 +1,423 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCFas connected to a simulated Axe-Fx II that replies to each request
+  after a delay, checks that the resync never has more than
+  BMC_FAS_SYNC_MAX_IN_FLIGHT requests waiting for a reply, that replies
+  arriving in a different order than the requests are matched to them and
+  that a request without a reply is sent again once it times out.
+
+  g++ -std=gnu++14 -I tests/fas -I tests/common -I src tests/fas/test-fas.cpp -o test-fas
+*/
+#include "bmc-test.h"
+// one less than the preset number, blocks and scene requests so every
+// resync reaches the limit
+#define BMC_FAS_SYNC_MAX_IN_FLIGHT 2
+#include "sync/fas/BMC-Fas.h"
+#include "sync/fas/BMC-Fas.cpp"
+#include <vector>
+
+#define AXE_FX_II 0x03
+#define SERIAL_A 0x02
+
+#define BLOCK_AMP 106
+#define BLOCK_DELAY 112
+#define BLOCK_REVERB 110
+
+BMCMidi midi;
+BMCGlobals globals;
+BMCFas fas(midi, globals);
+
+// the requests of a resync
+bool isSyncRequest(uint8_t funcId){
+  switch(funcId){
+    case BMC_FAS_FUNC_ID_GET_PRESET_NUMBER:
+    case BMC_FAS_FUNC_ID_PRESET_NAME:
+    case BMC_FAS_FUNC_ID_BLOCKS_DATA:
+    case BMC_FAS_FUNC_ID_SCENE_NUMBER:
+    case BMC_FAS_FUNC_ID_BLOCK_PARAM:
+      return true;
+  }
+  return false;
+}
+
+class FakeAxeFx {
+public:
+  struct Request {
+    uint8_t funcId;
+    unsigned long sentAt;
+  };
+  struct Reply {
+    BMCMidiMessage message;
+    uint8_t funcId;
+    unsigned long dueAt;
+  };
+  uint16_t preset = 12;
+  uint8_t scene = 2;
+  const char * name = "CLEAN";
+  // the milliseconds it takes to reply to each function id
+  unsigned long latency[128];
+  // the next @drop requests of function @dropFuncId get no reply
+  uint8_t dropFuncId = 0;
+  uint8_t drop = 0;
+  // every request received, in order
+  std::vector<Request> received;
+  // sync requests not replied to yet
+  std::vector<Request> waiting;
+  std::vector<Reply> replies;
+  uint8_t maxInFlight = 0;
+  uint8_t badCrc = 0;
+
+  FakeAxeFx(){
+    setLatency(10);
+  }
+  void setLatency(unsigned long ms){
+    for(uint8_t i = 0 ; i < 128 ; i++){
+      latency[i] = ms;
+    }
+  }
+  // requests BMCFas is still waiting for, a request it gave up on after
+  // BMC_FAS_RESYNC_TIMEOUT is forgotten so a late reply isn't taken for it
+  uint8_t inFlight(){
+    for(size_t i = 0 ; i < waiting.size() ; ){
+      if(millis() - waiting[i].sentAt >= BMC_FAS_RESYNC_TIMEOUT){
+        waiting.erase(waiting.begin() + i);
+      } else {
+        i++;
+      }
+    }
+    return waiting.size();
+  }
+  // the number of requests of @funcId received
+  size_t count(uint8_t funcId){
+    size_t n = 0;
+    for(size_t i = 0 ; i < received.size() ; i++){
+      if(received[i].funcId == funcId){
+        n++;
+      }
+    }
+    return n;
+  }
+  // the position of the first request of @funcId, -1 if there's none
+  long first(uint8_t funcId){
+    for(size_t i = 0 ; i < received.size() ; i++){
+      if(received[i].funcId == funcId){
+        return i;
+      }
+    }
+    return -1;
+  }
+  unsigned long firstAt(uint8_t funcId){
+    long i = first(funcId);
+    return (i < 0) ? 0 : received[i].sentAt;
+  }
+  void clear(){
+    received.clear();
+    maxInFlight = 0;
+  }
+  // takes the requests BMCFas sent
+  void take(){
+    for(size_t i = 0 ; i < midi.sent.size() ; i++){
+      request(midi.sent[i]);
+    }
+    midi.sent.clear();
+    if(inFlight() > maxInFlight){
+      maxInFlight = inFlight();
+    }
+  }
+  // passes BMCFas the replies that are due
+  void deliver(){
+    for(size_t i = 0 ; i < replies.size() ; ){
+      if(replies[i].dueAt > millis()){
+        i++;
+        continue;
+      }
+      Reply reply = replies[i];
+      replies.erase(replies.begin() + i);
+      for(size_t w = 0 ; w < waiting.size() ; w++){
+        if(waiting[w].funcId == reply.funcId){
+          waiting.erase(waiting.begin() + w);
+          break;
+        }
+      }
+      fas.incoming(reply.message);
+    }
+  }
+private:
+  void request(BMCMidiMessage& m){
+    uint8_t * s = m.getSysEx();
+    // device search, any message from the device is a reply
+    if(s[4] == 0x7F){
+      uint8_t beat[] = {0xF0, 0x00, 0x01, 0x74, AXE_FX_II, BMC_FAS_FUNC_ID_MIDI_TEMPO_BEAT, 0xF7};
+      BMCMidiMessage reply;
+      reply.addSysEx(beat, sizeof(beat));
+      reply.setPort(SERIAL_A);
+      fas.incoming(reply);
+      return;
+    }
+    uint8_t funcId = s[5];
+    if(!m.validateChecksum()){
+      badCrc++;
+    }
+    Request r = {funcId, millis()};
+    received.push_back(r);
+    if(!isSyncRequest(funcId)){
+      reply(funcId, m);
+      return;
+    }
+    waiting.push_back(r);
+    if(drop > 0 && funcId == dropFuncId){
+      drop--;
+      return;
+    }
+    reply(funcId, m);
+  }
+  void reply(uint8_t funcId, BMCMidiMessage& m){
+    Reply r;
+    r.funcId = funcId;
+    r.dueAt = millis() + latency[funcId];
+    BMCMidiMessage& reply = r.message;
+    reply.setStatus(BMC_MIDI_SYSTEM_EXCLUSIVE);
+    reply.setPort(SERIAL_A);
+    reply.appendSysExByte(0xF0);
+    reply.appendSysExByte(0x00);
+    reply.appendSysExByte(0x01);
+    reply.appendSysExByte(0x74);
+    reply.appendSysExByte(AXE_FX_II);
+    reply.appendSysExByte(funcId);
+    switch(funcId){
+      case BMC_FAS_FUNC_ID_FIRMWARE:
+        reply.appendSysExByte(10);
+        reply.appendSysExByte(4);
+        break;
+      case BMC_FAS_FUNC_ID_GET_MIDI_CHANNEL:
+      case BMC_FAS_FUNC_ID_CPU:
+        reply.appendSysExByte(0);
+        break;
+      case BMC_FAS_FUNC_ID_GET_PRESET_NUMBER:
+        reply.appendSysExByte(preset >> 7);
+        reply.appendSysExByte(preset);
+        break;
+      case BMC_FAS_FUNC_ID_PRESET_NAME:
+        for(uint8_t i = 0, len = strlen(name) ; i < 32 ; i++){
+          reply.appendSysExByte(i < len ? name[i] : ' ');
+        }
+        break;
+      case BMC_FAS_FUNC_ID_SCENE_NUMBER:
+        reply.appendSysExByte(scene);
+        break;
+      case BMC_FAS_FUNC_ID_BLOCKS_DATA:
+        appendBlock(reply, BLOCK_AMP, true);
+        appendBlock(reply, BLOCK_REVERB, true);
+        appendBlock(reply, BLOCK_DELAY, false);
+        break;
+      case BMC_FAS_FUNC_ID_BLOCK_PARAM:{
+        // the block and parameter of the request, each one has a
+        // different value
+        uint8_t block = m.get8BitsLSBFirst(6);
+        uint8_t param = m.get8BitsLSBFirst(8);
+        reply.appendToSysEx14BitsLSBFirst(block);
+        reply.appendToSysEx14BitsLSBFirst(param);
+        reply.appendToSysEx16BitsLSBFirst(paramValue(block, param));
+        break;
+      }
+      default:
+        return;
+    }
+    uint8_t crc = 0;
+    for(uint16_t i = 0 ; i < reply.size() ; i++){
+      crc ^= (reply.sysex[i] & 0x7F);
+    }
+    reply.appendSysExByte(crc);
+    reply.appendSysExByte(0xF7);
+    replies.push_back(r);
+  }
+  void appendBlock(BMCMidiMessage& reply, uint8_t id, bool engaged){
+    uint32_t value = ((uint32_t) id << 24) | 0x02 | (engaged ? 0x01 : 0x00);
+    for(uint8_t i = 0 ; i < 5 ; i++){
+      reply.appendSysExByte((value >> (i*7)) & 0x7F);
+    }
+  }
+public:
+  static uint16_t paramValue(uint8_t block, uint8_t param){
+    return (block * 100) + param;
+  }
+};
+
+FakeAxeFx axeFx;
+uint16_t syncCompleted = 0;
+
+void onSyncComplete(uint16_t latency){
+  syncCompleted++;
+}
+void run(unsigned long ms){
+  for(unsigned long i = 0 ; i < ms ; i++){
+    bmcTestAdvanceMs(1);
+    axeFx.deliver();
+    fas.update();
+    axeFx.take();
+  }
+}
+
+void testConnect(){
+  fas.begin();
+  run(1500);
+  CHECK(fas.connected());
+  CHECK_EQ(axeFx.badCrc, 0);
+  // the resync of the connection
+  run(2000);
+  CHECK_EQ(fas.getSyncCount(), 1);
+  CHECK_EQ(syncCompleted, 1);
+  CHECK_EQ(fas.getSyncRetries(), 0);
+  CHECK_EQ(fas.getPresetNumber(), 12);
+  CHECK_EQ(fas.getSceneNumber(), 2);
+  char name[32] = "";
+  fas.getPresetName(name);
+  CHECK(strncmp(name, "CLEAN", 5) == 0);
+  CHECK(fas.isBlockEngaged(BLOCK_AMP));
+  CHECK(fas.isBlockBypassed(BLOCK_DELAY));
+  CHECK_EQ(fas.getSyncedParameterValue(0), FakeAxeFx::paramValue(BLOCK_AMP, 1));
+  CHECK_EQ(fas.getSyncedParameterValue(1), FakeAxeFx::paramValue(BLOCK_DELAY, 4));
+  CHECK_EQ(fas.getSyncedParameterValue(2), FakeAxeFx::paramValue(BLOCK_REVERB, 2));
+  CHECK(axeFx.maxInFlight <= BMC_FAS_SYNC_MAX_IN_FLIGHT);
+}
+
+// a RESYNC from the device, 250ms later its requests are sent
+void resync(){
+  uint8_t data[] = {0xF0, 0x00, 0x01, 0x74, AXE_FX_II, BMC_FAS_FUNC_ID_RESYNC, 0x00, 0xF7};
+  uint8_t crc = 0;
+  for(uint8_t i = 0 ; i < 6 ; i++){
+    crc ^= (data[i] & 0x7F);
+  }
+  data[6] = crc;
+  BMCMidiMessage message;
+  message.addSysEx(data, sizeof(data));
+  message.setPort(SERIAL_A);
+  axeFx.clear();
+  fas.incoming(message);
+}
+
+void testPipelined(){
+  axeFx.setLatency(30);
+  axeFx.preset = 40;
+  axeFx.scene = 5;
+  axeFx.name = "LEAD";
+  uint16_t count = fas.getSyncCount();
+  resync();
+  unsigned long start = millis();
+  run(1000);
+  CHECK_EQ(fas.getSyncCount(), count + 1);
+  // preset number and blocks go out at once, not one per reply, the scene
+  // waits for room
+  unsigned long sentAt = axeFx.firstAt(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER);
+  CHECK_EQ(axeFx.maxInFlight, BMC_FAS_SYNC_MAX_IN_FLIGHT);
+  CHECK(sentAt >= start + 250);
+  CHECK_EQ(axeFx.firstAt(BMC_FAS_FUNC_ID_BLOCKS_DATA), sentAt);
+  CHECK_EQ(axeFx.firstAt(BMC_FAS_FUNC_ID_SCENE_NUMBER), sentAt + 30);
+  // the name waits for the preset number, each request is sent once
+  CHECK_EQ(axeFx.firstAt(BMC_FAS_FUNC_ID_PRESET_NAME), sentAt + 30);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER), 1);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_PRESET_NAME), 1);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_BLOCK_PARAM), 3);
+  CHECK_EQ(fas.getPresetNumber(), 40);
+  CHECK_EQ(fas.getSceneNumber(), 5);
+  char name[32] = "";
+  fas.getPresetName(name);
+  CHECK(strncmp(name, "LEAD", 4) == 0);
+  CHECK_EQ(fas.getSyncedParameterValue(1), FakeAxeFx::paramValue(BLOCK_DELAY, 4));
+  // preset number with blocks, scene with name, then the 3 parameters one
+  // after the other, not 7 round trips
+  CHECK(fas.getSyncLatency() <= (30 * 5) + 2);
+  CHECK_EQ(fas.getSyncRetries(), 0);
+  CHECK_EQ(axeFx.badCrc, 0);
+}
+
+void testReplyOrder(){
+  // the preset number is answered last, the scene first
+  axeFx.setLatency(5);
+  axeFx.latency[BMC_FAS_FUNC_ID_GET_PRESET_NUMBER] = 60;
+  axeFx.latency[BMC_FAS_FUNC_ID_BLOCKS_DATA] = 40;
+  axeFx.preset = 41;
+  axeFx.scene = 0;
+  axeFx.name = "CRUNCH";
+  uint16_t count = fas.getSyncCount();
+  resync();
+  run(1000);
+  CHECK_EQ(fas.getSyncCount(), count + 1);
+  CHECK_EQ(fas.getPresetNumber(), 41);
+  CHECK_EQ(fas.getSceneNumber(), 0);
+  char name[32] = "";
+  fas.getPresetName(name);
+  CHECK(strncmp(name, "CRUNCH", 6) == 0);
+  // parameters are only requested once the preset, blocks and scene are
+  // known and their values survive the new preset
+  long param = axeFx.first(BMC_FAS_FUNC_ID_BLOCK_PARAM);
+  CHECK(param > axeFx.first(BMC_FAS_FUNC_ID_PRESET_NAME));
+  CHECK(axeFx.firstAt(BMC_FAS_FUNC_ID_BLOCK_PARAM) >= axeFx.firstAt(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER) + 60);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_BLOCK_PARAM), 3);
+  CHECK_EQ(fas.getSyncedParameterValue(0), FakeAxeFx::paramValue(BLOCK_AMP, 1));
+  CHECK_EQ(fas.getSyncedParameterValue(2), FakeAxeFx::paramValue(BLOCK_REVERB, 2));
+  CHECK_EQ(fas.getSyncRetries(), 0);
+  // same preset, the name isn't requested again, the parameters are since
+  // a RESYNC from the device clears them
+  axeFx.setLatency(10);
+  resync();
+  run(1000);
+  CHECK_EQ(fas.getSyncCount(), count + 2);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER), 1);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_PRESET_NAME), 0);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_BLOCK_PARAM), 3);
+  CHECK(axeFx.maxInFlight <= BMC_FAS_SYNC_MAX_IN_FLIGHT);
+}
+
+void testRetry(){
+  axeFx.setLatency(10);
+  axeFx.preset = 50;
+  axeFx.dropFuncId = BMC_FAS_FUNC_ID_GET_PRESET_NUMBER;
+  axeFx.drop = 1;
+  uint16_t count = fas.getSyncCount();
+  uint16_t retries = fas.getSyncRetries();
+  resync();
+  run(200 + 250);
+  // the blocks and scene were answered, the preset number is still
+  // waiting for its reply and the name and parameters wait for it
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER), 1);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_PRESET_NAME), 0);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_BLOCK_PARAM), 0);
+  CHECK_EQ(fas.getSyncCount(), count);
+  run(1000);
+  // sent again once BMC_FAS_RESYNC_TIMEOUT is over
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER), 2);
+  unsigned long firstAt = axeFx.firstAt(BMC_FAS_FUNC_ID_GET_PRESET_NUMBER);
+  unsigned long retryAt = 0;
+  for(size_t i = 0 ; i < axeFx.received.size() ; i++){
+    if(axeFx.received[i].funcId == BMC_FAS_FUNC_ID_GET_PRESET_NUMBER){
+      retryAt = axeFx.received[i].sentAt;
+    }
+  }
+  CHECK(retryAt - firstAt >= BMC_FAS_RESYNC_TIMEOUT);
+  CHECK(retryAt - firstAt < BMC_FAS_RESYNC_TIMEOUT + 5);
+  CHECK_EQ(fas.getSyncRetries(), retries + 1);
+  CHECK_EQ(fas.getSyncCount(), count + 1);
+  CHECK_EQ(fas.getPresetNumber(), 50);
+  CHECK(fas.getSyncLatency() >= BMC_FAS_RESYNC_TIMEOUT);
+  CHECK(axeFx.maxInFlight <= BMC_FAS_SYNC_MAX_IN_FLIGHT);
+  // the retry replaced the request, nothing else was sent in it's place
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_BLOCKS_DATA), 1);
+  CHECK_EQ(axeFx.count(BMC_FAS_FUNC_ID_SCENE_NUMBER), 1);
+}
+
+int main(){
+  midi.callback.fasSyncComplete = onSyncComplete;
+  fas.setSyncedParameter(0, BLOCK_AMP, 1);
+  fas.setSyncedParameter(1, BLOCK_DELAY, 4);
+  fas.setSyncedParameter(2, BLOCK_REVERB, 2);
+  testConnect();
+  testPipelined();
+  testReplyOrder();
+  testRetry();
+  return BMC_TEST_RESULT();
+}
@@ -0,0 +1,173 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the FAS test, only the parts of BMC
+  that BMCFas uses, BMCMidi is the fake one in midi/BMC-Midi.h next to this
+  folder.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+#include "utility/BMC-Flags.h"
+#include "utility/BMC-Timer.h"
+
+#define BMC_SCROLL_DOWN 0
+#define BMC_SCROLL_UP 1
+
+#include "utility/BMC-Scroller.h"
+
+#define BMC_USE_FAS
+
+#define BMC_INFO(...)
+#define BMC_WARN(...)
+#define BMC_PRINTLN(...)
+
+#define B00111110 0x3E
+#define BMC_MIDI_SYSTEM_EXCLUSIVE 0xF0
+
+#define BMC_FAS_LOOPER_STATE_RECORDING 0
+#define BMC_FAS_LOOPER_STATE_PLAYING 1
+#define BMC_FAS_LOOPER_STATE_ONCE 2
+#define BMC_FAS_LOOPER_STATE_OVERDUBBING 3
+#define BMC_FAS_LOOPER_STATE_REVERSED 4
+#define BMC_FAS_LOOPER_STATE_HALF 5
+#define BMC_FAS_LOOPER_STATE_UNDO 6
+
+#define BMC_FAS_LOOPER_CONTROL_STOP 0
+#define BMC_FAS_LOOPER_CONTROL_RECORD 1
+#define BMC_FAS_LOOPER_CONTROL_PLAY 2
+#define BMC_FAS_LOOPER_CONTROL_ONCE 3
+#define BMC_FAS_LOOPER_CONTROL_OVERDUB 4
+#define BMC_FAS_LOOPER_CONTROL_REVERSE 5
+#define BMC_FAS_LOOPER_CONTROL_HALF 6
+#define BMC_FAS_LOOPER_CONTROL_UNDO 7
+#define BMC_FAS_LOOPER_CONTROL_REC_PLAY_DUB 8
+#define BMC_FAS_LOOPER_CONTROL_REC_DUB_PLAY 9
+#define BMC_FAS_LOOPER_CONTROL_CLEAR 10
+#define BMC_FAS_LOOPER_CONTROL_PLAY_STOP 11
+
+// same layout as src/utility/BMC-MidiMessage.h, a SysEx that is sent has
+// no 0xF0 and 0xF7, one that was received has both
+class BMCMidiMessage {
+public:
+  uint8_t sysex[128];
+  void setStatus(uint8_t t_status){ status = t_status; }
+  void setPort(uint8_t t_port){ port = t_port; }
+  uint8_t getPort(){ return port; }
+  bool isSysEx(){ return status == BMC_MIDI_SYSTEM_EXCLUSIVE; }
+  uint8_t * getSysEx(){ return sysex; }
+  uint16_t size(){ return length; }
+  void addSysEx(const uint8_t * data, uint16_t t_length){
+    setStatus(BMC_MIDI_SYSTEM_EXCLUSIVE);
+    memcpy(sysex, data, t_length);
+    length = t_length;
+  }
+  bool appendSysExByte(uint8_t value){
+    if(value != 0xF0 && value != 0xF7){
+      value &= 0x7F;
+    }
+    if(length >= sizeof(sysex)){
+      return false;
+    }
+    sysex[length++] = value;
+    return true;
+  }
+  void appendToSysEx7Bits(uint8_t value){
+    appendSysExByte(value & 0x7F);
+  }
+  void appendToSysEx14BitsLSBFirst(uint16_t value){
+    appendToSysEx7Bits(value);
+    appendToSysEx7Bits(value >> 7);
+  }
+  void appendToSysEx16BitsLSBFirst(uint16_t value){
+    appendToSysEx7Bits(value);
+    appendToSysEx7Bits(value >> 7);
+    appendToSysEx7Bits(value >> 14);
+  }
+  bool validateChecksum(){
+    if(!isSysEx() || length < 2){
+      return false;
+    }
+    uint8_t crc = 0;
+    for(uint16_t i = 0 ; i < length-2 ; i++){
+      crc ^= (sysex[i] & 0x7F);
+    }
+    return sysex[length-2] == crc;
+  }
+  void createCrc(bool addCrcByte){
+    if(!isSysEx() || length == 0){
+      return;
+    }
+    if(addCrcByte && sysex[length-1] != 0xF7){
+      appendToSysEx7Bits(0);
+    }
+    uint8_t crc = 0;
+    uint16_t n = length - (addCrcByte ? 1 : 2);
+    if(sysex[0] != 0xF0){
+      crc ^= 0x70;
+    }
+    for(uint16_t i = 0 ; i < n ; i++){
+      crc ^= (sysex[i] & 0x7F);
+    }
+    sysex[n] = crc;
+  }
+  uint8_t get7Bits(uint16_t i){
+    return (i < length) ? (sysex[i] & 0x7F) : 0;
+  }
+  uint16_t get14Bits(uint16_t i){
+    return ((i+1) < length) ? ((get7Bits(i) << 7) | get7Bits(i+1)) : 0;
+  }
+  uint8_t get8BitsLSBFirst(uint16_t i){
+    return ((i+1) < length) ? ((get7Bits(i+1) << 7) | get7Bits(i)) & 0xFF : 0;
+  }
+  uint16_t get16BitsLSBFirst(uint16_t i){
+    if((i+2) >= length){
+      return 0;
+    }
+    return ((uint32_t) get7Bits(i+2) << 14) | (get7Bits(i+1) << 7) | get7Bits(i);
+  }
+  uint32_t get32BitsLSBFirst(uint16_t i){
+    if((i+4) >= length){
+      return 0;
+    }
+    uint32_t value = 0;
+    for(uint8_t n = 0 ; n < 5 ; n++){
+      value |= (uint32_t) get7Bits(i+n) << (n*7);
+    }
+    return value;
+  }
+  void getStringFromSysEx(uint8_t startsAt, char * str, uint8_t t_length){
+    if(t_length > 1 && (startsAt + t_length) < length){
+      memcpy(str, &sysex[startsAt], t_length);
+      str[t_length-1] = 0;
+    }
+  }
+private:
+  uint8_t status = 0;
+  uint16_t length = 0;
+  uint8_t port = 0;
+};
+
+struct BMCTunerData {
+  uint8_t stringNumber = 0;
+  uint8_t note = 0;
+  int pitch = 0;
+  char noteName[3] = "";
+  void reset(){
+    stringNumber = 0;
+    pitch = 0;
+    note = 0;
+    strcpy(noteName, "");
+  }
+};
+
+class BMCGlobals {
+public:
+  void clearMidiInActivity(){}
+};
+
+#endif
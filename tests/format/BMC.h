@@ -0,0 +1,59 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/BMC.h for the format test, only the parts of the BMC class
+  that BMC.sketchStream.cpp uses so the real stream functions can be built
+  and called from test-format.cpp, the templates are the ones from src.
+*/
+#ifndef BMC_H
+#define BMC_H
+
+#include "Arduino.h"
+#include "utility/BMC-Format.h"
+#include "utility/BMC-StreamTemplates.h"
+
+#define BMC_MIDI_NOTE_OFF 0x80
+#define BMC_MIDI_NOTE_ON 0x90
+#define BMC_MIDI_CONTROL_CHANGE 0xB0
+#define BMC_MIDI_PROGRAM_CHANGE 0xC0
+#define BMC_MIDI_RT_CLOCK 0xF8
+
+#define BMC_ITEM_ID_PAGE 1
+#define BMC_ITEM_ID_PRESET 16
+#define BMC_ITEM_ID_SKETCH_BYTES 20
+#define BMC_ITEM_ID_SETLIST 22
+#define BMC_ITEM_ID_SETLIST_SONG 23
+#define BMC_ITEM_ID_MIDI_PROGRAM BMC_MIDI_PROGRAM_CHANGE
+#define BMC_ITEM_ID_MIDI_CONTROL BMC_MIDI_CONTROL_CHANGE
+#define BMC_ITEM_ID_MIDI_CLOCK BMC_MIDI_RT_CLOCK
+
+struct BMCValueStream {
+  uint8_t source = 0;
+  uint8_t id = 0;
+  int value = 0;
+  uint32_t data = 0;
+  char name[30];
+};
+
+class BMCCallbacks {
+public:
+  void (*valueStream)(BMCValueStream item) = 0;
+};
+
+class BMC {
+public:
+  BMCCallbacks callback;
+  void streamToSketch(uint8_t t_id, int t_value);
+  void streamToSketch(uint8_t t_id, int t_value, const char* str);
+  void streamToSketch(uint8_t t_id, int t_value, char* str);
+  void streamMidi(uint8_t status, uint8_t channel, uint8_t data1, uint8_t data2=255);
+  void streamRawValue(uint16_t t_value);
+  void streamMidiProgram(uint8_t channel, uint8_t program);
+  void streamMidiControl(uint8_t channel, uint8_t control, uint8_t value);
+  void streamMidiClockBPM(uint16_t value);
+};
+
+#endif
@@ -0,0 +1,174 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCFormat against snprintf for every value stream template from
+  utility/BMC-StreamTemplates.h and the names built with it, then calls the
+  real stream functions of BMC.sketchStream.cpp the way a few thousand
+  updates of BMC would and counts every malloc, calloc and realloc made
+  during each update, there must be none.
+
+  g++ -std=gnu++14 -I tests/format -I tests/common -I src tests/format/test-format.cpp -o test-format
+*/
+#include "bmc-test.h"
+#include "BMC.h"
+#include "BMC.sketchStream.cpp"
+#include <vector>
+
+// every allocation made while counting is on, new and the Arduino String
+// class both end up in malloc or realloc. Only glibc lets the test replace
+// them, anywhere else the allocations are not counted
+static bool counting = false;
+static unsigned long allocations = 0;
+#if defined(__GLIBC__)
+extern "C" {
+  void * __libc_malloc(size_t size);
+  void * __libc_calloc(size_t count, size_t size);
+  void * __libc_realloc(void * p, size_t size);
+  void __libc_free(void * p);
+  void * malloc(size_t size) noexcept {
+    allocations += counting;
+    return __libc_malloc(size);
+  }
+  void * calloc(size_t count, size_t size) noexcept {
+    allocations += counting;
+    return __libc_calloc(count, size);
+  }
+  void * realloc(void * p, size_t size) noexcept {
+    allocations += counting;
+    return __libc_realloc(p, size);
+  }
+  void free(void * p) noexcept {
+    __libc_free(p);
+  }
+}
+#endif
+
+// the size of BMCValueStream::name
+char name[30];
+char expected[30];
+
+void checkTemplate(const char * templ, const char * str, int a, int b=0, int c=0){
+  BMCFormat(name, sizeof(name)).addTemplate(templ, str, a, b, c);
+  if(strstr(templ, "%s") != 0){
+    snprintf(expected, sizeof(expected), templ, a, str);
+  } else {
+    snprintf(expected, sizeof(expected), templ, a, b, c);
+  }
+  if(strcmp(name, expected) != 0){
+    printf("template \"%s\": \"%s\" expected \"%s\"\n", templ, name, expected);
+  }
+  CHECK(strcmp(name, expected) == 0);
+}
+
+void testTemplates(){
+  checkTemplate(BMC_STREAM_TEMPL_PAGE, "Intro", 1);
+  checkTemplate(BMC_STREAM_TEMPL_PRESET, "Lead", 128);
+  checkTemplate(BMC_STREAM_TEMPL_MIDI_PC, "", 16, 127);
+  checkTemplate(BMC_STREAM_TEMPL_MIDI_CC, "", 1, 7, 0);
+  checkTemplate(BMC_STREAM_TEMPL_MIDI_NOTE_ON, "", 10, 60, 100);
+  checkTemplate(BMC_STREAM_TEMPL_MIDI_CLOCK_BPM, "", 300);
+  checkTemplate("%u%% %d", "", 50, -12);
+  // longer than the name, cut off and still terminated
+  checkTemplate(BMC_STREAM_TEMPL_PAGE, "A page name that doesn't fit", 1);
+  CHECK_EQ(strlen(name), sizeof(name) - 1);
+}
+
+void testNames(){
+  // sketch byte names from BMC-BuildData.h
+  char byteName[16];
+  BMCFormat(byteName, sizeof(byteName)).addString("Byte ").addNumber(7);
+  CHECK(strcmp(byteName, "Byte 7") == 0);
+  BMCFormat(byteName, sizeof(byteName)).addString("Byte ").addNumber(31);
+  CHECK(strcmp(byteName, "Byte 31") == 0);
+  // SD card store file names from BMC-SD.h
+  char fileName[11];
+  BMCFormat(fileName, sizeof(fileName)).addString("BMC").addNumber(5, 3).addString(".HEX");
+  CHECK(strcmp(fileName, "BMC005.HEX") == 0);
+  BMCFormat(fileName, sizeof(fileName)).addString("BMC").addNumber(255, 3).addString(".HEX");
+  CHECK(strcmp(fileName, "BMC255.HEX") == 0);
+  BMCFormat(name, sizeof(name)).addSigned(-8192).addChar(' ').addString("cents");
+  CHECK(strcmp(name, "-8192 cents") == 0);
+}
+
+BMC bmc;
+std::vector<BMCValueStream> streams;
+
+void onValueStream(BMCValueStream item){
+  streams.push_back(item);
+}
+BMCValueStream & lastStream(){
+  return streams.back();
+}
+
+// the names passed to the sketch by the stream functions
+void testStreams(){
+  bmc.callback.valueStream = onValueStream;
+  bmc.streamToSketch(BMC_ITEM_ID_PAGE, 0, "Intro");
+  CHECK(strcmp(lastStream().name, "Page 001 Intro") == 0);
+  CHECK_EQ(lastStream().value, 0);
+  bmc.streamToSketch(BMC_ITEM_ID_SETLIST_SONG, 9, "Encore");
+  CHECK(strcmp(lastStream().name, "Song 010 Encore") == 0);
+  bmc.streamToSketch(BMC_ITEM_ID_SKETCH_BYTES, 3, "Byte 3");
+  CHECK(strcmp(lastStream().name, "Byte 3") == 0);
+  bmc.streamMidi(BMC_MIDI_CONTROL_CHANGE, 1, 7, 100);
+  CHECK(strcmp(lastStream().name, "Control Ch:01 CC:007 V:100") == 0);
+  CHECK_EQ(lastStream().data, (100UL<<16) | (7<<8) | 0xB1);
+  bmc.streamMidi(BMC_MIDI_PROGRAM_CHANGE, 16, 127);
+  CHECK(strcmp(lastStream().name, "Program Ch:16 PC:127") == 0);
+  CHECK_EQ(lastStream().value, 127);
+  bmc.streamMidiControl(2, 64, 0);
+  CHECK(strcmp(lastStream().name, "Control Ch:02 CC:064 V:000") == 0);
+  bmc.streamMidiClockBPM(120);
+  CHECK(strcmp(lastStream().name, "BPM 120") == 0);
+  bmc.streamRawValue(5);
+  CHECK(strcmp(lastStream().name, "005") == 0);
+  streams.clear();
+}
+
+// every stream a BMC update can trigger, pages, presets, buttons, pots and
+// the midi clock, none of them may allocate
+void testAllocations(){
+  static BMCValueStream last;
+  bmc.callback.valueStream = [](BMCValueStream item){ last = item; };
+  unsigned long updatesThatAllocated = 0;
+  for(uint16_t update = 0 ; update < 5000 ; update++){
+    uint8_t channel = (update & 0x0F) + 1;
+    allocations = 0;
+    counting = true;
+    bmc.streamToSketch(BMC_ITEM_ID_PAGE, update & 0xFF, "Page Name");
+    bmc.streamToSketch(BMC_ITEM_ID_PRESET, update & 0x7F, (char*) "Preset Name");
+    bmc.streamToSketch(BMC_ITEM_ID_SETLIST, update & 0x1F, "SetList Name");
+    bmc.streamToSketch(BMC_ITEM_ID_SKETCH_BYTES, update & 0xFF);
+    bmc.streamMidi(BMC_MIDI_CONTROL_CHANGE, channel, update & 0x7F, (update >> 7) & 0x7F);
+    bmc.streamMidi(BMC_MIDI_NOTE_ON, channel, update & 0x7F, 100);
+    bmc.streamMidi(BMC_MIDI_NOTE_OFF, channel, update & 0x7F, 0);
+    bmc.streamMidi(BMC_MIDI_PROGRAM_CHANGE, channel, update & 0x7F);
+    bmc.streamMidiProgram(channel, update & 0x7F);
+    bmc.streamMidiControl(channel, update & 0x7F, (update >> 7) & 0x7F);
+    bmc.streamMidiClockBPM(30 + (update % 270));
+    bmc.streamRawValue(update);
+    counting = false;
+    updatesThatAllocated += (allocations > 0);
+  }
+  CHECK_EQ(updatesThatAllocated, 0);
+  CHECK_EQ(last.value, 4999);
+  // the counter itself works
+  allocations = 0;
+  counting = true;
+  free(malloc(16));
+  counting = false;
+#if defined(__GLIBC__)
+  CHECK_EQ(allocations, 1);
+#endif
+}
+
+int main(){
+  testTemplates();
+  testNames();
+  testStreams();
+  testAllocations();
+  return BMC_TEST_RESULT();
+}
@@ -0,0 +1,84 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces the USBHost_t36 library for the host test, a MIDI device object
+  is "claimed" when the test plugs a device into it, it hands out the
+  messages the test queued and keeps every message sent to it.
+*/
+#ifndef BMC_TEST_USB_HOST_H
+#define BMC_TEST_USB_HOST_H
+
+#include "Arduino.h"
+#include <vector>
+
+class USBHost {
+public:
+  void begin(){}
+  void Task(){}
+};
+
+class USBHub {
+public:
+  USBHub(USBHost&){}
+};
+
+struct FakeHostMessage {
+  uint8_t type;
+  uint8_t data1;
+  uint8_t data2;
+  uint8_t channel;
+};
+
+class MIDIDevice {
+public:
+  MIDIDevice(USBHost&){}
+  // the test side
+  bool plugged = false;
+  uint16_t vendorId = 0;
+  uint16_t productId = 0;
+  std::vector<FakeHostMessage> incoming;
+  std::vector<FakeHostMessage> sent;
+  void plug(uint16_t vendor, uint16_t product){
+    plugged = true;
+    vendorId = vendor;
+    productId = product;
+  }
+  void unplug(){
+    plugged = false;
+    incoming.clear();
+  }
+  // the USBHost_t36 side
+  operator bool(){ return plugged; }
+  uint16_t idVendor(){ return vendorId; }
+  uint16_t idProduct(){ return productId; }
+  bool read(){
+    if(!plugged || incoming.empty()){
+      return false;
+    }
+    last = incoming.front();
+    incoming.erase(incoming.begin());
+    return true;
+  }
+  uint8_t getType(){ return last.type; }
+  uint8_t getData1(){ return last.data1; }
+  uint8_t getData2(){ return last.data2; }
+  uint8_t getChannel(){ return last.channel; }
+  uint16_t getSysExArrayLength(){ return 0; }
+  const uint8_t * getSysExArray(){ return 0; }
+  void sendControlChange(uint8_t control, uint8_t value, uint8_t channel, uint8_t cable=0){
+    FakeHostMessage m = {0xB0, control, value, channel};
+    sent.push_back(m);
+  }
+private:
+  FakeHostMessage last = {0, 0, 0, 0};
+};
+
+class MIDIDevice_BigBuffer : public MIDIDevice {
+public:
+  MIDIDevice_BigBuffer(USBHost& host):MIDIDevice(host){}
+};
+
+#endif
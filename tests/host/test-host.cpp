@@ -0,0 +1,133 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCMidiPortHost with simulated devices plugged into a hub, checks the
+  connection callbacks, that reading takes turns between devices and that
+  host device ports only send to their device while BMC_HOST sends to every
+  connected device.
+
+  g++ -std=gnu++14 -I tests/host -I tests/common -I src tests/host/test-host.cpp -o test-host
+*/
+#include "bmc-test.h"
+#include "utility/BMC-Def.h"
+#include "midi/BMC-MidiPortHost.h"
+
+BMCCallbacks callbacks;
+BMCGlobals globals;
+BMCMidiPortHost host(callbacks, globals);
+BMCMidiMessage message;
+
+uint8_t deviceEvents = 0;
+uint8_t lastDevice = 0xFF;
+bool lastState = false;
+uint8_t hostEvents = 0;
+
+void onDevice(uint8_t device, bool state){
+  deviceEvents++;
+  lastDevice = device;
+  lastState = state;
+}
+void onHost(bool state){
+  hostEvents++;
+}
+void queue(uint8_t device, uint8_t control){
+  FakeHostMessage m = {0xB0, control, 127, 1};
+  host.Ports[device].incoming.push_back(m);
+}
+// sends a control change thru @port like BMCMidi does
+void sendControl(uint8_t port, uint8_t control){
+  host.forEachDevice(port, [&](BMCHostMidiDevice& device){
+    device.sendControlChange(control, 127, 1, 0);
+  });
+}
+size_t sentTo(uint8_t device){
+  size_t n = host.Ports[device].sent.size();
+  host.Ports[device].sent.clear();
+  return n;
+}
+
+void testConnection(){
+  CHECK(!host.read(message, false));
+  CHECK_EQ(host.getConnected(), 0);
+  CHECK(!globals.hostConnected());
+  host.Ports[0].plug(0x1234, 1);
+  host.Ports[2].plug(0x5678, 2);
+  CHECK(!host.read(message, false));
+  CHECK_EQ(host.getConnected(), 0x05);
+  CHECK(globals.hostConnected());
+  CHECK_EQ(hostEvents, 1);
+  CHECK_EQ(deviceEvents, 2);
+  CHECK_EQ(host.getVendorId(2), 0x5678);
+  CHECK_EQ(host.getProductId(0), 1);
+  CHECK_EQ(host.getVendorId(1), 0);
+}
+
+void testRead(){
+  for(uint8_t i = 0 ; i < 3 ; i++){
+    queue(0, i);
+    queue(2, 10+i);
+  }
+  // a device with messages waiting doesn't hold back the other one
+  uint8_t order[6];
+  for(uint8_t i = 0 ; i < 6 ; i++){
+    CHECK(host.read(message, false));
+    order[i] = message.getDevice();
+    CHECK_EQ(message.getSource(), BMC_MIDI_PORT_HOST_BIT);
+    CHECK_EQ(message.getData1(), (order[i] == 0 ? 0 : 10) + (i / 2));
+  }
+  for(uint8_t i = 1 ; i < 6 ; i++){
+    CHECK(order[i] != order[i-1]);
+  }
+  CHECK(!host.read(message, false));
+  // real time messages can be skipped
+  FakeHostMessage clock = {0xF8, 0, 0, 0};
+  host.Ports[2].incoming.push_back(clock);
+  CHECK(!host.read(message, true));
+}
+
+void testSend(){
+  sendControl(BMC_HOST, 7);
+  CHECK_EQ(sentTo(0), 1);
+  CHECK_EQ(sentTo(1), 0);
+  CHECK_EQ(sentTo(2), 1);
+  sendControl(BMC_HOST_DEVICE_PORT(2), 7);
+  CHECK_EQ(sentTo(0), 0);
+  CHECK_EQ(sentTo(2), 1);
+  // nothing is plugged into device 1
+  sendControl(BMC_HOST_DEVICE_PORT(1), 7);
+  CHECK_EQ(sentTo(1), 0);
+  CHECK_EQ(host.getDevices(BMC_HOST_DEVICE_PORT(0)), 0x01);
+  CHECK_EQ(host.getDevices(BMC_HOST), 0x05);
+}
+
+void testUnplug(){
+  host.Ports[0].unplug();
+  host.read(message, false);
+  CHECK_EQ(host.getConnected(), 0x04);
+  CHECK_EQ(lastDevice, 0);
+  CHECK(!lastState);
+  CHECK(globals.hostConnected());
+  sendControl(BMC_HOST_DEVICE_PORT(0), 7);
+  sendControl(BMC_HOST, 7);
+  CHECK_EQ(sentTo(0), 0);
+  CHECK_EQ(sentTo(2), 1);
+  host.Ports[2].unplug();
+  host.read(message, false);
+  CHECK_EQ(host.getConnected(), 0);
+  CHECK(!globals.hostConnected());
+  CHECK_EQ(hostEvents, 2);
+}
+
+int main(){
+  callbacks.hostConnection = onHost;
+  callbacks.hostDeviceConnection = onDevice;
+  host.begin();
+  testConnection();
+  testRead();
+  testSend();
+  testUnplug();
+  return BMC_TEST_RESULT();
+}
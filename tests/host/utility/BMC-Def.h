@@ -0,0 +1,73 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the USB Host test, only the parts of
+  BMC that BMCMidiPortHost uses, the USB Host library is the fake one in
+  USBHost_t36.h next to this folder.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+
+#define BMC_USB_HOST_ENABLED
+#define BMC_USB_HOST_DEVICES 4
+#define BMC_USB_HOST_HUBS 1
+#define BMC_USE_USB_MIDI_BIG_BUFFER 0
+
+#define BMC_PRINTLN(...)
+
+#define BMC_NONE 0
+#define BMC_MIDI_SYSEX_SIZE 32
+#define BMC_MIDI_PORT_HOST_BIT 5
+#define BMC_HOST 0x20
+#define BMC_HOST_DEVICE_PORT(n) (0xA0 | ((n) & 0x0F))
+#define BMC_IS_HOST_DEVICE_PORT(p) (((p) & 0xF0) == 0xA0)
+
+class BMCMidiMessage {
+public:
+  void reset(uint8_t t_source=0){
+    source = t_source;
+    status = BMC_NONE;
+    device = 0;
+  }
+  void setDevice(uint8_t value){ device = value; }
+  void setStatus(uint8_t value){ status = value; }
+  void setData1(uint8_t value){ data1 = value; }
+  void setData2(uint8_t value){ data2 = value; }
+  void setChannel(uint8_t value){ channel = value; }
+  void addSysEx(const uint8_t *, uint16_t){}
+  bool isSystemRealTimeStatus(){ return status >= 0xF8; }
+  bool isSystemExclusive(){ return status == 0xF0; }
+  bool isChannelStatus(){ return status >= 0x80 && status < 0xF0; }
+  uint8_t getSource(){ return source; }
+  uint8_t getDevice(){ return device; }
+  uint8_t getStatus(){ return status; }
+  uint8_t getData1(){ return data1; }
+  uint8_t getChannel(){ return channel; }
+private:
+  uint8_t source = 0;
+  uint8_t device = 0;
+  uint8_t status = 0;
+  uint8_t data1 = 0;
+  uint8_t data2 = 0;
+  uint8_t channel = 0;
+};
+
+struct BMCCallbacks {
+  void (*hostConnection)(bool) = 0;
+  void (*hostDeviceConnection)(uint8_t, bool) = 0;
+};
+
+class BMCGlobals {
+public:
+  bool hostConnected(){ return connected; }
+  void setHostConnected(bool value){ connected = value; }
+private:
+  bool connected = false;
+};
+
+#endif
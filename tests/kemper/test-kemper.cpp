@@ -0,0 +1,215 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCKemper against a simulated Kemper that answers parameter and string
+  requests after a delay and can ignore requests, checks the connection,
+  the values read by a sync, the request pacing and the retries.
+
+  g++ -std=gnu++14 -I tests/kemper -I tests/common -I src tests/kemper/test-kemper.cpp -o test-kemper
+*/
+#include "bmc-test.h"
+#include "utility/BMC-Def.h"
+#include "sync/kemp/BMC-Kemp.h"
+
+#define FAKE_KEMPER_LATENCY 5
+
+struct FakeKemperReply {
+  BMCMidiMessage message;
+  unsigned long due = 0;
+};
+
+// answers the requests BMCKemper sends thru the fake BMCMidi
+class FakeKemper {
+public:
+  char rigName[32] = "Clean Rig";
+  char performanceName[32] = "Live Set";
+  // 1 bit per BMC_KEMPER_MODULE_*
+  uint8_t modules = 0;
+  // requests to ignore before answering again
+  uint8_t drop = 0;
+  bool beacon = false;
+  uint16_t requests = 0;
+  // most replies waiting at the same time and the shortest time between
+  // 2 requests after the device was found
+  uint8_t maxInFlight = 0;
+  unsigned long minInterval = 0xFFFFFFFF;
+
+  void receive(BMCMidiMessage& request){
+    uint8_t fn = request.get7Bits(6);
+    if(fn == BMC_KEMPER_FN_CODE_BEACON){
+      beacon = true;
+      return;
+    }
+    // the device search is not paced, it comes before the first request
+    if(requests > 1 && (millis() - lastRequest) < minInterval){
+      minInterval = millis() - lastRequest;
+    }
+    lastRequest = millis();
+    requests++;
+    if(drop > 0){
+      drop--;
+      return;
+    }
+    BMCMidiMessage reply;
+    prep(reply, fn & 0x0F);
+    if(fn == BMC_KEMPER_FN_CODE_REQUEST_SINGLE_PARAM){
+      uint16_t param = (request.get7Bits(8) << 8) | request.get7Bits(9);
+      reply.appendToSysEx7Bits(param >> 8);
+      reply.appendToSysEx7Bits(param);
+      reply.appendToSysEx14Bits(getParameter(param));
+    } else if(fn == BMC_KEMPER_FN_CODE_REQUEST_STRING_PARAM){
+      reply.appendToSysEx7Bits(request.get7Bits(8));
+      reply.appendToSysEx7Bits(request.get7Bits(9));
+      appendString(reply, rigName);
+    } else if(fn == BMC_KEMPER_FN_CODE_REQUEST_EXT_STRING_PARAM){
+      for(uint8_t i = 8 ; i < 13 ; i++){
+        reply.appendToSysEx7Bits(request.get7Bits(i));
+      }
+      appendString(reply, performanceName);
+    } else {
+      return;
+    }
+    queue(reply);
+  }
+  // the rig was changed on the Kemper itself, it reports the new name
+  void selectRig(const char * name, uint8_t t_modules){
+    strcpy(rigName, name);
+    modules = t_modules;
+    BMCMidiMessage message;
+    prep(message, BMC_KEMPER_FN_CODE_STRING_PARAM);
+    message.appendToSysEx7Bits(BMC_KEMPER_STRING_RIG_NAME >> 8);
+    message.appendToSysEx7Bits(BMC_KEMPER_STRING_RIG_NAME);
+    appendString(message, rigName);
+    queue(message);
+  }
+  // deliver the replies that are due
+  void update(BMCKemper& kemper){
+    for(uint8_t i = 0 ; i < length ; ){
+      if((long)(millis() - replies[i].due) >= 0){
+        kemper.incoming(replies[i].message);
+        replies[i] = replies[--length];
+      } else {
+        i++;
+      }
+    }
+  }
+private:
+  FakeKemperReply replies[16];
+  uint8_t length = 0;
+  unsigned long lastRequest = 0;
+
+  uint16_t getParameter(uint16_t param){
+    const uint16_t moduleParams[BMC_KEMPER_MAX_MODULES] = {
+      BMC_KEMPER_PARAM_STOMP_A_ON_OFF_4_MIX,
+      BMC_KEMPER_PARAM_STOMP_B_ON_OFF_4_MIX,
+      BMC_KEMPER_PARAM_STOMP_C_ON_OFF_4_MIX,
+      BMC_KEMPER_PARAM_STOMP_D_ON_OFF_4_MIX,
+      BMC_KEMPER_PARAM_STOMP_X_ON_OFF_4_MIX,
+      BMC_KEMPER_PARAM_STOMP_MOD_ON_OFF_4_MIX,
+      BMC_KEMPER_PARAM_STOMP_DELAY_ON_OFF_4_MIX,
+      BMC_KEMPER_PARAM_REVERB_ON_OFF__CUTS_TAIL_
+    };
+    for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_MODULES ; i++){
+      if(moduleParams[i] == param){
+        return bitRead(modules, i);
+      }
+    }
+    return 0x2000;
+  }
+  void prep(BMCMidiMessage& message, uint8_t fn){
+    message.setStatus(BMC_MIDI_SYSTEM_EXCLUSIVE);
+    message.setPort(BMC_MIDI_PORT_SERIAL_A);
+    message.appendToSysEx7Bits(0x00);
+    message.appendToSysEx7Bits(0x20);
+    message.appendToSysEx7Bits(0x33);
+    message.appendToSysEx7Bits(0x02);
+    message.appendToSysEx7Bits(0x7F);
+    message.appendToSysEx7Bits(fn);
+    message.appendToSysEx7Bits(0x00);
+  }
+  void appendString(BMCMidiMessage& message, const char * str){
+    for(uint8_t i = 0 ; str[i] != 0 ; i++){
+      message.appendToSysEx7Bits(str[i]);
+    }
+    message.appendToSysEx(0);
+    message.appendToSysEx(0xF7);
+  }
+  void queue(BMCMidiMessage& message){
+    if(message.getSysEx()[message.size()-1] != 0xF7){
+      message.appendToSysEx(0xF7);
+    }
+    if(length < 16){
+      replies[length].message = message;
+      replies[length].due = millis() + FAKE_KEMPER_LATENCY;
+      length++;
+      if(length > maxInFlight){
+        maxInFlight = length;
+      }
+    }
+  }
+};
+
+BMCMidi midi;
+BMCKemper kemper(midi);
+FakeKemper device;
+
+void run(unsigned long ms){
+  for(unsigned long i = 0 ; i < ms ; i++){
+    bmcTestAdvanceMs(1);
+    kemper.update();
+    for(uint8_t n = 0 ; n < midi.sentLength ; n++){
+      device.receive(midi.sent[n]);
+    }
+    midi.sentLength = 0;
+    device.update(kemper);
+  }
+}
+
+int main(){
+  device.modules = 0x85; // Stomp A, Stomp C and Reverb
+  kemper.begin();
+  run(1500);
+
+  // found on the port that answered the search, then synced
+  CHECK(kemper.connected());
+  CHECK(device.beacon);
+  CHECK(!kemper.syncing());
+  CHECK_EQ(kemper.getSyncCount(), 1);
+  CHECK(strcmp(kemper.getRigName(), "Clean Rig") == 0);
+  CHECK(strcmp(kemper.getPerformanceName(), "Live Set") == 0);
+  for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_MODULES ; i++){
+    CHECK(kemper.isModuleKnown(i));
+    CHECK_EQ(kemper.isModuleOn(i), bitRead(device.modules, i));
+  }
+  // requests are paced and only a few wait on a reply at a time
+  CHECK(device.minInterval >= BMC_KEMPER_REQUEST_INTERVAL);
+  CHECK(device.maxInFlight <= BMC_KEMPER_MAX_IN_FLIGHT);
+  CHECK_EQ(kemper.getRequestRetries(), 0);
+
+  // a rig changed on the Kemper is read again, one request is lost and
+  // sent again after the timeout
+  device.drop = 1;
+  device.selectRig("Lead Rig", 0x12);
+  run(2000);
+  CHECK(kemper.rigChanged());
+  CHECK(strcmp(kemper.getRigName(), "Lead Rig") == 0);
+  CHECK_EQ(kemper.getSyncCount(), 2);
+  CHECK_EQ(kemper.getRequestRetries(), 1);
+  for(uint8_t i = 0 ; i < BMC_KEMPER_MAX_MODULES ; i++){
+    CHECK_EQ(kemper.isModuleOn(i), bitRead(device.modules, i));
+  }
+
+  // toggling a module sends the change and doesn't wait for an echo
+  kemper.toggleModule(BMC_KEMPER_MODULE_STOMP_A);
+  CHECK(kemper.isModuleOn(BMC_KEMPER_MODULE_STOMP_A));
+
+  // the Kemper stops answering, the connection is dropped and searched again
+  device.drop = 255;
+  run(BMC_KEMPER_CONNECTION_LOST_TIMEOUT * 2 + 100);
+  CHECK(!kemper.connected());
+
+  return BMC_TEST_RESULT();
+}
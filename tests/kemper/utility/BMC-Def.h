@@ -0,0 +1,108 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the Kemper test, only the parts of BMC
+  that BMCKemper uses, BMCMidi records what is sent so the simulated Kemper
+  in test-kemper.cpp can answer it.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+#include "utility/BMC-Flags.h"
+#include "utility/BMC-Timer.h"
+
+#define BMC_USE_KEMPER
+
+#define BMC_INFO(...)
+#define BMC_PRINTLN(...)
+
+#define B00111110 0x3E
+#define BMC_MIDI_SYSTEM_EXCLUSIVE 0xF0
+#define BMC_MIDI_PORT_SERIAL_A 0x02
+
+#define BMC_KEMPER_CC_FIRST_RIG 50
+#define BMC_KEMPER_CC_FIFTH_RIG 54
+#define BMC_KEMPER_PARAM_RIG_VOLUME 0x401
+#define BMC_KEMPER_PARAM_STOMP_A_ON_OFF_4_MIX 0x3203
+#define BMC_KEMPER_PARAM_STOMP_B_ON_OFF_4_MIX 0x3303
+#define BMC_KEMPER_PARAM_STOMP_C_ON_OFF_4_MIX 0x3403
+#define BMC_KEMPER_PARAM_STOMP_D_ON_OFF_4_MIX 0x3503
+#define BMC_KEMPER_PARAM_STOMP_X_ON_OFF_4_MIX 0x3803
+#define BMC_KEMPER_PARAM_STOMP_MOD_ON_OFF_4_MIX 0x3A03
+#define BMC_KEMPER_PARAM_STOMP_DELAY_ON_OFF_4_MIX 0x3C03
+#define BMC_KEMPER_PARAM_REVERB_ON_OFF__CUTS_TAIL_ 0x4B02
+
+class BMCMidiMessage {
+public:
+  uint8_t sysex[64];
+  void setStatus(uint8_t t_status){
+    status = t_status;
+    sysex[0] = t_status;
+    length = 1;
+  }
+  void setPort(uint8_t t_port){
+    port = t_port;
+  }
+  void appendToSysEx(uint8_t value){
+    if(length < sizeof(sysex)){
+      sysex[length++] = value;
+    }
+  }
+  void appendToSysEx7Bits(uint8_t value){
+    appendToSysEx(value & 0x7F);
+  }
+  void appendToSysEx14Bits(uint16_t value){
+    appendToSysEx7Bits(value >> 7);
+    appendToSysEx7Bits(value);
+  }
+  uint8_t * getSysEx(){ return sysex; }
+  uint16_t size(){ return length; }
+  uint8_t get7Bits(uint16_t i){ return (i < length) ? (sysex[i] & 0x7F) : 0; }
+  uint16_t get14Bits(uint16_t i){ return (get7Bits(i) << 7) | get7Bits(i+1); }
+  bool isSysEx(){ return status == BMC_MIDI_SYSTEM_EXCLUSIVE; }
+  bool isControlChange(){ return false; }
+  bool isProgramChange(){ return false; }
+  uint8_t getData1(){ return 0; }
+  uint8_t getChannel(){ return 1; }
+  uint8_t getPort(){ return port; }
+private:
+  uint8_t status = 0;
+  uint16_t length = 0;
+  uint8_t port = 0;
+};
+
+struct BMCCallbacks {
+  void (*kemperConnection)(bool) = 0;
+  void (*kemperRigChange)(char *) = 0;
+  void (*kemperModulesChange)() = 0;
+  void (*kemperSyncComplete)(uint16_t) = 0;
+  void (*kemperParamReceived)(uint16_t, uint16_t) = 0;
+  void (*kemperStringReceived)(uint16_t, char *, uint8_t) = 0;
+};
+
+// keeps every SysEx sent until the test takes it
+class BMCMidi {
+public:
+  BMCCallbacks callback;
+  BMCMidiMessage sent[32];
+  uint8_t sentLength = 0;
+  void sendSysEx(uint8_t port, uint8_t * data, uint16_t size, bool, uint8_t, bool){
+    if(sentLength >= 32){
+      return;
+    }
+    BMCMidiMessage& m = sent[sentLength++];
+    m.setStatus(BMC_MIDI_SYSTEM_EXCLUSIVE);
+    m.setPort(port);
+    for(uint16_t i = 1 ; i < size ; i++){
+      m.appendToSysEx(data[i]);
+    }
+  }
+  void sendControlChange(uint8_t, uint8_t, uint8_t, uint8_t){}
+  void sendProgramChange(uint8_t, uint8_t, uint8_t){}
+};
+
+#endif
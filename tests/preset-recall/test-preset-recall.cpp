@@ -0,0 +1,176 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCPresetRecall with a USB port and a Serial port with a 64 byte transmit
+  buffer, checks that items without a port are executed in their place in
+  the preset after a full buffer or a delay, and that a SysEx waits for
+  room in a buffer that was never seen empty.
+
+  g++ -std=gnu++14 -I tests/preset-recall -I tests/common -I src tests/preset-recall/test-preset-recall.cpp -o test-preset-recall
+*/
+#include "bmc-test.h"
+#include "utility/BMC-Def.h"
+#include "utility/BMC-PresetRecall.h"
+
+#define USB 0x01
+#define SERIAL_A 0x02
+
+BMCMidi midi;
+BMCLibrary library(midi);
+BMCPresetRecall recall(midi, library);
+bmcStoreGlobalPresets preset;
+
+// library item @n is a CC#n to @ports
+void setControl(uint8_t n, uint8_t ports){
+  library.events[n] = ((uint32_t) ports << 24) | ((uint32_t) n << 8) | 0xB0;
+}
+// library item @n has no port, like a page change
+void setPortless(uint8_t n){
+  library.events[n] = 0x01;
+}
+void setDelay(uint8_t n, uint8_t ports, uint8_t ms){
+  library.events[n] = ((uint32_t) ports << 24) | ((uint32_t) ms << 8) | BMC_LIBRARY_EVENT_DELAY;
+}
+void setSysEx(uint8_t n, uint8_t ports, uint16_t length){
+  library.events[n] = ((uint32_t) ports << 24) | 0xF0;
+  library.sysExLength[n] = length;
+}
+void setPreset(uint8_t a, uint8_t b, uint8_t c, uint8_t d){
+  preset.length = 4;
+  preset.events[0] = a;
+  preset.events[1] = b;
+  preset.events[2] = c;
+  preset.events[3] = d;
+}
+// the library items sent, in order
+std::vector<bmcLibrary_t> sentItems(){
+  std::vector<bmcLibrary_t> items;
+  for(size_t i = 0 ; i < bmcTestSent.size() ; i++){
+    items.push_back(bmcTestSent[i].index);
+  }
+  return items;
+}
+bool sentInOrder(uint8_t a, uint8_t b, uint8_t c, uint8_t d){
+  std::vector<bmcLibrary_t> items = sentItems();
+  return items.size() == 4 && items[0] == a && items[1] == b && items[2] == c && items[3] == d;
+}
+void run(unsigned long ms, BMCPresetRecall& r = recall){
+  for(unsigned long i = 0 ; i < ms ; i++){
+    bmcTestAdvanceMs(1);
+    r.update();
+  }
+}
+// the Serial buffer sent every byte
+void drain(){
+  midi.space[1] = 63;
+  recall.update();
+}
+void reset(){
+  bmcTestSent.clear();
+  midi.space[1] = 63;
+}
+
+void testOrder(){
+  reset();
+  setControl(1, USB);
+  setPortless(2);
+  setControl(3, SERIAL_A);
+  setControl(4, USB);
+  setPreset(1, 2, 3, 4);
+  recall.start(preset, false, 0);
+  CHECK(sentInOrder(1, 2, 3, 4) || sentInOrder(1, 2, 4, 3));
+  drain();
+  CHECK(!recall.active());
+  // the item without a port is first and last
+  reset();
+  setPreset(2, 1, 3, 2);
+  recall.start(preset, false, 0);
+  drain();
+  CHECK(!recall.active());
+  CHECK(sentItems().front() == 2 && sentItems().back() == 2);
+  CHECK_EQ(sentItems().size(), 4);
+}
+
+void testWaitsForPort(){
+  reset();
+  setControl(1, SERIAL_A);
+  setPortless(2);
+  setControl(3, USB);
+  setControl(4, SERIAL_A);
+  setPreset(1, 2, 3, 4);
+  // Serial A has no room for item 1, nothing after it is sent
+  midi.space[1] = 2;
+  recall.start(preset, false, 0);
+  CHECK(recall.active());
+  CHECK_EQ(bmcTestSent.size(), 0);
+  run(5);
+  CHECK_EQ(bmcTestSent.size(), 0);
+  midi.space[1] = 63;
+  run(1);
+  CHECK(sentInOrder(1, 2, 3, 4) || sentInOrder(1, 2, 4, 3));
+}
+
+void testWaitsForDelay(){
+  reset();
+  setDelay(1, SERIAL_A, 20);
+  setPortless(2);
+  setControl(3, USB);
+  setControl(4, SERIAL_A);
+  setPreset(3, 1, 2, 4);
+  unsigned long start = micros();
+  recall.start(preset, false, 0);
+  // the USB item before the delay is sent, the rest waits for it
+  CHECK_EQ(bmcTestSent.size(), 1);
+  run(10);
+  CHECK_EQ(bmcTestSent.size(), 1);
+  run(15);
+  drain();
+  CHECK(!recall.active());
+  CHECK_EQ(bmcTestSent.size(), 3);
+  CHECK_EQ(sentItems()[1], 2);
+  CHECK(bmcTestSent[1].time - start >= 20000);
+}
+
+void testSysExRoom(){
+  reset();
+  setControl(1, USB);
+  setSysEx(2, SERIAL_A, 40);
+  setSysEx(3, SERIAL_A, 100);
+  setControl(4, USB);
+  setPreset(1, 2, 3, 4);
+  // just booted, the buffer is partly full and was never seen empty, a 40
+  // byte SysEx doesn't fit in the 20 bytes left
+  BMCPresetRecall booted(midi, library);
+  midi.space[1] = 20;
+  booted.start(preset, false, 0);
+  run(5, booted);
+  CHECK_EQ(bmcTestSent.size(), 2);
+  midi.space[1] = 40;
+  run(1, booted);
+  CHECK_EQ(bmcTestSent.size(), 3);
+  CHECK_EQ(sentItems()[2], 2);
+  // larger than the buffer, sent once it's empty
+  midi.space[1] = 62;
+  run(5, booted);
+  CHECK_EQ(bmcTestSent.size(), 3);
+  midi.space[1] = 63;
+  run(1, booted);
+  CHECK_EQ(bmcTestSent.size(), 4);
+  // done once the buffer is empty again
+  CHECK(booted.active());
+  midi.space[1] = 63;
+  run(1, booted);
+  CHECK(!booted.active());
+  CHECK(booted.getLatency(BMC_MIDI_PORT_SERIAL_A_BIT) > 0);
+}
+
+int main(){
+  testOrder();
+  testWaitsForPort();
+  testWaitsForDelay();
+  testSysExRoom();
+  return BMC_TEST_RESULT();
+}
@@ -0,0 +1,99 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the Preset Recall test, only the parts
+  of BMC that BMCPresetRecall uses. BMCMidi has a transmit buffer per port
+  that the test empties, BMCLibrary keeps every item it was asked to send.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+#include <vector>
+
+#define BMC_MAX_LIBRARY 16
+#define BMC_MAX_PRESETS 4
+#define BMC_MAX_PRESET_ITEMS 8
+#define BMC_PRESET_PIPELINE_ENABLED
+#define BMC_MIDI_SERIAL_TX_BUFFER_SIZE 64
+
+#define BMC_MIDI_CONTROL_CHANGE 0xB0
+#define BMC_LIBRARY_EVENT_DELAY 4
+#define BMC_MIDI_PORT_USB_BIT 0
+#define BMC_MIDI_PORT_SERIAL_A_BIT 1
+
+#define BMC_GET_BYTE(byteIndex,item) ((byteIndex>0) ? ((item >> (byteIndex*8)) & 0xFF) : (item & 0xFF))
+
+typedef uint8_t bmcLibrary_t;
+
+struct __attribute__ ((packed)) bmcStoreGlobalPresets {
+  uint8_t length = 0;
+  bmcLibrary_t events[BMC_MAX_PRESET_ITEMS];
+};
+
+// what was sent, @port is 0 for items without a port
+struct FakeSent {
+  unsigned long time;
+  bmcLibrary_t index;
+  uint8_t port;
+};
+static std::vector<FakeSent> bmcTestSent;
+
+class BMCMidi {
+public:
+  // free bytes in the transmit buffer of USB and Serial A
+  uint8_t space[2] = {255, 63};
+  uint8_t getPortPreset(uint8_t port){ return port; }
+  uint8_t getLocalControl(uint8_t channel, uint8_t control){ return 0; }
+  uint8_t getTxSpace(uint8_t portBit){
+    return portBit < 2 ? space[portBit] : 255;
+  }
+  uint8_t getTxIdleSpace(uint8_t portBit){
+    return portBit == BMC_MIDI_PORT_SERIAL_A_BIT ? BMC_MIDI_SERIAL_TX_BUFFER_SIZE - 1 : 255;
+  }
+  void send(uint8_t port, uint32_t event){
+    consume(port, 3);
+    FakeSent sent = {micros(), (bmcLibrary_t) BMC_GET_BYTE(1, event), port};
+    bmcTestSent.push_back(sent);
+  }
+  // takes @length bytes from the buffer of the ports in @port
+  void consume(uint8_t port, uint16_t length){
+    if((port & 0x02) && space[1] != 255){
+      space[1] = (length > space[1]) ? 0 : space[1] - length;
+    }
+  }
+};
+
+// library events are CC#<index> so each one can be told apart
+class BMCLibrary {
+public:
+  uint32_t events[BMC_MAX_LIBRARY];
+  uint16_t sysExLength[BMC_MAX_LIBRARY];
+  BMCMidi& midi;
+  BMCLibrary(BMCMidi& t_midi):midi(t_midi){
+    for(uint8_t i = 0 ; i < BMC_MAX_LIBRARY ; i++){
+      events[i] = 0;
+      sysExLength[i] = 0;
+    }
+  }
+  uint32_t getEvent(bmcLibrary_t n){ return events[n]; }
+  uint16_t getDelay(bmcLibrary_t n){
+    return (BMC_GET_BYTE(1, events[n]) & 0x7F) | ((BMC_GET_BYTE(2, events[n]) & 0x7F) << 7);
+  }
+  uint16_t getSysExLength(bmcLibrary_t n){ return sysExLength[n]; }
+  // items without a port
+  void send(bmcLibrary_t n){
+    FakeSent sent = {micros(), n, 0};
+    bmcTestSent.push_back(sent);
+  }
+  void sendWithDifferentPorts(bmcLibrary_t n, uint8_t port){
+    midi.consume(port, sysExLength[n]);
+    FakeSent sent = {micros(), n, port};
+    bmcTestSent.push_back(sent);
+  }
+};
+
+#endif
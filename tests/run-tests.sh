@@ -0,0 +1,20 @@
+#!/bin/sh
+# Builds and runs every host test, run it from the root of the library:
+#   sh tests/run-tests.sh
+# each tests/<name>/test-<name>.cpp is built with the stubs in tests/<name>
+# and tests/common in front of src so they replace the headers of the same name
+CXX=${CXX:-g++}
+OUT=${TMPDIR:-/tmp}/bmc-tests
+mkdir -p "$OUT"
+failed=0
+for test in tests/*/test-*.cpp; do
+  dir=$(dirname "$test")
+  name=$(basename "$test" .cpp)
+  if ! $CXX -std=gnu++14 -Wall -I "$dir" -I tests/common -I src "$test" -o "$OUT/$name"; then
+    echo "$test: BUILD FAILED"
+    failed=1
+    continue
+  fi
+  "$OUT/$name" || failed=1
+done
+exit $failed
@@ -0,0 +1,31 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces the Arduino MIDI library for the SysEx pool test, only the
+  serial transport that BMC-MidiTransport.h builds on.
+*/
+#ifndef BMC_TEST_MIDI_H
+#define BMC_TEST_MIDI_H
+
+#include "Arduino.h"
+
+namespace midi {
+template <class SerialPort>
+class SerialMIDI {
+public:
+  SerialMIDI(SerialPort& t_serial):serial(t_serial){}
+  byte read(){
+    return serial.read();
+  }
+  unsigned available(){
+    return serial.available();
+  }
+protected:
+  SerialPort& serial;
+};
+}
+
+#endif
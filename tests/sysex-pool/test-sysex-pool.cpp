@@ -0,0 +1,169 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCSysExPool with 8 blocks of 16 bytes, feeds USB and USB Host chunks
+  interleaved the way the drivers pass them, runs the pool out of blocks and
+  reads a Serial SysEx larger than the MIDI library's buffer through the
+  transport in BMC-MidiTransport.h one byte at a time.
+
+  g++ -std=gnu++14 -I tests/sysex-pool -I tests/common -I src tests/sysex-pool/test-sysex-pool.cpp -o test-sysex-pool
+*/
+#include "bmc-test.h"
+#include "utility/BMC-Def.h"
+#include "midi/BMC-SysExPool.h"
+#include "midi/BMC-MidiTransport.h"
+#include <vector>
+
+#define USB BMC_MIDI_PORT_USB_BIT
+#define HOST BMC_MIDI_PORT_HOST_BIT
+#define SERIAL_A BMC_MIDI_PORT_SERIAL_A_BIT
+
+// bytes a serial port received, read by the MIDI library transport
+class FakeSerial {
+public:
+  std::vector<uint8_t> rx;
+  size_t position = 0;
+  unsigned available(){
+    return rx.size() - position;
+  }
+  uint8_t read(){
+    return rx[position++];
+  }
+};
+
+BMCSysExPool pool;
+
+// a SysEx of @length bytes, 0xF0 and 0xF7 included, the data starts at @seed
+std::vector<uint8_t> sysEx(uint16_t length, uint8_t seed){
+  std::vector<uint8_t> data;
+  data.push_back(0xF0);
+  for(uint16_t i = 0 ; i < length-2 ; i++){
+    data.push_back((seed + i) & 0x7F);
+  }
+  data.push_back(0xF7);
+  return data;
+}
+// feeds bytes @from to @to of @data
+void feed(uint8_t port, const std::vector<uint8_t>& data, size_t from, size_t to){
+  pool.feed(port, &data[from], to - from);
+}
+// the message on @port is @data
+bool holds(uint8_t port, const std::vector<uint8_t>& data){
+  if(!pool.isComplete(port) || pool.getLength(port) != data.size()){
+    return false;
+  }
+  std::vector<uint8_t> buff(data.size());
+  // read across the blocks in odd sized pieces
+  uint16_t offset = 0;
+  while(offset < data.size()){
+    offset += pool.read(port, offset, &buff[offset], 7);
+  }
+  return buff == data;
+}
+
+void testInterleaved(){
+  std::vector<uint8_t> usb = sysEx(60, 1);
+  std::vector<uint8_t> host = sysEx(50, 40);
+  // USB drivers pass 3 bytes at a time, the Host driver passes up to 16
+  size_t u = 0, h = 0;
+  while(u < usb.size() || h < host.size()){
+    if(u < usb.size()){
+      size_t n = (u + 3 < usb.size()) ? 3 : usb.size() - u;
+      feed(USB, usb, u, u + n);
+      u += n;
+    }
+    if(h < host.size()){
+      size_t n = (h + 16 < host.size()) ? 16 : host.size() - h;
+      feed(HOST, host, h, h + n);
+      h += n;
+    }
+  }
+  CHECK(holds(USB, usb));
+  CHECK(holds(HOST, host));
+  // 4 blocks for 60 bytes, 4 for 50
+  CHECK_EQ(pool.getStats().inUse, 8);
+  // the lowest port first, each one only once
+  CHECK(pool.hasCompleted());
+  CHECK_EQ(pool.takeCompleted(), USB);
+  CHECK_EQ(pool.takeCompleted(), HOST);
+  CHECK(!pool.hasCompleted());
+  CHECK_EQ(pool.takeCompleted(), BMC_SYSEX_POOL_NONE);
+  pool.release(USB);
+  pool.release(HOST);
+  CHECK_EQ(pool.getStats().inUse, 0);
+  CHECK_EQ(pool.getStats().assembled, 2);
+  CHECK(!pool.has(USB) && !pool.has(HOST));
+}
+
+void testExhaustion(){
+  pool.resetStats();
+  std::vector<uint8_t> usb = sysEx(100, 3);
+  std::vector<uint8_t> host = sysEx(40, 9);
+  // USB takes 6 of the 8 blocks before Host starts
+  feed(USB, usb, 0, 90);
+  CHECK(pool.has(USB) && !pool.isComplete(USB));
+  // Host needs 3 blocks, there are 2 left
+  feed(HOST, host, 0, host.size());
+  CHECK(!pool.has(HOST));
+  CHECK_EQ(pool.getStats().dropped, 1);
+  // USB isn't affected, the blocks Host had are back in the pool
+  feed(USB, usb, 90, usb.size());
+  CHECK(holds(USB, usb));
+  CHECK_EQ(pool.getStats().inUse, 7);
+  CHECK_EQ(pool.getStats().highWater, 8);
+  // nothing is left for a USB Host message while the USB one isn't released
+  feed(HOST, host, 0, host.size());
+  CHECK_EQ(pool.getStats().dropped, 2);
+  CHECK_EQ(pool.takeCompleted(), USB);
+  pool.release(USB);
+  // all of the blocks can be used by a single message
+  std::vector<uint8_t> full = sysEx(128, 5);
+  feed(HOST, full, 0, full.size());
+  CHECK(holds(HOST, full));
+  pool.release(HOST);
+  // one byte more doesn't fit
+  std::vector<uint8_t> large = sysEx(129, 5);
+  feed(HOST, large, 0, large.size());
+  CHECK(!pool.has(HOST));
+  CHECK_EQ(pool.getStats().dropped, 3);
+  CHECK_EQ(pool.getStats().inUse, 0);
+  // a status byte in the middle of a message cuts it off
+  feed(USB, usb, 0, 40);
+  uint8_t noteOn[] = {0x90, 60, 100};
+  pool.feed(USB, noteOn, 3);
+  CHECK(!pool.has(USB));
+  CHECK_EQ(pool.getStats().inUse, 0);
+  CHECK(!pool.hasCompleted());
+}
+
+void testSerial(){
+  FakeSerial serial;
+  bmcSerialMIDI<FakeSerial, SERIAL_A> transport(serial);
+  // larger than the MIDI library's buffer, with clocks in between
+  std::vector<uint8_t> data = sysEx(120, 20);
+  serial.rx = data;
+  serial.rx.insert(serial.rx.begin() + 30, 0xF8);
+  serial.rx.insert(serial.rx.begin() + 100, 0xF8);
+  // the library reads one byte at a time, the pool has the message as the
+  // bytes arrive, not once the library is done with it
+  while(serial.available() > 1){
+    transport.read();
+  }
+  CHECK(pool.has(SERIAL_A) && !pool.isComplete(SERIAL_A));
+  CHECK_EQ(pool.getLength(SERIAL_A), 119);
+  transport.read();
+  CHECK(holds(SERIAL_A, data));
+  CHECK_EQ(pool.takeCompleted(), SERIAL_A);
+  pool.release(SERIAL_A);
+}
+
+int main(){
+  BMCSysExPool::instance() = &pool;
+  testInterleaved();
+  testExhaustion();
+  testSerial();
+  return BMC_TEST_RESULT();
+}
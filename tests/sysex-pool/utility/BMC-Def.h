@@ -0,0 +1,24 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the SysEx pool test, a small pool so
+  it's easy to run out of blocks.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+
+#define BMC_SYSEX_POOL_ENABLED
+#define BMC_SYSEX_POOL_BLOCKS 8
+#define BMC_SYSEX_POOL_BLOCK_SIZE 16
+
+#define BMC_MIDI_PORT_USB_BIT       0
+#define BMC_MIDI_PORT_SERIAL_A_BIT  1
+#define BMC_MIDI_PORT_HOST_BIT      5
+#define BMC_MIDI_PORT_BLE_BIT       6
+
+#endif
@@ -0,0 +1,38 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/midi/BMC-Midi.h for the Tempo To Tap test, every event and
+  clock message sent is kept with the time it was sent at.
+*/
+#ifndef BMC_MIDI_H
+#define BMC_MIDI_H
+
+#include <vector>
+
+struct FakeSent {
+  unsigned long time;
+  uint32_t event;
+};
+
+class BMCMidi {
+public:
+  std::vector<FakeSent> events;
+  unsigned long clockTicks = 0;
+  void send(uint32_t event){
+    FakeSent sent = {micros(), event};
+    events.push_back(sent);
+  }
+  void sendRealTime(uint8_t port, uint8_t type, uint8_t cable=0){
+    if(type == BMC_MIDI_RT_CLOCK){
+      clockTicks++;
+    }
+  }
+  void sendSongPosition(uint8_t port, uint16_t position, uint8_t cable=0){}
+  uint8_t getListenerPorts(){ return 1; }
+  bool isIncomingClockPort(){ return false; }
+};
+
+#endif
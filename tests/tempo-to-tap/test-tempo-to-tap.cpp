@@ -0,0 +1,179 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  BMCTempoToTap driven by the master BMCMidiClock the way BMC.midi.cpp does
+  it, checks that taps are sent on the beats exactly one beat apart, that
+  each device gets the taps of it's profile, that the threshold keeps small
+  tempo changes from tapping again and that a window of 255 doesn't
+  overflow the number of taps.
+
+  g++ -std=gnu++14 -I tests/tempo-to-tap -I tests/common -I src tests/tempo-to-tap/test-tempo-to-tap.cpp -o test-tempo-to-tap
+*/
+#include "bmc-test.h"
+#include "utility/BMC-Def.h"
+#include "midi/BMC-MidiClock.h"
+#include "utility/BMC-TempoToTap.h"
+
+BMCMidi midi;
+bmcStoreGlobal global;
+BMCMidiClock midiClock(midi);
+BMCTempoToTap tempoToTap(midi, global);
+// the time of every beat of the clock
+std::vector<unsigned long> beats;
+
+// a Control Change on port 1, CC @n value 127
+uint32_t tapEvent(uint8_t n){
+  return 0x017F00B0UL | ((uint32_t) n << 8);
+}
+// runs the clock for @ms milliseconds
+void run(unsigned long ms){
+  unsigned long end = bmcTestMicros + (ms * 1000UL);
+  while(bmcTestMicros < end){
+    bmcTestAdvanceUs(10);
+    if(midiClock.read()){
+      beats.push_back(micros());
+      if(midiClock.tempoChanged()){
+        tempoToTap.send(midiClock.getBpm());
+      }
+      tempoToTap.beat();
+    }
+  }
+}
+// the times device @n was tapped at
+std::vector<unsigned long> tapsOf(uint8_t n){
+  std::vector<unsigned long> times;
+  for(size_t i = 0 ; i < midi.events.size() ; i++){
+    if(midi.events[i].event == tapEvent(n)){
+      times.push_back(midi.events[i].time);
+    }
+  }
+  return times;
+}
+bool isBeat(unsigned long time){
+  for(size_t i = 0 ; i < beats.size() ; i++){
+    if(beats[i] == time){
+      return true;
+    }
+  }
+  return false;
+}
+// @count taps, each one on a beat and one beat apart at @bpm, taps sent
+// before @bpm was assigned are skipped with @skip
+void checkTaps(uint8_t n, size_t count, uint16_t bpm, size_t skip=0){
+  std::vector<unsigned long> times = tapsOf(n);
+  CHECK_EQ(times.size(), count + skip);
+  for(size_t i = skip ; i < times.size() ; i++){
+    CHECK(isBeat(times[i]));
+    // the clock is read every 10us
+    if(i > skip){
+      long drift = (long) (times[i] - times[i-1]) - (long) (60000000UL / bpm);
+      CHECK(drift > -10 && drift < 10);
+    }
+  }
+}
+void clear(){
+  midi.events.clear();
+  beats.clear();
+}
+
+void testTaps(){
+  // 120 BPM is assigned 100ms after becoming master
+  midiClock.setMaster(true);
+  run(5000);
+  CHECK_EQ(midiClock.getBpm(), 120);
+  CHECK(!tempoToTap.isTapping());
+  checkTaps(0, BMC_TEMPO_TO_TAP_DEFAULT_TAPS, 120);
+  // at least the averaging window + 1
+  checkTaps(1, 7, 120);
+  checkTaps(2, 3, 120);
+  CHECK_EQ(tempoToTap.getTappedBpm(0), 120);
+  // the first tap is on the first beat at the new tempo
+  CHECK_EQ(tapsOf(0)[0], beats[0]);
+  clear();
+  midiClock.setBpm(100);
+  run(5000);
+  checkTaps(0, BMC_TEMPO_TO_TAP_DEFAULT_TAPS, 100);
+  checkTaps(1, 7, 100);
+  checkTaps(2, 3, 100);
+}
+
+void testThreshold(){
+  clear();
+  // device 1 only follows changes of 5 BPM or more
+  midiClock.setBpm(103);
+  run(5000);
+  checkTaps(0, BMC_TEMPO_TO_TAP_DEFAULT_TAPS, 103);
+  checkTaps(1, 0, 103);
+  CHECK_EQ(tempoToTap.getTappedBpm(1), 100);
+  clear();
+  // the drift is from the tempo device 1 was last tapped to, not 103
+  midiClock.setBpm(105);
+  run(5000);
+  checkTaps(0, BMC_TEMPO_TO_TAP_DEFAULT_TAPS, 105);
+  checkTaps(1, 7, 105);
+  clear();
+  // the same tempo again doesn't tap any device
+  tempoToTap.send(105);
+  run(5000);
+  CHECK_EQ(midi.events.size(), 0);
+  // retap sends to every device no matter the threshold
+  tempoToTap.retap(midiClock.getBpm());
+  run(5000);
+  checkTaps(0, BMC_TEMPO_TO_TAP_DEFAULT_TAPS, 105);
+  checkTaps(1, 7, 105);
+  checkTaps(2, 3, 105);
+}
+
+void testRestart(){
+  clear();
+  // a tempo change in the middle of a burst starts it over
+  midiClock.setBpm(140);
+  run(1200);
+  CHECK(tempoToTap.isTapping());
+  size_t sent = tapsOf(1).size();
+  CHECK(sent > 0 && sent < 7);
+  clear();
+  midiClock.setBpm(90);
+  run(10000);
+  // one more tap at 140 is sent in the 100ms the clock waits to assign 90
+  checkTaps(1, 7, 90, 1);
+  CHECK_EQ(tempoToTap.getTappedBpm(1), 90);
+}
+
+void testLargeWindow(){
+  global.tempoToTapProfiles[2].taps = 0;
+  global.tempoToTapProfiles[2].window = 254;
+  CHECK_EQ(tempoToTap.getTaps(2), 255);
+  // no room for one more tap, it used to wrap around to 0
+  global.tempoToTapProfiles[2].window = 255;
+  CHECK_EQ(tempoToTap.getTaps(2), 255);
+  global.tempoToTapProfiles[2].taps = 255;
+  global.tempoToTapProfiles[2].window = 10;
+  CHECK_EQ(tempoToTap.getTaps(2), 255);
+  // a burst of 255 taps is sent whole
+  global.tempoToTapProfiles[2].window = 255;
+  clear();
+  midiClock.setBpm(200);
+  run(80000);
+  checkTaps(2, 255, 200);
+  CHECK(!tempoToTap.isTapping());
+}
+
+int main(){
+  for(uint8_t i = 0 ; i < BMC_MAX_TEMPO_TO_TAP ; i++){
+    global.tempoToTap[i].event = tapEvent(i);
+  }
+  // device 0 uses the defaults
+  global.tempoToTapProfiles[1].taps = 2;
+  global.tempoToTapProfiles[1].window = 6;
+  global.tempoToTapProfiles[1].threshold = 5;
+  global.tempoToTapProfiles[2].taps = 3;
+  testTaps();
+  testThreshold();
+  testRestart();
+  testLargeWindow();
+  return BMC_TEST_RESULT();
+}
@@ -0,0 +1,48 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the Tempo To Tap test, only the parts
+  of BMC that BMCTempoToTap and the master BMCMidiClock use, BMCMidi is the
+  fake one in midi/BMC-Midi.h next to this folder.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+#include "utility/BMC-Flags.h"
+#include "utility/BMC-Timer.h"
+
+#define BMC_MAX_TEMPO_TO_TAP 3
+#define BMC_USE_TEMPO_TO_TAP_PROFILES
+#define BMC_TEMPO_TO_TAP_PROFILES_ENABLED
+
+#define BMC_PRINTLN(...)
+
+#define BMC_MIDI_RT_CLOCK 0xF8
+#define BMC_MIDI_RT_START 0xFA
+#define BMC_MIDI_RT_CONTINUE 0xFB
+#define BMC_MIDI_RT_STOP 0xFC
+
+#define BMC_GET_BYTE(byteIndex,item) ((byteIndex>0) ? ((item >> (byteIndex*8)) & 0xFF) : (item & 0xFF))
+
+// the store.global members from storage/BMC-Store.h
+struct __attribute__ ((packed)) bmcStoreGlobalTempoToTap {
+  uint32_t event = 0;
+};
+struct __attribute__ ((packed)) bmcStoreGlobalTempoToTapProfile {
+  uint8_t taps = 0;
+  uint8_t window = 0;
+  uint8_t threshold = 0;
+};
+struct __attribute__ ((packed)) bmcStoreGlobal {
+  bmcStoreGlobalTempoToTap tempoToTap[BMC_MAX_TEMPO_TO_TAP];
+  bmcStoreGlobalTempoToTapProfile tempoToTapProfiles[BMC_MAX_TEMPO_TO_TAP];
+};
+
+#include "utility/BMC-BpmCalculator.h"
+#include "midi/BMC-Midi.h"
+
+#endif
@@ -0,0 +1,154 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Benchmark of BMCTriggers, a dense stream of Control Changes and Notes is
+  dispatched the old way, every trigger up to available() is checked with
+  isValidTrigger(), and the new way, only the triggers in the bucket of the
+  message from findCandidates(), with 16 triggers and with 127 which is
+  BMC_LIMIT_MAX_TRIGGERS. Both have to run the same triggers in the same
+  order, the number of triggers compared and the time per message of each
+  one are printed.
+
+  g++ -std=gnu++14 -I tests/triggers -I tests/common -I src tests/triggers/test-triggers.cpp -o test-triggers
+*/
+#include "bmc-test.h"
+#include "utility/BMC-Def.h"
+#include "utility/BMC-Triggers.h"
+#include <chrono>
+#include <vector>
+
+#define MESSAGES 200000
+
+BMCMidi midi;
+bmcStoreGlobal global;
+BMCTriggers triggers(midi, global);
+// checksum of the triggers that ran so the compiler can't drop the loops
+unsigned long dispatched = 0;
+
+// trigger @n listens to CC#n on channel 1 port 1, consecutive numbers like
+// a controller mapped one knob after the other, each one compares data2 in
+// a different way
+void setTriggers(uint8_t count){
+  for(uint8_t n = 0 ; n < BMC_MAX_TRIGGERS ; n++){
+    bmcStoreGlobalTriggers& trigger = global.triggers[n];
+    trigger.event = n;
+    trigger.source = 0;
+    if(n >= count){
+      continue;
+    }
+    uint8_t status = BMC_MIDI_CONTROL_CHANGE;
+    uint8_t channel = 0;
+    uint8_t data1 = n;
+    uint8_t data2 = 64;
+    uint8_t op = n & 0x03;
+    trigger.source = (status | channel) | (data1 << 8) | ((uint32_t) data2 << 15) | ((uint32_t) op << 22) | (1UL << 24);
+  }
+  triggers.buildListeners();
+}
+// message @n of the stream, the same every run
+void setMessage(unsigned long n){
+  BMCMidiMessage& m = midi.message;
+  m.ports = 1;
+  m.status = (n % 4 == 0) ? BMC_MIDI_NOTE_ON : BMC_MIDI_CONTROL_CHANGE;
+  m.channel = (n % 7 == 0) ? 2 : 1;
+  m.data1 = (n * 13) & 0x7F;
+  m.data2 = (n * 31) & 0x7F;
+}
+// the old readTrigger()
+void dispatchLinear(std::vector<uint8_t>* ran){
+  if(!triggers.isAllowed()){
+    return;
+  }
+  for(uint8_t index = 0, n = triggers.available() ; index < n ; index++){
+    if(triggers.isValidTrigger(index)){
+      dispatched += index;
+      if(ran){
+        ran->push_back(index);
+      }
+    }
+  }
+}
+// the new readTrigger() in BMC.triggers.cpp
+void dispatchIndexed(std::vector<uint8_t>* ran){
+  if(!triggers.isAllowed()){
+    return;
+  }
+  for(uint8_t i = 0, n = triggers.findCandidates() ; i < n ; i++){
+    uint8_t index = triggers.getCandidate(i);
+    if(triggers.isValidCandidate(index)){
+      dispatched += index;
+      if(ran){
+        ran->push_back(index);
+      }
+    }
+  }
+}
+// every message runs the same triggers both ways
+void checkSameTriggers(){
+  size_t total = 0;
+  for(unsigned long n = 0 ; n < 4096 ; n++){
+    setMessage(n);
+    std::vector<uint8_t> linear, indexed;
+    dispatchLinear(&linear);
+    dispatchIndexed(&indexed);
+    CHECK(linear == indexed);
+    total += linear.size();
+  }
+  // the stream has to hit some triggers or there's nothing to compare
+  CHECK(total > 0);
+}
+// nanoseconds per message
+double measure(void (*dispatch)(std::vector<uint8_t>*)){
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(unsigned long n = 0 ; n < MESSAGES ; n++){
+    setMessage(n);
+    dispatch(0);
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / MESSAGES;
+}
+// triggers compared per message when each message is the one of a
+// trigger, the triggers that share a bucket are compared every time
+double candidates(uint8_t count){
+  unsigned long total = 0;
+  for(uint8_t n = 0 ; n < count ; n++){
+    uint32_t source = global.triggers[n].source;
+    BMCMidiMessage& m = midi.message;
+    m.status = source & 0xF0;
+    m.channel = (source & 0x0F) + 1;
+    m.data1 = (source >> 8) & 0x7F;
+    total += triggers.findCandidates();
+  }
+  return (double) total / count;
+}
+// returns the linear time divided by the indexed time
+double benchmark(uint8_t count){
+  setTriggers(count);
+  CHECK_EQ(triggers.available(), count);
+  checkSameTriggers();
+  printf("%3u triggers: %.1f compared per message\n", count, candidates(count));
+  // best of 3 so a busy machine doesn't skew one side
+  double linear = 1e12, indexed = 1e12;
+  for(uint8_t i = 0 ; i < 3 ; i++){
+    double a = measure(dispatchLinear);
+    double b = measure(dispatchIndexed);
+    linear = (a < linear) ? a : linear;
+    indexed = (b < indexed) ? b : indexed;
+  }
+  printf("%3u triggers: linear %7.1f ns, indexed %7.1f ns per message (%.1fx)\n",
+          count, linear, indexed, linear / indexed);
+  return linear / indexed;
+}
+
+int main(){
+  benchmark(16);
+  // 16 consecutive CCs fit in the 16 buckets one each
+  CHECK(candidates(16) == 1.0);
+  // with every trigger in use the index has to be clearly faster
+  CHECK(benchmark(BMC_MAX_TRIGGERS) > 2.0);
+  printf("checksum %lu\n", dispatched);
+  return BMC_TEST_RESULT();
+}
@@ -0,0 +1,78 @@
+/*
+  See https://www.RoxXxtar.com/bmc for more details
+  Copyright (c) 2020 RoxXxtar.com
+  Licensed under the MIT license.
+  See LICENSE file in the project root for full license information.
+
+  Replaces src/utility/BMC-Def.h for the triggers benchmark, only the parts
+  of BMC that BMCTriggers uses, with the most triggers BMC allows.
+*/
+#ifndef BMC_DEF_H
+#define BMC_DEF_H
+
+#include "Arduino.h"
+#include "utility/BMC-Flags.h"
+
+// BMC_LIMIT_MAX_TRIGGERS in BMC-ConfigCheck.h
+#define BMC_MAX_TRIGGERS 127
+
+#define BMC_PRINTLN(...)
+
+#define BMC_NONE    0
+#define BMC_IGNORE  0
+#define BMC_EQUAL_TO          1
+#define BMC_MORE_OR_EQUAL_TO  2
+#define BMC_LESS_OR_EQUAL_TO  3
+
+#define BMC_MIDI_NOTE_OFF 0x80
+#define BMC_MIDI_NOTE_ON 0x90
+#define BMC_MIDI_CONTROL_CHANGE 0xB0
+#define BMC_MIDI_PROGRAM_CHANGE 0xC0
+
+#define BMC_GET_MIDI_STATUS(value) ( (uint8_t) ((value&0xFF)<0xF0) ? (value & 0xF0) : value )
+#define BMC_GET_BYTE(byteIndex,item) ((byteIndex>0) ? ((item >> (byteIndex*8)) & 0xFF) : (item & 0xFF))
+
+// the parts of src/utility/BMC-MidiMessage.h that triggers read
+struct BMCMidiMessage {
+  uint8_t ports = 0;
+  uint8_t status = 0;
+  uint8_t channel = 0;
+  uint8_t data1 = 0;
+  uint8_t data2 = 0;
+  uint8_t getStatus(){ return status; }
+  uint8_t getChannel(){ return channel; }
+  uint8_t getData1(){ return data1; }
+  uint8_t getData2(){ return data2; }
+  uint8_t getSource(){ return ports; }
+  bool isVoiceStatus(){ return status >= 0x80 && status < 0xF0; }
+  bool isProgramChange(){ return status == BMC_MIDI_PROGRAM_CHANGE; }
+  uint32_t getEvent(){
+    uint32_t event = 0;
+    if(getStatus()>127 && getChannel()>0){
+      event = getStatus() | ((getChannel()-1) & 0x0F);
+      event |= (getData1() << 8) | (getData2() << 16);
+      event |= (getPort()<<24);
+    }
+    return event;
+  }
+  uint8_t getPort(){ return ports; }
+};
+
+class BMCMidi {
+public:
+  BMCMidiMessage message;
+  // no port presets, cables or host devices
+  bool matchPort(uint8_t port, BMCMidiMessage& m){
+    return (port & m.getSource()) != 0;
+  }
+};
+
+struct bmcStoreGlobalTriggers {
+  uint32_t event = 0;
+  uint32_t source = 0;
+};
+struct bmcStoreGlobal {
+  bmcStoreGlobalTriggers triggers[BMC_MAX_TRIGGERS];
+};
+
+#endif